@@ -57,6 +57,16 @@ namespace nrd
     NRD_API Result NRD_CALL CreateInstance(const InstanceCreationDesc& instanceCreationDesc, Instance*& instance);
     NRD_API void NRD_CALL DestroyInstance(Instance& instance);
 
+    // Serializes the instance graph (denoisers, dispatches, resources, pools, pipelines and embedded bytecode) into a versioned,
+    // relocatable blob. If "blob" is NULL, only the required "blobSize" is returned
+    NRD_API Result NRD_CALL SerializeInstance(const Instance& instance, void* blob, uint64_t& blobSize);
+
+    // Creates an instance from a blob produced by "SerializeInstance" of the same library build without graph reconstruction
+    // ("denoisers", "denoisersNum", "viewsNum" and "interleaveViews" of "instanceCreationDesc" are ignored, "UNSUPPORTED" is
+    // returned for blobs of other versions)
+    // IMPORTANT: names and bytecode are referenced in place, i.e. "blob" (can be memory-mapped) must be alive until instance destruction
+    NRD_API Result NRD_CALL CreateInstanceFromBlob(const InstanceCreationDesc& instanceCreationDesc, const void* blob, uint64_t blobSize, Instance*& instance);
+
     // Get
     NRD_API const LibraryDesc& NRD_CALL GetLibraryDesc();
     NRD_API const InstanceDesc& NRD_CALL GetInstanceDesc(const Instance& instance);
@@ -64,13 +74,63 @@ namespace nrd
     // Typically needs to be called once per frame
     NRD_API Result NRD_CALL SetCommonSettings(Instance& instance, const CommonSettings& commonSettings);
 
+    // Multi-view: typically needs to be called once per frame for each view ("SetCommonSettings" sets view 0)
+    NRD_API Result NRD_CALL SetViewCommonSettings(Instance& instance, uint32_t viewIndex, const CommonSettings& commonSettings);
+
+    // Multi-instance: camera derivations (inverse matrices, frustum and projection data) are copied from "cameraSourceViewIndex" view of
+    // "cameraSource" (can be "instance" itself) if it has been updated with the same matrices, otherwise they are computed as usual, i.e.
+    // the result is always the same as for "SetViewCommonSettings". Derivations are skipped anyway if matrices are unchanged since the last call
+    // IMPORTANT: "cameraSource" must not be modified concurrently
+    NRD_API Result NRD_CALL SetViewCommonSettingsWithSharedCamera(Instance& instance, uint32_t viewIndex, const CommonSettings& commonSettings, const Instance& cameraSource, uint32_t cameraSourceViewIndex);
+
     // Typically needs to be called at least once per denoiser (not necessarily on each frame)
     NRD_API Result NRD_CALL SetDenoiserSettings(Instance& instance, Identifier identifier, const void* denoiserSettings);
 
+    // Changes render resolution of all denoisers without reallocations and history loss. Takes effect on the next "SetCommonSettings"
+    // call with a new "frameIndex", history is reprojected from the previous resolution (as for "resolutionScalePrev"). "DenoiserDesc" dimensions become the
+    // maximum: pools and user provided textures keep them, only the top-left "renderWidth x renderHeight" part (additionally scaled
+    // by "resolutionScale") is used
+    NRD_API Result NRD_CALL ResizeInstance(Instance& instance, uint16_t renderWidth, uint16_t renderHeight);
+
     // Retrieves dispatches for the list of identifiers (if they are parts of the instance)
     // IMPORTANT: returned memory is owned by the "instance" and will be overwritten by the next "GetComputeDispatches" call
     NRD_API Result NRD_CALL GetComputeDispatches(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
 
+    // Dispatch contexts allow recording dispatches for disjoint lists of identifiers from multiple threads in parallel
+    // IMPORTANT: "Set*Settings" and "GetComputeDispatches" (without a context) must not overlap with context-based calls. Multi-view instances serialize
+    // context-based calls internally. "GetReachablePipelines" and "GetFrameDescriptorPoolDesc" are serialized with context-based calls internally
+    NRD_API Result NRD_CALL CreateDispatchContext(Instance& instance, DispatchContext*& dispatchContext);
+    NRD_API void NRD_CALL DestroyDispatchContext(Instance& instance, DispatchContext& dispatchContext);
+
+    // Same as "GetComputeDispatches", but uses storage of the context
+    // IMPORTANT: returned memory is owned by the "dispatchContext" and will be overwritten by the next "GetContextComputeDispatches" call with this context
+    NRD_API Result NRD_CALL GetContextComputeDispatches(Instance& instance, DispatchContext& dispatchContext, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
+
+    // Retrieves pipelines, which can be used by "GetComputeDispatches" for the list of identifiers with the current common and denoiser settings
+    // (can be used to create only needed pipelines upfront and the rest lazily). Cheap if settings haven't changed, i.e. can be polled on each frame
+    // IMPORTANT: returned memory is owned by the "instance" and will be overwritten by the next "GetReachablePipelines" call
+    NRD_API Result NRD_CALL GetReachablePipelines(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, ReachablePipelinesDesc& reachablePipelinesDesc);
+
+    // Retrieves descriptor pool requirements of a frame for the list of identifiers with the current common and denoiser settings: descriptors of
+    // all reachable dispatches plus "clear" dispatches of a restart. Valid for any split of the list across "GetComputeDispatches" calls within
+    // the frame. Unlike "InstanceDesc::descriptorPoolDesc" (all permutations) it's exact, i.e. can be used to avoid oversubscribing descriptor
+    // heaps. Cheap if settings haven't changed, i.e. can be polled on each frame
+    NRD_API Result NRD_CALL GetFrameDescriptorPoolDesc(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, DescriptorPoolDesc& descriptorPoolDesc);
+
+    // If embedded bytecode is compressed (NRD built with "NRD_EMBEDS_COMPRESSED_SHADERS"), "PipelineDesc::computeShader*" stay empty until
+    // this function is called for the pipeline. It decompresses all embedded formats once (identical bytecode is shared) and updates
+    // "InstanceDesc::pipelines" in place. A no-op for already available bytecode, i.e. can be called unconditionally before pipeline creation
+    // IMPORTANT: decompressed memory is owned by the "instance" and is valid until instance destruction
+    NRD_API Result NRD_CALL DecompressPipelineBytecode(Instance& instance, uint32_t pipelineIndex);
+
+    // Retrieves estimated texture memory of the instance per denoiser, format and purpose. Doesn't need any GPU resources, i.e. can be
+    // used for budgeting before creating them
+    // IMPORTANT: returned memory is owned by the "instance" and is valid until instance destruction
+    NRD_API Result NRD_CALL GetMemoryUsage(const Instance& instance, MemoryUsageDesc& memoryUsageDesc);
+
+    // Retrieves counters of allocations made by the instance (see "InstanceCreationDesc::lockAllocations")
+    NRD_API Result NRD_CALL GetAllocationStats(const Instance& instance, AllocationStatsDesc& allocationStatsDesc);
+
     // Helpers
     NRD_API const char* GetResourceTypeString(ResourceType resourceType);
     NRD_API const char* GetDenoiserString(Denoiser denoiser);
@@ -20,6 +20,7 @@ namespace nrd
     typedef uint32_t Identifier;
 
     struct Instance;
+    struct DispatchContext;
 
     enum class Result : uint32_t
     {
@@ -360,6 +361,20 @@ namespace nrd
         MAX_NUM
     };
 
+    enum class DependencyType : uint32_t
+    {
+        // A resource is read after being written by an earlier dispatch (the earlier dispatch is the producer)
+        READ_AFTER_WRITE,
+
+        // A resource is written after being read by an earlier dispatch
+        WRITE_AFTER_READ,
+
+        // A resource is written after being written by an earlier dispatch
+        WRITE_AFTER_WRITE,
+
+        MAX_NUM
+    };
+
     enum class Sampler : uint32_t
     {
         NEAREST_CLAMP,
@@ -402,6 +417,21 @@ namespace nrd
         MAX_NUM
     };
 
+    // Precision of history (permanent pool) textures
+    enum class MemoryBudget : uint8_t
+    {
+        // Full precision
+        DEFAULT,
+
+        // Only some history textures are packed, savings are modest (4-20% of history memory, see README):
+        // - "viewZ" history is stored in FP16 with range scaling (see "NRD_FP16_VIEWZ_SCALE")
+        // - RELAX diffuse responsive history, which doesn't use alpha, is stored in R11G11B10
+        // - radiance history (which keeps hit distance in alpha) is not affected
+        PARTIALLY_PACKED,
+
+        MAX_NUM
+    };
+
     struct MemoryAllocatorInterface
     {
         void* (*Allocate)(void* userArg, size_t size, size_t alignment);
@@ -434,7 +464,7 @@ namespace nrd
     {
         Identifier identifier;
         Denoiser denoiser;
-        uint16_t renderWidth;
+        uint16_t renderWidth; // maximum, if "ResizeInstance" is used
         uint16_t renderHeight;
     };
 
@@ -443,6 +473,43 @@ namespace nrd
         MemoryAllocatorInterface memoryAllocatorInterface;
         const DenoiserDesc* denoisers;
         uint32_t denoisersNum;
+
+        // Multi-view (optional)
+        // - all "denoisers" are instantiated for each view, each view has its own "CommonSettings" and history
+        // - a view is selected by "viewIndex" in "SetCommonSettings", denoiser settings are shared
+        // - "DispatchDesc::viewIndex" tells which view user provided resources belong to
+        uint32_t viewsNum; // 0 is treated as 1
+
+        // true - same-pipeline dispatches of different views are adjacent in the dispatch list (fewer pipeline switches),
+        //        views have dedicated transient resources since they run simultaneously
+        // false - views run sequentially and share transient resources
+        bool interleaveViews;
+
+        // Memory budget tier of history textures (see "MemoryBudget")
+        MemoryBudget memoryBudget;
+
+        // Geometry history sharing (optional)
+        // - denoisers of the same family (REBLUR or RELAX) and dimensions share "viewZ" and normal-roughness history (and material ID for RELAX)
+        // - it's written by the first of them dispatched in a frame (any subset can be dispatched), others read it. Calls dispatching them
+        //   must be submitted in the order of "GetComputeDispatches" calls. All of them must use the same "IN_VIEWZ" and "IN_NORMAL_ROUGHNESS"
+        // - the history is double buffered, i.e. the group keeps two textures per history instead of one per denoiser
+        bool shareGeometryHistory;
+
+        // Allocations made through "memoryAllocatorInterface" are counted (see "GetAllocationStats"). After creation storage needed
+        // for "GetComputeDispatches" is preallocated for the worst case, i.e. steady state allocations are not expected. If "true",
+        // any of them additionally triggers an assert in debug builds
+        bool lockAllocations;
+
+        // Constant data ring (optional)
+        // - constants returned by "GetComputeDispatches" are placed into one of "framesInFlightNum" partitions, a partition
+        //   is reused only after "framesInFlightNum" frames (a new frame starts when "CommonSettings::frameIndex" of view 0 changes)
+        // - if a partition is exhausted, "GetComputeDispatches" returns "Result::FAILURE" instead of overwriting data, which can be in use
+        // - "constantData" allows to place constants directly into persistently mapped upload memory (no copies), it must
+        //   be "framesInFlightNum * constantDataPerFrameSize" bytes, owned by the application and alive until instance destruction
+        uint8_t* constantData; // can be NULL
+        uint32_t framesInFlightNum; // 0 is treated as 3
+        uint32_t constantDataPerFrameSize; // 0 is treated as 1 Mb, must be a multiple of "constantDataAlignment"
+        uint32_t constantDataAlignment; // alignment of constants of each dispatch (i.e. "constantBufferOffsetAlignment"), 0 is treated as 4 (tightly packed)
     };
 
     struct TextureDesc
@@ -453,6 +520,19 @@ namespace nrd
         uint16_t mipNum;
     };
 
+    // Estimated memory placement of a transient texture (see "InstanceDesc::transientPoolAliasing")
+    struct TransientAliasingDesc
+    {
+        uint64_t offset; // in the aliasing group
+        uint64_t size;
+        uint32_t aliasingGroupIndex;
+    };
+
+    struct AliasingGroupDesc
+    {
+        uint64_t size;
+    };
+
     struct ResourceDesc
     {
         DescriptorType stateNeeded;
@@ -485,6 +565,8 @@ namespace nrd
         const ResourceRangeDesc* resourceRanges;
         uint32_t resourceRangesNum;
         bool hasConstantData;
+        bool hasSharedConstantData;
+        uint16_t uniquePipelineIndex; // the first pipeline with identical bytecode (in all embedded formats), resource ranges and constant buffers (can be this one), i.e. pipeline objects can be shared
     };
 
     struct DescriptorPoolDesc
@@ -503,6 +585,10 @@ namespace nrd
         uint32_t constantBufferSpaceIndex;
         uint32_t constantBufferRegisterIndex;
 
+        // Shared constant buffer (per denoiser, the same data for all dispatches of a denoiser within a frame)
+        uint32_t sharedConstantBufferMaxDataSize;
+        uint32_t sharedConstantBufferRegisterIndex;
+
         // Samplers (shared)
         const Sampler* samplers;
         uint32_t samplersNum;
@@ -511,9 +597,12 @@ namespace nrd
 
         // Pipelines
         // - if "PipelineDesc::hasConstantData = true" a pipeline has a constant buffer with the shared description
+        // - if "PipelineDesc::hasSharedConstantData = true" a pipeline has a shared constant buffer (in the same space)
         // - if "samplers" are used as static/immutable samplers, "DescriptorPoolDesc::samplerMaxNum" is not needed (it counts samplers across all dispatches)
+        // - pipelines with "PipelineDesc::uniquePipelineIndex != i" can reuse pipeline objects of "uniquePipelineIndex", i.e. only "uniquePipelinesNum" need to be created
         const PipelineDesc* pipelines;
         uint32_t pipelinesNum;
+        uint32_t uniquePipelinesNum;
         uint32_t resourcesSpaceIndex;
 
         // Textures
@@ -522,19 +611,93 @@ namespace nrd
         const TextureDesc* transientPool;
         uint32_t transientPoolSize;
 
-        // Limits
+        // Transient pool aliasing (optional)
+        // - "transientPoolAliasing[i]" describes placement of "transientPool[i]" in "aliasingGroups[ transientPoolAliasing[i].aliasingGroupIndex ]"
+        // - textures overlapping in memory never have overlapping lifetimes, i.e. memory of a group can be shared (aliased)
+        // - sizes and offsets are estimations: "width * height * bytesPerPixel" summed for all mips and aligned to 64 Kb
+        const TransientAliasingDesc* transientPoolAliasing;
+        const AliasingGroupDesc* aliasingGroups;
+        uint32_t aliasingGroupsNum;
+
+        // Views (see "InstanceCreationDesc::viewsNum")
+        uint32_t viewsNum;
+
+        // Constant data ring (see "InstanceCreationDesc::constantData")
+        // - the first byte of partition "i" is "constantData + i * constantDataPerFrameSize"
+        const uint8_t* constantData;
+        uint32_t framesInFlightNum;
+        uint32_t constantDataPerFrameSize;
+
+        // Limits (for all permutations, see "GetFrameDescriptorPoolDesc" for exact per-frame requirements)
         DescriptorPoolDesc descriptorPoolDesc;
     };
 
+    struct DispatchDependency
+    {
+        uint32_t dispatchIndex; // index of an earlier dispatch in the list returned by "GetComputeDispatches"
+        uint32_t resourceIndex; // index in "DispatchDesc::resources" of the dependent dispatch
+        DependencyType type;
+    };
+
     struct DispatchDesc
     {
         const char* name;
         const ResourceDesc* resources; // concatenated resources for all "resourceRanges" descriptions in DenoiserDesc::pipelines[ pipelineIndex ]
         uint32_t resourcesNum;
         const uint8_t* constantBufferData;
+        const uint8_t* sharedConstantBufferData; // the same pointer for all dispatches of a denoiser, i.e. needs to be uploaded only if changed
+        const DispatchDependency* dependencies; // all hazards (per mip) with earlier dispatches of the same "GetComputeDispatches" call
         uint32_t constantBufferDataSize;
+        uint32_t sharedConstantBufferDataSize;
+        uint32_t dependenciesNum;
+        uint16_t dependencyLevel; // dispatches with the same level don't depend on each other and can overlap
+        uint16_t viewIndex; // user provided resources must be taken from this view
         uint16_t pipelineIndex;
         uint16_t gridWidth;
         uint16_t gridHeight;
     };
+
+    struct ReachablePipelinesDesc
+    {
+        const uint16_t* pipelineIndices; // all reachable pipelines (including "clear" pipelines, sorted)
+        const uint16_t* newPipelineIndices; // reachable pipelines, which haven't been reported by previous calls (i.e. became reachable due to a settings change)
+        uint32_t pipelineIndicesNum;
+        uint32_t newPipelineIndicesNum;
+    };
+
+    // Estimated memory of textures of the same format and purpose used by a denoiser (see "GetMemoryUsage")
+    struct MemoryUsageEntry
+    {
+        Identifier identifier;
+        uint32_t viewIndex;
+        Format format;
+        bool isHistory; // true - history (permanent pool), false - intermediate data (transient pool)
+        uint32_t texturesNum;
+        uint64_t size; // bytes, all mips (estimated as for "TransientAliasingDesc::size")
+        uint64_t sharedSize; // bytes, part of "size" taken by textures of previous denoisers (i.e. reused, not allocated again)
+    };
+
+    struct MemoryUsageDesc
+    {
+        const MemoryUsageEntry* entries; // grouped by denoisers (in creation order, view by view)
+        uint32_t entriesNum;
+
+        // Totals
+        uint64_t permanentPoolSize; // allocated, i.e. sharing of geometry history is already applied (see "InstanceCreationDesc::shareGeometryHistory")
+        uint64_t permanentPoolSharedSize; // saved by sharing geometry history between denoisers
+        uint64_t transientPoolSize; // allocated without aliasing, i.e. sharing of transient textures between denoisers is already applied
+        uint64_t transientPoolSharedSize; // saved by sharing transient textures between denoisers
+        uint64_t transientPoolAliasedSize; // additionally saved by aliasing (see "InstanceDesc::aliasingGroups")
+    };
+
+    // Allocations made by an instance through "InstanceCreationDesc::memoryAllocatorInterface" (see "GetAllocationStats"),
+    // the instance object itself is not included
+    struct AllocationStatsDesc
+    {
+        uint64_t allocationsNum;
+        uint64_t freesNum;
+        uint64_t allocatedSize; // bytes, currently allocated
+        uint64_t peakAllocatedSize; // bytes
+        uint64_t steadyStateAllocationsNum; // made after creation, excluding "CreateDispatchContext" (expected to be 0)
+    };
 }
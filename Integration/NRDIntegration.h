@@ -18,9 +18,9 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 //    Extensions/NRIWrapperD3D12.h
 //    Extensions/NRIWrapperVK.h
 
+#include <algorithm>
 #include <array>
 #include <vector>
-#include <map>
 
 #define NRD_INTEGRATION_MAJOR 1
 #define NRD_INTEGRATION_MINOR 7
@@ -44,6 +44,7 @@ struct NrdIntegrationTexture
 };
 
 typedef std::array<NrdIntegrationTexture, (size_t)nrd::ResourceType::MAX_NUM - 2> NrdUserPool;
+typedef std::pair<uint64_t, nri::Descriptor*> NrdCachedDescriptor;
 
 // User pool must contain valid entries only for resources, which are required for requested denoisers, but
 // the entire pool must be zero-ed during initialization
@@ -55,6 +56,47 @@ inline void NrdIntegration_SetResource(NrdUserPool& pool, nrd::ResourceType slot
     pool[(size_t)slot] = texture;
 }
 
+class NrdIntegration;
+
+// Transient memory shared by several "NrdIntegration" instances (for example, a main view and a reflection probe).
+// Transient textures of each instance are placed from the beginning of the heap, i.e. the heap is sized to the
+// maximum of the instances, not to the sum. Instances must denoise strictly sequentially on the same queue and
+// "Denoise" calls must be recorded in the submission order
+class NrdTransientHeap
+{
+public:
+    // Must be called after initialization of all sharing instances and before the first "Denoise" call
+    bool Allocate(nri::Device& nriDevice, const nri::CoreInterface& nriCore);
+
+    // Must be called after destruction of all sharing instances
+    void Destroy();
+
+    inline double GetMemoryUsageInMb() const
+    {
+        uint64_t size = 0;
+        for (const Heap& heap : m_Heaps)
+            size += heap.size;
+
+        return double(size) / (1024.0 * 1024.0);
+    }
+
+private:
+    friend class NrdIntegration;
+
+    // One per memory type
+    struct Heap
+    {
+        nri::Memory* memory;
+        uint64_t size;
+        nri::MemoryType type;
+    };
+
+    std::vector<Heap> m_Heaps;
+    std::vector<NrdIntegration*> m_Instances;
+    const NrdIntegration* m_Owner = nullptr;
+    const nri::CoreInterface* m_NRI = nullptr;
+};
+
 class NrdIntegration
 {
 public:
@@ -73,20 +115,30 @@ public:
     ~NrdIntegration()
     { NRD_INTEGRATION_ASSERT( m_NRI == nullptr, "m_NRI must be NULL at this point!" ); }
 
-    // There is no "Resize" functionality, because NRD full recreation costs nothing.
-    // The main cost comes from render targets resizing, which needs to be done in any case
+    // Dimensions in "DenoiserDesc" are the maximum, "Resize" changes the render resolution within them
+    // without reallocations and history loss. Full recreation is needed only to grow beyond them
     // (call Destroy beforehand)
-    bool Initialize(const nrd::InstanceCreationDesc& instanceCreationDesc, nri::Device& nriDevice, const nri::CoreInterface& nriCore, const nri::HelperInterface& nriHelper);
+    // transientHeap:
+    //      optional, transient textures get placed into the shared heap (see "NrdTransientHeap") instead of
+    //      own memory. They are bound in "NrdTransientHeap::Allocate"
+    bool Initialize(const nrd::InstanceCreationDesc& instanceCreationDesc, nri::Device& nriDevice, const nri::CoreInterface& nriCore, const nri::HelperInterface& nriHelper, NrdTransientHeap* transientHeap = nullptr);
 
     // Must be called once on a frame start
     void NewFrame();
 
-    // Explicitly calls eponymous NRD API functions
-    bool SetCommonSettings(const nrd::CommonSettings& commonSettings);
+    // Explicitly calls eponymous NRD API functions ("viewIndex" is needed only for multi-view instances)
+    bool SetCommonSettings(const nrd::CommonSettings& commonSettings, uint32_t viewIndex = 0);
+
+    // Same as above, but camera derivations are copied from "cameraSource" view, if it has the same matrices (see "nrd::SetViewCommonSettingsWithSharedCamera")
+    bool SetCommonSettings(const nrd::CommonSettings& commonSettings, uint32_t viewIndex, const NrdIntegration& cameraSource, uint32_t cameraSourceViewIndex = 0);
     bool SetDenoiserSettings(nrd::Identifier denoiser, const void* denoiserSettings);
+    bool Resize(uint16_t renderWidth, uint16_t renderHeight);
 
     void Denoise(const nrd::Identifier* denoisers, uint32_t denoisersNum, nri::CommandBuffer& commandBuffer, const NrdUserPool& userPool);
 
+    // Multi-view: "userPools[ DispatchDesc::viewIndex ]" provides user resources for each dispatch
+    void Denoise(const nrd::Identifier* denoisers, uint32_t denoisersNum, nri::CommandBuffer& commandBuffer, const NrdUserPool* userPools, uint32_t userPoolsNum);
+
     // This function assumes that the device is in the IDLE state, i.e. there is no work in flight
     void Destroy();
 
@@ -104,35 +156,49 @@ public:
     { return double(m_TransientPoolSize) / (1024.0 * 1024.0); }
 
 private:
+    friend class NrdTransientHeap;
+
     NrdIntegration(const NrdIntegration&) = delete;
 
     void CreateResources();
     void AllocateAndBindMemory();
+    nri::DescriptorPool* CreateDescriptorPool(const nrd::DescriptorPoolDesc& poolDesc);
+    void AcquireTransientHeap(nri::CommandBuffer& commandBuffer);
     void Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPool& descriptorPool, const nrd::DispatchDesc& dispatchDesc, const NrdUserPool& userPool);
+    uint32_t UploadConstants(const uint8_t* data, uint32_t size);
 
 private:
     std::vector<NrdIntegrationTexture> m_TexturePool;
-    std::map<uint64_t, nri::Descriptor*> m_CachedDescriptors;
+    std::vector<NrdCachedDescriptor> m_CachedDescriptors; // sorted by key, reserved in "CreateResources"
     std::vector<std::vector<nri::Descriptor*>> m_DescriptorsInFlight;
     std::vector<nri::TextureTransitionBarrierDesc> m_ResourceState;
     std::vector<nri::PipelineLayout*> m_PipelineLayouts;
     std::vector<nri::Pipeline*> m_Pipelines;
+    std::vector<uint16_t> m_PipelineIndices; // NRD pipeline => index in "m_Pipelines" and "m_PipelineLayouts" (pipelines with identical bytecode share objects)
     std::vector<nri::Memory*> m_MemoryAllocations;
     std::vector<nri::Descriptor*> m_Samplers;
     std::vector<nri::DescriptorPool*> m_DescriptorPools = {};
+    std::vector<nrd::DescriptorPoolDesc> m_DescriptorPoolDescs = {}; // capacity of each pool
+    std::vector<std::pair<nri::DescriptorPool*, uint32_t>> m_RetiredDescriptorPools; // replaced by bigger ones, destroyed when the frame comes around again
+    std::vector<nrd::Identifier> m_Identifiers; // all denoisers of the instance
     std::vector<nri::DescriptorSet*> m_DescriptorSetSamplers = {};
+    std::vector<nri::TextureMemoryBindingDesc> m_TransientHeapBindings; // "memory" is set in "NrdTransientHeap::Allocate"
+    std::vector<uint32_t> m_TransientHeapIndices;
     const nri::CoreInterface* m_NRI = nullptr;
     const nri::HelperInterface* m_NRIHelper = nullptr;
     nri::Device* m_Device = nullptr;
     nri::Buffer* m_ConstantBuffer = nullptr;
     nri::Descriptor* m_ConstantBufferView = nullptr;
     nrd::Instance* m_Instance = nullptr;
+    NrdTransientHeap* m_TransientHeap = nullptr;
+    const uint8_t* m_SharedConstantBufferData = nullptr;
     const char* m_Name = nullptr;
     uint64_t m_PermanentPoolSize = 0;
     uint64_t m_TransientPoolSize = 0;
     uint64_t m_ConstantBufferSize = 0;
     uint32_t m_ConstantBufferViewSize = 0;
     uint32_t m_ConstantBufferOffset = 0;
+    uint32_t m_SharedConstantBufferOffset = 0;
     uint32_t m_BufferedFramesNum = 0;
     uint32_t m_DescriptorPoolIndex = 0;
     uint32_t m_FrameIndex = 0;
@@ -86,7 +86,7 @@ template<typename T, typename A> constexpr T NRD_GetAlignedSize(const T& size, A
 }
 
 bool NrdIntegration::Initialize(const nrd::InstanceCreationDesc& instanceCreationDesc, nri::Device& nriDevice,
-    const nri::CoreInterface& nriCore, const nri::HelperInterface& nriHelper)
+    const nri::CoreInterface& nriCore, const nri::HelperInterface& nriHelper, NrdTransientHeap* transientHeap)
 {
     NRD_INTEGRATION_ASSERT(!m_Instance, "Already initialized! Did you forget to call 'Destroy'?");
 
@@ -110,6 +110,10 @@ bool NrdIntegration::Initialize(const nrd::InstanceCreationDesc& instanceCreatio
     m_Device = &nriDevice;
     m_NRI = &nriCore;
     m_NRIHelper = &nriHelper;
+    m_TransientHeap = transientHeap;
+
+    for (uint32_t i = 0; i < instanceCreationDesc.denoisersNum; i++)
+        m_Identifiers.push_back(instanceCreationDesc.denoisers[i].identifier);
 
     CreatePipelines();
     CreateResources();
@@ -124,6 +128,11 @@ void NrdIntegration::CreatePipelines()
         m_NRI->DestroyPipeline(*pipeline);
     m_Pipelines.clear();
 
+    for (nri::PipelineLayout* pipelineLayout : m_PipelineLayouts)
+        m_NRI->DestroyPipelineLayout(*pipelineLayout);
+    m_PipelineLayouts.clear();
+    m_PipelineIndices.clear();
+
 #ifdef PROJECT_NAME
      utils::ShaderCodeStorage shaderCodeStorage;
 #endif
@@ -176,9 +185,12 @@ void NrdIntegration::CreatePipelines()
     nri::DescriptorRangeDesc* samplersRange = descriptorRanges;
     nri::DescriptorRangeDesc* resourcesRanges = descriptorRanges + 1;
 
-    // Constant buffer
-    const nri::DynamicConstantBufferDesc dynamicConstantBufferDesc = {constantBufferOffset + instanceDesc.constantBufferRegisterIndex, nri::ShaderStage::COMPUTE};
-    descriptorSetConstantBuffer.dynamicConstantBuffers = &dynamicConstantBufferDesc;
+    // Constant buffers
+    const nri::DynamicConstantBufferDesc dynamicConstantBufferDescs[2] =
+    {
+        {constantBufferOffset + instanceDesc.constantBufferRegisterIndex, nri::ShaderStage::COMPUTE},
+        {constantBufferOffset + instanceDesc.sharedConstantBufferRegisterIndex, nri::ShaderStage::COMPUTE},
+    };
 
     // Samplers
     samplersRange->descriptorType = nri::DescriptorType::SAMPLER;
@@ -187,8 +199,33 @@ void NrdIntegration::CreatePipelines()
     samplersRange->visibility =  nri::ShaderStage::COMPUTE;
 
     // Pipelines
+    m_Pipelines.reserve(instanceDesc.uniquePipelinesNum);
+    m_PipelineLayouts.reserve(instanceDesc.uniquePipelinesNum);
+    m_PipelineIndices.reserve(instanceDesc.pipelinesNum);
+
     for (uint32_t i = 0; i < instanceDesc.pipelinesNum; i++)
     {
+        // Pipelines with identical bytecode and bindings share objects (unless shaders get reloaded from disk)
+        uint16_t uniquePipelineIndex = instanceDesc.pipelines[i].uniquePipelineIndex;
+    #ifdef PROJECT_NAME
+        if (m_IsShadersReloadRequested)
+            uniquePipelineIndex = (uint16_t)i;
+    #endif
+
+        if (uniquePipelineIndex != i)
+        {
+            uint16_t sharedIndex = m_PipelineIndices[uniquePipelineIndex];
+            m_PipelineIndices.push_back(sharedIndex);
+
+            continue;
+        }
+
+        m_PipelineIndices.push_back((uint16_t)m_Pipelines.size());
+
+        // Compressed embedded bytecode gets decompressed on first use
+        [[maybe_unused]] nrd::Result result = nrd::DecompressPipelineBytecode(*m_Instance, i);
+        NRD_INTEGRATION_ASSERT(result == nrd::Result::SUCCESS, "nrd::DecompressPipelineBytecode(): failed!");
+
         const nrd::PipelineDesc& nrdPipelineDesc = instanceDesc.pipelines[i];
         const nrd::ComputeShaderDesc& nrdComputeShader = (&nrdPipelineDesc.computeShaderDXBC)[(uint32_t)deviceDesc.graphicsAPI];
 
@@ -227,7 +264,8 @@ void NrdIntegration::CreatePipelines()
             descriptorSetResources.rangeNum = nrdPipelineDesc.resourceRangesNum + 1;
         }
 
-        descriptorSetConstantBuffer.dynamicConstantBufferNum = nrdPipelineDesc.hasConstantData ? 1 : 0;
+        descriptorSetConstantBuffer.dynamicConstantBuffers = nrdPipelineDesc.hasConstantData ? dynamicConstantBufferDescs : dynamicConstantBufferDescs + 1;
+        descriptorSetConstantBuffer.dynamicConstantBufferNum = (nrdPipelineDesc.hasConstantData ? 1 : 0) + (nrdPipelineDesc.hasSharedConstantData ? 1 : 0);
 
         // Pipeline layout
         nri::PipelineLayoutDesc pipelineLayoutDesc = {};
@@ -362,8 +400,8 @@ void NrdIntegration::CreateResources()
 
     // Constant buffer
     const nri::DeviceDesc& deviceDesc = m_NRI->GetDeviceDesc(*m_Device);
-    m_ConstantBufferViewSize = NRD_GetAlignedSize(instanceDesc.constantBufferMaxDataSize, deviceDesc.constantBufferOffsetAlignment);
-    m_ConstantBufferSize = uint64_t(m_ConstantBufferViewSize) * instanceDesc.descriptorPoolDesc.setsMaxNum * m_BufferedFramesNum;
+    m_ConstantBufferViewSize = NRD_GetAlignedSize(std::max(instanceDesc.constantBufferMaxDataSize, instanceDesc.sharedConstantBufferMaxDataSize), deviceDesc.constantBufferOffsetAlignment);
+    m_ConstantBufferSize = uint64_t(m_ConstantBufferViewSize) * instanceDesc.descriptorPoolDesc.constantBuffersMaxNum * m_BufferedFramesNum;
 
     nri::BufferDesc bufferDesc = {};
     bufferDesc.size = m_ConstantBufferSize;
@@ -378,30 +416,95 @@ void NrdIntegration::CreateResources()
     constantBufferViewDesc.size = m_ConstantBufferViewSize;
     NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateBufferView(constantBufferViewDesc, m_ConstantBufferView));
 
-    // Descriptor pools
-    nri::DescriptorPoolDesc descriptorPoolDesc = {};
-    descriptorPoolDesc.descriptorSetMaxNum = instanceDesc.descriptorPoolDesc.setsMaxNum;
-    descriptorPoolDesc.storageTextureMaxNum = instanceDesc.descriptorPoolDesc.storageTexturesMaxNum;
-    descriptorPoolDesc.textureMaxNum = instanceDesc.descriptorPoolDesc.texturesMaxNum;
-    descriptorPoolDesc.dynamicConstantBufferMaxNum = instanceDesc.descriptorPoolDesc.constantBuffersMaxNum;
-    descriptorPoolDesc.samplerMaxNum = instanceDesc.descriptorPoolDesc.samplersMaxNum;
+    // Descriptor pools (sized exactly for the current settings, grow in "Denoise" if settings make more dispatches reachable)
+    nrd::DescriptorPoolDesc frameDescriptorPoolDesc = {};
+    nrd::GetFrameDescriptorPoolDesc(*m_Instance, m_Identifiers.data(), (uint32_t)m_Identifiers.size(), frameDescriptorPoolDesc);
+
+    // A frame can't create more texture descriptors than all permutations need, reserving it upfront keeps "Denoise" allocation-free
+    const uint32_t descriptorsMaxNum = instanceDesc.descriptorPoolDesc.texturesMaxNum + instanceDesc.descriptorPoolDesc.storageTexturesMaxNum;
+    m_CachedDescriptors.reserve(m_IsDescriptorCachingEnabled ? descriptorsMaxNum * m_BufferedFramesNum : descriptorsMaxNum);
 
     for (uint32_t i = 0; i < m_BufferedFramesNum; i++)
     {
-        nri::DescriptorPool* descriptorPool = nullptr;
-        NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateDescriptorPool(*m_Device, descriptorPoolDesc, descriptorPool));
-        m_DescriptorPools.push_back(descriptorPool);
-        
+        m_DescriptorPools.push_back(CreateDescriptorPool(frameDescriptorPoolDesc));
+        m_DescriptorPoolDescs.push_back(frameDescriptorPoolDesc);
+
         m_DescriptorSetSamplers.push_back(nullptr);
         m_DescriptorsInFlight.push_back({});
+        m_DescriptorsInFlight.back().reserve(descriptorsMaxNum);
     }
 }
 
+nri::DescriptorPool* NrdIntegration::CreateDescriptorPool(const nrd::DescriptorPoolDesc& poolDesc)
+{
+    nri::DescriptorPoolDesc descriptorPoolDesc = {};
+    descriptorPoolDesc.descriptorSetMaxNum = poolDesc.setsMaxNum;
+    descriptorPoolDesc.storageTextureMaxNum = poolDesc.storageTexturesMaxNum;
+    descriptorPoolDesc.textureMaxNum = poolDesc.texturesMaxNum;
+    descriptorPoolDesc.dynamicConstantBufferMaxNum = poolDesc.constantBuffersMaxNum;
+    descriptorPoolDesc.samplerMaxNum = poolDesc.samplersMaxNum;
+
+    nri::DescriptorPool* descriptorPool = nullptr;
+    NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateDescriptorPool(*m_Device, descriptorPoolDesc, descriptorPool));
+
+    return descriptorPool;
+}
+
 void NrdIntegration::AllocateAndBindMemory()
 {
-    std::vector<nri::Texture*> textures(m_TexturePool.size(), nullptr);
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*m_Instance);
+
+    std::vector<nri::Texture*> textures;
+    textures.reserve(m_TexturePool.size());
+
+    std::vector<uint64_t> transientHeapOffsets;
     for (size_t i = 0; i < m_TexturePool.size(); i++)
-        textures[i] = (nri::Texture*)m_TexturePool[i].subresourceStates->texture;
+    {
+        nri::Texture* texture = (nri::Texture*)m_TexturePool[i].subresourceStates->texture;
+
+        // Transient textures get placed into the shared heap, starting from the beginning for each instance
+        if (m_TransientHeap && i >= instanceDesc.permanentPoolSize)
+        {
+            nri::MemoryDesc memoryDesc = {};
+            m_NRI->GetTextureMemoryInfo(*texture, nri::MemoryLocation::DEVICE, memoryDesc);
+
+            if (!memoryDesc.mustBeDedicated)
+            {
+                std::vector<NrdTransientHeap::Heap>& heaps = m_TransientHeap->m_Heaps;
+
+                uint32_t heapIndex = 0;
+                while (heapIndex < heaps.size() && heaps[heapIndex].type != memoryDesc.type)
+                    heapIndex++;
+
+                if (heapIndex == heaps.size())
+                    heaps.push_back({nullptr, 0, memoryDesc.type});
+
+                transientHeapOffsets.resize(heaps.size(), 0);
+
+                uint64_t offset = NRD_GetAlignedSize(transientHeapOffsets[heapIndex], memoryDesc.alignment);
+                transientHeapOffsets[heapIndex] = offset + memoryDesc.size;
+                heaps[heapIndex].size = std::max(heaps[heapIndex].size, transientHeapOffsets[heapIndex]);
+
+                nri::TextureMemoryBindingDesc binding = {};
+                binding.texture = texture;
+                binding.offset = offset;
+                binding.nodeMask = nri::WHOLE_DEVICE_GROUP;
+
+                m_TransientHeapBindings.push_back(binding);
+                m_TransientHeapIndices.push_back(heapIndex);
+
+                continue;
+            }
+        }
+
+        textures.push_back(texture);
+    }
+
+    if (m_TransientHeap)
+    {
+        NRD_INTEGRATION_ASSERT(m_TransientHeap->m_Heaps.empty() || !m_TransientHeap->m_Heaps[0].memory, "'NrdTransientHeap' is already allocated!");
+        m_TransientHeap->m_Instances.push_back(this);
+    }
 
     nri::ResourceGroupDesc resourceGroupDesc = {};
     resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
@@ -423,6 +526,52 @@ void NrdIntegration::AllocateAndBindMemory()
     NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRIHelper->AllocateAndBindMemory(*m_Device, resourceGroupDesc, m_MemoryAllocations.data() + baseAllocation));
 }
 
+void NrdIntegration::AcquireTransientHeap(nri::CommandBuffer& commandBuffer)
+{
+    NRD_INTEGRATION_ASSERT(m_TransientHeap->m_Heaps.empty() || m_TransientHeap->m_Heaps[0].memory, "'NrdTransientHeap::Allocate' must be called before 'Denoise'!");
+
+    if (m_TransientHeap->m_Owner == this || m_TransientHeapBindings.empty())
+        return;
+
+    // Another instance has been using the heap, contents of transient textures are lost. An aliasing barrier is needed
+    // to activate them, tracked states get reset since the previous ones refer to the old contents
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*m_Instance);
+
+    const uint32_t aliasingBarriersNum = (uint32_t)m_TransientHeapBindings.size();
+    nri::TextureAliasingBarrierDesc* aliasingBarriers = (nri::TextureAliasingBarrierDesc*)alloca(sizeof(nri::TextureAliasingBarrierDesc) * aliasingBarriersNum);
+    memset(aliasingBarriers, 0, sizeof(nri::TextureAliasingBarrierDesc) * aliasingBarriersNum);
+
+    for (uint32_t i = 0; i < aliasingBarriersNum; i++)
+    {
+        nri::TextureAliasingBarrierDesc& aliasingBarrier = aliasingBarriers[i];
+        aliasingBarrier.before = nullptr;
+        aliasingBarrier.after = m_TransientHeapBindings[i].texture;
+        aliasingBarrier.nextAccess = nri::AccessBits::SHADER_RESOURCE_STORAGE;
+        aliasingBarrier.nextLayout = nri::TextureLayout::GENERAL;
+    }
+
+    for (uint32_t i = 0; i < instanceDesc.transientPoolSize; i++)
+    {
+        const nrd::TextureDesc& nrdTextureDesc = instanceDesc.transientPool[i];
+        NrdIntegrationTexture& nrdTexture = m_TexturePool[instanceDesc.permanentPoolSize + i];
+
+        bool isPlaced = false;
+        for (size_t j = 0; j < m_TransientHeapBindings.size() && !isPlaced; j++)
+            isPlaced = m_TransientHeapBindings[j].texture == nrdTexture.subresourceStates->texture;
+
+        for (uint16_t mip = 0; mip < nrdTextureDesc.mipNum && isPlaced; mip++)
+            nrdTexture.subresourceStates[mip] = nri::TextureTransitionFromUnknown(nrdTexture.subresourceStates->texture, nri::AccessBits::SHADER_RESOURCE_STORAGE, nri::TextureLayout::GENERAL, mip, 1);
+    }
+
+    nri::AliasingBarrierDesc aliasingBarrierDesc = {};
+    aliasingBarrierDesc.textures = aliasingBarriers;
+    aliasingBarrierDesc.textureNum = aliasingBarriersNum;
+
+    m_NRI->CmdPipelineBarrier(commandBuffer, nullptr, &aliasingBarrierDesc, nri::BarrierDependency::ALL_STAGES);
+
+    m_TransientHeap->m_Owner = this;
+}
+
 void NrdIntegration::NewFrame()
 {
     NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Initialize'?");
@@ -435,6 +584,19 @@ void NrdIntegration::NewFrame()
     nri::DescriptorPool* descriptorPool = m_DescriptorPools[m_DescriptorPoolIndex];
     m_NRI->ResetDescriptorPool(*descriptorPool);
 
+    // Pools replaced during the previous use of this frame are not referenced by the GPU anymore
+    for (size_t i = 0; i < m_RetiredDescriptorPools.size(); )
+    {
+        if (m_RetiredDescriptorPools[i].second == m_DescriptorPoolIndex)
+        {
+            m_NRI->DestroyDescriptorPool(*m_RetiredDescriptorPools[i].first);
+            m_RetiredDescriptorPools[i] = m_RetiredDescriptorPools.back();
+            m_RetiredDescriptorPools.pop_back();
+        }
+        else
+            i++;
+    }
+
     // Needs to be reset because the corresponding descriptor pool has been just reset
     m_DescriptorSetSamplers[m_DescriptorPoolIndex] = nullptr;
 
@@ -449,12 +611,22 @@ void NrdIntegration::NewFrame()
     m_FrameIndex++;
 }
 
-bool NrdIntegration::SetCommonSettings(const nrd::CommonSettings& commonSettings)
+bool NrdIntegration::SetCommonSettings(const nrd::CommonSettings& commonSettings, uint32_t viewIndex)
 {
     NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Initialize'?");
 
-    nrd::Result result = nrd::SetCommonSettings(*m_Instance, commonSettings);
-    NRD_INTEGRATION_ASSERT(result == nrd::Result::SUCCESS, "nrd::SetCommonSettings(): failed!");
+    nrd::Result result = nrd::SetViewCommonSettings(*m_Instance, viewIndex, commonSettings);
+    NRD_INTEGRATION_ASSERT(result == nrd::Result::SUCCESS, "nrd::SetViewCommonSettings(): failed!");
+
+    return result == nrd::Result::SUCCESS;
+}
+
+bool NrdIntegration::SetCommonSettings(const nrd::CommonSettings& commonSettings, uint32_t viewIndex, const NrdIntegration& cameraSource, uint32_t cameraSourceViewIndex)
+{
+    NRD_INTEGRATION_ASSERT(m_Instance && cameraSource.m_Instance, "Uninitialized! Did you forget to call 'Initialize'?");
+
+    nrd::Result result = nrd::SetViewCommonSettingsWithSharedCamera(*m_Instance, viewIndex, commonSettings, *cameraSource.m_Instance, cameraSourceViewIndex);
+    NRD_INTEGRATION_ASSERT(result == nrd::Result::SUCCESS, "nrd::SetViewCommonSettingsWithSharedCamera(): failed!");
 
     return result == nrd::Result::SUCCESS;
 }
@@ -469,9 +641,25 @@ bool NrdIntegration::SetDenoiserSettings(nrd::Identifier denoiser, const void* d
     return result == nrd::Result::SUCCESS;
 }
 
+bool NrdIntegration::Resize(uint16_t renderWidth, uint16_t renderHeight)
+{
+    NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Initialize'?");
+
+    nrd::Result result = nrd::ResizeInstance(*m_Instance, renderWidth, renderHeight);
+    NRD_INTEGRATION_ASSERT(result == nrd::Result::SUCCESS, "nrd::ResizeInstance(): failed!");
+
+    return result == nrd::Result::SUCCESS;
+}
+
 void NrdIntegration::Denoise(const nrd::Identifier* denoisers, uint32_t denoisersNum, nri::CommandBuffer& commandBuffer, const NrdUserPool& userPool)
+{
+    Denoise(denoisers, denoisersNum, commandBuffer, &userPool, 1);
+}
+
+void NrdIntegration::Denoise(const nrd::Identifier* denoisers, uint32_t denoisersNum, nri::CommandBuffer& commandBuffer, const NrdUserPool* userPools, uint32_t userPoolsNum)
 {
     NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Initialize'?");
+    NRD_INTEGRATION_ASSERT(userPoolsNum >= nrd::GetInstanceDesc(*m_Instance).viewsNum, "A user pool is needed for each view!");
 
     const nrd::DispatchDesc* dispatchDescs = nullptr;
     uint32_t dispatchDescsNum = 0;
@@ -481,15 +669,47 @@ void NrdIntegration::Denoise(const nrd::Identifier* denoisers, uint32_t denoiser
     if (!m_IsDescriptorCachingEnabled)
         m_CachedDescriptors.clear();
 
+    // Settings can make more dispatches reachable. The new pool holds the whole frame, the old one can still be referenced by previous "Denoise"
+    // calls of the frame, i.e. it gets destroyed when the frame comes around again
+    nrd::DescriptorPoolDesc frameDescriptorPoolDesc = {};
+    nrd::GetFrameDescriptorPoolDesc(*m_Instance, m_Identifiers.data(), (uint32_t)m_Identifiers.size(), frameDescriptorPoolDesc);
+
+    nrd::DescriptorPoolDesc& poolDesc = m_DescriptorPoolDescs[m_DescriptorPoolIndex];
+    bool isPoolTooSmall = frameDescriptorPoolDesc.setsMaxNum > poolDesc.setsMaxNum
+        || frameDescriptorPoolDesc.constantBuffersMaxNum > poolDesc.constantBuffersMaxNum
+        || frameDescriptorPoolDesc.samplersMaxNum > poolDesc.samplersMaxNum
+        || frameDescriptorPoolDesc.texturesMaxNum > poolDesc.texturesMaxNum
+        || frameDescriptorPoolDesc.storageTexturesMaxNum > poolDesc.storageTexturesMaxNum;
+
+    if (isPoolTooSmall)
+    {
+        // Never shrinks to avoid recreation on toggling settings back and forth
+        poolDesc.setsMaxNum = std::max(poolDesc.setsMaxNum, frameDescriptorPoolDesc.setsMaxNum);
+        poolDesc.constantBuffersMaxNum = std::max(poolDesc.constantBuffersMaxNum, frameDescriptorPoolDesc.constantBuffersMaxNum);
+        poolDesc.samplersMaxNum = std::max(poolDesc.samplersMaxNum, frameDescriptorPoolDesc.samplersMaxNum);
+        poolDesc.texturesMaxNum = std::max(poolDesc.texturesMaxNum, frameDescriptorPoolDesc.texturesMaxNum);
+        poolDesc.storageTexturesMaxNum = std::max(poolDesc.storageTexturesMaxNum, frameDescriptorPoolDesc.storageTexturesMaxNum);
+
+        m_RetiredDescriptorPools.push_back({m_DescriptorPools[m_DescriptorPoolIndex], m_DescriptorPoolIndex});
+        m_DescriptorPools[m_DescriptorPoolIndex] = CreateDescriptorPool(poolDesc);
+        m_DescriptorSetSamplers[m_DescriptorPoolIndex] = nullptr;
+    }
+
     nri::DescriptorPool* descriptorPool = m_DescriptorPools[m_DescriptorPoolIndex];
     m_NRI->CmdSetDescriptorPool(commandBuffer, *descriptorPool);
 
+    // Shared constants of the previous call are not valid anymore
+    m_SharedConstantBufferData = nullptr;
+
+    if (m_TransientHeap)
+        AcquireTransientHeap(commandBuffer);
+
     for (uint32_t i = 0; i < dispatchDescsNum; i++)
     {
         const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
         m_NRI->CmdBeginAnnotation(commandBuffer, dispatchDesc.name);
 
-        Dispatch(commandBuffer, *descriptorPool, dispatchDesc, userPool);
+        Dispatch(commandBuffer, *descriptorPool, dispatchDesc, userPools[dispatchDesc.viewIndex]);
 
         m_NRI->CmdEndAnnotation(commandBuffer);
     }
@@ -542,9 +762,14 @@ void NrdIntegration::Dispatch(nri::CommandBuffer& commandBuffer, nri::Descriptor
                 NRD_INTEGRATION_ASSERT(nrdTexture->format != nri::Format::UNKNOWN, "Format must be valid!");
             }
 
+            // A resource can be bound more than once (unused slots of batched clears), it needs only one barrier
+            bool isBound = false;
+            for (uint32_t k = 0; k < n && !isBound; k++)
+                isBound = !memcmp(&dispatchDesc.resources[k], &nrdResource, sizeof(nrdResource));
+
             const nri::AccessBits nextAccess = nrdResource.stateNeeded == nrd::DescriptorType::TEXTURE ? nri::AccessBits::SHADER_RESOURCE : nri::AccessBits::SHADER_RESOURCE_STORAGE;
             const nri::TextureLayout nextLayout =  nrdResource.stateNeeded == nrd::DescriptorType::TEXTURE ? nri::TextureLayout::SHADER_RESOURCE : nri::TextureLayout::GENERAL;
-            for (uint16_t mip = 0; mip < nrdResource.mipNum; mip++)
+            for (uint16_t mip = 0; mip < nrdResource.mipNum && !isBound; mip++)
             {
                 nri::TextureTransitionBarrierDesc* state = nrdTexture->subresourceStates + nrdResource.mipOffset + mip;
                 bool isStateChanged = nextAccess != state->nextAccess || nextLayout != state->nextLayout;
@@ -555,14 +780,14 @@ void NrdIntegration::Dispatch(nri::CommandBuffer& commandBuffer, nri::Descriptor
 
             uint64_t resource = m_NRI->GetTextureNativeObject(*nrdTexture->subresourceStates->texture, 0);
             uint64_t key = NRD_CreateDescriptorKey(resource, isStorage, (uint8_t)nrdResource.mipOffset, (uint8_t)nrdResource.mipNum);
-            const auto& entry = m_CachedDescriptors.find(key);
+            const auto entry = std::lower_bound(m_CachedDescriptors.begin(), m_CachedDescriptors.end(), key, [](const NrdCachedDescriptor& a, uint64_t b) { return a.first < b; });
 
             nri::Descriptor* descriptor = nullptr;
-            if (entry == m_CachedDescriptors.end())
+            if (entry == m_CachedDescriptors.end() || entry->first != key)
             {
                 nri::Texture2DViewDesc desc = {nrdTexture->subresourceStates->texture, isStorage ? nri::Texture2DViewType::SHADER_RESOURCE_STORAGE_2D : nri::Texture2DViewType::SHADER_RESOURCE_2D, nrdTexture->format, nrdResource.mipOffset, nrdResource.mipNum};
                 NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateTexture2DView(desc, descriptor));
-                m_CachedDescriptors.insert( std::make_pair(key, descriptor) );
+                m_CachedDescriptors.insert(entry, std::make_pair(key, descriptor));
                 m_DescriptorsInFlight[m_DescriptorPoolIndex].push_back(descriptor);
             }
             else
@@ -579,7 +804,8 @@ void NrdIntegration::Dispatch(nri::CommandBuffer& commandBuffer, nri::Descriptor
     bool samplersAreInSeparateSet = instanceDesc.samplersSpaceIndex != instanceDesc.constantBufferSpaceIndex && instanceDesc.samplersSpaceIndex != instanceDesc.resourcesSpaceIndex;
 
     nri::DescriptorSet** descriptorSets = (nri::DescriptorSet**)alloca(sizeof(nri::DescriptorSet*) * descriptorSetNum);
-    nri::PipelineLayout* pipelineLayout = m_PipelineLayouts[dispatchDesc.pipelineIndex];
+    uint16_t pipelineIndex = m_PipelineIndices[dispatchDesc.pipelineIndex];
+    nri::PipelineLayout* pipelineLayout = m_PipelineLayouts[pipelineIndex];
 
     for (uint32_t i = 0; i < descriptorSetNum; i++)
     {
@@ -588,23 +814,32 @@ void NrdIntegration::Dispatch(nri::CommandBuffer& commandBuffer, nri::Descriptor
     }
 
     // Updating constants
-    uint32_t dynamicConstantBufferOffset = 0;
+    uint32_t dynamicConstantBufferOffsets[2] = {};
+    nri::Descriptor* dynamicConstantBuffers[2] = {};
+    uint32_t dynamicConstantBufferNum = 0;
+
     if (dispatchDesc.constantBufferDataSize)
     {
-        if (m_ConstantBufferOffset + m_ConstantBufferViewSize > m_ConstantBufferSize)
-            m_ConstantBufferOffset = 0;
-
-        // TODO: persistent mapping? But no D3D11 support...
-        void* data = m_NRI->MapBuffer(*m_ConstantBuffer, m_ConstantBufferOffset, dispatchDesc.constantBufferDataSize);
-        memcpy(data, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
-        m_NRI->UnmapBuffer(*m_ConstantBuffer);
+        dynamicConstantBufferOffsets[dynamicConstantBufferNum] = UploadConstants(dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
+        dynamicConstantBuffers[dynamicConstantBufferNum++] = m_ConstantBufferView;
+    }
 
-        m_NRI->UpdateDynamicConstantBuffers(*descriptorSets[0], nri::WHOLE_DEVICE_GROUP, 0, 1, &m_ConstantBufferView);
+    if (dispatchDesc.sharedConstantBufferDataSize)
+    {
+        // Shared constants are the same for all dispatches of a denoiser, upload only once
+        if (dispatchDesc.sharedConstantBufferData != m_SharedConstantBufferData)
+        {
+            m_SharedConstantBufferOffset = UploadConstants(dispatchDesc.sharedConstantBufferData, dispatchDesc.sharedConstantBufferDataSize);
+            m_SharedConstantBufferData = dispatchDesc.sharedConstantBufferData;
+        }
 
-        dynamicConstantBufferOffset = m_ConstantBufferOffset;
-        m_ConstantBufferOffset += m_ConstantBufferViewSize;
+        dynamicConstantBufferOffsets[dynamicConstantBufferNum] = m_SharedConstantBufferOffset;
+        dynamicConstantBuffers[dynamicConstantBufferNum++] = m_ConstantBufferView;
     }
 
+    if (dynamicConstantBufferNum)
+        m_NRI->UpdateDynamicConstantBuffers(*descriptorSets[0], nri::WHOLE_DEVICE_GROUP, 0, dynamicConstantBufferNum, dynamicConstantBuffers);
+
     // Updating samplers
     const nri::DescriptorRangeUpdateDesc samplersDescriptorRange = {m_Samplers.data(), instanceDesc.samplersNum, 0};
     if (samplersAreInSeparateSet)
@@ -625,14 +860,15 @@ void NrdIntegration::Dispatch(nri::CommandBuffer& commandBuffer, nri::Descriptor
     m_NRI->UpdateDescriptorRanges(*descriptorSets[descriptorSetResourcesIndex], nri::WHOLE_DEVICE_GROUP, instanceDesc.samplersSpaceIndex == instanceDesc.resourcesSpaceIndex ? 1 : 0, pipelineDesc.resourceRangesNum, resourceRanges);
 
     // Rendering
-    m_NRI->CmdPipelineBarrier(commandBuffer, &transitionBarriers, nullptr, nri::BarrierDependency::ALL_STAGES);
+    if (transitionBarriers.textureNum)
+        m_NRI->CmdPipelineBarrier(commandBuffer, &transitionBarriers, nullptr, nri::BarrierDependency::ALL_STAGES);
     m_NRI->CmdSetPipelineLayout(commandBuffer, *pipelineLayout);
 
-    nri::Pipeline* pipeline = m_Pipelines[dispatchDesc.pipelineIndex];
+    nri::Pipeline* pipeline = m_Pipelines[pipelineIndex];
     m_NRI->CmdSetPipeline(commandBuffer, *pipeline);
 
     for (uint32_t i = 0; i < descriptorSetNum; i++)
-        m_NRI->CmdSetDescriptorSet(commandBuffer, i, *descriptorSets[i], i == 0 ? &dynamicConstantBufferOffset : nullptr);
+        m_NRI->CmdSetDescriptorSet(commandBuffer, i, *descriptorSets[i], i == 0 ? dynamicConstantBufferOffsets : nullptr);
 
     m_NRI->CmdDispatch(commandBuffer, dispatchDesc.gridWidth, dispatchDesc.gridHeight, 1);
 
@@ -662,6 +898,22 @@ void NrdIntegration::Dispatch(nri::CommandBuffer& commandBuffer, nri::Descriptor
     #endif
 }
 
+uint32_t NrdIntegration::UploadConstants(const uint8_t* data, uint32_t size)
+{
+    if (m_ConstantBufferOffset + m_ConstantBufferViewSize > m_ConstantBufferSize)
+        m_ConstantBufferOffset = 0;
+
+    // TODO: persistent mapping? But no D3D11 support...
+    void* dst = m_NRI->MapBuffer(*m_ConstantBuffer, m_ConstantBufferOffset, size);
+    memcpy(dst, data, size);
+    m_NRI->UnmapBuffer(*m_ConstantBuffer);
+
+    uint32_t offset = m_ConstantBufferOffset;
+    m_ConstantBufferOffset += m_ConstantBufferViewSize;
+
+    return offset;
+}
+
 void NrdIntegration::Destroy()
 {
     NRD_INTEGRATION_ASSERT(m_Instance, "Already destroyed! Did you forget to call 'Initialize'?");
@@ -695,15 +947,34 @@ void NrdIntegration::Destroy()
     for (nri::PipelineLayout* pipelineLayout : m_PipelineLayouts)
         m_NRI->DestroyPipelineLayout(*pipelineLayout);
     m_PipelineLayouts.clear();
+    m_PipelineIndices.clear();
 
     for (nri::Memory* memory : m_MemoryAllocations)
         m_NRI->FreeMemory(*memory);
     m_MemoryAllocations.clear();
 
+    if (m_TransientHeap)
+    {
+        std::vector<NrdIntegration*>& instances = m_TransientHeap->m_Instances;
+        instances.erase(std::find(instances.begin(), instances.end(), this));
+
+        if (m_TransientHeap->m_Owner == this)
+            m_TransientHeap->m_Owner = nullptr;
+    }
+    m_TransientHeapBindings.clear();
+    m_TransientHeapIndices.clear();
+
     for (nri::DescriptorPool* descriptorPool : m_DescriptorPools)
         m_NRI->DestroyDescriptorPool(*descriptorPool);
     m_DescriptorPools.clear();
+    m_DescriptorPoolDescs.clear();
+
+    for (const auto& retiredDescriptorPool : m_RetiredDescriptorPools)
+        m_NRI->DestroyDescriptorPool(*retiredDescriptorPool.first);
+    m_RetiredDescriptorPools.clear();
+
     m_DescriptorSetSamplers.clear();
+    m_Identifiers.clear();
 
     nrd::DestroyInstance(*m_Instance);
 
@@ -713,6 +984,7 @@ void NrdIntegration::Destroy()
     m_ConstantBuffer = nullptr;
     m_ConstantBufferView = nullptr;
     m_Instance = nullptr;
+    m_TransientHeap = nullptr;
     m_Name = nullptr;
     m_PermanentPoolSize = 0;
     m_TransientPoolSize = 0;
@@ -725,3 +997,49 @@ void NrdIntegration::Destroy()
     m_IsShadersReloadRequested = false;
     m_IsDescriptorCachingEnabled = false;
 }
+
+bool NrdTransientHeap::Allocate(nri::Device& nriDevice, const nri::CoreInterface& nriCore)
+{
+    NRD_INTEGRATION_ASSERT(m_Heaps.empty() || !m_Heaps[0].memory, "Already allocated! Did you forget to call 'Destroy'?");
+
+    m_NRI = &nriCore;
+
+    for (Heap& heap : m_Heaps)
+    {
+        if (m_NRI->AllocateMemory(nriDevice, nri::WHOLE_DEVICE_GROUP, heap.type, heap.size, heap.memory) != nri::Result::SUCCESS)
+            return false;
+    }
+
+    for (NrdIntegration* instance : m_Instances)
+    {
+        for (size_t i = 0; i < instance->m_TransientHeapBindings.size(); i++)
+            instance->m_TransientHeapBindings[i].memory = m_Heaps[instance->m_TransientHeapIndices[i]].memory;
+
+        if (!instance->m_TransientHeapBindings.empty())
+        {
+            if (m_NRI->BindTextureMemory(nriDevice, instance->m_TransientHeapBindings.data(), (uint32_t)instance->m_TransientHeapBindings.size()) != nri::Result::SUCCESS)
+                return false;
+        }
+    }
+
+#if( NRD_INTEGRATION_DEBUG_LOGGING == 1 )
+    printf("NrdTransientHeap: %.1f Mb (%u instances)\n\n", GetMemoryUsageInMb(), (uint32_t)m_Instances.size());
+#endif
+
+    return true;
+}
+
+void NrdTransientHeap::Destroy()
+{
+    NRD_INTEGRATION_ASSERT(m_Instances.empty(), "All sharing instances must be destroyed beforehand!");
+
+    for (Heap& heap : m_Heaps)
+    {
+        if (heap.memory)
+            m_NRI->FreeMemory(*heap.memory);
+    }
+    m_Heaps.clear();
+
+    m_Owner = nullptr;
+    m_NRI = nullptr;
+}
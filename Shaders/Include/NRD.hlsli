@@ -93,6 +93,11 @@ float tanOfLightAngularRadius:
 // Custom engine that has already defined all the macros
 #if( defined( NRD_INPUT_TEXTURE ) && defined( NRD_OUTPUT_TEXTURE ) && defined( NRD_CONSTANTS_START ) && defined( NRD_CONSTANT ) && defined( NRD_CONSTANTS_END ) )
 
+    // Shared (per denoiser) constants live in a separate constant buffer ( register b1 )
+    #if( !defined( NRD_SHARED_CONSTANTS_START ) || !defined( NRD_SHARED_CONSTANTS_END ) )
+        #error "NRD_SHARED_CONSTANTS_START and NRD_SHARED_CONSTANTS_END must be defined as well!"
+    #endif
+
     #define NRD_EXPORT
 
 // DXC
@@ -102,6 +107,9 @@ float tanOfLightAngularRadius:
     #define NRD_CONSTANT( constantType, constantName )                                  constantType constantName;
     #define NRD_CONSTANTS_END                                                           };
 
+    #define NRD_SHARED_CONSTANTS_START                                                  cbuffer sharedConstants : register( b1, NRD_MERGE_TOKENS( space, NRD_CONSTANT_BUFFER_SPACE_INDEX ) ) {
+    #define NRD_SHARED_CONSTANTS_END                                                    };
+
     #define NRD_INPUT_TEXTURE_START
     #define NRD_INPUT_TEXTURE( resourceType, resourceName, regName, bindingIndex )      resourceType resourceName : register( regName ## bindingIndex, NRD_MERGE_TOKENS( space, NRD_RESOURCES_SPACE_INDEX ) );
     #define NRD_INPUT_TEXTURE_END
@@ -133,6 +141,9 @@ float tanOfLightAngularRadius:
     #define NRD_CONSTANT( constantType, constantName )                                  constantType constantName;
     #define NRD_CONSTANTS_END                                                           };
 
+    #define NRD_SHARED_CONSTANTS_START                                                  ConstantBuffer sharedConstants : register( b1 ) {
+    #define NRD_SHARED_CONSTANTS_END                                                    };
+
     #define NRD_INPUT_TEXTURE_START
     #define NRD_INPUT_TEXTURE( resourceType, resourceName, regName, bindingIndex )      resourceType resourceName : register( regName ## bindingIndex );
     #define NRD_INPUT_TEXTURE_END
@@ -176,6 +187,9 @@ float tanOfLightAngularRadius:
     #define NRD_CONSTANT( constantType, constantName )                                  constantType constantName;
     #define NRD_CONSTANTS_END
 
+    #define NRD_SHARED_CONSTANTS_START
+    #define NRD_SHARED_CONSTANTS_END
+
     #define NRD_INPUT_TEXTURE_START
     #define NRD_INPUT_TEXTURE( resourceType, resourceName, regName, bindingIndex )      resourceType resourceName;
     #define NRD_INPUT_TEXTURE_END
@@ -197,6 +211,9 @@ float tanOfLightAngularRadius:
     #define NRD_CONSTANT( constantType, constantName )                                  constantType constantName;
     #define NRD_CONSTANTS_END                                                           };
 
+    #define NRD_SHARED_CONSTANTS_START                                                  cbuffer sharedConstants : register( b1 ) {
+    #define NRD_SHARED_CONSTANTS_END                                                    };
+
     #define NRD_INPUT_TEXTURE_START
     #define NRD_INPUT_TEXTURE( resourceType, resourceName, regName, bindingIndex )      resourceType resourceName : register( regName ## bindingIndex );
     #define NRD_INPUT_TEXTURE_END
@@ -0,0 +1,55 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// IMPORTANT: also included by NRD (C++) to declare per-pass constant structs with the same layout, i.e. only "NRD_CONSTANT" lists are allowed here.
+// Constants of passes, which don't belong to a denoiser family
+
+#define CLASSIFY_TILES_CB_DATA \
+    NRD_CONSTANT( float, gDenoisingRange )
+
+#define CLEAR_CB_DATA \
+    NRD_CONSTANT( uint, gResourcesNum )
+
+#define REFERENCE_TEMPORAL_ACCUMULATION_CB_DATA \
+    NRD_CONSTANT( uint2, gRectOrigin ) \
+    NRD_CONSTANT( float2, gInvRectSize ) \
+    NRD_CONSTANT( float, gSplitScreen ) \
+    NRD_CONSTANT( float, gAccumSpeed ) \
+    NRD_CONSTANT( float, gDebug )
+
+#define SPECULAR_DELTA_MV_CB_DATA \
+    NRD_CONSTANT( float4x4, gWorldToClipPrev ) \
+    NRD_CONSTANT( float3, gMvScale ) \
+    NRD_CONSTANT( float, gDebug ) \
+    NRD_CONSTANT( uint2, gRectSize ) \
+    NRD_CONSTANT( float2, gInvRectSize ) \
+    NRD_CONSTANT( uint2, gRectOrigin ) \
+    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled )
+
+#define SPECULAR_REFLECTION_MV_CB_DATA \
+    NRD_CONSTANT( float4x4, gViewToWorld ) \
+    NRD_CONSTANT( float4x4, gWorldToClip ) \
+    NRD_CONSTANT( float4x4, gWorldToClipPrev ) \
+    NRD_CONSTANT( float4x4, gWorldToViewPrev ) \
+    NRD_CONSTANT( float4, gFrustumPrev ) \
+    NRD_CONSTANT( float4, gFrustum ) \
+    NRD_CONSTANT( float3, gViewVectorWorld ) \
+    NRD_CONSTANT( float, gOrthoMode ) \
+    NRD_CONSTANT( float3, gCameraDelta ) \
+    NRD_CONSTANT( float, gUnproject ) \
+    NRD_CONSTANT( float3, gMvScale ) \
+    NRD_CONSTANT( float, gDebug ) \
+    NRD_CONSTANT( float2, gRectSize ) \
+    NRD_CONSTANT( float2, gInvRectSize ) \
+    NRD_CONSTANT( float2, gRectOffset ) \
+    NRD_CONSTANT( float2, gResolutionScale ) \
+    NRD_CONSTANT( uint2, gRectOrigin ) \
+    NRD_CONSTANT( float, gDenoisingRange ) \
+    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled )
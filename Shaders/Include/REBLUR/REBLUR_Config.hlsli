@@ -87,47 +87,11 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define REBLUR_ANTI_FIREFLY_SIGMA_SCALE                         2.0
 #define REBLUR_SAMPLES_PER_FRAME                                1.0 // TODO: expose in settings, it will become useful with very clean signals, when max number of accumulated frames is low
 
-// Shared data
-#define REBLUR_SHARED_CB_DATA \
-    NRD_CONSTANT( float4x4, gViewToClip ) \
-    NRD_CONSTANT( float4x4, gViewToWorld ) \
-    NRD_CONSTANT( float4, gFrustum ) \
-    NRD_CONSTANT( float4, gHitDistParams ) \
-    NRD_CONSTANT( float4, gViewVectorWorld ) \
-    NRD_CONSTANT( float4, gViewVectorWorldPrev ) \
-    NRD_CONSTANT( float3, gMvScale ) \
-    NRD_CONSTANT( float, gDebug ) \
-    NRD_CONSTANT( float2, gInvScreenSize ) \
-    NRD_CONSTANT( float2, gScreenSize ) \
-    NRD_CONSTANT( float2, gInvRectSize ) \
-    NRD_CONSTANT( float2, gRectSize ) \
-    NRD_CONSTANT( float2, gResolutionScale ) \
-    NRD_CONSTANT( float2, gResolutionScalePrev ) \
-    NRD_CONSTANT( float2, gRectSizePrev ) \
-    NRD_CONSTANT( float2, gRectOffset ) \
-    NRD_CONSTANT( uint2, gRectOrigin ) \
-    NRD_CONSTANT( float, gOrthoMode ) \
-    NRD_CONSTANT( float, gUnproject ) \
-    NRD_CONSTANT( float, gDenoisingRange ) \
-    NRD_CONSTANT( float, gPlaneDistSensitivity ) \
-    NRD_CONSTANT( float, gFramerateScale ) \
-    NRD_CONSTANT( float, gBlurRadius ) \
-    NRD_CONSTANT( float, gMaxAccumulatedFrameNum ) \
-    NRD_CONSTANT( float, gMaxFastAccumulatedFrameNum ) \
-    NRD_CONSTANT( float, gAntiFirefly ) \
-    NRD_CONSTANT( float, gLobeAngleFraction ) \
-    NRD_CONSTANT( float, gRoughnessFraction ) \
-    NRD_CONSTANT( float, gResponsiveAccumulationRoughnessThreshold ) \
-    NRD_CONSTANT( float, gDiffPrepassBlurRadius ) \
-    NRD_CONSTANT( float, gSpecPrepassBlurRadius ) \
-    NRD_CONSTANT( float, gHistoryFixFrameNum ) \
-    NRD_CONSTANT( float, gMinRectDimMulUnproject ) \
-    NRD_CONSTANT( float, gUsePrepassNotOnlyForSpecularMotionEstimation ) \
-    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled ) \
-    NRD_CONSTANT( uint, gFrameIndex ) \
-    NRD_CONSTANT( uint, gDiffMaterialMask ) \
-    NRD_CONSTANT( uint, gSpecMaterialMask ) \
-    NRD_CONSTANT( uint, gResetHistory )
+// Shared data (see "REBLUR_SharedConstants.hlsli")
+#include "REBLUR/REBLUR_SharedConstants.hlsli"
+
+// Per-pass data (see "REBLUR_PassConstants.hlsli")
+#include "REBLUR/REBLUR_PassConstants.hlsli"
 
 // Texture access
 #if( REBLUR_USE_LOADS == 1 )
@@ -21,7 +21,10 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
 
     // Early out
     float viewZ = abs( gIn_ViewZ[ pixelPosUser ] );
-    gOut_ViewZ[ pixelPos ] = PackViewZ( viewZ );
+
+    // Shared geometry history is written by one denoiser per frame
+    if( gIsGeometryHistoryWriter != 0 )
+        gOut_ViewZ[ pixelPos ] = PackViewZ( viewZ );
 
     if( viewZ > gDenoisingRange )
         return;
@@ -19,7 +19,8 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
     if( isSky != 0.0 || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y )
     {
         // ~0 normal is needed to allow bilinear filter in TA ( 0 can't be used due to "division by zero" in "UnpackNormalRoughness" )
-        gOut_Normal_Roughness[ pixelPos ] = PackNormalRoughness( 1.0 / 255.0 );
+        if( gIsGeometryHistoryWriter != 0 )
+            gOut_Normal_Roughness[ pixelPos ] = PackNormalRoughness( 1.0 / 255.0 );
 
         return; // IMPORTANT: no data output, must be rejected by the "viewZ" check!
     }
@@ -29,7 +30,8 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
     if( viewZ > gDenoisingRange || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y )
     {
         // ~0 normal is needed to allow bilinear filter in TA ( 0 can't be used due to "division by zero" in "UnpackNormalRoughness" )
-        gOut_Normal_Roughness[ pixelPos ] = PackNormalRoughness( 1.0 / 255.0 );
+        if( gIsGeometryHistoryWriter != 0 )
+            gOut_Normal_Roughness[ pixelPos ] = PackNormalRoughness( 1.0 / 255.0 );
 
         return; // IMPORTANT: no data output, must be rejected by the "viewZ" check!
     }
@@ -50,8 +52,9 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
     float3 Vv = GetViewVector( Xv, true );
     float NoV = abs( dot( Nv, Vv ) );
 
-    // Output
-    gOut_Normal_Roughness[ pixelPos ] = PackNormalRoughness( normalAndRoughness );
+    // Output ( shared geometry history is written by one denoiser per frame )
+    if( gIsGeometryHistoryWriter != 0 )
+        gOut_Normal_Roughness[ pixelPos ] = PackNormalRoughness( normalAndRoughness );
     #ifdef REBLUR_NO_TEMPORAL_STABILIZATION
         gOut_InternalData[ pixelPos ] = PackInternalData( data1.x + 1.0, data1.z + 1.0, materialID ); // increment history length
     #endif
@@ -0,0 +1,66 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// IMPORTANT: also included by NRD (C++) to declare per-pass constant structs with the same layout, i.e. only "NRD_CONSTANT" lists are allowed here
+
+#define REBLUR_PREPASS_CB_DATA \
+    NRD_CONSTANT( float4, gRotator ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard )
+
+#define REBLUR_TEMPORAL_ACCUMULATION_CB_DATA \
+    NRD_CONSTANT( float4x4, gWorldToViewPrev ) \
+    NRD_CONSTANT( float4x4, gWorldToClipPrev ) \
+    NRD_CONSTANT( float4x4, gWorldToClip ) \
+    NRD_CONSTANT( float4x4, gWorldPrevToWorld ) \
+    NRD_CONSTANT( float4, gFrustumPrev ) \
+    NRD_CONSTANT( float3, gCameraDelta ) \
+    NRD_CONSTANT( float, gDisocclusionThreshold ) \
+    NRD_CONSTANT( float, gDisocclusionThresholdAlternate ) \
+    NRD_CONSTANT( float, gCheckerboardResolveAccumSpeed ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard ) \
+    NRD_CONSTANT( uint, gIsPrepassEnabled ) \
+    NRD_CONSTANT( uint, gHasHistoryConfidence ) \
+    NRD_CONSTANT( uint, gHasDisocclusionThresholdMix )
+
+#define REBLUR_HISTORY_FIX_CB_DATA \
+    NRD_CONSTANT( float, gHistoryFixStrideBetweenSamples )
+
+// Blur and post-blur
+#define REBLUR_BLUR_CB_DATA \
+    NRD_CONSTANT( float4, gRotator )
+
+#define REBLUR_COPY_STABILIZED_HISTORY_CB_DATA \
+    NRD_CONSTANT( uint, gIsRectChanged )
+
+#define REBLUR_TEMPORAL_STABILIZATION_CB_DATA \
+    NRD_CONSTANT( float4x4, gWorldToClip ) \
+    NRD_CONSTANT( float4x4, gWorldToClipPrev ) \
+    NRD_CONSTANT( float4x4, gWorldToViewPrev ) \
+    NRD_CONSTANT( float4, gFrustumPrev ) \
+    NRD_CONSTANT( float3, gCameraDelta ) \
+    NRD_CONSTANT( float, gStabilizationStrength ) \
+    NRD_CONSTANT( float4, gAntilagParams ) \
+    NRD_CONSTANT( float2, gSpecularProbabilityThresholdsForMvModification ) \
+    NRD_CONSTANT( float, gSplitScreen )
+
+#define REBLUR_SPLIT_SCREEN_CB_DATA \
+    NRD_CONSTANT( float, gSplitScreen ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard )
+
+#define REBLUR_VALIDATION_CB_DATA \
+    NRD_CONSTANT( float4x4, gWorldToClipPrev ) \
+    NRD_CONSTANT( float2, gJitter ) \
+    NRD_CONSTANT( uint, gHasDiffuse ) \
+    NRD_CONSTANT( uint, gHasSpecular ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard )
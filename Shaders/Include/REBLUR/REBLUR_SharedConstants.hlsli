@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// IMPORTANT: also included by NRD (C++) to declare "ReblurSharedConstants" with the same layout, i.e. only "NRD_CONSTANT" lists are allowed here
+
+// Shared data
+#define REBLUR_SHARED_CB_DATA \
+    NRD_CONSTANT( float4x4, gViewToClip ) \
+    NRD_CONSTANT( float4x4, gViewToWorld ) \
+    NRD_CONSTANT( float4, gFrustum ) \
+    NRD_CONSTANT( float4, gHitDistParams ) \
+    NRD_CONSTANT( float4, gViewVectorWorld ) \
+    NRD_CONSTANT( float4, gViewVectorWorldPrev ) \
+    NRD_CONSTANT( float3, gMvScale ) \
+    NRD_CONSTANT( float, gDebug ) \
+    NRD_CONSTANT( float2, gInvScreenSize ) \
+    NRD_CONSTANT( float2, gScreenSize ) \
+    NRD_CONSTANT( float2, gInvRectSize ) \
+    NRD_CONSTANT( float2, gRectSize ) \
+    NRD_CONSTANT( float2, gResolutionScale ) \
+    NRD_CONSTANT( float2, gResolutionScalePrev ) \
+    NRD_CONSTANT( float2, gRectSizePrev ) \
+    NRD_CONSTANT( float2, gRectOffset ) \
+    NRD_CONSTANT( uint2, gRectOrigin ) \
+    NRD_CONSTANT( float, gOrthoMode ) \
+    NRD_CONSTANT( float, gUnproject ) \
+    NRD_CONSTANT( float, gDenoisingRange ) \
+    NRD_CONSTANT( float, gPlaneDistSensitivity ) \
+    NRD_CONSTANT( float, gFramerateScale ) \
+    NRD_CONSTANT( float, gBlurRadius ) \
+    NRD_CONSTANT( float, gMaxAccumulatedFrameNum ) \
+    NRD_CONSTANT( float, gMaxFastAccumulatedFrameNum ) \
+    NRD_CONSTANT( float, gAntiFirefly ) \
+    NRD_CONSTANT( float, gLobeAngleFraction ) \
+    NRD_CONSTANT( float, gRoughnessFraction ) \
+    NRD_CONSTANT( float, gResponsiveAccumulationRoughnessThreshold ) \
+    NRD_CONSTANT( float, gDiffPrepassBlurRadius ) \
+    NRD_CONSTANT( float, gSpecPrepassBlurRadius ) \
+    NRD_CONSTANT( float, gHistoryFixFrameNum ) \
+    NRD_CONSTANT( float, gMinRectDimMulUnproject ) \
+    NRD_CONSTANT( float, gUsePrepassNotOnlyForSpecularMotionEstimation ) \
+    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled ) \
+    NRD_CONSTANT( uint, gFrameIndex ) \
+    NRD_CONSTANT( uint, gDiffMaterialMask ) \
+    NRD_CONSTANT( uint, gSpecMaterialMask ) \
+    NRD_CONSTANT( uint, gResetHistory ) \
+    NRD_CONSTANT( uint, gIsGeometryHistoryWriter ) \
+    NRD_CONSTANT( uint, unused1 ) \
+    NRD_CONSTANT( uint, unused2 ) \
+    NRD_CONSTANT( uint, unused3 )
@@ -26,6 +26,17 @@ float4 PackPrevNormalRoughness(float4 normalRoughness)
     return result;
 }
 
+// Range scaling keeps "viewZ" history representable in FP16, it's used only for "MemoryBudget::PARTIALLY_PACKED" (FP32 history is stored as is)
+float PackPrevViewZ(float viewZ)
+{
+    return gIsPrevViewZPacked ? min(viewZ * NRD_FP16_VIEWZ_SCALE, NRD_FP16_MAX) : viewZ;
+}
+
+float4 UnpackPrevViewZ(float4 packedViewZ)
+{
+    return gIsPrevViewZPacked ? packedViewZ / NRD_FP16_VIEWZ_SCALE : packedViewZ;
+}
+
 float BilinearWithCustomWeightsImmediateFloat(float s00, float s10, float s01, float s11, float4 bilinearCustomWeights)
 {
     float output = s00 * bilinearCustomWeights.x;
@@ -14,43 +14,11 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define RELAX_HIT_DIST_MIN_WEIGHT                           0.2 // Sacrifices spatial fidelity to improve temporal stability. Should be set to 0 for relatively clean input signals like RTXDI and 0.1 .. 0.2 for lower quality input signals
 #define RELAX_ANTILAG_ACCELERATION_AMOUNT_SCALE             10.0 // Multiplier used to put RelaxAntilagSettings::accelerationAmount to convenient [0; 1] range
 
-// Shared constants common to all ReLAX denoisers
-#define RELAX_SHARED_CB_DATA \
-    NRD_CONSTANT( float4x4, gPrevWorldToClip ) \
-    NRD_CONSTANT( float4x4, gPrevWorldToView ) \
-    NRD_CONSTANT( float4x4, gWorldToClip ) \
-    NRD_CONSTANT( float4x4, gWorldPrevToWorld ) \
-    NRD_CONSTANT( float4x4, gViewToWorld ) \
-    NRD_CONSTANT( float4, gFrustumRight ) \
-    NRD_CONSTANT( float4, gFrustumUp ) \
-    NRD_CONSTANT( float4, gFrustumForward ) \
-    NRD_CONSTANT( float4, gPrevFrustumRight ) \
-    NRD_CONSTANT( float4, gPrevFrustumUp ) \
-    NRD_CONSTANT( float4, gPrevFrustumForward ) \
-    NRD_CONSTANT( float4, gPrevCameraPosition ) \
-    NRD_CONSTANT( float3, gMvScale ) \
-    NRD_CONSTANT( float, gDebug ) \
-    NRD_CONSTANT( float2, gResolutionScale) \
-    NRD_CONSTANT( uint2, gRectOrigin ) \
-    NRD_CONSTANT( float2, gRectOffset ) \
-    NRD_CONSTANT( uint2, gRectSize ) \
-    NRD_CONSTANT( float2, gInvResourceSize ) \
-    NRD_CONSTANT( float2, gInvRectSize ) \
-    NRD_CONSTANT( float2, gRectSizePrev ) \
-    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled ) \
-    NRD_CONSTANT( float, gOrthoMode ) \
-    NRD_CONSTANT( float, gUnproject ) \
-    NRD_CONSTANT( uint, gFrameIndex ) \
-    NRD_CONSTANT( float, gDenoisingRange ) \
-    NRD_CONSTANT( float, gFramerateScale ) \
-    NRD_CONSTANT( float, gCheckerboardResolveAccumSpeed ) \
-    NRD_CONSTANT( float, gJitterDelta ) \
-    NRD_CONSTANT( uint, gDiffMaterialMask ) \
-    NRD_CONSTANT( uint, gSpecMaterialMask ) \
-    NRD_CONSTANT( uint, gUseWorldPrevToWorld ) \
-    NRD_CONSTANT( uint, gResetHistory ) \
-    NRD_CONSTANT( uint, unused2 ) \
-    NRD_CONSTANT( uint, unused3 )
+// Shared constants common to all ReLAX denoisers (see "RELAX_SharedConstants.hlsli")
+#include "RELAX/RELAX_SharedConstants.hlsli"
+
+// Per-pass data (see "RELAX_PassConstants.hlsli")
+#include "RELAX/RELAX_PassConstants.hlsli"
 
 #if( !defined RELAX_DIFFUSE && !defined RELAX_SPECULAR )
     #define RELAX_DIFFUSE
@@ -121,7 +121,6 @@ NRD_EXPORT void NRD_CS_MAIN(int2 pixelPos : SV_DispatchThreadId, uint2 threadPos
     float3 centerWorldPos = centerWorldPosMaterialID.xyz;
     float centerMaterialID = centerWorldPosMaterialID.w;
     float centerViewZ = abs(gViewZ[pixelPos]);
-    gOutViewZ[pixelPos] = centerViewZ;
 
     // Repacking normal and roughness to prev normal roughness to be used in the next frame
     float4 normalRoughness = sharedNormalRoughness[sharedMemoryIndex.y][sharedMemoryIndex.x];
@@ -130,11 +129,17 @@ NRD_EXPORT void NRD_CS_MAIN(int2 pixelPos : SV_DispatchThreadId, uint2 threadPos
         // Setting normal and roughness to close to zero for out of range pixels
         normalRoughness = 1.0 / 255.0;
     }
-    gOutNormalRoughness[pixelPos] = PackPrevNormalRoughness(normalRoughness);
 
-#if( NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
-    gOutMaterialID[pixelPos] = centerMaterialID;
-#endif
+    // Shared geometry history is written by one denoiser per frame
+    if (gIsGeometryHistoryWriter != 0)
+    {
+        gOutViewZ[pixelPos] = PackPrevViewZ(centerViewZ);
+        gOutNormalRoughness[pixelPos] = PackPrevNormalRoughness(normalRoughness);
+
+    #if( NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
+        gOutMaterialID[pixelPos] = centerMaterialID;
+    #endif
+    }
 
     // Tile-based early out
     if (isSky != 0.0)
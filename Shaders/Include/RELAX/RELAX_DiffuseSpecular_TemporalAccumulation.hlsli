@@ -92,10 +92,10 @@ float loadSurfaceMotionBasedPrevData(
     float2 gatherOrigin10 = (float2(bilinearOrigin)+float2(2.0, 0.0)) * gInvResourceSize;
     float2 gatherOrigin01 = (float2(bilinearOrigin)+float2(0.0, 2.0)) * gInvResourceSize;
     float2 gatherOrigin11 = (float2(bilinearOrigin)+float2(2.0, 2.0)) * gInvResourceSize;
-    float4 prevViewZs00 = gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin00).wzxy;
-    float4 prevViewZs10 = gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin10).wzxy;
-    float4 prevViewZs01 = gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin01).wzxy;
-    float4 prevViewZs11 = gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin11).wzxy;
+    float4 prevViewZs00 = UnpackPrevViewZ(gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin00).wzxy);
+    float4 prevViewZs10 = UnpackPrevViewZ(gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin10).wzxy);
+    float4 prevViewZs01 = UnpackPrevViewZ(gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin01).wzxy);
+    float4 prevViewZs11 = UnpackPrevViewZ(gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin11).wzxy);
     float4 prevMaterialIDs00 = gPrevMaterialID.GatherRed(gNearestClamp, gatherOrigin00).wzxy;
     float4 prevMaterialIDs10 = gPrevMaterialID.GatherRed(gNearestClamp, gatherOrigin10).wzxy;
     float4 prevMaterialIDs01 = gPrevMaterialID.GatherRed(gNearestClamp, gatherOrigin01).wzxy;
@@ -291,7 +291,7 @@ float loadVirtualMotionBasedPrevData(
     disocclusionThreshold -= NRD_EPS;
 
     // Checking bilinear footprint only for virtual motion based specular reprojection
-    float4 prevViewZs = gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin).wzxy;
+    float4 prevViewZs = UnpackPrevViewZ(gPrevViewZ.GatherRed(gNearestClamp, gatherOrigin).wzxy);
     float4 prevMaterialIDs = gPrevMaterialID.GatherRed(gNearestClamp, gatherOrigin).wzxy;
     float3 prevWorldPosInTap;
     float4 bilinearTapsValid;
@@ -0,0 +1,271 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// IMPORTANT: also included by NRD (C++) to declare per-pass constant structs with the same layout, i.e. only "NRD_CONSTANT" lists are allowed here.
+// Most passes have a list per variant ("DIFFUSE_SPECULAR", "DIFFUSE" and "SPECULAR"), resources pick one based on "RELAX_DIFFUSE", "RELAX_SPECULAR"
+// and "RELAX_SH"
+
+#define RELAX_DIFFUSE_SPECULAR_PREPASS_CB_DATA \
+    NRD_CONSTANT( float4, gRotator ) \
+    NRD_CONSTANT( uint, gDiffuseCheckerboard ) \
+    NRD_CONSTANT( uint, gSpecularCheckerboard ) \
+    NRD_CONSTANT( float, gDiffuseBlurRadius ) \
+    NRD_CONSTANT( float, gSpecularBlurRadius ) \
+    NRD_CONSTANT( float, gMeterToUnitsMultiplier ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( float, gRoughnessFraction )
+
+#define RELAX_DIFFUSE_PREPASS_CB_DATA \
+    NRD_CONSTANT( float4, gRotator ) \
+    NRD_CONSTANT( uint, gDiffuseCheckerboard ) \
+    NRD_CONSTANT( float, gDiffuseBlurRadius ) \
+    NRD_CONSTANT( float, gMeterToUnitsMultiplier ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
+
+#define RELAX_SPECULAR_PREPASS_CB_DATA \
+    NRD_CONSTANT( float4, gRotator ) \
+    NRD_CONSTANT( uint, gSpecularCheckerboard ) \
+    NRD_CONSTANT( float, gSpecularBlurRadius ) \
+    NRD_CONSTANT( float, gMeterToUnitsMultiplier ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( float, gRoughnessFraction )
+
+#define RELAX_DIFFUSE_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA \
+    NRD_CONSTANT( float, gSpecularMaxAccumulatedFrameNum ) \
+    NRD_CONSTANT( float, gSpecularMaxFastAccumulatedFrameNum ) \
+    NRD_CONSTANT( float, gDiffuseMaxAccumulatedFrameNum ) \
+    NRD_CONSTANT( float, gDiffuseMaxFastAccumulatedFrameNum ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard ) \
+    NRD_CONSTANT( float, gDisocclusionDepthThreshold ) \
+    NRD_CONSTANT( float, gDisocclusionDepthThresholdAlternate ) \
+    NRD_CONSTANT( float, gRoughnessFraction ) \
+    NRD_CONSTANT( float, gSpecularVarianceBoost ) \
+    NRD_CONSTANT( uint, gSkipReprojectionTestWithoutMotion ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( uint, gUseDisocclusionThresholdMix )
+
+#define RELAX_DIFFUSE_TEMPORAL_ACCUMULATION_CB_DATA \
+    NRD_CONSTANT( float, gDiffuseMaxAccumulatedFrameNum ) \
+    NRD_CONSTANT( float, gDiffuseMaxFastAccumulatedFrameNum ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard ) \
+    NRD_CONSTANT( float, gDisocclusionDepthThreshold ) \
+    NRD_CONSTANT( float, gDisocclusionDepthThresholdAlternate ) \
+    NRD_CONSTANT( uint, gSkipReprojectionTestWithoutMotion ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( uint, gUseDisocclusionThresholdMix )
+
+#define RELAX_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA \
+    NRD_CONSTANT( float, gSpecularMaxAccumulatedFrameNum ) \
+    NRD_CONSTANT( float, gSpecularMaxFastAccumulatedFrameNum ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard ) \
+    NRD_CONSTANT( float, gDisocclusionDepthThreshold ) \
+    NRD_CONSTANT( float, gDisocclusionDepthThresholdAlternate ) \
+    NRD_CONSTANT( float, gRoughnessFraction ) \
+    NRD_CONSTANT( float, gSpecularVarianceBoost ) \
+    NRD_CONSTANT( uint, gSkipReprojectionTestWithoutMotion ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( uint, gUseDisocclusionThresholdMix )
+
+#define RELAX_DIFFUSE_SPECULAR_HISTORY_FIX_CB_DATA \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gHistoryFixEdgeStoppingNormalPower ) \
+    NRD_CONSTANT( float, gHistoryFixStrideBetweenSamples ) \
+    NRD_CONSTANT( float, gHistoryFixFrameNum ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation )
+
+#define RELAX_DIFFUSE_HISTORY_FIX_CB_DATA \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gHistoryFixEdgeStoppingNormalPower ) \
+    NRD_CONSTANT( float, gHistoryFixStrideBetweenSamples ) \
+    NRD_CONSTANT( float, gHistoryFixFrameNum )
+
+#define RELAX_SPECULAR_HISTORY_FIX_CB_DATA \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gHistoryFixEdgeStoppingNormalPower ) \
+    NRD_CONSTANT( float, gHistoryFixStrideBetweenSamples ) \
+    NRD_CONSTANT( float, gHistoryFixFrameNum ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation )
+
+#define RELAX_DIFFUSE_SPECULAR_HISTORY_CLAMPING_CB_DATA \
+    NRD_CONSTANT( float, gColorBoxSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryFixFrameNum ) \
+    NRD_CONSTANT( uint, gSpecFastHistory ) \
+    NRD_CONSTANT( uint, gDiffFastHistory ) \
+    NRD_CONSTANT( float, gHistoryAccelerationAmount ) \
+    NRD_CONSTANT( float, gHistoryResetTemporalSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryResetSpatialSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryResetAmount )
+
+#define RELAX_DIFFUSE_HISTORY_CLAMPING_CB_DATA \
+    NRD_CONSTANT( float, gColorBoxSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryFixFrameNum ) \
+    NRD_CONSTANT( uint, gDiffFastHistory ) \
+    NRD_CONSTANT( float, gHistoryAccelerationAmount ) \
+    NRD_CONSTANT( float, gHistoryResetTemporalSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryResetSpatialSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryResetAmount )
+
+#define RELAX_SPECULAR_HISTORY_CLAMPING_CB_DATA \
+    NRD_CONSTANT( float, gColorBoxSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryFixFrameNum ) \
+    NRD_CONSTANT( uint, gSpecFastHistory ) \
+    NRD_CONSTANT( float, gHistoryAccelerationAmount ) \
+    NRD_CONSTANT( float, gHistoryResetTemporalSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryResetSpatialSigmaScale ) \
+    NRD_CONSTANT( float, gHistoryResetAmount )
+
+// The first A-trous iteration
+#define RELAX_DIFFUSE_SPECULAR_ATROUS_SMEM_CB_DATA \
+    NRD_CONSTANT( uint2, gResourceSize ) \
+    NRD_CONSTANT( uint, gHistoryThreshold ) \
+    NRD_CONSTANT( float, gSpecularPhiLuminance ) \
+    NRD_CONSTANT( float, gDiffusePhiLuminance ) \
+    NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction ) \
+    NRD_CONSTANT( float, gRoughnessFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( uint, gStepSize ) \
+    NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled ) \
+    NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier ) \
+    NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+
+#define RELAX_DIFFUSE_ATROUS_SMEM_CB_DATA \
+    NRD_CONSTANT( uint2, gResourceSize ) \
+    NRD_CONSTANT( uint, gHistoryThreshold ) \
+    NRD_CONSTANT( float, gDiffusePhiLuminance ) \
+    NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction ) \
+    NRD_CONSTANT( uint, gStepSize ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier ) \
+    NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+
+#define RELAX_SPECULAR_ATROUS_SMEM_CB_DATA \
+    NRD_CONSTANT( uint2, gResourceSize ) \
+    NRD_CONSTANT( uint, gHistoryThreshold ) \
+    NRD_CONSTANT( float, gSpecularPhiLuminance ) \
+    NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction ) \
+    NRD_CONSTANT( float, gRoughnessFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( uint, gStepSize ) \
+    NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled ) \
+    NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier ) \
+    NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+
+// Other A-trous iterations ("SH" variants also know if the iteration is the last one)
+#define RELAX_DIFFUSE_SPECULAR_ATROUS_CB_DATA \
+    NRD_CONSTANT( float, gSpecularPhiLuminance ) \
+    NRD_CONSTANT( float, gDiffusePhiLuminance ) \
+    NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction ) \
+    NRD_CONSTANT( float, gRoughnessFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( uint, gStepSize ) \
+    NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled ) \
+    NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier ) \
+    NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+
+#define RELAX_DIFFUSE_ATROUS_CB_DATA \
+    NRD_CONSTANT( float, gDiffusePhiLuminance ) \
+    NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction ) \
+    NRD_CONSTANT( uint, gStepSize ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier ) \
+    NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+
+#define RELAX_SPECULAR_ATROUS_CB_DATA \
+    NRD_CONSTANT( float, gSpecularPhiLuminance ) \
+    NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference ) \
+    NRD_CONSTANT( float, gDepthThreshold ) \
+    NRD_CONSTANT( float, gDiffuseLobeAngleFraction ) \
+    NRD_CONSTANT( float, gRoughnessFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleFraction ) \
+    NRD_CONSTANT( float, gSpecularLobeAngleSlack ) \
+    NRD_CONSTANT( uint, gStepSize ) \
+    NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled ) \
+    NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( uint, gUseConfidenceInputs ) \
+    NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier ) \
+    NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation ) \
+    NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+
+#define RELAX_DIFFUSE_SPECULAR_SH_ATROUS_CB_DATA \
+    RELAX_DIFFUSE_SPECULAR_ATROUS_CB_DATA \
+    NRD_CONSTANT( uint, gIsLastPass )
+
+#define RELAX_DIFFUSE_SH_ATROUS_CB_DATA \
+    RELAX_DIFFUSE_ATROUS_CB_DATA \
+    NRD_CONSTANT( uint, gIsLastPass )
+
+#define RELAX_SPECULAR_SH_ATROUS_CB_DATA \
+    RELAX_SPECULAR_ATROUS_CB_DATA \
+    NRD_CONSTANT( uint, gIsLastPass )
+
+#define RELAX_DIFFUSE_SPECULAR_SPLIT_SCREEN_CB_DATA \
+    NRD_CONSTANT( float, gSplitScreen ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard )
+
+#define RELAX_DIFFUSE_SPLIT_SCREEN_CB_DATA \
+    NRD_CONSTANT( float, gSplitScreen ) \
+    NRD_CONSTANT( uint, gDiffCheckerboard )
+
+#define RELAX_SPECULAR_SPLIT_SCREEN_CB_DATA \
+    NRD_CONSTANT( float, gSplitScreen ) \
+    NRD_CONSTANT( uint, gSpecCheckerboard )
+
+#define RELAX_VALIDATION_CB_DATA \
+    NRD_CONSTANT( float4x4, gWorldToClipPrev ) \
+    NRD_CONSTANT( float2, gJitter ) \
+    NRD_CONSTANT( float, gMaxAccumulatedFrameNum )
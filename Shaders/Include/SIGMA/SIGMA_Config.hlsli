@@ -25,25 +25,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
     #define SIGMA_TYPE                                  float
 #endif
 
-// Shared data
-#define SIGMA_SHARED_CB_DATA \
-    NRD_CONSTANT( float4x4, gViewToClip ) \
-    NRD_CONSTANT( float4, gFrustum ) \
-    NRD_CONSTANT( float3, gMvScale ) \
-    NRD_CONSTANT( float, gDebug ) \
-    NRD_CONSTANT( float2, gInvScreenSize ) \
-    NRD_CONSTANT( float2, gScreenSize ) \
-    NRD_CONSTANT( float2, gInvRectSize ) \
-    NRD_CONSTANT( float2, gRectSize ) \
-    NRD_CONSTANT( float2, gRectSizePrev ) \
-    NRD_CONSTANT( float2, gResolutionScale ) \
-    NRD_CONSTANT( float2, gRectOffset ) \
-    NRD_CONSTANT( uint2, gRectOrigin ) \
-    NRD_CONSTANT( float, gOrthoMode ) \
-    NRD_CONSTANT( float, gUnproject ) \
-    NRD_CONSTANT( float, gDenoisingRange ) \
-    NRD_CONSTANT( float, gPlaneDistSensitivity ) \
-    NRD_CONSTANT( float, gBlurRadiusScale ) \
-    NRD_CONSTANT( float, gContinueAccumulation ) \
-    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled ) \
-    NRD_CONSTANT( uint, gFrameIndex )
+// Shared data (see "SIGMA_SharedConstants.hlsli")
+#include "SIGMA/SIGMA_SharedConstants.hlsli"
+
+// Per-pass data (see "SIGMA_PassConstants.hlsli")
+#include "SIGMA/SIGMA_PassConstants.hlsli"
@@ -0,0 +1,26 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// IMPORTANT: also included by NRD (C++) to declare per-pass constant structs with the same layout, i.e. only "NRD_CONSTANT" lists are allowed here
+
+#define SIGMA_SMOOTH_TILES_CB_DATA \
+    NRD_CONSTANT( int2, gTilesSizeMinusOne )
+
+// Blur and post-blur
+#define SIGMA_BLUR_CB_DATA \
+    NRD_CONSTANT( float4x4, gWorldToView ) \
+    NRD_CONSTANT( float4, gRotator )
+
+#define SIGMA_TEMPORAL_STABILIZATION_CB_DATA \
+    NRD_CONSTANT( float4x4, gWorldToClipPrev ) \
+    NRD_CONSTANT( float4x4, gViewToWorld )
+
+#define SIGMA_SPLIT_SCREEN_CB_DATA \
+    NRD_CONSTANT( float, gSplitScreen )
@@ -0,0 +1,34 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// IMPORTANT: also included by NRD (C++) to declare "SigmaSharedConstants" with the same layout, i.e. only "NRD_CONSTANT" lists are allowed here
+
+// Shared data
+#define SIGMA_SHARED_CB_DATA \
+    NRD_CONSTANT( float4x4, gViewToClip ) \
+    NRD_CONSTANT( float4, gFrustum ) \
+    NRD_CONSTANT( float3, gMvScale ) \
+    NRD_CONSTANT( float, gDebug ) \
+    NRD_CONSTANT( float2, gInvScreenSize ) \
+    NRD_CONSTANT( float2, gScreenSize ) \
+    NRD_CONSTANT( float2, gInvRectSize ) \
+    NRD_CONSTANT( float2, gRectSize ) \
+    NRD_CONSTANT( float2, gRectSizePrev ) \
+    NRD_CONSTANT( float2, gResolutionScale ) \
+    NRD_CONSTANT( float2, gRectOffset ) \
+    NRD_CONSTANT( uint2, gRectOrigin ) \
+    NRD_CONSTANT( float, gOrthoMode ) \
+    NRD_CONSTANT( float, gUnproject ) \
+    NRD_CONSTANT( float, gDenoisingRange ) \
+    NRD_CONSTANT( float, gPlaneDistSensitivity ) \
+    NRD_CONSTANT( float, gBlurRadiusScale ) \
+    NRD_CONSTANT( float, gContinueAccumulation ) \
+    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled ) \
+    NRD_CONSTANT( uint, gFrameIndex )
@@ -9,7 +9,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
 NRD_CONSTANTS_START
-    NRD_CONSTANT( float, gDenoisingRange )
+    CLASSIFY_TILES_CB_DATA
 NRD_CONSTANTS_END
 
 NRD_INPUT_TEXTURE_START
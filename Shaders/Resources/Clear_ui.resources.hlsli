@@ -9,9 +9,18 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
 NRD_CONSTANTS_START
+    CLEAR_CB_DATA
     NRD_CONSTANT( float, gDebug ) // ( must be last ) used for availability in Common.hlsl only
 NRD_CONSTANTS_END
 
+// Up to "CLEAR_RESOURCES_MAX_NUM" same-sized textures are cleared at once, unused slots are bound to "gOut0"
 NRD_OUTPUT_TEXTURE_START
-    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut, u, 0 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut0, u, 0 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut1, u, 1 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut2, u, 2 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut3, u, 3 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut4, u, 4 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut5, u, 5 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut6, u, 6 )
+    NRD_OUTPUT_TEXTURE( RWTexture2D<uint4>, gOut7, u, 7 )
 NRD_OUTPUT_TEXTURE_END
@@ -9,7 +9,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
 NRD_CONSTANTS_START
-    NRD_CONSTANT( uint, gIsRectChanged )
+    REBLUR_COPY_STABILIZED_HISTORY_CB_DATA
     NRD_CONSTANT( float, gDebug ) // ( must be last ) used for availability in Common.hlsl only
 NRD_CONSTANTS_END
 
@@ -15,9 +15,9 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     REBLUR_SHARED_CB_DATA
-NRD_CONSTANTS_END
+NRD_SHARED_CONSTANTS_END
 
 #if( defined REBLUR_DIFFUSE && defined REBLUR_SPECULAR )
 
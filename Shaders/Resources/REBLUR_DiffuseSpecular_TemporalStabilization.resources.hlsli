@@ -15,17 +15,12 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     REBLUR_SHARED_CB_DATA
-    NRD_CONSTANT( float4x4, gWorldToClip )
-    NRD_CONSTANT( float4x4, gWorldToClipPrev )
-    NRD_CONSTANT( float4x4, gWorldToViewPrev )
-    NRD_CONSTANT( float4, gFrustumPrev )
-    NRD_CONSTANT( float3, gCameraDelta )
-    NRD_CONSTANT( float, gStabilizationStrength )
-    NRD_CONSTANT( float4, gAntilagParams )
-    NRD_CONSTANT( float2, gSpecularProbabilityThresholdsForMvModification )
-    NRD_CONSTANT( float, gSplitScreen )
+NRD_SHARED_CONSTANTS_END
+
+NRD_CONSTANTS_START
+    REBLUR_TEMPORAL_STABILIZATION_CB_DATA
 NRD_CONSTANTS_END
 
 #if( defined REBLUR_DIFFUSE && defined REBLUR_SPECULAR )
@@ -16,11 +16,7 @@ NRD_SAMPLER_START
 NRD_SAMPLER_END
 
 NRD_CONSTANTS_START
-    NRD_CONSTANT( uint2, gRectOrigin )
-    NRD_CONSTANT( float2, gInvRectSize )
-    NRD_CONSTANT( float, gSplitScreen )
-    NRD_CONSTANT( float, gAccumSpeed )
-    NRD_CONSTANT( float, gDebug )
+    REFERENCE_TEMPORAL_ACCUMULATION_CB_DATA
 NRD_CONSTANTS_END
 
 NRD_INPUT_TEXTURE_START
@@ -17,28 +17,15 @@ NRD_SAMPLER_END
 
 #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gSpecularPhiLuminance )
-        NRD_CONSTANT( float, gDiffusePhiLuminance )
-        NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
-        NRD_CONSTANT( float, gRoughnessFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleSlack )
-        NRD_CONSTANT( uint, gStepSize )
-        NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled )
-        NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier )
-        NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
         #ifdef RELAX_SH
-            NRD_CONSTANT( uint, gIsLastPass )
+            RELAX_DIFFUSE_SPECULAR_SH_ATROUS_CB_DATA
+        #else
+            RELAX_DIFFUSE_SPECULAR_ATROUS_CB_DATA
         #endif
     NRD_CONSTANTS_END
 
@@ -69,19 +56,15 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_DIFFUSE )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gDiffusePhiLuminance )
-        NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
-        NRD_CONSTANT( uint, gStepSize )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier )
-        NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
         #ifdef RELAX_SH
-            NRD_CONSTANT( uint, gIsLastPass )
+            RELAX_DIFFUSE_SH_ATROUS_CB_DATA
+        #else
+            RELAX_DIFFUSE_ATROUS_CB_DATA
         #endif
     NRD_CONSTANTS_END
 
@@ -106,26 +89,15 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gSpecularPhiLuminance )
-        NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
-        NRD_CONSTANT( float, gRoughnessFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleSlack )
-        NRD_CONSTANT( uint, gStepSize )
-        NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled )
-        NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier )
-        NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
         #ifdef RELAX_SH
-            NRD_CONSTANT( uint, gIsLastPass )
+            RELAX_SPECULAR_SH_ATROUS_CB_DATA
+        #else
+            RELAX_SPECULAR_ATROUS_CB_DATA
         #endif
     NRD_CONSTANTS_END
 
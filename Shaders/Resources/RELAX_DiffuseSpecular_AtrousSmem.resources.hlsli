@@ -17,28 +17,12 @@ NRD_SAMPLER_END
 
 #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( uint2, gResourceSize )
-        NRD_CONSTANT( uint, gHistoryThreshold )
-        NRD_CONSTANT( float, gSpecularPhiLuminance )
-        NRD_CONSTANT( float, gDiffusePhiLuminance )
-        NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
-        NRD_CONSTANT( float, gRoughnessFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleSlack )
-        NRD_CONSTANT( uint, gStepSize )
-        NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled )
-        NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier )
-        NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_SPECULAR_ATROUS_SMEM_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -72,19 +56,12 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_DIFFUSE )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( uint2, gResourceSize )
-        NRD_CONSTANT( uint, gHistoryThreshold )
-        NRD_CONSTANT( float, gDiffusePhiLuminance )
-        NRD_CONSTANT( float, gMaxDiffuseLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
-        NRD_CONSTANT( uint, gStepSize )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier )
-        NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_ATROUS_SMEM_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -111,26 +88,12 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( uint2, gResourceSize )
-        NRD_CONSTANT( uint, gHistoryThreshold )
-        NRD_CONSTANT( float, gSpecularPhiLuminance )
-        NRD_CONSTANT( float, gMaxSpecularLuminanceRelativeDifference )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
-        NRD_CONSTANT( float, gRoughnessFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleSlack )
-        NRD_CONSTANT( uint, gStepSize )
-        NRD_CONSTANT( uint, gRoughnessEdgeStoppingEnabled )
-        NRD_CONSTANT( float, gRoughnessEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gNormalEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( float, gConfidenceDrivenRelaxationMultiplier )
-        NRD_CONSTANT( float, gConfidenceDrivenLuminanceEdgeStoppingRelaxation )
-        NRD_CONSTANT( float, gConfidenceDrivenNormalEdgeStoppingRelaxation )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_SPECULAR_ATROUS_SMEM_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
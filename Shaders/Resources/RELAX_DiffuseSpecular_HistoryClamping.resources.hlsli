@@ -15,20 +15,18 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     RELAX_SHARED_CB_DATA
-    NRD_CONSTANT( float, gColorBoxSigmaScale )
-    NRD_CONSTANT( float, gHistoryFixFrameNum )
-    #if( defined RELAX_SPECULAR )
-        NRD_CONSTANT( uint, gSpecFastHistory )
-    #endif
-    #if( defined RELAX_DIFFUSE )
-        NRD_CONSTANT( uint, gDiffFastHistory )
+NRD_SHARED_CONSTANTS_END
+
+NRD_CONSTANTS_START
+    #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
+        RELAX_DIFFUSE_SPECULAR_HISTORY_CLAMPING_CB_DATA
+    #elif( defined RELAX_DIFFUSE )
+        RELAX_DIFFUSE_HISTORY_CLAMPING_CB_DATA
+    #else
+        RELAX_SPECULAR_HISTORY_CLAMPING_CB_DATA
     #endif
-    NRD_CONSTANT(float, gHistoryAccelerationAmount)
-    NRD_CONSTANT(float, gHistoryResetTemporalSigmaScale)
-    NRD_CONSTANT(float, gHistoryResetSpatialSigmaScale)
-    NRD_CONSTANT(float, gHistoryResetAmount)
 NRD_CONSTANTS_END
 
 #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
@@ -15,17 +15,17 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     RELAX_SHARED_CB_DATA
-    NRD_CONSTANT( float, gDepthThreshold )
-    NRD_CONSTANT( float, gHistoryFixEdgeStoppingNormalPower )
-    NRD_CONSTANT( float, gHistoryFixStrideBetweenSamples )
-    NRD_CONSTANT( float, gHistoryFixFrameNum )
-    #if( defined RELAX_SPECULAR )
-        NRD_CONSTANT(float, gSpecularLobeAngleFraction)
-        NRD_CONSTANT(float, gSpecularLobeAngleSlack)
-        NRD_CONSTANT(float, gRoughnessEdgeStoppingRelaxation)
-        NRD_CONSTANT(float, gNormalEdgeStoppingRelaxation)
+NRD_SHARED_CONSTANTS_END
+
+NRD_CONSTANTS_START
+    #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
+        RELAX_DIFFUSE_SPECULAR_HISTORY_FIX_CB_DATA
+    #elif( defined RELAX_DIFFUSE )
+        RELAX_DIFFUSE_HISTORY_FIX_CB_DATA
+    #else
+        RELAX_SPECULAR_HISTORY_FIX_CB_DATA
     #endif
 NRD_CONSTANTS_END
 
@@ -15,9 +15,9 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     RELAX_SHARED_CB_DATA
-NRD_CONSTANTS_END
+NRD_SHARED_CONSTANTS_END
 
 // This shader works on specular signal only
 
@@ -17,19 +17,12 @@ NRD_SAMPLER_END
 
 #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float4, gRotator)
-        NRD_CONSTANT( uint, gDiffuseCheckerboard )
-        NRD_CONSTANT( uint, gSpecularCheckerboard )
-        NRD_CONSTANT( float, gDiffuseBlurRadius )
-        NRD_CONSTANT( float, gSpecularBlurRadius )
-        NRD_CONSTANT( float, gMeterToUnitsMultiplier )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleSlack )
-        NRD_CONSTANT( float, gRoughnessFraction )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_SPECULAR_PREPASS_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -55,14 +48,12 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_DIFFUSE )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float4, gRotator)
-        NRD_CONSTANT( uint, gDiffuseCheckerboard )
-        NRD_CONSTANT( float, gDiffuseBlurRadius )
-        NRD_CONSTANT( float, gMeterToUnitsMultiplier )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gDiffuseLobeAngleFraction )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_PREPASS_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -84,16 +75,12 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float4, gRotator)
-        NRD_CONSTANT( uint, gSpecularCheckerboard )
-        NRD_CONSTANT( float, gSpecularBlurRadius )
-        NRD_CONSTANT( float, gMeterToUnitsMultiplier )
-        NRD_CONSTANT( float, gDepthThreshold )
-        NRD_CONSTANT( float, gSpecularLobeAngleFraction )
-        NRD_CONSTANT( float, gSpecularLobeAngleSlack )
-        NRD_CONSTANT( float, gRoughnessFraction )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_SPECULAR_PREPASS_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
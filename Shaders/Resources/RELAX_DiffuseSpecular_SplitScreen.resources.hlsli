@@ -17,11 +17,12 @@ NRD_SAMPLER_END
 
 #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gSplitScreen )
-        NRD_CONSTANT( uint, gDiffCheckerboard )
-        NRD_CONSTANT( uint, gSpecCheckerboard )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_SPECULAR_SPLIT_SCREEN_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -37,10 +38,12 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_DIFFUSE )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gSplitScreen )
-        NRD_CONSTANT( uint, gDiffCheckerboard )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_SPLIT_SCREEN_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -54,10 +57,12 @@ NRD_SAMPLER_END
 
 #else
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gSplitScreen )
-        NRD_CONSTANT( uint, gSpecCheckerboard )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_SPECULAR_SPLIT_SCREEN_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -17,21 +17,12 @@ NRD_SAMPLER_END
 
 #if( defined RELAX_DIFFUSE && defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gSpecularMaxAccumulatedFrameNum )
-        NRD_CONSTANT( float, gSpecularMaxFastAccumulatedFrameNum )
-        NRD_CONSTANT( float, gDiffuseMaxAccumulatedFrameNum )
-        NRD_CONSTANT( float, gDiffuseMaxFastAccumulatedFrameNum )
-        NRD_CONSTANT( uint, gDiffCheckerboard )
-        NRD_CONSTANT( uint, gSpecCheckerboard )
-        NRD_CONSTANT( float, gDisocclusionDepthThreshold )
-        NRD_CONSTANT( float, gDisocclusionDepthThresholdAlternate )
-        NRD_CONSTANT( float, gRoughnessFraction )
-        NRD_CONSTANT( float, gSpecularVarianceBoost )
-        NRD_CONSTANT( uint, gSkipReprojectionTestWithoutMotion )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( uint, gUseDisocclusionThresholdMix )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -81,16 +72,12 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_DIFFUSE )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gDiffuseMaxAccumulatedFrameNum )
-        NRD_CONSTANT( float, gDiffuseMaxFastAccumulatedFrameNum )
-        NRD_CONSTANT( uint, gDiffCheckerboard )
-        NRD_CONSTANT( float, gDisocclusionDepthThreshold )
-        NRD_CONSTANT( float, gDisocclusionDepthThresholdAlternate )
-        NRD_CONSTANT( uint, gSkipReprojectionTestWithoutMotion )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( uint, gUseDisocclusionThresholdMix )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_DIFFUSE_TEMPORAL_ACCUMULATION_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -126,18 +113,12 @@ NRD_SAMPLER_END
 
 #elif( defined RELAX_SPECULAR )
 
-    NRD_CONSTANTS_START
+    NRD_SHARED_CONSTANTS_START
         RELAX_SHARED_CB_DATA
-        NRD_CONSTANT( float, gSpecularMaxAccumulatedFrameNum )
-        NRD_CONSTANT( float, gSpecularMaxFastAccumulatedFrameNum )
-        NRD_CONSTANT( uint, gSpecCheckerboard )
-        NRD_CONSTANT( float, gDisocclusionDepthThreshold )
-        NRD_CONSTANT( float, gDisocclusionDepthThresholdAlternate )
-        NRD_CONSTANT( float, gRoughnessFraction )
-        NRD_CONSTANT( float, gSpecularVarianceBoost )
-        NRD_CONSTANT( uint, gSkipReprojectionTestWithoutMotion )
-        NRD_CONSTANT( uint, gUseConfidenceInputs )
-        NRD_CONSTANT( uint, gUseDisocclusionThresholdMix )
+    NRD_SHARED_CONSTANTS_END
+
+    NRD_CONSTANTS_START
+        RELAX_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA
     NRD_CONSTANTS_END
 
     NRD_INPUT_TEXTURE_START
@@ -15,11 +15,12 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     RELAX_SHARED_CB_DATA
-    NRD_CONSTANT( float4x4, gWorldToClipPrev )
-    NRD_CONSTANT( float2, gJitter )
-    NRD_CONSTANT( float, gMaxAccumulatedFrameNum )
+NRD_SHARED_CONSTANTS_END
+
+NRD_CONSTANTS_START
+    RELAX_VALIDATION_CB_DATA
 NRD_CONSTANTS_END
 
 NRD_INPUT_TEXTURE_START
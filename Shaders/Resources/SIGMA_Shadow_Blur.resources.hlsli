@@ -15,10 +15,12 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     SIGMA_SHARED_CB_DATA
-    NRD_CONSTANT( float4x4, gWorldToView )
-    NRD_CONSTANT( float4, gRotator )
+NRD_SHARED_CONSTANTS_END
+
+NRD_CONSTANTS_START
+    SIGMA_BLUR_CB_DATA
 NRD_CONSTANTS_END
 
 NRD_INPUT_TEXTURE_START
@@ -15,9 +15,9 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     SIGMA_SHARED_CB_DATA
-NRD_CONSTANTS_END
+NRD_SHARED_CONSTANTS_END
 
 NRD_INPUT_TEXTURE_START
     NRD_INPUT_TEXTURE( Texture2D<float2>, gIn_Hit_ViewZ, t, 0 )
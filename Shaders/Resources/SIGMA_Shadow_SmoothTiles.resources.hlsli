@@ -15,9 +15,12 @@ NRD_SAMPLER_START
     NRD_SAMPLER( SamplerState, gLinearMirror, s, 3 )
 NRD_SAMPLER_END
 
-NRD_CONSTANTS_START
+NRD_SHARED_CONSTANTS_START
     SIGMA_SHARED_CB_DATA
-    NRD_CONSTANT( int2, gTilesSizeMinusOne )
+NRD_SHARED_CONSTANTS_END
+
+NRD_CONSTANTS_START
+    SIGMA_SMOOTH_TILES_CB_DATA
 NRD_CONSTANTS_END
 
 NRD_INPUT_TEXTURE_START
@@ -16,13 +16,7 @@ NRD_SAMPLER_START
 NRD_SAMPLER_END
 
 NRD_CONSTANTS_START
-    NRD_CONSTANT( float4x4, gWorldToClipPrev )
-    NRD_CONSTANT( float3, gMvScale )
-    NRD_CONSTANT( float, gDebug )
-    NRD_CONSTANT( uint2, gRectSize )
-    NRD_CONSTANT( float2, gInvRectSize )
-    NRD_CONSTANT( uint2, gRectOrigin )
-    NRD_CONSTANT( uint, gIsWorldSpaceMotionEnabled )
+    SPECULAR_DELTA_MV_CB_DATA
 NRD_CONSTANTS_END
 
 NRD_INPUT_TEXTURE_START
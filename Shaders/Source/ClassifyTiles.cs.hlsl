@@ -11,7 +11,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "NRD.hlsli"
 #include "STL.hlsli"
 
-#include "REBLUR_ClassifyTiles.resources.hlsli"
+#include "PassConstants.hlsli"
+#include "ClassifyTiles.resources.hlsli"
 
 groupshared uint s_isSky;
 
@@ -11,6 +11,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "NRD.hlsli"
 #include "STL.hlsli"
 
+#include "PassConstants.hlsli"
 #include "Clear_ui.resources.hlsli"
 
 #include "Common.hlsli"
@@ -18,5 +19,33 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 [numthreads( 16, 16, 1 )]
 NRD_EXPORT void NRD_CS_MAIN( uint2 pixelPos : SV_DispatchThreadId )
 {
-    gOut[ pixelPos ] = 0;
+    gOut0[ pixelPos ] = 0;
+
+    [branch]
+    if( gResourcesNum > 1 )
+        gOut1[ pixelPos ] = 0;
+
+    [branch]
+    if( gResourcesNum > 2 )
+        gOut2[ pixelPos ] = 0;
+
+    [branch]
+    if( gResourcesNum > 3 )
+        gOut3[ pixelPos ] = 0;
+
+    [branch]
+    if( gResourcesNum > 4 )
+        gOut4[ pixelPos ] = 0;
+
+    [branch]
+    if( gResourcesNum > 5 )
+        gOut5[ pixelPos ] = 0;
+
+    [branch]
+    if( gResourcesNum > 6 )
+        gOut6[ pixelPos ] = 0;
+
+    [branch]
+    if( gResourcesNum > 7 )
+        gOut7[ pixelPos ] = 0;
 }
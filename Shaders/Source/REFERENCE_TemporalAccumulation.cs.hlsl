@@ -11,6 +11,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "NRD.hlsli"
 #include "STL.hlsli"
 
+#include "PassConstants.hlsli"
 #include "REFERENCE_TemporalAccumulation.resources.hlsli"
 
 #include "Common.hlsli"
@@ -14,36 +14,43 @@ void nrd::InstanceImpl::Add_Reference(DenoiserData& denoiserData)
 
     denoiserData.settings.reference = ReferenceSettings();
     denoiserData.settingsSize = sizeof(denoiserData.settings.reference);
-            
-    uint16_t w = denoiserData.desc.renderWidth;
-    uint16_t h = denoiserData.desc.renderHeight;
 
-    enum class Permanent
+    struct Builder : GraphBuilder
     {
-        HISTORY = PERMANENT_POOL_START,
-    };
+        constexpr Builder()
+        {
+            enum class Permanent
+            {
+                HISTORY = PERMANENT_POOL_START,
+            };
 
-    AddTextureToPermanentPool( {Format::RGBA32_SFLOAT, w, h, 1} );
+            AddTextureToPermanentPool( {Format::RGBA32_SFLOAT, 1} );
 
-    SetSharedConstants(0, 0, 0, 0);
+            PushPass("Temporal accumulation");
+            {
+                PushInput( AsUint(ResourceType::IN_RADIANCE) );
 
-    PushPass("Temporal accumulation");
-    {
-        PushInput( AsUint(ResourceType::IN_RADIANCE) );
+                PushOutput( AsUint(Permanent::HISTORY) );
 
-        PushOutput( AsUint(Permanent::HISTORY) );
+                AddDispatch( REFERENCE_TemporalAccumulation, ConstantsOf<ReferenceTemporalAccumulationConstants>(), NumThreads(16, 16), 1 );
+            }
 
-        AddDispatch( REFERENCE_TemporalAccumulation, SumConstants(0, 0, 2, 3), NumThreads(16, 16), 1 );
-    }
+            PushPass("Split screen");
+            {
+                PushInput( AsUint(Permanent::HISTORY) );
 
-    PushPass("Split screen");
-    {
-        PushInput( AsUint(Permanent::HISTORY) );
+                PushOutput( AsUint(ResourceType::OUT_RADIANCE) );
+
+                AddDispatch( REFERENCE_SplitScreen, NoConstants(), NumThreads(16, 16), 1 );
+            }
+        }
+    };
+
+    NRD_DECLARE_GRAPH(graph, Builder);
 
-        PushOutput( AsUint(ResourceType::OUT_RADIANCE) );
+    SetSharedConstants(0);
 
-        AddDispatch( REFERENCE_SplitScreen, SumConstants(0, 0, 0, 0), NumThreads(16, 16), 1 );
-    }
+    AddGraph(denoiserData, graph);
 
     #undef DENOISER_NAME
 }
@@ -59,22 +66,21 @@ void nrd::InstanceImpl::Update_Reference(const DenoiserData& denoiserData)
     const ReferenceSettings& settings = denoiserData.settings.reference;
 
     if (m_WorldToClip != m_WorldToClipPrev || m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE)
-        m_AccumulatedFrameNum = 0;
+        denoiserData.accumulatedFrameNum = 0;
     else
-        m_AccumulatedFrameNum = ml::Min(m_AccumulatedFrameNum + 1, settings.maxAccumulatedFrameNum);
+        denoiserData.accumulatedFrameNum = ml::Min(denoiserData.accumulatedFrameNum + 1, settings.maxAccumulatedFrameNum);
 
     NRD_DECLARE_DIMS;
 
     // ACCUMULATE
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::ACCUMULATE));
-    AddUint2(data, m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]);
-    AddFloat2(data, 1.0f / float(rectW), 1.0f / float(rectH));
-    AddFloat(data, m_CommonSettings.splitScreen);
-    AddFloat(data, 1.0f / (1.0f + float(m_AccumulatedFrameNum)));
-    AddFloat(data, m_CommonSettings.debug);
-    ValidateConstants(data);
+    ReferenceTemporalAccumulationConstants accumulateConstants = {};
+    accumulateConstants.gRectOrigin = {m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]};
+    accumulateConstants.gInvRectSize = {1.0f / float(rectW), 1.0f / float(rectH)};
+    accumulateConstants.gSplitScreen = m_CommonSettings.splitScreen;
+    accumulateConstants.gAccumSpeed = 1.0f / (1.0f + float(denoiserData.accumulatedFrameNum));
+    accumulateConstants.gDebug = m_CommonSettings.debug;
+    PushDispatch(denoiserData, AsUint(Dispatch::ACCUMULATE), accumulateConstants);
 
     // COPY
-    data = PushDispatch(denoiserData, AsUint(Dispatch::COPY));
-    ValidateConstants(data);
+    PushDispatch(denoiserData, AsUint(Dispatch::COPY));
 }
@@ -15,329 +15,337 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData)
     denoiserData.settings.diffuseRelax = RelaxDiffuseSettings();
     denoiserData.settingsSize = sizeof(denoiserData.settings.diffuseRelax);
 
-    uint16_t w = denoiserData.desc.renderWidth;
-    uint16_t h = denoiserData.desc.renderHeight;
-    uint16_t tilesW = DivideUp(w, 16);
-    uint16_t tilesH = DivideUp(h, 16);
-
-    enum class Permanent
-    {
-        DIFF_ILLUM_PREV = PERMANENT_POOL_START,
-        DIFF_ILLUM_PREV_SH1,
-        DIFF_ILLUM_RESPONSIVE_PREV,
-        DIFF_ILLUM_RESPONSIVE_PREV_SH1,
-        HISTORY_LENGTH_PREV,
-        NORMAL_ROUGHNESS_PREV,
-        MATERIAL_ID_PREV,
-        VIEWZ_PREV
-    };
-
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, w, h, 1} );
-    AddTextureToPermanentPool( {Format::RGBA8_UNORM, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R32_SFLOAT, w, h, 1} );
-
-    enum class Transient
-    {
-        DIFF_ILLUM_PING = TRANSIENT_POOL_START,
-        DIFF_ILLUM_PING_SH1,
-        DIFF_ILLUM_PONG,
-        DIFF_ILLUM_PONG_SH1,
-        TILES,
-        HISTORY_LENGTH
-    };
-
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, tilesW, tilesH, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, w, h, 1} );
-
-    RELAX_SET_SHARED_CONSTANTS;
-
-    const uint32_t halfMaxPassNum = (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
-
-    PushPass("Classify tiles");
+    struct Builder : GraphBuilder
     {
-        PushInput(AsUint(ResourceType::IN_VIEWZ));
-        PushOutput(AsUint(Transient::TILES));
-
-        AddDispatch(RELAX_ClassifyTiles, SumConstants(0, 0, 0, 1, false), NumThreads(16, 16), 1);
-    }
+        constexpr Builder()
+        {
+            enum class Permanent
+            {
+                DIFF_ILLUM_PREV = PERMANENT_POOL_START,
+                DIFF_ILLUM_PREV_SH1,
+                DIFF_ILLUM_RESPONSIVE_PREV,
+                DIFF_ILLUM_RESPONSIVE_PREV_SH1,
+                HISTORY_LENGTH_PREV,
+                NORMAL_ROUGHNESS_PREV,
+                NORMAL_ROUGHNESS_CURR,
+                MATERIAL_ID_PREV,
+                MATERIAL_ID_CURR,
+                VIEWZ_PREV,
+                VIEWZ_CURR
+            };
+
+            AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToPermanentPool( {RELAX_FORMAT_DIFF_ILLUM_RESPONSIVE_PREV, 1, RELAX_FORMAT_DIFF_ILLUM_RESPONSIVE_PREV_PACKED} );
+            AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
+            AddSharedTextureToPermanentPool( {RELAX_FORMAT_PREV_NORMAL_ROUGHNESS, 1}, GeometryHistory::RELAX_NORMAL_ROUGHNESS );
+            AddSharedTextureToPermanentPool( {RELAX_FORMAT_PREV_MATERIAL_ID, 1}, GeometryHistory::RELAX_MATERIAL_ID );
+            AddSharedTextureToPermanentPool( {RELAX_FORMAT_PREV_VIEWZ, 1, RELAX_FORMAT_PREV_VIEWZ_PACKED}, GeometryHistory::RELAX_VIEWZ );
+
+            enum class Transient
+            {
+                DIFF_ILLUM_PING = TRANSIENT_POOL_START,
+                DIFF_ILLUM_PING_SH1,
+                DIFF_ILLUM_PONG,
+                DIFF_ILLUM_PONG_SH1,
+                TILES,
+                HISTORY_LENGTH,
+            };
+
+            AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToTransientPool( {Format::R8_UNORM, 16} );
+            AddTextureToTransientPool( {Format::R8_UNORM, 1} );
+
+            const uint32_t halfMaxPassNum = (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
+
+            PushPass("Classify tiles");
+            {
+                PushInput(AsUint(ResourceType::IN_VIEWZ));
+                PushOutput(AsUint(Transient::TILES));
 
-    PushPass("Hit distance reconstruction 3x3"); // 3x3
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                AddDispatch(ClassifyTiles, ConstantsOf<ClassifyTilesConstants>(false), NumThreads(16, 16), 1);
+            }
 
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+            PushPass("Hit distance reconstruction 3x3"); // 3x3
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        AddDispatch( RELAX_Diffuse_HitDistReconstruction, SumConstants(0, 0, 0, 0), NumThreads(8, 8), 1 );
-    }
+                PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
 
-    PushPass("Hit distance reconstruction 5x5"); // 5x5
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+                AddDispatch( RELAX_Diffuse_HitDistReconstruction, NoConstants(), NumThreads(8, 8), 1 );
+            }
 
-        AddDispatch( RELAX_Diffuse_HitDistReconstruction_5x5, SumConstants(0, 0, 0, 0), NumThreads(8, 8), 1 );
-    }
+            PushPass("Hit distance reconstruction 5x5"); // 5x5
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-    PushPass("Pre-pass"); // After hit distance reconstruction
-    {
-        // Does preblur (if enabled) and checkerboard reconstruction (if enabled)
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+                PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
 
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                AddDispatch( RELAX_Diffuse_HitDistReconstruction_5x5, NoConstants(), NumThreads(8, 8), 1 );
+            }
 
-        AddDispatch( RELAX_DiffuseSh_PrePass, SumConstants(0, 1, 0, 5), NumThreads(16, 16), 1 );
-    }
+            PushPass("Pre-pass"); // After hit distance reconstruction
+            {
+                // Does preblur (if enabled) and checkerboard reconstruction (if enabled)
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
 
-    PushPass("Pre-pass"); // Without hit distance reconstruction
-    {
-        // Does preblur (if enabled) and checkerboard reconstruction (if enabled)
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+                PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
 
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                AddDispatch( RELAX_DiffuseSh_PrePass, ConstantsOf<RelaxDiffusePrePassConstants>(), NumThreads(16, 16), 1 );
+            }
 
-        AddDispatch( RELAX_DiffuseSh_PrePass, SumConstants(0, 1, 0, 5), NumThreads(16, 16), 1 );
-    }
+            PushPass("Pre-pass"); // Without hit distance reconstruction
+            {
+                // Does preblur (if enabled) and checkerboard reconstruction (if enabled)
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
 
-    for (int i = 0; i < 4; i++)
-    {
-        // The following passes are defined here:
-        // TEMPORAL_ACCUMULATION,
-        // TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS,
-        // TEMPORAL_ACCUMULATION_WITH_THRESHOLD_MIX,
-        // TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS_WITH_THRESHOLD_MIX
+                PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
 
-        PushPass("Temporal accumulation");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_MV) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-            PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-            PushInput( AsUint(Permanent::VIEWZ_PREV) );
-            PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
-            PushInput( AsUint(Permanent::MATERIAL_ID_PREV) );
-            // Confidence inputs:
-            if (i == 0)
-            {
-                PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
-                PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
+                AddDispatch( RELAX_DiffuseSh_PrePass, ConstantsOf<RelaxDiffusePrePassConstants>(), NumThreads(16, 16), 1 );
             }
-            if (i == 1)
-            {
-                PushInput( AsUint(ResourceType::IN_DIFF_CONFIDENCE) );
-                PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
-            }
-            if (i == 2)
-            {
-                PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
-                PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
-            }
-            if (i == 3)
+
+            for (int i = 0; i < 4; i++)
             {
-                PushInput( AsUint(ResourceType::IN_DIFF_CONFIDENCE) );
-                PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
+                // The following passes are defined here:
+                // TEMPORAL_ACCUMULATION,
+                // TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS,
+                // TEMPORAL_ACCUMULATION_WITH_THRESHOLD_MIX,
+                // TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS_WITH_THRESHOLD_MIX
+
+                PushPass("Temporal accumulation");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    PushInput( AsUint(ResourceType::IN_MV) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
+                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV), 0, 1, AsUint(Permanent::NORMAL_ROUGHNESS_CURR) );
+                    PushInput( AsUint(Permanent::VIEWZ_PREV), 0, 1, AsUint(Permanent::VIEWZ_CURR) );
+                    PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                    PushInput( AsUint(Permanent::MATERIAL_ID_PREV), 0, 1, AsUint(Permanent::MATERIAL_ID_CURR) );
+                    // Confidence inputs:
+                    if (i == 0)
+                    {
+                        PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
+                        PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
+                    }
+                    if (i == 1)
+                    {
+                        PushInput( AsUint(ResourceType::IN_DIFF_CONFIDENCE) );
+                        PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
+                    }
+                    if (i == 2)
+                    {
+                        PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
+                        PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
+                    }
+                    if (i == 3)
+                    {
+                        PushInput( AsUint(ResourceType::IN_DIFF_CONFIDENCE) );
+                        PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
+                    }
+                    PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
+                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    PushOutput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    AddDispatch( RELAX_DiffuseSh_TemporalAccumulation, ConstantsOf<RelaxDiffuseTemporalAccumulationConstants>(), NumThreads(8, 8), 1 );
+                }
             }
-            PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
-            PushOutput( AsUint(Transient::HISTORY_LENGTH) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
 
-            AddDispatch( RELAX_DiffuseSh_TemporalAccumulation, SumConstants(0, 0, 0, 8), NumThreads(8, 8), 1 );
-        }
-    }
-
-    PushPass("History fix");
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+            PushPass("History fix");
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
 
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+                PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
 
-        AddDispatch( RELAX_DiffuseSh_HistoryFix, SumConstants(0, 0, 0, 4), NumThreads(8, 8), 1 );
-    }
+                AddDispatch( RELAX_DiffuseSh_HistoryFix, ConstantsOf<RelaxDiffuseHistoryFixConstants>(), NumThreads(8, 8), 1 );
+            }
 
-    PushPass("History clamping");
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
-        PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
-
-        AddDispatch( RELAX_DiffuseSh_HistoryClamping, SumConstants(0, 0, 0, 7), NumThreads(8, 8), 1 );
-    }
-    
-    PushPass("Copy");
-    {
-        PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+            PushPass("History clamping");
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
+                PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+                PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
+
+                AddDispatch( RELAX_DiffuseSh_HistoryClamping, ConstantsOf<RelaxDiffuseHistoryClampingConstants>(), NumThreads(8, 8), 1 );
+            }
 
-        AddDispatch( RELAX_DiffuseSh_Copy, SumConstants(0, 0, 0, 0), NumThreads(8, 8), 1 );
-    }
+            PushPass("Copy");
+            {
+                PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
 
-    PushPass("Anti-firefly");
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                AddDispatch( RELAX_DiffuseSh_Copy, NoConstants(), NumThreads(8, 8), 1 );
+            }
 
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+            PushPass("Anti-firefly");
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        AddDispatch( RELAX_DiffuseSh_AntiFirefly, SumConstants(0, 0, 0, 0), NumThreads(16, 16), 1 );
-    }
+                PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
 
-    for (int i = 0; i < 2; i++)
-    {
-        bool withConfidenceInputs = (i == 1);
+                AddDispatch( RELAX_DiffuseSh_AntiFirefly, NoConstants(), NumThreads(16, 16), 1 );
+            }
 
-        // A-trous (first)
-        PushPass("A-trous (SMEM)");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
-            PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-            PushOutput( AsUint(Permanent::MATERIAL_ID_PREV) );
-            PushOutput( AsUint(Permanent::VIEWZ_PREV) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-
-            AddDispatch( RELAX_DiffuseSh_AtrousSmem, SumConstants(0, 0, 1, 10), NumThreads(8, 8), 1 );
-        }
+            for (int i = 0; i < 2; i++)
+            {
+                bool withConfidenceInputs = (i == 1);
+
+                // A-trous (first)
+                PushPass("A-trous (SMEM)");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_CURR), 0, 1, AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
+                    PushOutput( AsUint(Permanent::MATERIAL_ID_CURR), 0, 1, AsUint(Permanent::MATERIAL_ID_PREV) );
+                    PushOutput( AsUint(Permanent::VIEWZ_CURR), 0, 1, AsUint(Permanent::VIEWZ_PREV) );
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+
+                    AddDispatch( RELAX_DiffuseSh_AtrousSmem, ConstantsOf<RelaxDiffuseAtrousSmemConstants>(), NumThreads(8, 8), 1 );
+                }
+
+                // A-trous (odd)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    AddDispatchRepeated( RELAX_DiffuseSh_Atrous, ConstantsOf<RelaxDiffuseShAtrousConstants>(), NumThreads(16, 16), 1, halfMaxPassNum );
+                }
+
+                // A-trous (even)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+
+                    AddDispatchRepeated(RELAX_DiffuseSh_Atrous, ConstantsOf<RelaxDiffuseShAtrousConstants>(), NumThreads(16, 16), 1, halfMaxPassNum );
+                }
+
+                // A-trous (odd, last)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+
+                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+
+                    AddDispatch(RELAX_DiffuseSh_Atrous, ConstantsOf<RelaxDiffuseShAtrousConstants>(), NumThreads(16, 16), 1 );
+                }
+
+                // A-trous (even, last)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+
+                    AddDispatch(RELAX_DiffuseSh_Atrous, ConstantsOf<RelaxDiffuseShAtrousConstants>(), NumThreads(16, 16), 1 );
+                }
+            }
 
-        // A-trous (odd)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-            AddDispatchRepeated( RELAX_DiffuseSh_Atrous, SumConstants(0, 0, 0, 10), NumThreads(16, 16), 1, halfMaxPassNum );
-        }
+            PushPass("Split screen");
+            {
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                PushInput( AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
 
-        // A-trous (even)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-
-            AddDispatchRepeated(RELAX_DiffuseSh_Atrous, SumConstants(0, 0, 0, 10), NumThreads(16, 16), 1, halfMaxPassNum );
-        }
+                PushOutput( AsUint( ResourceType::OUT_DIFF_RADIANCE_HITDIST ) );
 
-        // A-trous (odd, last)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-
-            AddDispatch(RELAX_DiffuseSh_Atrous, SumConstants(0, 0, 0, 10), NumThreads(16, 16), 1 );
-        }
+                AddDispatch( RELAX_Diffuse_SplitScreen, ConstantsOf<RelaxDiffuseSplitScreenConstants>(), NumThreads(16, 16), 1 );
+            }
 
-        // A-trous (even, last)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-
-            AddDispatch(RELAX_DiffuseSh_Atrous, SumConstants(0, 0, 0, 10), NumThreads(16, 16), 1 );
+            RELAX_ADD_VALIDATION_DISPATCH;
         }
-    }
-
-    PushPass("Split screen");
-    {
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
+    };
 
-        PushOutput( AsUint( ResourceType::OUT_DIFF_RADIANCE_HITDIST ) );
+    NRD_DECLARE_GRAPH(graph, Builder);
 
-        AddDispatch( RELAX_Diffuse_SplitScreen, SumConstants(0, 0, 0, 2), NumThreads(16, 16), 1 );
-    }
+    RELAX_SET_SHARED_CONSTANTS;
 
-    RELAX_ADD_VALIDATION_DISPATCH;
+    AddGraph(denoiserData, graph);
 
     #undef DENOISER_NAME
 }
@@ -415,104 +423,99 @@ void nrd::InstanceImpl::Update_RelaxDiffuseSh(const DenoiserData& denoiserData)
         break;
     }
 
+    // Shared constants (once per frame)
+    PushSharedConstants_Relax(denoiserData, denoiserData.desc.denoiser);
+
+    RelaxDiffuseSplitScreenConstants splitScreenConstants = {};
+    splitScreenConstants.gSplitScreen = m_CommonSettings.splitScreen;
+    splitScreenConstants.gDiffCheckerboard = diffuseCheckerboard;
+
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, diffuseCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
 
         return;
     }
 
     // CLASSIFY_TILES
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    ValidateConstants(data);
+    ClassifyTilesConstants classifyTilesConstants = {};
+    classifyTilesConstants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES), classifyTilesConstants);
 
     // HITDIST_RECONSTRUCTION
     if (enableHitDistanceReconstruction)
     {
         bool is3x3 = settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_3X3;
-        data = PushDispatch(denoiserData, is3x3 ? AsUint(Dispatch::HITDIST_RECONSTRUCTION_3x3) : AsUint(Dispatch::HITDIST_RECONSTRUCTION_5x5));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, is3x3 ? AsUint(Dispatch::HITDIST_RECONSTRUCTION_3x3) : AsUint(Dispatch::HITDIST_RECONSTRUCTION_5x5));
     }
 
     // PREPASS
-    data = PushDispatch(denoiserData, AsUint(enableHitDistanceReconstruction ? Dispatch::PREPASS_AFTER_HITDIST_RECONSTRUCTION : Dispatch::PREPASS));
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-    AddFloat4(data, m_Rotator_PrePass);
-    AddUint(data, diffuseCheckerboard);
-    AddFloat(data, settings.prepassBlurRadius);
-    AddFloat(data, 1.0f);
-    AddFloat(data, m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho);
-    AddFloat(data, settings.diffuseLobeAngleFraction);
-    
-    ValidateConstants(data);
+    RelaxDiffusePrePassConstants prePassConstants = {};
+    prePassConstants.gRotator = cb::AsFloat4(m_Rotator_PrePass);
+    prePassConstants.gDiffuseCheckerboard = diffuseCheckerboard;
+    prePassConstants.gDiffuseBlurRadius = settings.prepassBlurRadius;
+    prePassConstants.gMeterToUnitsMultiplier = 1.0f;
+    prePassConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+    prePassConstants.gDiffuseLobeAngleFraction = settings.diffuseLobeAngleFraction;
+    PushDispatch(denoiserData, AsUint(enableHitDistanceReconstruction ? Dispatch::PREPASS_AFTER_HITDIST_RECONSTRUCTION : Dispatch::PREPASS), prePassConstants);
 
     // TEMPORAL_ACCUMULATION
+    RelaxDiffuseTemporalAccumulationConstants temporalAccumulationConstants = {};
+    temporalAccumulationConstants.gDiffuseMaxAccumulatedFrameNum = (float)settings.diffuseMaxAccumulatedFrameNum;
+    temporalAccumulationConstants.gDiffuseMaxFastAccumulatedFrameNum = (float)settings.diffuseMaxFastAccumulatedFrameNum;
+    temporalAccumulationConstants.gDiffCheckerboard = diffuseCheckerboard;
+    temporalAccumulationConstants.gDisocclusionDepthThreshold = m_IsOrtho == 0 ? disocclusionThreshold : disocclusionThresholdOrtho;
+    temporalAccumulationConstants.gDisocclusionDepthThresholdAlternate = m_IsOrtho == 0 ? disocclusionThresholdAlternate : disocclusionThresholdAlternateOrtho;
+    temporalAccumulationConstants.gSkipReprojectionTestWithoutMotion = settings.enableReprojectionTestSkippingWithoutMotion && isCameraStatic;
+    temporalAccumulationConstants.gUseConfidenceInputs = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+    temporalAccumulationConstants.gUseDisocclusionThresholdMix = m_CommonSettings.isDisocclusionThresholdMixAvailable ? 1 : 0;
+
     if (!m_CommonSettings.isDisocclusionThresholdMixAvailable)
     {
-        data = PushDispatch(
+        PushDispatch(
             denoiserData,
             AsUint(m_CommonSettings.isHistoryConfidenceAvailable ?
                 Dispatch::TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS :
-                Dispatch::TEMPORAL_ACCUMULATION));
+                Dispatch::TEMPORAL_ACCUMULATION),
+            temporalAccumulationConstants);
     }
     else
     {
-        data = PushDispatch(
+        PushDispatch(
             denoiserData,
             AsUint(m_CommonSettings.isHistoryConfidenceAvailable ?
                 Dispatch::TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS_WITH_THRESHOLD_MIX :
-                Dispatch::TEMPORAL_ACCUMULATION_WITH_THRESHOLD_MIX));
+                Dispatch::TEMPORAL_ACCUMULATION_WITH_THRESHOLD_MIX),
+            temporalAccumulationConstants);
     }
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-    AddFloat(data, (float)settings.diffuseMaxAccumulatedFrameNum);
-    AddFloat(data, (float)settings.diffuseMaxFastAccumulatedFrameNum);
-    AddUint(data, diffuseCheckerboard);
-    AddFloat(data, m_IsOrtho == 0 ? disocclusionThreshold : disocclusionThresholdOrtho);
-    AddFloat(data, m_IsOrtho == 0 ? disocclusionThresholdAlternate : disocclusionThresholdAlternateOrtho);
-    AddUint(data, settings.enableReprojectionTestSkippingWithoutMotion && isCameraStatic);
-    AddUint(data, m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0);
-    AddUint(data, m_CommonSettings.isDisocclusionThresholdMixAvailable ? 1 : 0);
-    ValidateConstants(data);
 
     // HISTORY_FIX
-    data = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX));
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-    AddFloat(data, m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho);
-    AddFloat(data, settings.historyFixEdgeStoppingNormalPower);
-    AddFloat(data, settings.historyFixStrideBetweenSamples);
-    AddFloat(data, float(settings.historyFixFrameNum));
-    ValidateConstants(data);
+    RelaxDiffuseHistoryFixConstants historyFixConstants = {};
+    historyFixConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+    historyFixConstants.gHistoryFixEdgeStoppingNormalPower = settings.historyFixEdgeStoppingNormalPower;
+    historyFixConstants.gHistoryFixStrideBetweenSamples = settings.historyFixStrideBetweenSamples;
+    historyFixConstants.gHistoryFixFrameNum = float(settings.historyFixFrameNum);
+    PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX), historyFixConstants);
 
     // HISTORY_CLAMPING
-    data = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_CLAMPING));
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-    AddFloat(data, settings.historyClampingColorBoxSigmaScale);
-    AddFloat(data, float(settings.historyFixFrameNum));
-    AddUint(data, settings.diffuseMaxFastAccumulatedFrameNum < settings.diffuseMaxAccumulatedFrameNum ? 1 : 0);
-    AddFloat(data, float(settings.antilagSettings.accelerationAmount));
-    AddFloat(data, float(settings.antilagSettings.temporalSigmaScale));
-    AddFloat(data, float(settings.antilagSettings.spatialSigmaScale));
-    AddFloat(data, float(settings.antilagSettings.resetAmount));
-    ValidateConstants(data);
+    RelaxDiffuseHistoryClampingConstants historyClampingConstants = {};
+    historyClampingConstants.gColorBoxSigmaScale = settings.historyClampingColorBoxSigmaScale;
+    historyClampingConstants.gHistoryFixFrameNum = float(settings.historyFixFrameNum);
+    historyClampingConstants.gDiffFastHistory = settings.diffuseMaxFastAccumulatedFrameNum < settings.diffuseMaxAccumulatedFrameNum ? 1 : 0;
+    historyClampingConstants.gHistoryAccelerationAmount = float(settings.antilagSettings.accelerationAmount);
+    historyClampingConstants.gHistoryResetTemporalSigmaScale = float(settings.antilagSettings.temporalSigmaScale);
+    historyClampingConstants.gHistoryResetSpatialSigmaScale = float(settings.antilagSettings.spatialSigmaScale);
+    historyClampingConstants.gHistoryResetAmount = float(settings.antilagSettings.resetAmount);
+    PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_CLAMPING), historyClampingConstants);
 
     if (settings.enableAntiFirefly)
     {
         // COPY
-        data = PushDispatch(denoiserData, AsUint(Dispatch::COPY));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::COPY));
 
         // FIREFLY
-        data = PushDispatch(denoiserData, AsUint(Dispatch::FIREFLY));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::FIREFLY));
     }
 
     // A-TROUS
@@ -539,49 +542,52 @@ void nrd::InstanceImpl::Update_RelaxDiffuseSh(const DenoiserData& denoiserData)
                 dispatch = (i % 2 == 0) ? Dispatch::ATROUS_EVEN_WITH_CONFIDENCE_INPUTS : Dispatch::ATROUS_ODD_WITH_CONFIDENCE_INPUTS;
         }
 
-        data = PushDispatch(denoiserData, AsUint(dispatch));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-
         if (i == 0)
         {
-            AddUint2(data, screenW, screenH); // For Atrous_shmem
-            AddUint(data, settings.spatialVarianceEstimationHistoryThreshold);
+            RelaxDiffuseAtrousSmemConstants atrousSmemConstants = {};
+            atrousSmemConstants.gResourceSize = {screenW, screenH};
+            atrousSmemConstants.gHistoryThreshold = settings.spatialVarianceEstimationHistoryThreshold;
+            atrousSmemConstants.gDiffusePhiLuminance = settings.diffusePhiLuminance;
+            atrousSmemConstants.gMaxDiffuseLuminanceRelativeDifference = maxLuminanceRelativeDifference;
+            atrousSmemConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+            atrousSmemConstants.gDiffuseLobeAngleFraction = settings.diffuseLobeAngleFraction;
+            atrousSmemConstants.gStepSize = 1 << i;
+            atrousSmemConstants.gUseConfidenceInputs = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+            atrousSmemConstants.gConfidenceDrivenRelaxationMultiplier = settings.confidenceDrivenRelaxationMultiplier;
+            atrousSmemConstants.gConfidenceDrivenLuminanceEdgeStoppingRelaxation = settings.confidenceDrivenLuminanceEdgeStoppingRelaxation;
+            atrousSmemConstants.gConfidenceDrivenNormalEdgeStoppingRelaxation = settings.confidenceDrivenNormalEdgeStoppingRelaxation;
+            PushDispatch(denoiserData, AsUint(dispatch), atrousSmemConstants);
         }
-
-        AddFloat(data, settings.diffusePhiLuminance);
-        AddFloat(data, maxLuminanceRelativeDifference);
-        AddFloat(data, m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho);
-        AddFloat(data, settings.diffuseLobeAngleFraction);
-        AddUint(data, 1 << i);
-        AddUint(data, m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0);
-        AddFloat(data, settings.confidenceDrivenRelaxationMultiplier);
-        AddFloat(data, settings.confidenceDrivenLuminanceEdgeStoppingRelaxation);
-        AddFloat(data, settings.confidenceDrivenNormalEdgeStoppingRelaxation);
-        if (i != 0)
+        else
         {
-            AddUint(data, (i == iterationNum - 1) ? 1 : 0);
+            RelaxDiffuseShAtrousConstants atrousConstants = {};
+            atrousConstants.gDiffusePhiLuminance = settings.diffusePhiLuminance;
+            atrousConstants.gMaxDiffuseLuminanceRelativeDifference = maxLuminanceRelativeDifference;
+            atrousConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+            atrousConstants.gDiffuseLobeAngleFraction = settings.diffuseLobeAngleFraction;
+            atrousConstants.gStepSize = 1 << i;
+            atrousConstants.gUseConfidenceInputs = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+            atrousConstants.gConfidenceDrivenRelaxationMultiplier = settings.confidenceDrivenRelaxationMultiplier;
+            atrousConstants.gConfidenceDrivenLuminanceEdgeStoppingRelaxation = settings.confidenceDrivenLuminanceEdgeStoppingRelaxation;
+            atrousConstants.gConfidenceDrivenNormalEdgeStoppingRelaxation = settings.confidenceDrivenNormalEdgeStoppingRelaxation;
+            atrousConstants.gIsLastPass = (i == iterationNum - 1) ? 1 : 0;
+            PushDispatch(denoiserData, AsUint(dispatch), atrousConstants);
         }
-        ValidateConstants(data);
     }
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, diffuseCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
     }
 
     // VALIDATION
     if (m_CommonSettings.enableValidation)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE_SPECULAR);
-        AddFloat4x4(data, m_WorldToClipPrev);
-        AddFloat2(data, m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]);
-        AddFloat(data, (float)settings.diffuseMaxAccumulatedFrameNum);
-        ValidateConstants(data);
+        RelaxValidationConstants validationConstants = {};
+        validationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+        validationConstants.gJitter = {m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]};
+        validationConstants.gMaxAccumulatedFrameNum = (float)settings.diffuseMaxAccumulatedFrameNum;
+        PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION), validationConstants);
     }
 }
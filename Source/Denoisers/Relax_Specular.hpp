@@ -15,310 +15,318 @@ void nrd::InstanceImpl::Add_RelaxSpecular(DenoiserData& denoiserData)
     denoiserData.settings.specularRelax = RelaxSpecularSettings();
     denoiserData.settingsSize = sizeof(denoiserData.settings.specularRelax);
 
-    uint16_t w = denoiserData.desc.renderWidth;
-    uint16_t h = denoiserData.desc.renderHeight;
-    uint16_t tilesW = DivideUp(w, 16);
-    uint16_t tilesH = DivideUp(h, 16);
-
-    enum class Permanent
-    {
-        SPEC_ILLUM_PREV = PERMANENT_POOL_START,
-        SPEC_ILLUM_RESPONSIVE_PREV,
-        REFLECTION_HIT_T_CURR,
-        REFLECTION_HIT_T_PREV,
-        HISTORY_LENGTH_PREV,
-        NORMAL_ROUGHNESS_PREV,
-        MATERIAL_ID_PREV,
-        VIEWZ_PREV
-    };
-
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R16_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, w, h, 1} );
-    AddTextureToPermanentPool( {Format::RGBA8_UNORM, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, w, h, 1} );
-    AddTextureToPermanentPool( {Format::R32_SFLOAT, w, h, 1} );
-
-    enum class Transient
-    {
-        SPEC_ILLUM_PING = TRANSIENT_POOL_START,
-        SPEC_ILLUM_PONG,
-        SPEC_REPROJECTION_CONFIDENCE,
-        TILES,
-        HISTORY_LENGTH
-    };
-
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, w, h, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, w, h, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, tilesW, tilesH, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, w, h, 1} );
-
-    RELAX_SET_SHARED_CONSTANTS;
-
-    const uint32_t halfMaxPassNum = (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
-
-    PushPass("Classify tiles");
-    {
-        PushInput(AsUint(ResourceType::IN_VIEWZ));
-        PushOutput(AsUint(Transient::TILES));
-
-        AddDispatch(RELAX_ClassifyTiles, SumConstants(0, 0, 0, 1, false), NumThreads(16, 16), 1);
-    }
-
-    PushPass("Hit distance reconstruction"); // 3x3
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
-
-        AddDispatch( RELAX_Specular_HitDistReconstruction, SumConstants(0, 0, 0, 0), NumThreads(8, 8), 1 );
-    }
-
-    PushPass("Hit distance reconstruction"); // 5x5
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
-
-        AddDispatch( RELAX_Specular_HitDistReconstruction_5x5, SumConstants(0, 0, 0, 0), NumThreads(8, 8), 1 );
-    }
-
-    PushPass("Pre-pass"); // After hit distance reconstruction
+    struct Builder : GraphBuilder
     {
-        // Does preblur (if enabled) and checkerboard reconstruction (if enabled) and generates
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-
-        AddDispatch( RELAX_Specular_PrePass, SumConstants(0, 1, 0, 7), NumThreads(16, 16), 1 );
-    }
-
-    PushPass("Pre-pass"); // Without hit distance reconstruction
-    {
-        // Does preblur (if enabled) and checkerboard reconstruction (if enabled) and generates
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-
-        AddDispatch( RELAX_Specular_PrePass, SumConstants(0, 1, 0, 7), NumThreads(16, 16), 1 );
-    }
-
-    for (int i = 0; i < 4; i++)
-    {
-        // The following passes are defined here:
-        // REPROJECT,
-        // REPROJECT_WITH_CONFIDENCE_INPUTS,
-        // REPROJECT_WITH_THRESHOLD_MIX,
-        // REPROJECT_WITH_CONFIDENCE_INPUTS_WITH_THRESHOLD_MIX
-
-        PushPass("Temporal accumulation");
+        constexpr Builder()
         {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-            PushInput( AsUint(ResourceType::IN_MV) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
-            PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-            PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-            PushInput( AsUint(Permanent::VIEWZ_PREV) );
-            PushInput( AsUint(Permanent::REFLECTION_HIT_T_PREV), 0, 1, AsUint(Permanent::REFLECTION_HIT_T_CURR) );
-            PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
-            PushInput( AsUint(Permanent::MATERIAL_ID_PREV) );
-            // Confidence inputs:
-            if (i == 0)
+            enum class Permanent
             {
-                PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
-                PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
-            }
-            if (i == 1)
+                SPEC_ILLUM_PREV = PERMANENT_POOL_START,
+                SPEC_ILLUM_RESPONSIVE_PREV,
+                REFLECTION_HIT_T_CURR,
+                REFLECTION_HIT_T_PREV,
+                HISTORY_LENGTH_PREV,
+                NORMAL_ROUGHNESS_PREV,
+                NORMAL_ROUGHNESS_CURR,
+                MATERIAL_ID_PREV,
+                MATERIAL_ID_CURR,
+                VIEWZ_PREV,
+                VIEWZ_CURR
+            };
+
+            AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToPermanentPool( {Format::R16_SFLOAT, 1} );
+            AddTextureToPermanentPool( {Format::R16_SFLOAT, 1} );
+            AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
+            AddSharedTextureToPermanentPool( {RELAX_FORMAT_PREV_NORMAL_ROUGHNESS, 1}, GeometryHistory::RELAX_NORMAL_ROUGHNESS );
+            AddSharedTextureToPermanentPool( {RELAX_FORMAT_PREV_MATERIAL_ID, 1}, GeometryHistory::RELAX_MATERIAL_ID );
+            AddSharedTextureToPermanentPool( {RELAX_FORMAT_PREV_VIEWZ, 1, RELAX_FORMAT_PREV_VIEWZ_PACKED}, GeometryHistory::RELAX_VIEWZ );
+
+            enum class Transient
             {
-                PushInput( AsUint(ResourceType::IN_SPEC_CONFIDENCE) );
-                PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
-            }
-            if (i == 2)
+                SPEC_ILLUM_PING = TRANSIENT_POOL_START,
+                SPEC_ILLUM_PONG,
+                SPEC_REPROJECTION_CONFIDENCE,
+                TILES,
+                HISTORY_LENGTH,
+            };
+
+            AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+            AddTextureToTransientPool( {Format::R8_UNORM, 1} );
+            AddTextureToTransientPool( {Format::R8_UNORM, 16} );
+            AddTextureToTransientPool( {Format::R8_UNORM, 1} );
+
+            const uint32_t halfMaxPassNum = (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
+
+            PushPass("Classify tiles");
             {
-                PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
-                PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
+                PushInput(AsUint(ResourceType::IN_VIEWZ));
+                PushOutput(AsUint(Transient::TILES));
+
+                AddDispatch(ClassifyTiles, ConstantsOf<ClassifyTilesConstants>(false), NumThreads(16, 16), 1);
             }
-            if (i == 3)
+
+            PushPass("Hit distance reconstruction"); // 3x3
             {
-                PushInput( AsUint(ResourceType::IN_SPEC_CONFIDENCE) );
-                PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
-            }
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
-            PushOutput( AsUint(Permanent::REFLECTION_HIT_T_CURR), 0, 1, AsUint(Permanent::REFLECTION_HIT_T_PREV) );
-            PushOutput( AsUint(Transient::HISTORY_LENGTH) );
-            PushOutput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
 
-            AddDispatch( RELAX_Specular_TemporalAccumulation, SumConstants(0, 0, 0, 10), NumThreads(8, 8), 1 );
-        }
-    }
+                AddDispatch( RELAX_Specular_HitDistReconstruction, NoConstants(), NumThreads(8, 8), 1 );
+            }
 
-    PushPass("History fix");
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
+            PushPass("Hit distance reconstruction"); // 5x5
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
+                PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
 
-        AddDispatch( RELAX_Specular_HistoryFix, SumConstants(0, 0, 0, 8), NumThreads(8, 8), 1 );
-    }
+                AddDispatch( RELAX_Specular_HitDistReconstruction_5x5, NoConstants(), NumThreads(8, 8), 1 );
+            }
 
-    PushPass("History clamping");
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PONG) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
+            PushPass("Pre-pass"); // After hit distance reconstruction
+            {
+                // Does preblur (if enabled) and checkerboard reconstruction (if enabled) and generates
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
-        PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
 
-        AddDispatch( RELAX_Specular_HistoryClamping, SumConstants(0, 0, 0, 7), NumThreads(8, 8), 1 );
-    }
+                AddDispatch( RELAX_Specular_PrePass, ConstantsOf<RelaxSpecularPrePassConstants>(), NumThreads(16, 16), 1 );
+            }
 
-    PushPass("Copy");
-    {
-        PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-        PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+            PushPass("Pre-pass"); // Without hit distance reconstruction
+            {
+                // Does preblur (if enabled) and checkerboard reconstruction (if enabled) and generates
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        AddDispatch( RELAX_Specular_Copy, SumConstants(0, 0, 0, 0), NumThreads(8, 8), 1 );
-    }
+                PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
 
-    PushPass("Anti-firefly");
-    {
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                AddDispatch( RELAX_Specular_PrePass, ConstantsOf<RelaxSpecularPrePassConstants>(), NumThreads(16, 16), 1 );
+            }
 
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+            for (int i = 0; i < 4; i++)
+            {
+                // The following passes are defined here:
+                // REPROJECT,
+                // REPROJECT_WITH_CONFIDENCE_INPUTS,
+                // REPROJECT_WITH_THRESHOLD_MIX,
+                // REPROJECT_WITH_CONFIDENCE_INPUTS_WITH_THRESHOLD_MIX
+
+                PushPass("Temporal accumulation");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+                    PushInput( AsUint(ResourceType::IN_MV) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
+                    PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                    PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV), 0, 1, AsUint(Permanent::NORMAL_ROUGHNESS_CURR) );
+                    PushInput( AsUint(Permanent::VIEWZ_PREV), 0, 1, AsUint(Permanent::VIEWZ_CURR) );
+                    PushInput( AsUint(Permanent::REFLECTION_HIT_T_PREV), 0, 1, AsUint(Permanent::REFLECTION_HIT_T_CURR) );
+                    PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                    PushInput( AsUint(Permanent::MATERIAL_ID_PREV), 0, 1, AsUint(Permanent::MATERIAL_ID_CURR) );
+                    // Confidence inputs:
+                    if (i == 0)
+                    {
+                        PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
+                        PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
+                    }
+                    if (i == 1)
+                    {
+                        PushInput( AsUint(ResourceType::IN_SPEC_CONFIDENCE) );
+                        PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) ); // Bogus input that will not be fetched anyway
+                    }
+                    if (i == 2)
+                    {
+                        PushInput( AsUint(ResourceType::IN_VIEWZ) ); // Bogus input that will not be fetched anyway
+                        PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
+                    }
+                    if (i == 3)
+                    {
+                        PushInput( AsUint(ResourceType::IN_SPEC_CONFIDENCE) );
+                        PushInput( AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) );
+                    }
+
+                    PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
+                    PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
+                    PushOutput( AsUint(Permanent::REFLECTION_HIT_T_CURR), 0, 1, AsUint(Permanent::REFLECTION_HIT_T_PREV) );
+                    PushOutput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushOutput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+
+                    AddDispatch( RELAX_Specular_TemporalAccumulation, ConstantsOf<RelaxSpecularTemporalAccumulationConstants>(), NumThreads(8, 8), 1 );
+                }
+            }
 
-        AddDispatch( RELAX_Specular_AntiFirefly, SumConstants(0, 0, 0, 0), NumThreads(16, 16), 1 );
-    }
+            PushPass("History fix");
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
+                PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-    for (int i = 0; i < 2; i++)
-    {
-        bool withConfidenceInputs = (i == 1);
+                PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
 
-        // A-trous (first)
-        PushPass("A-trous (SMEM)");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
-
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
-            PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-            PushOutput( AsUint(Permanent::MATERIAL_ID_PREV) );
-            PushOutput( AsUint(Permanent::VIEWZ_PREV) );
-
-            AddDispatch( RELAX_Specular_AtrousSmem, SumConstants(0, 0, 1, 17), NumThreads(8, 8), 1 );
-        }
+                AddDispatch( RELAX_Specular_HistoryFix, ConstantsOf<RelaxSpecularHistoryFixConstants>(), NumThreads(8, 8), 1 );
+            }
 
-        // A-trous (odd)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+            PushPass("History clamping");
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+                PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
+                PushInput( AsUint(Transient::SPEC_ILLUM_PONG) );
+                PushInput( AsUint(Transient::HISTORY_LENGTH) );
 
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
+                PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                PushOutput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
+                PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
 
-            AddDispatchRepeated( RELAX_Specular_Atrous, SumConstants(0, 0, 0, 16), NumThreads(16, 16), 1, halfMaxPassNum );
-        }
+                AddDispatch( RELAX_Specular_HistoryClamping, ConstantsOf<RelaxSpecularHistoryClampingConstants>(), NumThreads(8, 8), 1 );
+            }
 
-        // A-trous (even)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::SPEC_ILLUM_PONG) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+            PushPass("Copy");
+            {
+                PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
 
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
+                AddDispatch( RELAX_Specular_Copy, NoConstants(), NumThreads(8, 8), 1 );
+            }
 
-            AddDispatchRepeated( RELAX_Specular_Atrous, SumConstants(0, 0, 0, 16), NumThreads(16, 16), 1, halfMaxPassNum );
-        }
+            PushPass("Anti-firefly");
+            {
+                PushInput( AsUint(Transient::TILES) );
+                PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        // A-trous (odd, last)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+                PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
 
-            PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+                AddDispatch( RELAX_Specular_AntiFirefly, NoConstants(), NumThreads(16, 16), 1 );
+            }
 
-            AddDispatch( RELAX_Specular_Atrous, SumConstants(0, 0, 0, 16), NumThreads(16, 16), 1 );
-        }
+            for (int i = 0; i < 2; i++)
+            {
+                bool withConfidenceInputs = (i == 1);
+
+                // A-trous (first)
+                PushPass("A-trous (SMEM)");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+
+                    PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
+                    PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_CURR), 0, 1, AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
+                    PushOutput( AsUint(Permanent::MATERIAL_ID_CURR), 0, 1, AsUint(Permanent::MATERIAL_ID_PREV) );
+                    PushOutput( AsUint(Permanent::VIEWZ_CURR), 0, 1, AsUint(Permanent::VIEWZ_PREV) );
+
+                    AddDispatch( RELAX_Specular_AtrousSmem, ConstantsOf<RelaxSpecularAtrousSmemConstants>(), NumThreads(8, 8), 1 );
+                }
+
+                // A-trous (odd)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+
+                    PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
+
+                    AddDispatchRepeated( RELAX_Specular_Atrous, ConstantsOf<RelaxSpecularAtrousConstants>(), NumThreads(16, 16), 1, halfMaxPassNum );
+                }
+
+                // A-trous (even)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::SPEC_ILLUM_PONG) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+
+                    PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
+
+                    AddDispatchRepeated( RELAX_Specular_Atrous, ConstantsOf<RelaxSpecularAtrousConstants>(), NumThreads(16, 16), 1, halfMaxPassNum );
+                }
+
+                // A-trous (odd, last)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::SPEC_ILLUM_PING) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+
+                    PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+
+                    AddDispatch( RELAX_Specular_Atrous, ConstantsOf<RelaxSpecularAtrousConstants>(), NumThreads(16, 16), 1 );
+                }
+
+                // A-trous (even, last)
+                PushPass("A-trous");
+                {
+                    PushInput( AsUint(Transient::TILES) );
+                    PushInput( AsUint(Transient::SPEC_ILLUM_PONG) );
+                    PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                    PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+
+                    PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+
+                    AddDispatch( RELAX_Specular_Atrous, ConstantsOf<RelaxSpecularAtrousConstants>(), NumThreads(16, 16), 1 );
+                }
+            }
 
-        // A-trous (even, last)
-        PushPass("A-trous");
-        {
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(Transient::SPEC_ILLUM_PONG) );
-            PushInput( AsUint(Transient::HISTORY_LENGTH) );
-            PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( withConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : AsUint(ResourceType::IN_VIEWZ) );
+            PushPass("Split screen");
+            {
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST));
 
-            PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+                PushOutput( AsUint( ResourceType::OUT_SPEC_RADIANCE_HITDIST ) );
 
-            AddDispatch( RELAX_Specular_Atrous, SumConstants(0, 0, 0, 16), NumThreads(16, 16), 1 );
-        }
-    }
+                AddDispatch( RELAX_Specular_SplitScreen, ConstantsOf<RelaxSpecularSplitScreenConstants>(), NumThreads(16, 16), 1 );
+            }
 
-    PushPass("Split screen");
-    {
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST));
+            RELAX_ADD_VALIDATION_DISPATCH;
+        }
+    };
 
-        PushOutput( AsUint( ResourceType::OUT_SPEC_RADIANCE_HITDIST ) );
+    NRD_DECLARE_GRAPH(graph, Builder);
 
-        AddDispatch( RELAX_Specular_SplitScreen, SumConstants(0, 0, 0, 2), NumThreads(16, 16), 1 );
-    }
+    RELAX_SET_SHARED_CONSTANTS;
 
-    RELAX_ADD_VALIDATION_DISPATCH;
+    AddGraph(denoiserData, graph);
 
     #undef DENOISER_NAME
 }
@@ -396,111 +404,107 @@ void nrd::InstanceImpl::Update_RelaxSpecular(const DenoiserData& denoiserData)
         break;
     }
 
+    // Shared constants (once per frame)
+    PushSharedConstants_Relax(denoiserData, denoiserData.desc.denoiser);
+
+    RelaxSpecularSplitScreenConstants splitScreenConstants = {};
+    splitScreenConstants.gSplitScreen = m_CommonSettings.splitScreen;
+    splitScreenConstants.gSpecCheckerboard = specularCheckerboard;
+
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, specularCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
 
         return;
     }
 
     // CLASSIFY_TILES
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    ValidateConstants(data);
+    ClassifyTilesConstants classifyTilesConstants = {};
+    classifyTilesConstants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES), classifyTilesConstants);
 
     // HITDIST_RECONSTRUCTION
     if (enableHitDistanceReconstruction)
     {
         bool is3x3 = settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_3X3;
-        data = PushDispatch(denoiserData, is3x3 ? AsUint(Dispatch::HITDIST_RECONSTRUCTION_3x3) : AsUint(Dispatch::HITDIST_RECONSTRUCTION_5x5));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, is3x3 ? AsUint(Dispatch::HITDIST_RECONSTRUCTION_3x3) : AsUint(Dispatch::HITDIST_RECONSTRUCTION_5x5));
     }
 
     // PREPASS
-    data = PushDispatch(denoiserData, AsUint(enableHitDistanceReconstruction ? Dispatch::PREPASS_AFTER_HITDIST_RECONSTRUCTION : Dispatch::PREPASS));
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-    AddFloat4(data, m_Rotator_PrePass);
-    AddUint(data, specularCheckerboard);
-    AddFloat(data, settings.prepassBlurRadius);
-    AddFloat(data, 1.0f);
-    AddFloat(data, m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho);
-    AddFloat(data, settings.specularLobeAngleFraction);
-    AddFloat(data, settings.specularLobeAngleSlack);
-    AddFloat(data, settings.roughnessFraction);
-    ValidateConstants(data);
+    RelaxSpecularPrePassConstants prePassConstants = {};
+    prePassConstants.gRotator = cb::AsFloat4(m_Rotator_PrePass);
+    prePassConstants.gSpecularCheckerboard = specularCheckerboard;
+    prePassConstants.gSpecularBlurRadius = settings.prepassBlurRadius;
+    prePassConstants.gMeterToUnitsMultiplier = 1.0f;
+    prePassConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+    prePassConstants.gSpecularLobeAngleFraction = settings.specularLobeAngleFraction;
+    prePassConstants.gSpecularLobeAngleSlack = settings.specularLobeAngleSlack;
+    prePassConstants.gRoughnessFraction = settings.roughnessFraction;
+    PushDispatch(denoiserData, AsUint(enableHitDistanceReconstruction ? Dispatch::PREPASS_AFTER_HITDIST_RECONSTRUCTION : Dispatch::PREPASS), prePassConstants);
 
     // TEMPORAL_ACCUMULATION
+    RelaxSpecularTemporalAccumulationConstants temporalAccumulationConstants = {};
+    temporalAccumulationConstants.gSpecularMaxAccumulatedFrameNum = (float)settings.specularMaxAccumulatedFrameNum;
+    temporalAccumulationConstants.gSpecularMaxFastAccumulatedFrameNum = (float)settings.specularMaxFastAccumulatedFrameNum;
+    temporalAccumulationConstants.gSpecCheckerboard = specularCheckerboard;
+    temporalAccumulationConstants.gDisocclusionDepthThreshold = m_IsOrtho == 0 ? disocclusionThreshold : disocclusionThresholdOrtho;
+    temporalAccumulationConstants.gDisocclusionDepthThresholdAlternate = m_IsOrtho == 0 ? disocclusionThresholdAlternate : disocclusionThresholdAlternateOrtho;
+    temporalAccumulationConstants.gRoughnessFraction = settings.roughnessFraction;
+    temporalAccumulationConstants.gSpecularVarianceBoost = settings.specularVarianceBoost;
+    temporalAccumulationConstants.gSkipReprojectionTestWithoutMotion = settings.enableReprojectionTestSkippingWithoutMotion && isCameraStatic;
+    temporalAccumulationConstants.gUseConfidenceInputs = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+    temporalAccumulationConstants.gUseDisocclusionThresholdMix = m_CommonSettings.isDisocclusionThresholdMixAvailable ? 1 : 0;
+
     if (!m_CommonSettings.isDisocclusionThresholdMixAvailable)
     {
-        data = PushDispatch(
+        PushDispatch(
             denoiserData,
             AsUint(m_CommonSettings.isHistoryConfidenceAvailable ?
                 Dispatch::TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS :
-                Dispatch::TEMPORAL_ACCUMULATION));
+                Dispatch::TEMPORAL_ACCUMULATION),
+            temporalAccumulationConstants);
     }
     else
     {
-        data = PushDispatch(
+        PushDispatch(
             denoiserData,
             AsUint(m_CommonSettings.isHistoryConfidenceAvailable ?
                 Dispatch::TEMPORAL_ACCUMULATION_WITH_CONFIDENCE_INPUTS_WITH_THRESHOLD_MIX :
-                Dispatch::TEMPORAL_ACCUMULATION_WITH_THRESHOLD_MIX));
+                Dispatch::TEMPORAL_ACCUMULATION_WITH_THRESHOLD_MIX),
+            temporalAccumulationConstants);
     }
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-    AddFloat(data, (float)settings.specularMaxAccumulatedFrameNum);
-    AddFloat(data, (float)settings.specularMaxFastAccumulatedFrameNum);
-    AddUint(data, specularCheckerboard);
-    AddFloat(data, m_IsOrtho == 0 ? disocclusionThreshold : disocclusionThresholdOrtho);
-    AddFloat(data, m_IsOrtho == 0 ? disocclusionThresholdAlternate : disocclusionThresholdAlternateOrtho);
-    AddFloat(data, settings.roughnessFraction);
-    AddFloat(data, settings.specularVarianceBoost);
-    AddUint(data, settings.enableReprojectionTestSkippingWithoutMotion && isCameraStatic);
-    AddUint(data, m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0);
-    AddUint(data, m_CommonSettings.isDisocclusionThresholdMixAvailable ? 1 : 0);
-    ValidateConstants(data);
 
     // HISTORY_FIX
-    data = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX));
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-    AddFloat(data, m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho);
-    AddFloat(data, settings.historyFixEdgeStoppingNormalPower);
-    AddFloat(data, settings.historyFixStrideBetweenSamples);
-    AddFloat(data, float(settings.historyFixFrameNum));
-    AddFloat(data, settings.specularLobeAngleFraction);
-    AddFloat(data, ml::DegToRad(settings.specularLobeAngleSlack));
-    AddFloat(data, settings.roughnessEdgeStoppingRelaxation);
-    AddFloat(data, settings.normalEdgeStoppingRelaxation);
-    ValidateConstants(data);
+    RelaxSpecularHistoryFixConstants historyFixConstants = {};
+    historyFixConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+    historyFixConstants.gHistoryFixEdgeStoppingNormalPower = settings.historyFixEdgeStoppingNormalPower;
+    historyFixConstants.gHistoryFixStrideBetweenSamples = settings.historyFixStrideBetweenSamples;
+    historyFixConstants.gHistoryFixFrameNum = float(settings.historyFixFrameNum);
+    historyFixConstants.gSpecularLobeAngleFraction = settings.specularLobeAngleFraction;
+    historyFixConstants.gSpecularLobeAngleSlack = ml::DegToRad(settings.specularLobeAngleSlack);
+    historyFixConstants.gRoughnessEdgeStoppingRelaxation = settings.roughnessEdgeStoppingRelaxation;
+    historyFixConstants.gNormalEdgeStoppingRelaxation = settings.normalEdgeStoppingRelaxation;
+    PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX), historyFixConstants);
 
     // HISTORY_CLAMPING
-    data = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_CLAMPING));
-    AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-    AddFloat(data, settings.historyClampingColorBoxSigmaScale);
-    AddFloat(data, float(settings.historyFixFrameNum));
-    AddUint(data, settings.specularMaxFastAccumulatedFrameNum < settings.specularMaxAccumulatedFrameNum ? 1 : 0);
-    AddFloat(data, float(settings.antilagSettings.accelerationAmount));
-    AddFloat(data, float(settings.antilagSettings.temporalSigmaScale));
-    AddFloat(data, float(settings.antilagSettings.spatialSigmaScale));
-    AddFloat(data, float(settings.antilagSettings.resetAmount));
-    ValidateConstants(data);
+    RelaxSpecularHistoryClampingConstants historyClampingConstants = {};
+    historyClampingConstants.gColorBoxSigmaScale = settings.historyClampingColorBoxSigmaScale;
+    historyClampingConstants.gHistoryFixFrameNum = float(settings.historyFixFrameNum);
+    historyClampingConstants.gSpecFastHistory = settings.specularMaxFastAccumulatedFrameNum < settings.specularMaxAccumulatedFrameNum ? 1 : 0;
+    historyClampingConstants.gHistoryAccelerationAmount = float(settings.antilagSettings.accelerationAmount);
+    historyClampingConstants.gHistoryResetTemporalSigmaScale = float(settings.antilagSettings.temporalSigmaScale);
+    historyClampingConstants.gHistoryResetSpatialSigmaScale = float(settings.antilagSettings.spatialSigmaScale);
+    historyClampingConstants.gHistoryResetAmount = float(settings.antilagSettings.resetAmount);
+    PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_CLAMPING), historyClampingConstants);
 
     if (settings.enableAntiFirefly)
     {
         // COPY
-        data = PushDispatch(denoiserData, AsUint(Dispatch::COPY));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::COPY));
 
         // FIREFLY
-        data = PushDispatch(denoiserData, AsUint(Dispatch::FIREFLY));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::FIREFLY));
     }
 
 
@@ -528,52 +532,65 @@ void nrd::InstanceImpl::Update_RelaxSpecular(const DenoiserData& denoiserData)
                 dispatch = (i % 2 == 0) ? Dispatch::ATROUS_EVEN_WITH_CONFIDENCE_INPUTS : Dispatch::ATROUS_ODD_WITH_CONFIDENCE_INPUTS;
         }
 
-        data = PushDispatch(denoiserData, AsUint(dispatch));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-
         if (i == 0)
         {
-            AddUint2(data, screenW, screenH); // For Atrous_shmem
-            AddUint(data, settings.spatialVarianceEstimationHistoryThreshold);
+            RelaxSpecularAtrousSmemConstants atrousSmemConstants = {};
+            atrousSmemConstants.gResourceSize = {screenW, screenH};
+            atrousSmemConstants.gHistoryThreshold = settings.spatialVarianceEstimationHistoryThreshold;
+            atrousSmemConstants.gSpecularPhiLuminance = settings.specularPhiLuminance;
+            atrousSmemConstants.gMaxSpecularLuminanceRelativeDifference = maxLuminanceRelativeDifference;
+            atrousSmemConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+            atrousSmemConstants.gDiffuseLobeAngleFraction = settings.diffuseLobeAngleFraction;
+            atrousSmemConstants.gRoughnessFraction = settings.roughnessFraction;
+            atrousSmemConstants.gSpecularLobeAngleFraction = settings.specularLobeAngleFraction;
+            atrousSmemConstants.gSpecularLobeAngleSlack = ml::DegToRad(settings.specularLobeAngleSlack);
+            atrousSmemConstants.gStepSize = 1 << i;
+            atrousSmemConstants.gRoughnessEdgeStoppingEnabled = settings.enableRoughnessEdgeStopping;
+            atrousSmemConstants.gRoughnessEdgeStoppingRelaxation = settings.roughnessEdgeStoppingRelaxation;
+            atrousSmemConstants.gNormalEdgeStoppingRelaxation = settings.normalEdgeStoppingRelaxation;
+            atrousSmemConstants.gLuminanceEdgeStoppingRelaxation = settings.luminanceEdgeStoppingRelaxation;
+            atrousSmemConstants.gUseConfidenceInputs = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+            atrousSmemConstants.gConfidenceDrivenRelaxationMultiplier = settings.confidenceDrivenRelaxationMultiplier;
+            atrousSmemConstants.gConfidenceDrivenLuminanceEdgeStoppingRelaxation = settings.confidenceDrivenLuminanceEdgeStoppingRelaxation;
+            atrousSmemConstants.gConfidenceDrivenNormalEdgeStoppingRelaxation = settings.confidenceDrivenNormalEdgeStoppingRelaxation;
+            PushDispatch(denoiserData, AsUint(dispatch), atrousSmemConstants);
+        }
+        else
+        {
+            RelaxSpecularAtrousConstants atrousConstants = {};
+            atrousConstants.gSpecularPhiLuminance = settings.specularPhiLuminance;
+            atrousConstants.gMaxSpecularLuminanceRelativeDifference = maxLuminanceRelativeDifference;
+            atrousConstants.gDepthThreshold = m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho;
+            atrousConstants.gDiffuseLobeAngleFraction = settings.diffuseLobeAngleFraction;
+            atrousConstants.gRoughnessFraction = settings.roughnessFraction;
+            atrousConstants.gSpecularLobeAngleFraction = settings.specularLobeAngleFraction;
+            atrousConstants.gSpecularLobeAngleSlack = ml::DegToRad(settings.specularLobeAngleSlack);
+            atrousConstants.gStepSize = 1 << i;
+            atrousConstants.gRoughnessEdgeStoppingEnabled = settings.enableRoughnessEdgeStopping;
+            atrousConstants.gRoughnessEdgeStoppingRelaxation = settings.roughnessEdgeStoppingRelaxation;
+            atrousConstants.gNormalEdgeStoppingRelaxation = settings.normalEdgeStoppingRelaxation;
+            atrousConstants.gLuminanceEdgeStoppingRelaxation = settings.luminanceEdgeStoppingRelaxation;
+            atrousConstants.gUseConfidenceInputs = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+            atrousConstants.gConfidenceDrivenRelaxationMultiplier = settings.confidenceDrivenRelaxationMultiplier;
+            atrousConstants.gConfidenceDrivenLuminanceEdgeStoppingRelaxation = settings.confidenceDrivenLuminanceEdgeStoppingRelaxation;
+            atrousConstants.gConfidenceDrivenNormalEdgeStoppingRelaxation = settings.confidenceDrivenNormalEdgeStoppingRelaxation;
+            PushDispatch(denoiserData, AsUint(dispatch), atrousConstants);
         }
-
-        AddFloat(data, settings.specularPhiLuminance);
-        AddFloat(data, maxLuminanceRelativeDifference);
-        AddFloat(data, m_IsOrtho == 0 ? settings.depthThreshold : depthThresholdOrtho);
-        AddFloat(data, settings.diffuseLobeAngleFraction);
-        AddFloat(data, settings.roughnessFraction);
-        AddFloat(data, settings.specularLobeAngleFraction);
-        AddFloat(data, ml::DegToRad(settings.specularLobeAngleSlack));
-        AddUint(data, 1 << i);
-        AddUint(data, settings.enableRoughnessEdgeStopping);
-        AddFloat(data, settings.roughnessEdgeStoppingRelaxation);
-        AddFloat(data, settings.normalEdgeStoppingRelaxation);
-        AddFloat(data, settings.luminanceEdgeStoppingRelaxation);
-        AddUint(data, m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0);
-        AddFloat(data, settings.confidenceDrivenRelaxationMultiplier);
-        AddFloat(data, settings.confidenceDrivenLuminanceEdgeStoppingRelaxation);
-        AddFloat(data, settings.confidenceDrivenNormalEdgeStoppingRelaxation);
-        ValidateConstants(data);
     }
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_SPECULAR);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, specularCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
     }
 
     // VALIDATION
     if (m_CommonSettings.enableValidation)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
-        AddSharedConstants_Relax(denoiserData, data, Denoiser::RELAX_DIFFUSE_SPECULAR);
-        AddFloat4x4(data, m_WorldToClipPrev);
-        AddFloat2(data, m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]);
-        AddFloat(data, (float)settings.specularMaxAccumulatedFrameNum);
-        ValidateConstants(data);
+        RelaxValidationConstants validationConstants = {};
+        validationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+        validationConstants.gJitter = {m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]};
+        validationConstants.gMaxAccumulatedFrameNum = (float)settings.specularMaxAccumulatedFrameNum;
+        PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION), validationConstants);
     }
 }
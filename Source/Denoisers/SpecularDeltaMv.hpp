@@ -14,33 +14,40 @@ void nrd::InstanceImpl::Add_SpecularDeltaMv(DenoiserData& denoiserData)
 
     denoiserData.settings.specularDeltaMv = SpecularDeltaMvSettings();
     denoiserData.settingsSize = sizeof(denoiserData.settings.specularDeltaMv);
-            
-    uint16_t w = denoiserData.desc.renderWidth;
-    uint16_t h = denoiserData.desc.renderHeight;
 
-    enum class Permanent
+    struct Builder : GraphBuilder
     {
-        DELTA_SECONDARY_POS_CURR = PERMANENT_POOL_START,
-        DELTA_SECONDARY_POS_PREV
-    };
+        constexpr Builder()
+        {
+            enum class Permanent
+            {
+                DELTA_SECONDARY_POS_CURR = PERMANENT_POOL_START,
+                DELTA_SECONDARY_POS_PREV
+            };
 
-    AddTextureToPermanentPool( {Format::RGBA32_SFLOAT, w, h, 1} );
-    AddTextureToPermanentPool( {Format::RGBA32_SFLOAT, w, h, 1} );
+            AddTextureToPermanentPool( {Format::RGBA32_SFLOAT, 1} );
+            AddTextureToPermanentPool( {Format::RGBA32_SFLOAT, 1} );
 
-    SetSharedConstants(0, 0, 0, 0);
+            PushPass("Compute");
+            {
+                PushInput( AsUint(ResourceType::IN_MV) );
+                PushInput( AsUint(ResourceType::IN_DELTA_PRIMARY_POS) );
+                PushInput( AsUint(ResourceType::IN_DELTA_SECONDARY_POS) );
+                PushInput( AsUint(Permanent::DELTA_SECONDARY_POS_PREV), 0, 1, AsUint(Permanent::DELTA_SECONDARY_POS_CURR) );
 
-    PushPass("Compute");
-    {
-        PushInput( AsUint(ResourceType::IN_MV) );
-        PushInput( AsUint(ResourceType::IN_DELTA_PRIMARY_POS) );
-        PushInput( AsUint(ResourceType::IN_DELTA_SECONDARY_POS) );
-        PushInput( AsUint(Permanent::DELTA_SECONDARY_POS_PREV), 0, 1, AsUint(Permanent::DELTA_SECONDARY_POS_CURR) );
+                PushOutput( AsUint(ResourceType::OUT_DELTA_MV) );
+                PushOutput( AsUint(Permanent::DELTA_SECONDARY_POS_CURR), 0, 1, AsUint(Permanent::DELTA_SECONDARY_POS_PREV) );
+
+                AddDispatch( SpecularDeltaMv_Compute, ConstantsOf<SpecularDeltaMvConstants>(), NumThreads(16, 16), 1 );
+            }
+        }
+    };
+
+    NRD_DECLARE_GRAPH(graph, Builder);
 
-        PushOutput( AsUint(ResourceType::OUT_DELTA_MV) );
-        PushOutput( AsUint(Permanent::DELTA_SECONDARY_POS_CURR), 0, 1, AsUint(Permanent::DELTA_SECONDARY_POS_PREV) );
+    SetSharedConstants(0);
 
-        AddDispatch( SpecularDeltaMv_Compute, SumConstants(1, 1, 3, 1), NumThreads(16, 16), 1 );
-    }
+    AddGraph(denoiserData, graph);
 
     #undef DENOISER_NAME
 }
@@ -55,12 +62,13 @@ void nrd::InstanceImpl::Update_SpecularDeltaMv(const DenoiserData& denoiserData)
     NRD_DECLARE_DIMS;
 
     // COMPUTE
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::COMPUTE));
-    AddFloat4x4(data, m_WorldToClipPrev);
-    AddFloat4(data, ml::float4(m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2], m_CommonSettings.debug));
-    AddUint2(data, rectW, rectH);
-    AddFloat2(data, 1.0f / float(rectW), 1.0f / float(rectH));
-    AddUint2(data, m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]);
-    AddUint(data, m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0);
-    ValidateConstants(data);
+    SpecularDeltaMvConstants constants = {};
+    constants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+    constants.gMvScale = {m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2]};
+    constants.gDebug = m_CommonSettings.debug;
+    constants.gRectSize = {rectW, rectH};
+    constants.gInvRectSize = {1.0f / float(rectW), 1.0f / float(rectH)};
+    constants.gRectOrigin = {m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]};
+    constants.gIsWorldSpaceMotionEnabled = m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0;
+    PushDispatch(denoiserData, AsUint(Dispatch::COMPUTE), constants);
 }
@@ -14,20 +14,30 @@ void nrd::InstanceImpl::Add_SpecularReflectionMv(DenoiserData& denoiserData)
 
     denoiserData.settings.specularReflectionMv = SpecularReflectionMvSettings();
     denoiserData.settingsSize = sizeof(denoiserData.settings.specularReflectionMv);
-            
-    SetSharedConstants(0, 0, 0, 0);
 
-    PushPass("Compute");
+    struct Builder : GraphBuilder
     {
-        PushInput( AsUint(ResourceType::IN_MV) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_SPEC_HITDIST) );
+        constexpr Builder()
+        {
+            PushPass("Compute");
+            {
+                PushInput( AsUint(ResourceType::IN_MV) );
+                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                PushInput( AsUint(ResourceType::IN_SPEC_HITDIST) );
 
-        PushOutput( AsUint(ResourceType::OUT_REFLECTION_MV) );
+                PushOutput( AsUint(ResourceType::OUT_REFLECTION_MV) );
 
-        AddDispatch( SpecularReflectionMv_Compute, SumConstants(4, 5, 5, 2), NumThreads(16, 16), 1 );
-    }
+                AddDispatch( SpecularReflectionMv_Compute, ConstantsOf<SpecularReflectionMvConstants>(), NumThreads(16, 16), 1 );
+            }
+        }
+    };
+
+    NRD_DECLARE_GRAPH(graph, Builder);
+
+    SetSharedConstants(0);
+
+    AddGraph(denoiserData, graph);
 
     #undef DENOISER_NAME
 }
@@ -45,22 +55,25 @@ void nrd::InstanceImpl::Update_SpecularReflectionMv(const DenoiserData& denoiser
     float unproject = 1.0f / (0.5f * rectH * m_ProjectY);
 
     // COMPUTE
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::COMPUTE));
-    AddFloat4x4(data, m_ViewToWorld);
-    AddFloat4x4(data, m_WorldToClip);
-    AddFloat4x4(data, m_WorldToClipPrev);
-    AddFloat4x4(data, m_WorldToViewPrev);
-    AddFloat4(data, m_FrustumPrev);
-    AddFloat4(data, m_Frustum);
-    AddFloat4(data, ml::float4(m_ViewDirection.x, m_ViewDirection.y, m_ViewDirection.z, m_IsOrtho));
-    AddFloat4(data, ml::float4(m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z, unproject));
-    AddFloat4(data, ml::float4(m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2], m_CommonSettings.debug));
-    AddFloat2(data, float(rectW), float(rectH));
-    AddFloat2(data, 1.0f / float(rectW), 1.0f / float(rectH));
-    AddFloat2(data, float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH));
-    AddFloat2(data, float(rectW) / float(screenW), float(rectH) / float(screenH));
-    AddUint2(data, m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]);
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    AddUint(data, m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0);
-    ValidateConstants(data);
+    SpecularReflectionMvConstants constants = {};
+    constants.gViewToWorld = cb::AsFloat4x4(m_ViewToWorld);
+    constants.gWorldToClip = cb::AsFloat4x4(m_WorldToClip);
+    constants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+    constants.gWorldToViewPrev = cb::AsFloat4x4(m_WorldToViewPrev);
+    constants.gFrustumPrev = cb::AsFloat4(m_FrustumPrev);
+    constants.gFrustum = cb::AsFloat4(m_Frustum);
+    constants.gViewVectorWorld = {m_ViewDirection.x, m_ViewDirection.y, m_ViewDirection.z};
+    constants.gOrthoMode = m_IsOrtho;
+    constants.gCameraDelta = {m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z};
+    constants.gUnproject = unproject;
+    constants.gMvScale = {m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2]};
+    constants.gDebug = m_CommonSettings.debug;
+    constants.gRectSize = {float(rectW), float(rectH)};
+    constants.gInvRectSize = {1.0f / float(rectW), 1.0f / float(rectH)};
+    constants.gRectOffset = {float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH)};
+    constants.gResolutionScale = {float(rectW) / float(screenW), float(rectH) / float(screenH)};
+    constants.gRectOrigin = {m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]};
+    constants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    constants.gIsWorldSpaceMotionEnabled = m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0;
+    PushDispatch(denoiserData, AsUint(Dispatch::COMPUTE), constants);
 }
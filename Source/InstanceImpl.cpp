@@ -12,6 +12,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "InstanceImpl.h"
 
 #include <array>
+#include <algorithm>
 
 constexpr std::array<nrd::Sampler, (size_t)nrd::Sampler::MAX_NUM> g_Samplers =
 {
@@ -69,6 +70,56 @@ constexpr std::array<bool, (size_t)nrd::Format::MAX_NUM> g_IsIntegerFormat =
     false,        // R9_G9_B9_E5_UFLOAT
 };
 
+constexpr std::array<uint8_t, (size_t)nrd::Format::MAX_NUM> g_BytesPerPixel =
+{
+    1,            // R8_UNORM
+    1,            // R8_SNORM
+    1,            // R8_UINT
+    1,            // R8_SINT
+    2,            // RG8_UNORM
+    2,            // RG8_SNORM
+    2,            // RG8_UINT
+    2,            // RG8_SINT
+    4,            // RGBA8_UNORM
+    4,            // RGBA8_SNORM
+    4,            // RGBA8_UINT
+    4,            // RGBA8_SINT
+    4,            // RGBA8_SRGB
+    2,            // R16_UNORM
+    2,            // R16_SNORM
+    2,            // R16_UINT
+    2,            // R16_SINT
+    2,            // R16_SFLOAT
+    4,            // RG16_UNORM
+    4,            // RG16_SNORM
+    4,            // RG16_UINT
+    4,            // RG16_SINT
+    4,            // RG16_SFLOAT
+    8,            // RGBA16_UNORM
+    8,            // RGBA16_SNORM
+    8,            // RGBA16_UINT
+    8,            // RGBA16_SINT
+    8,            // RGBA16_SFLOAT
+    4,            // R32_UINT
+    4,            // R32_SINT
+    4,            // R32_SFLOAT
+    8,            // RG32_UINT
+    8,            // RG32_SINT
+    8,            // RG32_SFLOAT
+    12,           // RGB32_UINT
+    12,           // RGB32_SINT
+    12,           // RGB32_SFLOAT
+    16,           // RGBA32_UINT
+    16,           // RGBA32_SINT
+    16,           // RGBA32_SFLOAT
+    4,            // R10_G10_B10_A2_UNORM
+    4,            // R10_G10_B10_A2_UINT
+    4,            // R11_G11_B10_UFLOAT
+    4,            // R9_G9_B9_E5_UFLOAT
+};
+
+constexpr uint64_t ALIASING_ALIGNMENT = 64 * 1024;
+
 #ifdef NRD_EMBEDS_DXBC_SHADERS
     #include "Clear_f.cs.dxbc.h"
     #include "Clear_ui.cs.dxbc.h"
@@ -84,6 +135,101 @@ constexpr std::array<bool, (size_t)nrd::Format::MAX_NUM> g_IsIntegerFormat =
     #include "Clear_ui.cs.spirv.h"
 #endif
 
+inline uint64_t EstimateTextureSize(const nrd::TextureDesc& textureDesc)
+{
+    uint64_t size = 0;
+    for (uint16_t mip = 0; mip < textureDesc.mipNum; mip++)
+    {
+        uint64_t w = std::max(textureDesc.width >> mip, 1);
+        uint64_t h = std::max(textureDesc.height >> mip, 1);
+
+        size += w * h * g_BytesPerPixel[(size_t)textureDesc.format];
+    }
+
+    return (size + ALIASING_ALIGNMENT - 1) & ~(ALIASING_ALIGNMENT - 1);
+}
+
+// Denoisers of the same family store geometry history identically, i.e. it can be shared
+inline uint32_t GetGeometryHistoryFamily(nrd::Denoiser denoiser)
+{
+    if (denoiser >= nrd::Denoiser::REBLUR_DIFFUSE && denoiser <= nrd::Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
+        return 1;
+
+    if (denoiser >= nrd::Denoiser::RELAX_DIFFUSE && denoiser <= nrd::Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
+        return 2;
+
+    return 0;
+}
+
+inline uint64_t GetClearResourceKey(uint32_t viewIndex, const nrd::ResourceDesc& resource)
+{
+    // Only STORAGE resources get cleared
+    return (uint64_t(viewIndex) << 48) | (uint64_t(resource.type) << 32) | (uint64_t(resource.indexInPool) << 16) | (uint64_t(resource.mipOffset) << 8) | uint64_t(resource.mipNum);
+}
+
+inline bool IsClearBatchable(const nrd::ClearResource& a, const nrd::ClearResource& b)
+{
+    return a.viewIndex == b.viewIndex && a.isInteger == b.isInteger && a.w == b.w && a.h == b.h;
+}
+
+inline uint32_t GetClearBatchesNum(const nrd::ClearResource* clearResources, size_t clearResourcesNum)
+{
+    uint32_t batchesNum = 0;
+    uint32_t batchSize = 0;
+
+    for (size_t i = 0; i < clearResourcesNum; i++)
+    {
+        if (!batchSize || batchSize == nrd::CLEAR_RESOURCES_MAX_NUM || !IsClearBatchable(clearResources[i - 1], clearResources[i]))
+        {
+            batchesNum++;
+            batchSize = 0;
+        }
+
+        batchSize++;
+    }
+
+    return batchesNum;
+}
+
+inline uint32_t GetBranchingFlags(const nrd::CommonSettings& commonSettings)
+{
+    // Common settings, which affect selection of dispatches in "Update_X" functions
+    uint32_t flags = 0;
+    flags |= commonSettings.splitScreen > 0.0f ? 0x1 : 0;
+    flags |= commonSettings.splitScreen >= 1.0f ? 0x2 : 0;
+    flags |= commonSettings.enableValidation ? 0x4 : 0;
+    flags |= commonSettings.isDisocclusionThresholdMixAvailable ? 0x8 : 0;
+    flags |= commonSettings.isHistoryConfidenceAvailable ? 0x10 : 0;
+    flags |= commonSettings.isBaseColorMetalnessAvailable ? 0x20 : 0;
+
+    return flags;
+}
+
+constexpr bool SAMPLERS_ARE_IN_SEPARATE_SET = NRD_SAMPLERS_SPACE_INDEX != NRD_CONSTANT_BUFFER_SPACE_INDEX && NRD_SAMPLERS_SPACE_INDEX != NRD_RESOURCES_SPACE_INDEX;
+
+// Descriptor sets per dispatch (number of "spaces")
+inline uint32_t GetDescriptorSetSpacesNum(const nrd::InstanceDesc& instanceDesc)
+{
+    uint32_t descriptorSetNum = 1;
+    if (instanceDesc.constantBufferSpaceIndex != instanceDesc.samplersSpaceIndex)
+        descriptorSetNum++;
+    if (instanceDesc.samplersSpaceIndex != instanceDesc.resourcesSpaceIndex)
+        descriptorSetNum++;
+
+    return descriptorSetNum;
+}
+
+inline bool IsDenoiserSupported(const nrd::LibraryDesc& libraryDesc, nrd::Denoiser denoiser)
+{
+    for (uint32_t i = 0; i < libraryDesc.supportedDenoisersNum; i++)
+    {
+        if (libraryDesc.supportedDenoisers[i] == denoiser)
+            return true;
+    }
+
+    return false;
+}
+
 inline bool IsInList(nrd::Identifier identifier, const nrd::Identifier* identifiers, uint32_t identifiersNum)
 {
     for (uint32_t i = 0; i < identifiersNum; i++)
@@ -95,588 +241,2506 @@ inline bool IsInList(nrd::Identifier identifier, const nrd::Identifier* identifi
     return false;
 }
 
+nrd::Result nrd::InstanceImpl::InitConstantData(const InstanceCreationDesc& instanceCreationDesc)
+{
+    m_FramesInFlightNum = instanceCreationDesc.framesInFlightNum ? instanceCreationDesc.framesInFlightNum : FRAMES_IN_FLIGHT_DEFAULT_NUM;
+    m_ConstantDataPerFrameSize = instanceCreationDesc.constantDataPerFrameSize ? instanceCreationDesc.constantDataPerFrameSize : CONSTANT_DATA_PER_FRAME_DEFAULT_SIZE;
+    m_ConstantDataAlignment = instanceCreationDesc.constantDataAlignment ? instanceCreationDesc.constantDataAlignment : CONSTANT_DATA_DEFAULT_ALIGNMENT;
+
+    bool isPowerOfTwo = (m_ConstantDataAlignment & (m_ConstantDataAlignment - 1)) == 0;
+    if (!isPowerOfTwo || m_ConstantDataPerFrameSize % m_ConstantDataAlignment != 0)
+        return Result::INVALID_ARGUMENT;
+
+    if (instanceCreationDesc.constantData && !instanceCreationDesc.constantDataPerFrameSize)
+        return Result::INVALID_ARGUMENT;
+
+    // Owned memory is carved from the arena in "CompactTables"
+    if (instanceCreationDesc.constantData)
+        m_ConstantData = instanceCreationDesc.constantData;
+    else
+        m_OwnedConstantDataSize = size_t(m_FramesInFlightNum) * m_ConstantDataPerFrameSize;
+
+    return Result::SUCCESS;
+}
+
 nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreationDesc)
 {
     const LibraryDesc& libraryDesc = GetLibraryDesc();
 
-    // Collect dispatches from all denoisers
-    for (uint32_t i = 0; i < instanceCreationDesc.denoisersNum; i++)
-    {
-        const DenoiserDesc& denoiserDesc = instanceCreationDesc.denoisers[i];
+    if (instanceCreationDesc.memoryBudget >= MemoryBudget::MAX_NUM)
+        return Result::INVALID_ARGUMENT;
 
-        // Check that denoiser is supported
-        uint32_t j = 0;
-        for (; j < libraryDesc.supportedDenoisersNum; j++)
-        {
-            if (denoiserDesc.denoiser == libraryDesc.supportedDenoisers[j])
-                break;
-        }
-        if (j == libraryDesc.supportedDenoisersNum)
-            return Result::UNSUPPORTED;
+    m_MemoryBudget = instanceCreationDesc.memoryBudget;
+
+    // Constant data ring
+    Result result = InitConstantData(instanceCreationDesc);
+    if (result != Result::SUCCESS)
+        return result;
+
+    uint32_t viewsNum = std::max(instanceCreationDesc.viewsNum, 1u);
+    m_InterleaveViews = instanceCreationDesc.interleaveViews && viewsNum > 1;
+    m_ViewStates.resize(viewsNum);
+
+    Vector<uint64_t> clearResourceKeys(GetStdAllocator()); // sorted
 
-        // Check that identifier is unique
-        for (j = 0; j < instanceCreationDesc.denoisersNum; j++)
+    // Collect dispatches from all denoisers for all views
+    for (uint32_t viewIndex = 0; viewIndex < viewsNum; viewIndex++)
+    {
+        // Interleaved views run simultaneously: transient resources can't be shared and stages overlap
+        if (m_InterleaveViews)
         {
-            if (i != j && instanceCreationDesc.denoisers[j].identifier == denoiserDesc.identifier)
-                return Result::NON_UNIQUE_IDENTIFIER;
+            m_ViewTransientPoolOffset = (uint16_t)m_TransientPool.size();
+            m_Stage = 0;
         }
 
-        // Append dispatches for the current denoiser
-        m_PermanentPoolOffset = (uint16_t)m_PermanentPool.size();
-        m_TransientPoolOffset = (uint16_t)m_TransientPool.size();
-
-        m_IndexRemap.clear();
+        // Views have dedicated history
+        m_SharedTextures.clear();
+        size_t viewDenoiserDataOffset = m_DenoiserData.size();
 
-        DenoiserData denoiserData = {};
-        denoiserData.desc = denoiserDesc;
-        denoiserData.dispatchOffset = m_Dispatches.size();
-        denoiserData.pingPongOffset = m_PingPongs.size();
+        for (uint32_t i = 0; i < instanceCreationDesc.denoisersNum; i++)
+        {
+            const DenoiserDesc& denoiserDesc = instanceCreationDesc.denoisers[i];
 
-        size_t resourceOffset = m_Resources.size();
+            // Check that denoiser is supported
+            if (!IsDenoiserSupported(libraryDesc, denoiserDesc.denoiser))
+                return Result::UNSUPPORTED;
 
-        if (denoiserDesc.denoiser == Denoiser::REBLUR_DIFFUSE)
-            Add_ReblurDiffuse(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_DIFFUSE_OCCLUSION)
-            Add_ReblurDiffuseOcclusion(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_DIFFUSE_SH)
-            Add_ReblurDiffuseSh(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_SPECULAR)
-            Add_ReblurSpecular(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_SPECULAR_OCCLUSION)
-            Add_ReblurSpecularOcclusion(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_SPECULAR_SH)
-            Add_ReblurSpecularSh(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR)
-            Add_ReblurDiffuseSpecular(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_OCCLUSION)
-            Add_ReblurDiffuseSpecularOcclusion(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_SH)
-            Add_ReblurDiffuseSpecularSh(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
-            Add_ReblurDiffuseDirectionalOcclusion(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::SIGMA_SHADOW)
-            Add_SigmaShadow(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::SIGMA_SHADOW_TRANSLUCENCY)
-            Add_SigmaShadowTranslucency(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::RELAX_DIFFUSE)
-            Add_RelaxDiffuse(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::RELAX_DIFFUSE_SH)
-            Add_RelaxDiffuseSh(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::RELAX_SPECULAR)
-            Add_RelaxSpecular(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::RELAX_SPECULAR_SH)
-            Add_RelaxSpecularSh(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR)
-            Add_RelaxDiffuseSpecular(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
-            Add_RelaxDiffuseSpecularSh(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::REFERENCE)
-            Add_Reference(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::SPECULAR_REFLECTION_MV)
-            Add_SpecularReflectionMv(denoiserData);
-        else if (denoiserDesc.denoiser == Denoiser::SPECULAR_DELTA_MV)
-            Add_SpecularDeltaMv(denoiserData);
-        else // Should not be here
-            return Result::INVALID_ARGUMENT;
+            // Check that identifier is unique
+            for (uint32_t j = 0; j < instanceCreationDesc.denoisersNum; j++)
+            {
+                if (i != j && instanceCreationDesc.denoisers[j].identifier == denoiserDesc.identifier)
+                    return Result::NON_UNIQUE_IDENTIFIER;
+            }
 
-        denoiserData.pingPongNum = m_PingPongs.size() - denoiserData.pingPongOffset;
+            // Append dispatches for the current denoiser
+            m_PermanentPoolOffset = (uint16_t)m_PermanentPool.size();
+            m_TransientPoolOffset = (uint16_t)m_TransientPool.size();
 
-        // Gather resources, which need to be cleared
-        for (size_t resourceIndex = resourceOffset; resourceIndex < m_Resources.size(); resourceIndex++)
-        {
-            const ResourceDesc& resource = m_Resources[resourceIndex];
+            m_IndexRemap.clear();
+            m_PermanentIndexRemap.clear();
+            m_PrevPassName = nullptr;
 
-            // Loop through all resources and find all used as STORAGE (i.e. ignore read-only user provided inputs)
-            if (resource.stateNeeded != DescriptorType::STORAGE_TEXTURE)
-                continue;
+            // Geometry history is shared by denoisers of the same family and dimensions. The first of them in "denoisers" order
+            // keeps the state of the group, the writer is chosen per frame (see "UpdateGeometryHistory")
+            m_IsGeometryHistoryShared = false;
+            uint32_t geometryHistoryOwner = GEOMETRY_HISTORY_NOT_SHARED;
 
-            // Keep only unique instances
-            bool isFound = false;
-            for (const ClearResource& temp : m_ClearResources)
+            uint32_t family = GetGeometryHistoryFamily(denoiserDesc.denoiser);
+            if (instanceCreationDesc.shareGeometryHistory && family)
             {
-                if (temp.resource.stateNeeded == resource.stateNeeded &&
-                    temp.resource.type == resource.type &&
-                    temp.resource.indexInPool == resource.indexInPool &&
-                    temp.resource.mipOffset == resource.mipOffset &&
-                    temp.resource.mipNum == resource.mipNum)
+                for (uint32_t j = 0; j < instanceCreationDesc.denoisersNum; j++)
                 {
-                    isFound = true;
-                    break;
+                    const DenoiserDesc& other = instanceCreationDesc.denoisers[j];
+                    if (i != j && GetGeometryHistoryFamily(other.denoiser) == family && other.renderWidth == denoiserDesc.renderWidth && other.renderHeight == denoiserDesc.renderHeight)
+                    {
+                        m_IsGeometryHistoryShared = true;
+                        if (geometryHistoryOwner == GEOMETRY_HISTORY_NOT_SHARED)
+                            geometryHistoryOwner = uint32_t(viewDenoiserDataOffset + std::min(i, j));
+                    }
                 }
             }
 
-            // Skip "OUT_VALIDATION" resource because it can be not provided
-            if (resource.type == ResourceType::OUT_VALIDATION)
-                isFound = true;
+            DenoiserData denoiserData = {};
+            denoiserData.desc = denoiserDesc;
+            denoiserData.dispatchOffset = m_Dispatches.size();
+            denoiserData.pingPongOffset = m_PingPongs.size();
+            denoiserData.viewIndex = viewIndex;
+            denoiserData.geometryHistoryOwner = geometryHistoryOwner;
+            denoiserData.geometryHistoryFrameIndex = uint32_t(-1);
+            denoiserData.isGeometryHistoryWriter = true;
+            denoiserData.permanentPoolOffset = m_PermanentPoolOffset;
+            denoiserData.transientPoolOffset = m_TransientPoolOffset;
+
+            size_t resourceOffset = m_Resources.size();
+
+            m_SharedConstantDataSize = 0;
 
-            if (!isFound)
+            // Excluded denoisers are rejected above (not in "LibraryDesc::supportedDenoisers")
+            switch (denoiserDesc.denoiser)
             {
-                // Texture props
-                uint32_t w = denoiserDesc.renderWidth;
-                uint32_t h = denoiserDesc.renderHeight;
-                bool isInteger = false;
+#if NRD_WITH_REBLUR
+            case Denoiser::REBLUR_DIFFUSE: Add_ReblurDiffuse(denoiserData); break;
+            case Denoiser::REBLUR_DIFFUSE_OCCLUSION: Add_ReblurDiffuseOcclusion(denoiserData); break;
+            case Denoiser::REBLUR_DIFFUSE_SH: Add_ReblurDiffuseSh(denoiserData); break;
+            case Denoiser::REBLUR_SPECULAR: Add_ReblurSpecular(denoiserData); break;
+            case Denoiser::REBLUR_SPECULAR_OCCLUSION: Add_ReblurSpecularOcclusion(denoiserData); break;
+            case Denoiser::REBLUR_SPECULAR_SH: Add_ReblurSpecularSh(denoiserData); break;
+            case Denoiser::REBLUR_DIFFUSE_SPECULAR: Add_ReblurDiffuseSpecular(denoiserData); break;
+            case Denoiser::REBLUR_DIFFUSE_SPECULAR_OCCLUSION: Add_ReblurDiffuseSpecularOcclusion(denoiserData); break;
+            case Denoiser::REBLUR_DIFFUSE_SPECULAR_SH: Add_ReblurDiffuseSpecularSh(denoiserData); break;
+            case Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION: Add_ReblurDiffuseDirectionalOcclusion(denoiserData); break;
+#endif
+#if NRD_WITH_SIGMA
+            case Denoiser::SIGMA_SHADOW: Add_SigmaShadow(denoiserData); break;
+            case Denoiser::SIGMA_SHADOW_TRANSLUCENCY: Add_SigmaShadowTranslucency(denoiserData); break;
+#endif
+#if NRD_WITH_RELAX
+            case Denoiser::RELAX_DIFFUSE: Add_RelaxDiffuse(denoiserData); break;
+            case Denoiser::RELAX_DIFFUSE_SH: Add_RelaxDiffuseSh(denoiserData); break;
+            case Denoiser::RELAX_SPECULAR: Add_RelaxSpecular(denoiserData); break;
+            case Denoiser::RELAX_SPECULAR_SH: Add_RelaxSpecularSh(denoiserData); break;
+            case Denoiser::RELAX_DIFFUSE_SPECULAR: Add_RelaxDiffuseSpecular(denoiserData); break;
+            case Denoiser::RELAX_DIFFUSE_SPECULAR_SH: Add_RelaxDiffuseSpecularSh(denoiserData); break;
+#endif
+#if NRD_WITH_REFERENCE
+            case Denoiser::REFERENCE: Add_Reference(denoiserData); break;
+#endif
+#if NRD_WITH_MV
+            case Denoiser::SPECULAR_REFLECTION_MV: Add_SpecularReflectionMv(denoiserData); break;
+            case Denoiser::SPECULAR_DELTA_MV: Add_SpecularDeltaMv(denoiserData); break;
+#endif
+            default: // Should not be here
+                return Result::INVALID_ARGUMENT;
+            }
 
-                if (resource.type == ResourceType::PERMANENT_POOL || resource.type == ResourceType::TRANSIENT_POOL)
-                {
-                    TextureDesc& textureDesc = resource.type == ResourceType::PERMANENT_POOL ? m_PermanentPool[resource.indexInPool] : m_TransientPool[resource.indexInPool];
+            denoiserData.pingPongNum = m_PingPongs.size() - denoiserData.pingPongOffset;
+            denoiserData.permanentPoolNum = uint16_t(m_PermanentPool.size() - m_PermanentPoolOffset);
+            denoiserData.sharedConstantBufferDataSize = m_SharedConstantDataSize;
 
-                    w = textureDesc.width >> resource.mipOffset;
-                    h = textureDesc.height >> resource.mipOffset;
-                    isInteger = g_IsIntegerFormat[(size_t)textureDesc.format];
-                }
+            // Reuse outputs of identical dispatches of previous denoisers (can remove textures just added to the transient pool)
+            DeduplicateDispatches(denoiserData, resourceOffset);
+
+            denoiserData.transientPoolNum = uint16_t(m_TransientPool.size() - m_TransientPoolOffset);
+
+            // Gather resources, which need to be cleared
+            for (size_t resourceIndex = resourceOffset; resourceIndex < m_Resources.size(); resourceIndex++)
+            {
+                const ResourceDesc& resource = m_Resources[resourceIndex];
+
+                // Loop through all resources and find all used as STORAGE (i.e. ignore read-only user provided inputs)
+                if (resource.stateNeeded != DescriptorType::STORAGE_TEXTURE)
+                    continue;
 
-                // Add PING resource
-                m_ClearResources.push_back( {denoiserDesc.identifier, resource, w, h, isInteger} );
+                // Keep only unique instances (views get restarted independently)
+                uint64_t clearResourceKey = GetClearResourceKey(viewIndex, resource);
+                auto clearResourceKeyIt = std::lower_bound(clearResourceKeys.begin(), clearResourceKeys.end(), clearResourceKey);
+                bool isFound = clearResourceKeyIt != clearResourceKeys.end() && *clearResourceKeyIt == clearResourceKey;
 
-                // Add PONG resource
-                for (uint32_t p = 0; p < denoiserData.pingPongNum; p++)
+                // Skip "OUT_VALIDATION" resource because it can be not provided
+                if (resource.type == ResourceType::OUT_VALIDATION)
+                    isFound = true;
+
+                if (!isFound)
                 {
-                    const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + p];
-                    if (pingPong.resourceIndex == (uint32_t)resourceIndex)
+                    // Texture props
+                    uint32_t w = denoiserDesc.renderWidth;
+                    uint32_t h = denoiserDesc.renderHeight;
+                    bool isInteger = false;
+
+                    if (resource.type == ResourceType::PERMANENT_POOL || resource.type == ResourceType::TRANSIENT_POOL)
                     {
-                        ResourceDesc resourcePong = {resource.stateNeeded, resource.type, pingPong.indexInPoolToSwapWith, resource.mipOffset, resource.mipNum};
-                        m_ClearResources.push_back( {denoiserDesc.identifier, resourcePong, w, h, isInteger} );
-                        break;
+                        TextureDesc& textureDesc = resource.type == ResourceType::PERMANENT_POOL ? m_PermanentPool[resource.indexInPool] : m_TransientPool[resource.indexInPool];
+
+                        w = textureDesc.width >> resource.mipOffset;
+                        h = textureDesc.height >> resource.mipOffset;
+                        isInteger = g_IsIntegerFormat[(size_t)textureDesc.format];
+                    }
+
+                    // Add PING resource
+                    m_ClearResources.push_back( {denoiserDesc.identifier, resource, w, h, viewIndex, isInteger} );
+                    clearResourceKeys.insert(clearResourceKeyIt, clearResourceKey);
+
+                    // Add PONG resource
+                    for (uint32_t p = 0; p < denoiserData.pingPongNum; p++)
+                    {
+                        const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + p];
+                        if (pingPong.resourceIndex == (uint32_t)resourceIndex)
+                        {
+                            ResourceDesc resourcePong = {resource.stateNeeded, resource.type, pingPong.indexInPoolToSwapWith, resource.mipOffset, resource.mipNum};
+                            m_ClearResources.push_back( {denoiserDesc.identifier, resourcePong, w, h, viewIndex, isInteger} );
+
+                            uint64_t clearResourcePongKey = GetClearResourceKey(viewIndex, resourcePong);
+                            clearResourceKeys.insert(std::lower_bound(clearResourceKeys.begin(), clearResourceKeys.end(), clearResourcePongKey), clearResourcePongKey);
+                            break;
+                        }
                     }
                 }
             }
-        }
 
-        m_DenoiserData.push_back(denoiserData);
+            GatherTransientLifetimes(denoiserData);
+
+            m_DenoiserData.push_back(denoiserData);
+        }
     }
 
+    PlanTransientPoolAliasing();
+
+    // Same-sized resources of the same class get cleared in one dispatch
+    std::sort(m_ClearResources.begin(), m_ClearResources.end(), [](const ClearResource& a, const ClearResource& b)
+    {
+        if (a.viewIndex != b.viewIndex)
+            return a.viewIndex < b.viewIndex;
+        if (a.isInteger != b.isInteger)
+            return a.isInteger < b.isInteger;
+        if (a.w != b.w)
+            return a.w < b.w;
+
+        return a.h < b.h;
+    });
+
     // Add "clear" dispatches
+    struct ClearGraph : GraphBuilder
+    {
+        constexpr ClearGraph()
+        {
+            _PushPass("Clear (f)");
+            {
+                for (uint32_t i = 0; i < CLEAR_RESOURCES_MAX_NUM; i++)
+                    PushOutput(0, 0, 1);
+
+                AddDispatch( Clear_f, ConstantsOf<ClearConstants>(false), NumThreads(16, 16), 1 );
+            }
+
+            _PushPass("Clear (ui)");
+            {
+                for (uint32_t i = 0; i < CLEAR_RESOURCES_MAX_NUM; i++)
+                    PushOutput(0, 0, 1);
+
+                AddDispatch( Clear_ui, ConstantsOf<ClearConstants>(false), NumThreads(16, 16), 1 );
+            }
+        }
+    };
+
+    NRD_DECLARE_GRAPH(clearGraph, ClearGraph);
+
     m_DispatchClearIndex[0] = m_Dispatches.size();
-    _PushPass("Clear (f)");
+    m_DispatchClearIndex[1] = m_Dispatches.size() + 1;
+    AddGraph(clearGraph.GetDesc(), 0, 0);
+
+    PrepareDesc();
+
+    result = CompactTables();
+    if (result != Result::SUCCESS)
+        return result;
+
+    // IMPORTANT: since now all std::vectors become "locked" (no reallocations)
+    m_AllocationTracker.isLocked = instanceCreationDesc.lockAllocations;
+    m_AllocationTracker.isSteadyState = true;
+
+    return Result::SUCCESS;
+}
+
+nrd::Result nrd::InstanceImpl::CreateFromBlob(const InstanceCreationDesc& instanceCreationDesc, const uint8_t* blob, uint64_t blobSize)
+{
+    const LibraryDesc& libraryDesc = GetLibraryDesc();
+
+    if (!blob || blobSize < sizeof(BlobHeader))
+        return Result::INVALID_ARGUMENT;
+
+    BlobHeader header = {};
+    memcpy(&header, blob, sizeof(header));
+
+    if (header.magic != BLOB_MAGIC || header.size != blobSize)
+        return Result::INVALID_ARGUMENT;
+
+    // The blob must be produced by the same library
+    if (header.version != BLOB_VERSION
+        || header.libraryVersion[0] != libraryDesc.versionMajor
+        || header.libraryVersion[1] != libraryDesc.versionMinor
+        || header.libraryVersion[2] != libraryDesc.versionBuild
+        || header.normalEncoding != (uint32_t)libraryDesc.normalEncoding
+        || header.roughnessEncoding != (uint32_t)libraryDesc.roughnessEncoding)
+        return Result::UNSUPPORTED;
+
+    const uint32_t strides[] =
+    {
+        sizeof(DenoiserData),
+        sizeof(TextureDesc),
+        sizeof(TextureDesc),
+        sizeof(ResourceDesc),
+        sizeof(ClearResource),
+        sizeof(PingPong),
+        sizeof(ResourceRangeDesc),
+        sizeof(PipelineDesc),
+        sizeof(PipelineKey),
+        sizeof(InternalDispatchDesc),
+        sizeof(TransientAliasingDesc),
+        sizeof(AliasingGroupDesc),
+        sizeof(char),
+        sizeof(uint8_t),
+    };
+    static_assert(GetCountOf(strides) == (uint32_t)BlobTable::MAX_NUM, "Unexpected number of blob tables");
+
+    for (uint32_t i = 0; i < (uint32_t)BlobTable::MAX_NUM; i++)
+    {
+        const BlobTableDesc& tableDesc = header.tables[i];
+        if (tableDesc.stride != strides[i])
+            return Result::UNSUPPORTED;
+
+        if (tableDesc.offset > blobSize || uint64_t(tableDesc.num) * tableDesc.stride > blobSize - tableDesc.offset)
+            return Result::INVALID_ARGUMENT;
+    }
+
+    const BlobTableDesc& strings = header.tables[(size_t)BlobTable::STRINGS];
+    const BlobTableDesc& bytecode = header.tables[(size_t)BlobTable::BYTECODE];
+
+    if (strings.num && blob[strings.offset + strings.num - 1] != 0)
+        return Result::INVALID_ARGUMENT;
+
+    if (!header.viewsNum || header.dispatchClearIndex[0] >= header.tables[(size_t)BlobTable::DISPATCHES].num || header.dispatchClearIndex[1] >= header.tables[(size_t)BlobTable::DISPATCHES].num)
+        return Result::INVALID_ARGUMENT;
+
+    // Constant data ring
+    Result result = InitConstantData(instanceCreationDesc);
+    if (result != Result::SUCCESS)
+        return result;
+
+    // Tables
+    auto ReadTable = [&](BlobTable table, auto& elements)
+    {
+        const BlobTableDesc& tableDesc = header.tables[(size_t)table];
+
+        elements.clear();
+        elements.reserve(tableDesc.num);
+
+        for (uint32_t i = 0; i < tableDesc.num; i++)
+        {
+            elements.push_back({});
+            memcpy(&elements.back(), blob + tableDesc.offset + size_t(i) * tableDesc.stride, tableDesc.stride);
+        }
+    };
+
+    ReadTable(BlobTable::DENOISER_DATA, m_DenoiserData);
+    ReadTable(BlobTable::PERMANENT_POOL, m_PermanentPool);
+    ReadTable(BlobTable::TRANSIENT_POOL, m_TransientPool);
+    ReadTable(BlobTable::RESOURCES, m_Resources);
+    ReadTable(BlobTable::CLEAR_RESOURCES, m_ClearResources);
+    ReadTable(BlobTable::PING_PONGS, m_PingPongs);
+    ReadTable(BlobTable::RESOURCE_RANGES, m_ResourceRanges);
+    ReadTable(BlobTable::PIPELINES, m_Pipelines);
+    ReadTable(BlobTable::PIPELINE_KEYS, m_PipelineKeys);
+    ReadTable(BlobTable::DISPATCHES, m_Dispatches);
+    ReadTable(BlobTable::TRANSIENT_POOL_ALIASING, m_TransientPoolAliasing);
+    ReadTable(BlobTable::ALIASING_GROUPS, m_AliasingGroups);
+
+    // The blob can come from a build with a different set of denoisers
+    for (const DenoiserData& denoiserData : m_DenoiserData)
+    {
+        if (!IsDenoiserSupported(libraryDesc, denoiserData.desc.denoiser))
+            return Result::UNSUPPORTED;
+    }
+
+    m_ViewStates.resize(header.viewsNum);
+    m_InterleaveViews = header.interleaveViews != 0;
+    m_DispatchClearIndex[0] = header.dispatchClearIndex[0];
+    m_DispatchClearIndex[1] = header.dispatchClearIndex[1];
+
+    // Relocation: names and bytecode are referenced in place
+    auto GetString = [&](const char* offset) -> const char*
+    {
+        uint64_t stringOffset = (uint64_t)(size_t)offset;
+        if (stringOffset < strings.offset || stringOffset >= strings.offset + strings.num)
+            return nullptr;
+
+        return (const char*)blob + stringOffset;
+    };
+
+    auto RelocateBytecode = [&](ComputeShaderDesc& computeShaderDesc) -> bool
+    {
+        uint64_t bytecodeOffset = (uint64_t)(size_t)computeShaderDesc.bytecode;
+        if (!computeShaderDesc.size)
+            computeShaderDesc.bytecode = nullptr;
+        else if (bytecodeOffset < bytecode.offset || computeShaderDesc.size > bytecode.offset + bytecode.num - bytecodeOffset)
+            return false;
+        else
+            computeShaderDesc.bytecode = blob + bytecodeOffset;
+
+        return true;
+    };
+
+    for (PipelineDesc& pipelineDesc : m_Pipelines)
+    {
+        pipelineDesc.shaderFileName = GetString(pipelineDesc.shaderFileName);
+        pipelineDesc.shaderEntryPointName = GetString(pipelineDesc.shaderEntryPointName);
+
+        if (!pipelineDesc.shaderFileName || !pipelineDesc.shaderEntryPointName)
+            return Result::INVALID_ARGUMENT;
+
+        if (!RelocateBytecode(pipelineDesc.computeShaderDXBC) || !RelocateBytecode(pipelineDesc.computeShaderDXIL) || !RelocateBytecode(pipelineDesc.computeShaderSPIRV))
+            return Result::INVALID_ARGUMENT;
+
+        if ((size_t)pipelineDesc.resourceRanges + pipelineDesc.resourceRangesNum > m_ResourceRanges.size())
+            return Result::INVALID_ARGUMENT;
+    }
+
+    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
     {
-        PushOutput(0, 0, 1);
-        AddDispatch( Clear_f, 0, NumThreads(16, 16), 1 );
+        dispatchDesc.name = GetString(dispatchDesc.name);
+
+        if (!dispatchDesc.name || dispatchDesc.pipelineIndex >= m_Pipelines.size() || (size_t)dispatchDesc.resources + dispatchDesc.resourcesNum > m_Resources.size())
+            return Result::INVALID_ARGUMENT;
     }
 
-    m_DispatchClearIndex[1] = m_Dispatches.size();
-    _PushPass("Clear (ui)");
+    for (DenoiserData& denoiserData : m_DenoiserData)
     {
-        PushOutput(0, 0, 1);
-        AddDispatch( Clear_ui, 0, NumThreads(16, 16), 1 );
+        if (denoiserData.pingPongOffset + denoiserData.pingPongNum > m_PingPongs.size() || denoiserData.dispatchOffset > m_Dispatches.size() || denoiserData.viewIndex >= header.viewsNum)
+            return Result::INVALID_ARGUMENT;
+
+        if (denoiserData.geometryHistoryOwner != GEOMETRY_HISTORY_NOT_SHARED && denoiserData.geometryHistoryOwner >= m_DenoiserData.size())
+            return Result::INVALID_ARGUMENT;
     }
 
     PrepareDesc();
 
+    result = CompactTables();
+    if (result != Result::SUCCESS)
+        return result;
+
     // IMPORTANT: since now all std::vectors become "locked" (no reallocations)
+    m_AllocationTracker.isLocked = instanceCreationDesc.lockAllocations;
+    m_AllocationTracker.isSteadyState = true;
 
     return Result::SUCCESS;
 }
 
-nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSettings)
+nrd::Result nrd::InstanceImpl::Serialize(uint8_t* blob, uint64_t& blobSize) const
 {
-    // TODO: add a lot of verifications of fields in CommonSettings
-    memcpy(&m_CommonSettings, &commonSettings, sizeof(commonSettings));
+    // Temporary storage, not a steady state allocation
+    AllocationCreationScope creationScope;
 
-    // Rotators
-    ml::float4 rndScale = ml::float4(1.0f) + ml::Rand::sf4(&m_FastRandState) * 0.25f;
-    ml::float4 rndAngle = ml::Rand::uf4(&m_FastRandState) * ml::DegToRad(360.0f);
-    rndAngle.w = ml::DegToRad( 120.0f * float(m_CommonSettings.frameIndex % 3) );
+    const LibraryDesc& libraryDesc = GetLibraryDesc();
 
-    float ca = ml::Cos( rndAngle.x );
-    float sa = ml::Sin( rndAngle.x );
-    m_Rotator_PrePass = ml::float4( ca, sa, -sa, ca ) * rndScale.x;
+    StdAllocator<uint8_t> allocator = m_StdAllocator;
+    Vector<uint8_t> data(allocator);
+    Vector<uint64_t> stringOffsets(allocator); // unique strings
+    Vector<uint64_t> pipelineOffsets(allocator); // file name and entry point name offsets for each pipeline, then bytecode offset and size for each format of each pipeline
+    Vector<uint64_t> dispatchNameOffsets(allocator);
+
+    BlobHeader header = {};
+    header.magic = BLOB_MAGIC;
+    header.version = BLOB_VERSION;
+    header.libraryVersion[0] = libraryDesc.versionMajor;
+    header.libraryVersion[1] = libraryDesc.versionMinor;
+    header.libraryVersion[2] = libraryDesc.versionBuild;
+    header.normalEncoding = (uint32_t)libraryDesc.normalEncoding;
+    header.roughnessEncoding = (uint32_t)libraryDesc.roughnessEncoding;
+    header.viewsNum = (uint32_t)m_ViewStates.size();
+    header.dispatchClearIndex[0] = (uint32_t)m_DispatchClearIndex[0];
+    header.dispatchClearIndex[1] = (uint32_t)m_DispatchClearIndex[1];
+    header.interleaveViews = m_InterleaveViews ? 1 : 0;
+
+    data.resize(sizeof(header));
+
+    auto AddTable = [&](BlobTable table, size_t num, size_t stride) -> size_t
+    {
+        size_t offset = GetAlignedSize(data.size(), 8);
+        data.resize(offset + num * stride);
 
-    ca = ml::Cos( rndAngle.y );
-    sa = ml::Sin( rndAngle.y );
-    m_Rotator_Blur = ml::float4( ca, sa, -sa, ca ) * rndScale.y;
+        header.tables[(size_t)table] = {offset, (uint32_t)num, (uint32_t)stride};
 
-    ca = ml::Cos( rndAngle.z );
-    sa = ml::Sin( rndAngle.z );
-    m_Rotator_PostBlur = ml::float4( ca, sa, -sa, ca ) * rndScale.z;
+        return offset;
+    };
 
-    // Main matrices
-    m_ViewToClip = ml::float4x4
-    (
-        ml::float4(m_CommonSettings.viewToClipMatrix),
-        ml::float4(m_CommonSettings.viewToClipMatrix + 4),
-        ml::float4(m_CommonSettings.viewToClipMatrix + 8),
-        ml::float4(m_CommonSettings.viewToClipMatrix + 12)
-    );
+    auto WriteTable = [&](BlobTable table, const auto& elements)
+    {
+        size_t stride = sizeof(elements[0]);
+        size_t offset = AddTable(table, elements.size(), stride);
 
-    m_ViewToClipPrev = ml::float4x4
-    (
-        ml::float4(m_CommonSettings.viewToClipMatrixPrev),
-        ml::float4(m_CommonSettings.viewToClipMatrixPrev + 4),
-        ml::float4(m_CommonSettings.viewToClipMatrixPrev + 8),
-        ml::float4(m_CommonSettings.viewToClipMatrixPrev + 12)
-    );
+        if (!elements.empty())
+            memcpy(data.data() + offset, elements.data(), elements.size() * stride);
+    };
 
-    m_WorldToView = ml::float4x4
-    (
-        ml::float4(m_CommonSettings.worldToViewMatrix),
-        ml::float4(m_CommonSettings.worldToViewMatrix + 4),
-        ml::float4(m_CommonSettings.worldToViewMatrix + 8),
-        ml::float4(m_CommonSettings.worldToViewMatrix + 12)
-    );
+    // Strings (deduplicated)
+    header.tables[(size_t)BlobTable::STRINGS] = {data.size(), 0, sizeof(char)};
 
-    m_WorldToViewPrev = ml::float4x4
-    (
-        ml::float4(m_CommonSettings.worldToViewMatrixPrev),
-        ml::float4(m_CommonSettings.worldToViewMatrixPrev + 4),
-        ml::float4(m_CommonSettings.worldToViewMatrixPrev + 8),
-        ml::float4(m_CommonSettings.worldToViewMatrixPrev + 12)
-    );
+    auto AddString = [&](const char* s) -> uint64_t
+    {
+        for (uint64_t stringOffset : stringOffsets)
+        {
+            if (!strcmp((const char*)data.data() + stringOffset, s))
+                return stringOffset;
+        }
 
-    m_WorldPrevToWorld = ml::float4x4
-    (
-        ml::float4(m_CommonSettings.worldPrevToWorldMatrix),
-        ml::float4(m_CommonSettings.worldPrevToWorldMatrix + 4),
-        ml::float4(m_CommonSettings.worldPrevToWorldMatrix + 8),
-        ml::float4(m_CommonSettings.worldPrevToWorldMatrix + 12)
-    );
+        uint64_t stringOffset = data.size();
+        data.insert(data.end(), s, s + strlen(s) + 1);
+        stringOffsets.push_back(stringOffset);
 
-    // There are many cases, where history buffers contain garbage - handle at least one of them internally
-    if (m_IsFirstUse)
+        return stringOffset;
+    };
+
+    for (const PipelineDesc& pipelineDesc : m_Pipelines)
     {
-        m_CommonSettings.accumulationMode = AccumulationMode::CLEAR_AND_RESTART;
-        m_WorldToViewPrev = m_WorldToView;
-        m_ViewToClipPrev = m_ViewToClip;
-        m_IsFirstUse = false;
+        pipelineOffsets.push_back(AddString(pipelineDesc.shaderFileName));
+        pipelineOffsets.push_back(AddString(pipelineDesc.shaderEntryPointName));
     }
 
-    // Convert to LH
-    uint32_t flags = 0;
-    ml::DecomposeProjection(NDC_D3D, NDC_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.pv, nullptr, nullptr);
+    for (const InternalDispatchDesc& dispatchDesc : m_Dispatches)
+        dispatchNameOffsets.push_back(AddString(dispatchDesc.name));
 
-    if ( !(flags & ml::PROJ_LEFT_HANDED) )
+    header.tables[(size_t)BlobTable::STRINGS].num = uint32_t(data.size() - header.tables[(size_t)BlobTable::STRINGS].offset);
+
+    // Bytecode (stored once for pipelines sharing it)
+    size_t bytecodeOffset = AddTable(BlobTable::BYTECODE, 0, sizeof(uint8_t));
+
+    for (size_t i = 0; i < m_Pipelines.size(); i++)
     {
-        m_ViewToClip.col2 = (-m_ViewToClip.GetCol2()).xmm;
-        m_ViewToClipPrev.col2 = (-m_ViewToClipPrev.GetCol2()).xmm;
+        const PipelineDesc& pipelineDesc = m_Pipelines[i];
 
-        m_WorldToView.Transpose();
-        m_WorldToView.col2 = (-m_WorldToView.GetCol2()).xmm;
-        m_WorldToView.Transpose();
+        for (const ComputeShaderDesc* computeShaderDesc : {&pipelineDesc.computeShaderDXBC, &pipelineDesc.computeShaderDXIL, &pipelineDesc.computeShaderSPIRV})
+        {
+            ShaderFormat format = ShaderFormat(computeShaderDesc - &pipelineDesc.computeShaderDXBC);
+            if (pipelineDesc.uniquePipelineIndex != i)
+            {
+                size_t unique = m_Pipelines.size() * 2 + (pipelineDesc.uniquePipelineIndex * 3 + (size_t)format) * 2;
+                uint64_t uniqueOffset = pipelineOffsets[unique];
+                uint64_t uniqueSize = pipelineOffsets[unique + 1];
 
-        m_WorldToViewPrev.Transpose();
-        m_WorldToViewPrev.col2 = (-m_WorldToViewPrev.GetCol2()).xmm;
-        m_WorldToViewPrev.Transpose();
+                pipelineOffsets.push_back(uniqueOffset);
+                pipelineOffsets.push_back(uniqueSize);
+
+                continue;
+            }
+
+            uint64_t begin = data.size();
+
+            const uint8_t* bytes = (const uint8_t*)computeShaderDesc->bytecode;
+            if (bytes)
+                data.insert(data.end(), bytes, bytes + computeShaderDesc->size);
+            else
+            {
+                // Not decompressed yet, the blob stores bytecode uncompressed
+                uint32_t blockIndex = 0;
+                const ShaderArchiveBlock* block = FindArchivedShader(HashShaderName(pipelineDesc.shaderFileName), format, blockIndex);
+                if (block)
+                {
+                    data.resize(data.size() + block->size);
+                    if (!DecompressArchivedShader(*block, data.data() + data.size() - block->size))
+                        return Result::FAILURE;
+                }
+            }
+
+            pipelineOffsets.push_back(begin);
+            pipelineOffsets.push_back(data.size() - begin);
+        }
     }
 
-    // Compute other matrices
-    m_ViewToWorld = m_WorldToView;
-    m_ViewToWorld.InvertOrtho();
+    header.tables[(size_t)BlobTable::BYTECODE].num = uint32_t(data.size() - bytecodeOffset);
+
+    // Tables
+    WriteTable(BlobTable::PERMANENT_POOL, m_PermanentPool);
+    WriteTable(BlobTable::TRANSIENT_POOL, m_TransientPool);
+    WriteTable(BlobTable::RESOURCES, m_Resources);
+    WriteTable(BlobTable::CLEAR_RESOURCES, m_ClearResources);
+    WriteTable(BlobTable::PING_PONGS, m_PingPongs);
+    WriteTable(BlobTable::RESOURCE_RANGES, m_ResourceRanges);
+    WriteTable(BlobTable::PIPELINE_KEYS, m_PipelineKeys);
+    WriteTable(BlobTable::TRANSIENT_POOL_ALIASING, m_TransientPoolAliasing);
+    WriteTable(BlobTable::ALIASING_GROUPS, m_AliasingGroups);
+
+    size_t offset = AddTable(BlobTable::DENOISER_DATA, m_DenoiserData.size(), sizeof(DenoiserData));
+    for (DenoiserData denoiserData : m_DenoiserData)
+    {
+        denoiserData.context = nullptr;
+        denoiserData.accumulatedFrameNum = 0;
+
+        memcpy(data.data() + offset, &denoiserData, sizeof(denoiserData));
+        offset += sizeof(denoiserData);
+    }
+
+    offset = AddTable(BlobTable::PIPELINES, m_Pipelines.size(), sizeof(PipelineDesc));
+    for (size_t i = 0; i < m_Pipelines.size(); i++)
+    {
+        const uint64_t* offsets = &pipelineOffsets[i * 2];
+        const uint64_t* bytecodeRanges = &pipelineOffsets[m_Pipelines.size() * 2 + i * 6];
+
+        PipelineDesc pipelineDesc = m_Pipelines[i];
+        pipelineDesc.shaderFileName = (const char*)(size_t)offsets[0];
+        pipelineDesc.shaderEntryPointName = (const char*)(size_t)offsets[1];
+        pipelineDesc.resourceRanges = (const ResourceRangeDesc*)size_t(pipelineDesc.resourceRanges - m_ResourceRanges.data());
+
+        // Sizes are needed for not yet decompressed bytecode
+        for (size_t j = 0; j < 3; j++)
+        {
+            ComputeShaderDesc& computeShaderDesc = (&pipelineDesc.computeShaderDXBC)[j];
+            computeShaderDesc.bytecode = (const void*)(size_t)bytecodeRanges[j * 2];
+            computeShaderDesc.size = bytecodeRanges[j * 2 + 1];
+        }
+
+        memcpy(data.data() + offset, &pipelineDesc, sizeof(pipelineDesc));
+        offset += sizeof(pipelineDesc);
+    }
+
+    offset = AddTable(BlobTable::DISPATCHES, m_Dispatches.size(), sizeof(InternalDispatchDesc));
+    for (size_t i = 0; i < m_Dispatches.size(); i++)
+    {
+        InternalDispatchDesc dispatchDesc = m_Dispatches[i];
+        dispatchDesc.name = (const char*)(size_t)dispatchNameOffsets[i];
+        dispatchDesc.resources = (const ResourceDesc*)size_t(dispatchDesc.resources - m_Resources.data());
+
+        memcpy(data.data() + offset, &dispatchDesc, sizeof(dispatchDesc));
+        offset += sizeof(dispatchDesc);
+    }
+
+    header.size = data.size();
+    memcpy(data.data(), &header, sizeof(header));
+
+    // Size query or copy
+    uint64_t availableSize = blobSize;
+    blobSize = data.size();
+
+    if (!blob)
+        return Result::SUCCESS;
+
+    if (availableSize < data.size())
+        return Result::INVALID_ARGUMENT;
+
+    memcpy(blob, data.data(), data.size());
+
+    return Result::SUCCESS;
+}
+
+nrd::Result nrd::InstanceImpl::SetCommonSettings(uint32_t viewIndex, const CommonSettings& commonSettings, const InstanceImpl* cameraSource, uint32_t cameraSourceViewIndex)
+{
+    // TODO: add a lot of verifications of fields in CommonSettings
+    if (viewIndex >= m_ViewStates.size())
+        return Result::INVALID_ARGUMENT;
+
+    if (cameraSource && cameraSourceViewIndex >= cameraSource->m_ViewStates.size())
+        return Result::INVALID_ARGUMENT;
+
+    LoadView(viewIndex);
+
+    // Grid sizes depend on resolution scales and render sizes, the cached frame template can't be reused
+    if (m_CommonSettings.resolutionScale[0] != commonSettings.resolutionScale[0] || m_CommonSettings.resolutionScale[1] != commonSettings.resolutionScale[1] ||
+        m_CommonSettings.resolutionScalePrev[0] != commonSettings.resolutionScalePrev[0] || m_CommonSettings.resolutionScalePrev[1] != commonSettings.resolutionScalePrev[1] ||
+        m_RenderWidth != m_ResizedWidth || m_RenderHeight != m_ResizedHeight || m_RenderWidthPrev != m_RenderWidth || m_RenderHeightPrev != m_RenderHeight)
+        m_SettingsVersion++;
+
+    // A new frame starts: the size requested by "Resize" gets applied, history is reprojected from the previous size. Repeated
+    // calls for the same frame (same "frameIndex") must not shift sizes again
+    if (m_IsFirstUse || commonSettings.frameIndex != m_CommonSettings.frameIndex)
+    {
+        m_IsFirstFrame = m_IsFirstUse;
+        m_IsFirstUse = false;
+        m_RenderWidthPrev = m_RenderWidth;
+        m_RenderHeightPrev = m_RenderHeight;
+        m_RenderWidth = m_ResizedWidth;
+        m_RenderHeight = m_ResizedHeight;
+    }
+
+    // Flags can make other pipelines reachable and change the sequence of dispatches
+    if (GetBranchingFlags(m_CommonSettings) != GetBranchingFlags(commonSettings))
+    {
+        m_SettingsVersion++;
+        m_IsReachabilityDirty = true;
+        m_IsFramePoolDirty = true;
+    }
+
+    memcpy(&m_CommonSettings, &commonSettings, sizeof(commonSettings));
+
+    // Rotators
+    ml::float4 rndScale = ml::float4(1.0f) + ml::Rand::sf4(&m_FastRandState) * 0.25f;
+    ml::float4 rndAngle = ml::Rand::uf4(&m_FastRandState) * ml::DegToRad(360.0f);
+    rndAngle.w = ml::DegToRad( 120.0f * float(m_CommonSettings.frameIndex % 3) );
+
+    float ca = ml::Cos( rndAngle.x );
+    float sa = ml::Sin( rndAngle.x );
+    m_Rotator_PrePass = ml::float4( ca, sa, -sa, ca ) * rndScale.x;
+
+    ca = ml::Cos( rndAngle.y );
+    sa = ml::Sin( rndAngle.y );
+    m_Rotator_Blur = ml::float4( ca, sa, -sa, ca ) * rndScale.y;
+
+    ca = ml::Cos( rndAngle.z );
+    sa = ml::Sin( rndAngle.z );
+    m_Rotator_PostBlur = ml::float4( ca, sa, -sa, ca ) * rndScale.z;
+
+    // Camera
+    CameraInputs cameraInputs;
+    memcpy(cameraInputs.viewToClip, m_CommonSettings.viewToClipMatrix, sizeof(cameraInputs.viewToClip));
+    memcpy(cameraInputs.viewToClipPrev, m_CommonSettings.viewToClipMatrixPrev, sizeof(cameraInputs.viewToClipPrev));
+    memcpy(cameraInputs.worldToView, m_CommonSettings.worldToViewMatrix, sizeof(cameraInputs.worldToView));
+    memcpy(cameraInputs.worldToViewPrev, m_CommonSettings.worldToViewMatrixPrev, sizeof(cameraInputs.worldToViewPrev));
+    memcpy(cameraInputs.worldPrevToWorld, m_CommonSettings.worldPrevToWorldMatrix, sizeof(cameraInputs.worldPrevToWorld));
+
+    // There are many cases, where history buffers contain garbage - handle at least one of them internally
+    if (m_IsFirstFrame)
+    {
+        m_CommonSettings.accumulationMode = AccumulationMode::CLEAR_AND_RESTART;
+        memcpy(cameraInputs.worldToViewPrev, cameraInputs.worldToView, sizeof(cameraInputs.worldToViewPrev));
+        memcpy(cameraInputs.viewToClipPrev, cameraInputs.viewToClip, sizeof(cameraInputs.viewToClipPrev));
+        m_RenderWidthPrev = m_RenderWidth;
+        m_RenderHeightPrev = m_RenderHeight;
+    }
+
+    // Derivations are skipped if the camera hasn't changed (pause, cinematics) or copied from a view with the same camera
+    if (!m_IsCameraValid || memcmp(&m_CameraInputs, &cameraInputs, sizeof(cameraInputs)))
+    {
+        const CameraState* sharedCamera = cameraSource ? &cameraSource->GetViewState(cameraSourceViewIndex) : nullptr;
+        if (sharedCamera && sharedCamera->m_IsCameraValid && !memcmp(&sharedCamera->m_CameraInputs, &cameraInputs, sizeof(cameraInputs)))
+            *(CameraState*)this = *sharedCamera;
+        else
+            UpdateCamera(cameraInputs);
+    }
+
+    m_Timer.UpdateElapsedTimeSinceLastSave();
+    m_Timer.SaveCurrentTime();
+
+    m_TimeDelta = m_CommonSettings.timeDeltaBetweenFrames > 0.0f ? m_CommonSettings.timeDeltaBetweenFrames : m_Timer.GetSmoothedElapsedTime();
+    m_FrameRateScale = ml::Max(33.333f / m_TimeDelta, 1.0f);
+
+    float dx = ml::Abs(m_CommonSettings.cameraJitter[0] - m_CommonSettings.cameraJitterPrev[0]);
+    float dy = ml::Abs(m_CommonSettings.cameraJitter[1] - m_CommonSettings.cameraJitterPrev[1]);
+    m_JitterDelta = ml::Max(dx, dy);
+
+    float FPS = m_FrameRateScale * 30.0f;
+    float nonLinearAccumSpeed = FPS * 0.25f / (1.0f + FPS * 0.25f);
+    m_CheckerboardResolveAccumSpeed = ml::Lerp(nonLinearAccumSpeed, 0.5f, m_JitterDelta);
+
+    return Result::SUCCESS;
+}
+
+void nrd::InstanceImpl::UpdateCamera(const CameraInputs& cameraInputs)
+{
+    m_CameraInputs = cameraInputs;
+    m_IsCameraValid = true;
+
+    // Main matrices
+    m_ViewToClip = ml::float4x4
+    (
+        ml::float4(cameraInputs.viewToClip),
+        ml::float4(cameraInputs.viewToClip + 4),
+        ml::float4(cameraInputs.viewToClip + 8),
+        ml::float4(cameraInputs.viewToClip + 12)
+    );
+
+    m_ViewToClipPrev = ml::float4x4
+    (
+        ml::float4(cameraInputs.viewToClipPrev),
+        ml::float4(cameraInputs.viewToClipPrev + 4),
+        ml::float4(cameraInputs.viewToClipPrev + 8),
+        ml::float4(cameraInputs.viewToClipPrev + 12)
+    );
+
+    m_WorldToView = ml::float4x4
+    (
+        ml::float4(cameraInputs.worldToView),
+        ml::float4(cameraInputs.worldToView + 4),
+        ml::float4(cameraInputs.worldToView + 8),
+        ml::float4(cameraInputs.worldToView + 12)
+    );
+
+    m_WorldToViewPrev = ml::float4x4
+    (
+        ml::float4(cameraInputs.worldToViewPrev),
+        ml::float4(cameraInputs.worldToViewPrev + 4),
+        ml::float4(cameraInputs.worldToViewPrev + 8),
+        ml::float4(cameraInputs.worldToViewPrev + 12)
+    );
+
+    m_WorldPrevToWorld = ml::float4x4
+    (
+        ml::float4(cameraInputs.worldPrevToWorld),
+        ml::float4(cameraInputs.worldPrevToWorld + 4),
+        ml::float4(cameraInputs.worldPrevToWorld + 8),
+        ml::float4(cameraInputs.worldPrevToWorld + 12)
+    );
+
+    // Convert to LH
+    uint32_t flags = 0;
+    ml::DecomposeProjection(NDC_D3D, NDC_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.pv, nullptr, nullptr);
+
+    if ( !(flags & ml::PROJ_LEFT_HANDED) )
+    {
+        m_ViewToClip.col2 = (-m_ViewToClip.GetCol2()).xmm;
+        m_ViewToClipPrev.col2 = (-m_ViewToClipPrev.GetCol2()).xmm;
+
+        m_WorldToView.Transpose();
+        m_WorldToView.col2 = (-m_WorldToView.GetCol2()).xmm;
+        m_WorldToView.Transpose();
+
+        m_WorldToViewPrev.Transpose();
+        m_WorldToViewPrev.col2 = (-m_WorldToViewPrev.GetCol2()).xmm;
+        m_WorldToViewPrev.Transpose();
+    }
+
+    // Compute other matrices
+    m_ViewToWorld = m_WorldToView;
+    m_ViewToWorld.InvertOrtho();
+
+    m_ViewToWorldPrev = m_WorldToViewPrev;
+    m_ViewToWorldPrev.InvertOrtho();
+
+    const ml::float3& cameraPosition = m_ViewToWorld.GetCol3().To3d();
+    const ml::float3& cameraPositionPrev = m_ViewToWorldPrev.GetCol3().To3d();
+    ml::float3 translationDelta = cameraPositionPrev - cameraPosition;
+
+    // IMPORTANT: this part is mandatory needed to preserve precision by making matrices camera relative
+    m_ViewToWorld.SetTranslation( ml::float3::Zero() );
+    m_WorldToView = m_ViewToWorld;
+    m_WorldToView.InvertOrtho();
+
+    m_ViewToWorldPrev.SetTranslation( translationDelta );
+    m_WorldToViewPrev = m_ViewToWorldPrev;
+    m_WorldToViewPrev.InvertOrtho();
+
+    m_WorldToClip = m_ViewToClip * m_WorldToView;
+    m_WorldToClipPrev = m_ViewToClipPrev * m_WorldToViewPrev;
+
+    m_ClipToWorldPrev = m_WorldToClipPrev;
+    m_ClipToWorldPrev.Invert();
+
+    m_ClipToView = m_ViewToClip;
+    m_ClipToView.Invert();
+
+    m_ClipToViewPrev = m_ViewToClipPrev;
+    m_ClipToViewPrev.Invert();
+
+    m_ClipToWorld = m_WorldToClip;
+    m_ClipToWorld.Invert();
+
+    float project[3];
+    float settings[ml::PROJ_NUM];
+    ml::DecomposeProjection(NDC_D3D, NDC_D3D, m_ViewToClip, &flags, settings, nullptr, m_Frustum.pv, project, nullptr);
+    m_ProjectY = project[1];
+    m_IsOrtho = (flags & ml::PROJ_ORTHO) ? -1.0f : 0.0f;
+
+    ml::DecomposeProjection(NDC_D3D, NDC_D3D, m_ViewToClipPrev, &flags, nullptr, nullptr, m_FrustumPrev.pv, nullptr, nullptr);
+
+    m_ViewDirection = -ml::float3(m_ViewToWorld.GetCol2().xmm);
+    m_ViewDirectionPrev = -ml::float3(m_ViewToWorldPrev.GetCol2().xmm);
+
+    m_CameraDelta = ml::float3(translationDelta.x, translationDelta.y, translationDelta.z);
+}
+
+nrd::Result nrd::InstanceImpl::SetDenoiserSettings(Identifier identifier, const void* denoiserSettings)
+{
+    // A denoiser is instantiated for each view, settings are shared
+    Result result = Result::INVALID_ARGUMENT;
+
+    for( DenoiserData& denoiserData : m_DenoiserData )
+    {
+        if (denoiserData.desc.identifier == identifier)
+        {
+            // Settings can change selected permutations
+            if (memcmp(&denoiserData.settings, denoiserSettings, denoiserData.settingsSize))
+            {
+                memcpy(&denoiserData.settings, denoiserSettings, denoiserData.settingsSize);
+                m_SettingsVersion++;
+                m_IsReachabilityDirty = true;
+                m_IsFramePoolDirty = true;
+            }
+
+            result = Result::SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+nrd::Result nrd::InstanceImpl::Resize(uint16_t renderWidth, uint16_t renderHeight)
+{
+    // Textures are not reallocated, i.e. dimensions provided at creation are the maximum
+    if (!renderWidth || !renderHeight)
+        return Result::INVALID_ARGUMENT;
+
+    for (const DenoiserData& denoiserData : m_DenoiserData)
+    {
+        if (renderWidth > denoiserData.desc.renderWidth || renderHeight > denoiserData.desc.renderHeight)
+            return Result::INVALID_ARGUMENT;
+    }
+
+    m_ResizedWidth = renderWidth;
+    m_ResizedHeight = renderHeight;
+
+    return Result::SUCCESS;
+}
+
+nrd::Result nrd::InstanceImpl::GetComputeDispatches(DispatchContextImpl& context, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
+{
+    // Trivial checks
+    if (!identifiers || !identifiersNum)
+    {
+        context.m_ActiveDispatches.clear();
+        context.m_ViewBatchedDispatches.clear();
+        context.m_IsFrameTemplateValid = false;
+
+        dispatchDescs = nullptr;
+        dispatchDescsNum = 0;
+
+        return !identifiersNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_Mutex);
+
+    // Constant data ring: a new frame takes the next partition
+    uint32_t frameIndex = GetViewState(0).m_CommonSettings.frameIndex;
+    if (frameIndex != m_ConstantDataFrameIndex)
+    {
+        m_ConstantDataPartition = (m_ConstantDataPartition + 1) % m_FramesInFlightNum;
+        m_ConstantDataFrameIndex = frameIndex;
+        m_ConstantDataOffset = 0;
+    }
+
+    // Views are switched by copying, i.e. calls for multi-view instances are serialized. Contexts of single-view instances
+    // (disjoint sets of identifiers) run in parallel, but not in parallel with dry runs, which touch all requested denoisers
+    std::shared_lock<std::shared_mutex> sharedLock;
+    if (m_ViewStates.size() == 1)
+    {
+        lock.unlock();
+        sharedLock = std::shared_lock<std::shared_mutex>(m_Mutex);
+    }
+
+    context.m_IsConstantDataOverflowed = false;
+
+    // Steady state: if settings haven't changed since the previous call for the same set of identifiers, previously generated
+    // dispatches are reused and "PushDispatch" only patches constants. "PushDispatch" verifies that the sequence of dispatches
+    // matches the template and falls back to regular generation if branching has changed
+    bool isClearNeeded = false;
+    for (uint32_t viewIndex = 0; viewIndex < (uint32_t)m_ViewStates.size(); viewIndex++)
+        isClearNeeded |= GetViewState(viewIndex).m_CommonSettings.accumulationMode == AccumulationMode::CLEAR_AND_RESTART;
+
+    context.m_FrameTemplateCursor = 0;
+    context.m_DeduplicatedDispatches.clear();
+    context.m_IsFrameTemplateReplayed = !isClearNeeded && IsFrameTemplateReusable(context, identifiers, identifiersNum);
+
+    if (!context.m_IsFrameTemplateReplayed)
+    {
+        context.m_ActiveDispatches.clear();
+        context.m_FrameTemplateDispatches.clear();
+        context.m_FrameTemplateIdentifiers.assign(identifiers, identifiers + identifiersNum);
+        context.m_FrameTemplateSettingsVersion = m_SettingsVersion;
+    }
+
+    // Inject "clear" calls if needed. Up to "CLEAR_RESOURCES_MAX_NUM" resources of the same view, class and size are cleared
+    // by a single dispatch, unused slots are bound to the first resource of the batch
+    if (isClearNeeded)
+    {
+        context.m_ClearBatchResources.clear();
+
+        const ClearResource* batchFirst = nullptr;
+        uint32_t batchSize = 0;
+
+        auto AddClearDispatch = [&]()
+        {
+            size_t resourceOffset = context.m_ClearBatchResources.size() - batchSize;
+            for (uint32_t i = batchSize; i < CLEAR_RESOURCES_MAX_NUM; i++)
+                context.m_ClearBatchResources.push_back(batchFirst->resource);
+
+            const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[ m_DispatchClearIndex[batchFirst->isInteger ? 1 : 0] ];
+            assert( internalDispatchDesc.constantBufferDataSize == sizeof(ClearConstants) );
+
+            ClearConstants clearConstants = {};
+            clearConstants.gResourcesNum = batchSize;
+
+            uint8_t* data = PushConstants(context, internalDispatchDesc.constantBufferDataSize);
+            memcpy(data, &clearConstants, sizeof(clearConstants));
+
+            DispatchDesc dispatchDesc = {};
+            dispatchDesc.resourcesNum = CLEAR_RESOURCES_MAX_NUM;
+            dispatchDesc.name = internalDispatchDesc.name;
+            dispatchDesc.resources = &context.m_ClearBatchResources[resourceOffset];
+            dispatchDesc.constantBufferData = data;
+            dispatchDesc.constantBufferDataSize = internalDispatchDesc.constantBufferDataSize;
+            dispatchDesc.viewIndex = (uint16_t)batchFirst->viewIndex;
+            dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
+            dispatchDesc.gridWidth = DivideUp(batchFirst->w, internalDispatchDesc.numThreads.width);
+            dispatchDesc.gridHeight = DivideUp(batchFirst->h, internalDispatchDesc.numThreads.height);
+
+            context.m_ActiveDispatches.push_back(dispatchDesc);
+            context.m_FrameTemplateDispatches.push_back(uint32_t(-1));
+            context.m_FrameTemplateCursor++;
+
+            batchSize = 0;
+        };
+
+        for (const ClearResource& clearResource : m_ClearResources)
+        {
+            // If current denoiser is in list
+            if (!IsInList(clearResource.identifier, identifiers, identifiersNum))
+                continue;
+
+            // If the view is restarted
+            if (GetViewState(clearResource.viewIndex).m_CommonSettings.accumulationMode != AccumulationMode::CLEAR_AND_RESTART)
+                continue;
+
+            // Flush the current batch
+            if (batchSize && (batchSize == CLEAR_RESOURCES_MAX_NUM || !IsClearBatchable(*batchFirst, clearResource)))
+                AddClearDispatch();
+
+            if (!batchSize)
+                batchFirst = &clearResource;
+
+            context.m_ClearBatchResources.push_back(clearResource.resource);
+            batchSize++;
+        }
+
+        if (batchSize)
+            AddClearDispatch();
+    }
+
+    // Collect dispatches for requested denoisers
+    for (DenoiserData& denoiserData : m_DenoiserData)
+    {
+        // If current denoiser is in list
+        if (!IsInList(denoiserData.desc.identifier, identifiers, identifiersNum))
+            continue;
+
+        // Update denoiser and gather dispatches
+        denoiserData.context = &context;
+
+        LoadView(denoiserData.viewIndex);
+        UpdatePingPong(denoiserData);
+        UpdateGeometryHistory(denoiserData);
+
+        UpdateDenoiser(denoiserData);
+    }
+
+    // Drop leftovers if fewer dispatches have been emitted than in the template (the template has diverged)
+    if (context.m_FrameTemplateCursor < context.m_FrameTemplateDispatches.size())
+        context.m_IsFrameTemplateReplayed = false;
+
+    context.m_ActiveDispatches.resize(context.m_FrameTemplateCursor);
+    context.m_FrameTemplateDispatches.resize(context.m_FrameTemplateCursor);
+
+    // Emit skipped duplicates, which turned out to be not identical (constants differ)
+    ResolveDeduplicatedDispatches(context);
+
+    // Dependencies are the same for the replayed template (ping-pongs are swapped symmetrically)
+    if (m_InterleaveViews)
+        BatchViews(context);
+    else if (!context.m_IsFrameTemplateReplayed)
+        BuildDependencies(context, context.m_ActiveDispatches);
+
+    // "Clear" dispatches are not a part of the steady state
+    context.m_IsFrameTemplateValid = !isClearNeeded;
+
+    // Constants of in-flight frames are not overwritten, instead the call fails
+    if (context.m_IsConstantDataOverflowed)
+    {
+        context.m_IsFrameTemplateValid = false;
+
+        dispatchDescs = nullptr;
+        dispatchDescsNum = 0;
+
+        return Result::FAILURE;
+    }
+
+    const Vector<DispatchDesc>& activeDispatches = m_InterleaveViews ? context.m_ViewBatchedDispatches : context.m_ActiveDispatches;
+    dispatchDescs = activeDispatches.data();
+    dispatchDescsNum = (uint32_t)activeDispatches.size();
+
+    return dispatchDescsNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
+}
+
+nrd::Result nrd::InstanceImpl::CreateDispatchContext(DispatchContextImpl*& context)
+{
+    AllocationCreationScope allocationCreationScope;
+
+    context = Allocate<DispatchContextImpl>(m_StdAllocator, m_StdAllocator);
+    InitDispatchContext(*context);
+
+    return Result::SUCCESS;
+}
+
+void nrd::InstanceImpl::DestroyDispatchContext(DispatchContextImpl& context)
+{
+    Deallocate(m_StdAllocator, &context);
+}
+
+nrd::Result nrd::InstanceImpl::GetReachablePipelines(const Identifier* identifiers, uint32_t identifiersNum, ReachablePipelinesDesc& reachablePipelinesDesc)
+{
+    if (!identifiers && identifiersNum)
+        return Result::INVALID_ARGUMENT;
+
+    // Dry runs switch views and redirect denoisers to the dry run context, i.e. "GetComputeDispatches" must not run meanwhile
+    std::lock_guard<std::shared_mutex> lock(m_Mutex);
+
+    // Nothing has changed since the previous call
+    bool isSameIdentifiers = m_ReachabilityIdentifiers.size() == identifiersNum && !memcmp(m_ReachabilityIdentifiers.data(), identifiers, identifiersNum * sizeof(Identifier));
+    if (isSameIdentifiers && !m_IsReachabilityDirty)
+        m_NewReachablePipelines.clear();
+    else
+    {
+        for (uint8_t& bits : m_PipelineReachability)
+            bits &= ~PIPELINE_REACHABLE;
+
+        // "Clear" dispatches are emitted on resets (including the first frame)
+        for (const ClearResource& clearResource : m_ClearResources)
+        {
+            if (IsInList(clearResource.identifier, identifiers, identifiersNum))
+                m_PipelineReachability[ m_Dispatches[ m_DispatchClearIndex[clearResource.isInteger ? 1 : 0] ].pipelineIndex ] |= PIPELINE_REACHABLE;
+        }
+
+        DryRun(identifiers, identifiersNum);
+
+        // Gather
+        m_ReachablePipelines.clear();
+        m_NewReachablePipelines.clear();
+
+        for (size_t i = 0; i < m_PipelineReachability.size(); i++)
+        {
+            uint8_t& bits = m_PipelineReachability[i];
+            if (!(bits & PIPELINE_REACHABLE))
+                continue;
+
+            m_ReachablePipelines.push_back((uint16_t)i);
+
+            if (!(bits & PIPELINE_REPORTED))
+                m_NewReachablePipelines.push_back((uint16_t)i);
+
+            bits |= PIPELINE_REPORTED;
+        }
+
+        m_ReachabilityIdentifiers.assign(identifiers, identifiers + identifiersNum);
+        m_IsReachabilityDirty = false;
+    }
+
+    reachablePipelinesDesc.pipelineIndices = m_ReachablePipelines.data();
+    reachablePipelinesDesc.pipelineIndicesNum = (uint32_t)m_ReachablePipelines.size();
+    reachablePipelinesDesc.newPipelineIndices = m_NewReachablePipelines.data();
+    reachablePipelinesDesc.newPipelineIndicesNum = (uint32_t)m_NewReachablePipelines.size();
+
+    return Result::SUCCESS;
+}
+
+nrd::Result nrd::InstanceImpl::GetFrameDescriptorPoolDesc(const Identifier* identifiers, uint32_t identifiersNum, DescriptorPoolDesc& descriptorPoolDesc)
+{
+    if (!identifiers && identifiersNum)
+        return Result::INVALID_ARGUMENT;
+
+    // See "GetReachablePipelines"
+    std::lock_guard<std::shared_mutex> lock(m_Mutex);
+
+    // Nothing has changed since the previous call
+    bool isSameIdentifiers = m_FramePoolIdentifiers.size() == identifiersNum && !memcmp(m_FramePoolIdentifiers.data(), identifiers, identifiersNum * sizeof(Identifier));
+    if (!isSameIdentifiers || m_IsFramePoolDirty)
+    {
+        m_DryRunPoolDesc = {};
+        DryRun(identifiers, identifiersNum);
+
+        // Potential clears (any view can be restarted). Clear resources are sorted by batch class, i.e. batching them per identifier
+        // gives the worst case for any split of "identifiers" across "GetComputeDispatches" calls within a frame
+        uint32_t clearBatchesNum = 0;
+        for (uint32_t i = 0; i < identifiersNum; i++)
+        {
+            const ClearResource* batchFirst = nullptr;
+            uint32_t batchSize = 0;
+
+            for (const ClearResource& clearResource : m_ClearResources)
+            {
+                if (clearResource.identifier != identifiers[i])
+                    continue;
+
+                if (!batchSize || batchSize == CLEAR_RESOURCES_MAX_NUM || !IsClearBatchable(*batchFirst, clearResource))
+                {
+                    clearBatchesNum++;
+                    batchFirst = &clearResource;
+                    batchSize = 0;
+                }
+
+                batchSize++;
+            }
+        }
+
+        m_DryRunPoolDesc.storageTexturesMaxNum += clearBatchesNum * CLEAR_RESOURCES_MAX_NUM;
+        m_DryRunPoolDesc.constantBuffersMaxNum += clearBatchesNum;
+        m_DryRunPoolDesc.setsMaxNum += clearBatchesNum;
+
+        if (SAMPLERS_ARE_IN_SEPARATE_SET)
+            m_DryRunPoolDesc.samplersMaxNum += m_Desc.samplersNum;
+        else
+            m_DryRunPoolDesc.samplersMaxNum += clearBatchesNum * m_Desc.samplersNum;
+
+        m_DryRunPoolDesc.setsMaxNum *= GetDescriptorSetSpacesNum(m_Desc);
+
+        m_FramePoolDesc = m_DryRunPoolDesc;
+        m_FramePoolIdentifiers.assign(identifiers, identifiers + identifiersNum);
+        m_IsFramePoolDirty = false;
+    }
+
+    descriptorPoolDesc = m_FramePoolDesc;
+
+    return Result::SUCCESS;
+}
+
+void nrd::InstanceImpl::DryRun(const Identifier* identifiers, uint32_t identifiersNum)
+{
+    // "PushDispatch" only marks pipelines and counts descriptors. Branching doesn't depend on per-frame data, but "Update_X" can modify the denoiser state
+    uint32_t loadedViewIndex = m_LoadedViewIndex;
+
+    for (DenoiserData& denoiserData : m_DenoiserData)
+    {
+        if (!IsInList(denoiserData.desc.identifier, identifiers, identifiersNum))
+            continue;
+
+        denoiserData.context = &m_DryRunContext;
+        LoadView(denoiserData.viewIndex);
+
+        uint32_t accumulatedFrameNum = denoiserData.accumulatedFrameNum;
+        UpdateDenoiser(denoiserData);
+        denoiserData.accumulatedFrameNum = accumulatedFrameNum;
+    }
+
+    LoadView(loadedViewIndex);
+}
+
+nrd::Result nrd::InstanceImpl::DecompressPipelineBytecode(uint32_t pipelineIndex)
+{
+    if (pipelineIndex >= m_Pipelines.size())
+        return Result::INVALID_ARGUMENT;
+
+    std::lock_guard<std::mutex> lock(m_BytecodeMutex);
+
+    // Happens once per block, not a steady state allocation
+    AllocationCreationScope creationScope;
+
+    PipelineDesc& pipelineDesc = m_Pipelines[pipelineIndex];
+    uint64_t shaderHash = HashShaderName(pipelineDesc.shaderFileName);
+
+    for (uint32_t format = 0; format < (uint32_t)ShaderFormat::MAX_NUM; format++)
+    {
+        ComputeShaderDesc& computeShaderDesc = (&pipelineDesc.computeShaderDXBC)[format];
+        if (computeShaderDesc.bytecode)
+            continue;
+
+        uint32_t blockIndex = 0;
+        const ShaderArchiveBlock* block = FindArchivedShader(shaderHash, (ShaderFormat)format, blockIndex);
+        if (!block || !block->size)
+            continue;
+
+        if (m_DecompressedBytecode.empty())
+            m_DecompressedBytecode.resize(GetArchivedShaderBlocksNum(), {});
+
+        ComputeShaderDesc& decompressedBytecode = m_DecompressedBytecode[blockIndex];
+        if (!decompressedBytecode.bytecode)
+        {
+            uint8_t* bytecode = m_StdAllocator.allocate(block->size);
+            if (!bytecode)
+                return Result::FAILURE;
+
+            if (!DecompressArchivedShader(*block, bytecode))
+            {
+                m_StdAllocator.deallocate(bytecode, block->size);
+                return Result::FAILURE;
+            }
+
+            decompressedBytecode.bytecode = bytecode;
+            decompressedBytecode.size = block->size;
+        }
+
+        computeShaderDesc = decompressedBytecode;
+    }
+
+    return Result::SUCCESS;
+}
+
+void nrd::InstanceImpl::AddGraph(const GraphDesc& graph, uint16_t width, uint16_t height)
+{
+    // Textures
+    for (size_t i = 0; i < graph.texturesNum; i++)
+    {
+        const GraphTexture& texture = graph.textures[i];
+
+        Format format = texture.format;
+        if (m_MemoryBudget == MemoryBudget::PARTIALLY_PACKED && texture.packedFormat != Format::MAX_NUM)
+            format = texture.packedFormat;
+
+        TextureDesc textureDesc = {format, DivideUp(width, texture.downsampleFactor), DivideUp(height, texture.downsampleFactor), 1};
+        if (texture.pool == GraphPool::TRANSIENT)
+            AddTextureToTransientPool(textureDesc);
+        else if (texture.pool == GraphPool::PERMANENT)
+            AddTextureToPermanentPool(textureDesc);
+        else
+            AddSharedTextureToPermanentPool(textureDesc, texture.geometryHistory);
+    }
+
+    // Pipelines: dispatches refer to them by local indices resolved at compile time, only unique pipelines are looked up
+    uint16_t pipelineIndices[GRAPH_PIPELINES_MAX_NUM];
+    for (size_t i = 0; i < graph.pipelinesNum; i++)
+        pipelineIndices[i] = AddPipeline(graph.pipelines[i]);
+
+    // Passes
+    for (size_t p = 0; p < graph.passesNum; p++)
+    {
+        const GraphPass& pass = graph.passes[p];
+
+        size_t resourceOffset = m_Resources.size();
+        for (size_t r = pass.resourcesOffset; r < size_t(pass.resourcesOffset + pass.resourcesNum); r++)
+        {
+            const GraphResource& resource = graph.resources[r];
+            PushTexture(resource.descriptorType, resource.indexInPool, resource.mipOffset, resource.mipNum, resource.indexToSwapWith);
+        }
+
+        // Stage
+        if (!m_PrevPassName || strcmp(m_PrevPassName, pass.name))
+            m_Stage++;
+
+        m_PrevPassName = pass.name;
+
+        // Dispatches
+        for (size_t d = pass.dispatchesOffset; d < size_t(pass.dispatchesOffset + pass.dispatchesNum); d++)
+        {
+            const GraphDispatch& dispatch = graph.dispatches[d];
+
+            InternalDispatchDesc computeDispatchDesc = {};
+            computeDispatchDesc.name = pass.name;
+            computeDispatchDesc.pipelineIndex = pipelineIndices[dispatch.pipelineIndex];
+            computeDispatchDesc.downsampleFactor = dispatch.downsampleFactor;
+            computeDispatchDesc.maxRepeatsNum = dispatch.maxRepeatNum;
+            computeDispatchDesc.stage = m_Stage;
+            computeDispatchDesc.sourceDispatchIndex = uint32_t(-1);
+            computeDispatchDesc.constantBufferDataSize = dispatch.passConstants.dataSize;
+            computeDispatchDesc.hasSharedConstants = dispatch.passConstants.hasSharedConstants && m_SharedConstantDataSize != 0;
+            computeDispatchDesc.resourcesNum = uint32_t(m_Resources.size() - resourceOffset);
+            computeDispatchDesc.resources = (ResourceDesc*)resourceOffset;
+            computeDispatchDesc.numThreads = dispatch.numThreads;
+
+            m_Dispatches.push_back(computeDispatchDesc);
+        }
+    }
+}
+
+uint16_t nrd::InstanceImpl::AddPipeline(const GraphPipeline& pipeline)
+{
+    // Unique only
+    auto pipelineKey = std::lower_bound(m_PipelineKeys.begin(), m_PipelineKeys.end(), pipeline.shaderHash, [](const PipelineKey& key, uint64_t hash)
+    {
+        return key.shaderHash < hash;
+    });
+
+    if (pipelineKey != m_PipelineKeys.end() && pipelineKey->shaderHash == pipeline.shaderHash)
+    {
+        assert( !strcmp(m_Pipelines[pipelineKey->pipelineIndex].shaderFileName, pipeline.shaderFileName) && "Shader name hash collision!" );
+
+        return pipelineKey->pipelineIndex;
+    }
+
+    uint16_t pipelineIndex = (uint16_t)m_Pipelines.size();
+    m_PipelineKeys.insert(pipelineKey, {pipeline.shaderHash, pipelineIndex});
+
+    PipelineDesc pipelineDesc = {};
+    pipelineDesc.shaderFileName = pipeline.shaderFileName;
+    pipelineDesc.shaderEntryPointName = NRD_STRINGIFY(NRD_CS_MAIN);
+    pipelineDesc.computeShaderDXBC = pipeline.dxbc;
+    pipelineDesc.computeShaderDXIL = pipeline.dxil;
+    pipelineDesc.computeShaderSPIRV = pipeline.spirv;
+    pipelineDesc.resourceRanges = (ResourceRangeDesc*)m_ResourceRanges.size();
+    pipelineDesc.hasConstantData = pipeline.passConstants.dataSize != 0;
+    pipelineDesc.hasSharedConstantData = pipeline.passConstants.hasSharedConstants && m_SharedConstantDataSize != 0;
+
+    if (pipeline.texturesNum != 0)
+    {
+        m_ResourceRanges.push_back( {DescriptorType::TEXTURE, 0, pipeline.texturesNum} );
+        pipelineDesc.resourceRangesNum++;
+    }
+
+    if (pipeline.storageTexturesNum != 0)
+    {
+        m_ResourceRanges.push_back( {DescriptorType::STORAGE_TEXTURE, 0, pipeline.storageTexturesNum} );
+        pipelineDesc.resourceRangesNum++;
+    }
+
+    m_Pipelines.push_back(pipelineDesc);
+
+    return pipelineIndex;
+}
+
+void nrd::InstanceImpl::DeduplicateDispatches(const DenoiserData& denoiserData, size_t resourceOffset)
+{
+    for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < m_Dispatches.size(); dispatchIndex++)
+    {
+        // Find an identical dispatch in previous denoisers
+        size_t sourceDispatchIndex = 0;
+        for (; sourceDispatchIndex < denoiserData.dispatchOffset; sourceDispatchIndex++)
+        {
+            if (IsDuplicateDispatch(sourceDispatchIndex, dispatchIndex, denoiserData))
+                break;
+        }
+
+        if (sourceDispatchIndex == denoiserData.dispatchOffset)
+            continue;
+
+        InternalDispatchDesc& dispatchDesc = m_Dispatches[dispatchIndex];
+        const InternalDispatchDesc& sourceDispatchDesc = m_Dispatches[sourceDispatchIndex];
+        dispatchDesc.sourceDispatchIndex = sourceDispatchDesc.sourceDispatchIndex == uint32_t(-1) ? (uint32_t)sourceDispatchIndex : sourceDispatchDesc.sourceDispatchIndex;
+
+        // Rewire consumers to outputs of the source dispatch
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            const ResourceDesc& sourceResource = m_Resources[(size_t)sourceDispatchDesc.resources + r];
+            uint16_t indexInPool = m_Resources[(size_t)dispatchDesc.resources + r].indexInPool;
+
+            if (sourceResource.type != ResourceType::TRANSIENT_POOL || sourceResource.indexInPool == indexInPool)
+                continue;
+
+            for (size_t i = resourceOffset; i < m_Resources.size(); i++)
+            {
+                ResourceDesc& resource = m_Resources[i];
+                if (resource.type == ResourceType::TRANSIENT_POOL && resource.indexInPool == indexInPool)
+                    resource.indexInPool = sourceResource.indexInPool;
+            }
+
+            // Remove the texture if it has been added by the current denoiser (it's not used anymore)
+            if (indexInPool >= m_TransientPoolOffset)
+            {
+                m_TransientPool.erase(m_TransientPool.begin() + indexInPool);
+
+                for (size_t i = resourceOffset; i < m_Resources.size(); i++)
+                {
+                    ResourceDesc& resource = m_Resources[i];
+                    if (resource.type == ResourceType::TRANSIENT_POOL && resource.indexInPool > indexInPool)
+                        resource.indexInPool--;
+                }
+
+                for (size_t p = 0; p < denoiserData.pingPongNum; p++)
+                {
+                    PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + p];
+                    if (m_Resources[pingPong.resourceIndex].type == ResourceType::TRANSIENT_POOL && pingPong.indexInPoolToSwapWith > indexInPool)
+                        pingPong.indexInPoolToSwapWith--;
+                }
+            }
+        }
+    }
+}
+
+bool nrd::InstanceImpl::IsDuplicateDispatch(size_t sourceDispatchIndex, size_t dispatchIndex, const DenoiserData& denoiserData) const
+{
+    const InternalDispatchDesc& a = m_Dispatches[sourceDispatchIndex];
+    const InternalDispatchDesc& b = m_Dispatches[dispatchIndex];
+
+    // Pipeline and grid size must match (shared constants are denoiser specific)
+    if (a.pipelineIndex != b.pipelineIndex || a.resourcesNum != b.resourcesNum || a.constantBufferDataSize != b.constantBufferDataSize ||
+        a.downsampleFactor != b.downsampleFactor || a.maxRepeatsNum != 1 || b.maxRepeatsNum != 1 || a.hasSharedConstants || b.hasSharedConstants)
+        return false;
+
+    const DenoiserData* sourceDenoiserData = nullptr;
+    for (const DenoiserData& prevDenoiserData : m_DenoiserData)
+    {
+        if (prevDenoiserData.dispatchOffset <= sourceDispatchIndex)
+            sourceDenoiserData = &prevDenoiserData;
+    }
+
+    // User provided inputs of different views are different resources
+    if (sourceDenoiserData->viewIndex != denoiserData.viewIndex)
+        return false;
+
+    if (sourceDenoiserData->desc.renderWidth != denoiserData.desc.renderWidth || sourceDenoiserData->desc.renderHeight != denoiserData.desc.renderHeight)
+        return false;
+
+    for (uint32_t r = 0; r < b.resourcesNum; r++)
+    {
+        size_t resourceIndexA = (size_t)a.resources + r;
+        size_t resourceIndexB = (size_t)b.resources + r;
+        const ResourceDesc& ra = m_Resources[resourceIndexA];
+        const ResourceDesc& rb = m_Resources[resourceIndexB];
+
+        if (ra.stateNeeded != rb.stateNeeded || ra.type != rb.type || ra.mipOffset != rb.mipOffset || ra.mipNum != rb.mipNum)
+            return false;
+
+        // Ping-pongs are not supported
+        for (const PingPong& pingPong : m_PingPongs)
+        {
+            if (pingPong.resourceIndex == resourceIndexA || pingPong.resourceIndex == resourceIndexB)
+                return false;
+        }
+
+        // Inputs must be the same user provided resources
+        if (ra.stateNeeded == DescriptorType::TEXTURE)
+        {
+            if (ra.type == ResourceType::TRANSIENT_POOL || ra.type == ResourceType::PERMANENT_POOL)
+                return false;
+
+            continue;
+        }
+
+        // Outputs must be textures from the transient pool with the same description
+        if (ra.type != ResourceType::TRANSIENT_POOL)
+            return false;
+
+        const TextureDesc& ta = m_TransientPool[ra.indexInPool];
+        const TextureDesc& tb = m_TransientPool[rb.indexInPool];
+        if (ta.format != tb.format || ta.width != tb.width || ta.height != tb.height || ta.mipNum != tb.mipNum)
+            return false;
+
+        // The output of the source dispatch must survive till the current dispatch. Duplicates of the same source are not a problem
+        uint32_t sourceIndex = a.sourceDispatchIndex == uint32_t(-1) ? (uint32_t)sourceDispatchIndex : a.sourceDispatchIndex;
+        for (size_t i = sourceDispatchIndex + 1; i < m_Dispatches.size(); i++)
+        {
+            if (i == dispatchIndex)
+                continue;
+
+            const InternalDispatchDesc& dispatchDesc = m_Dispatches[i];
+            bool isCurrentDenoiser = i >= denoiserData.dispatchOffset;
+            bool isSameSource = dispatchDesc.sourceDispatchIndex == sourceIndex;
+
+            for (uint32_t j = 0; j < dispatchDesc.resourcesNum; j++)
+            {
+                const ResourceDesc& resource = m_Resources[(size_t)dispatchDesc.resources + j];
+                if (resource.type != ResourceType::TRANSIENT_POOL || resource.indexInPool != ra.indexInPool)
+                    continue;
+
+                // The current denoiser can't use the texture for something else
+                if (isCurrentDenoiser && ra.indexInPool != rb.indexInPool)
+                    return false;
+
+                if (resource.stateNeeded == DescriptorType::STORAGE_TEXTURE && !isSameSource)
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void nrd::InstanceImpl::ResolveDeduplicatedDispatches(DispatchContextImpl& context)
+{
+    size_t emittedNum = 0;
+
+    for (size_t i = 0; i < context.m_DeduplicatedDispatches.size(); i++)
+    {
+        DeduplicatedDispatch& deduplicatedDispatch = context.m_DeduplicatedDispatches[i];
+
+        // Account for already emitted duplicates
+        size_t referencePosition = deduplicatedDispatch.referencePosition;
+        bool isIdentical = true;
+
+        for (size_t j = 0; j < i; j++)
+        {
+            const DeduplicatedDispatch& prev = context.m_DeduplicatedDispatches[j];
+            if (prev.isEmitted && prev.position <= deduplicatedDispatch.referencePosition)
+                referencePosition++;
+
+            // If a previous duplicate of the same source has been emitted, the reference can be overwritten
+            if (prev.isEmitted && prev.sourceDispatchIndex == deduplicatedDispatch.sourceDispatchIndex)
+                isIdentical = false;
+        }
+
+        const DispatchDesc& reference = context.m_ActiveDispatches[referencePosition];
+        const DispatchDesc& dispatchDesc = deduplicatedDispatch.dispatchDesc;
+        if (isIdentical && !memcmp(reference.constantBufferData, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize))
+            continue;
+
+        // Emit
+        size_t position = deduplicatedDispatch.position + emittedNum;
+        context.m_ActiveDispatches.insert(context.m_ActiveDispatches.begin() + position, dispatchDesc);
+        context.m_FrameTemplateDispatches.insert(context.m_FrameTemplateDispatches.begin() + position, deduplicatedDispatch.dispatchIndex);
+
+        deduplicatedDispatch.isEmitted = true;
+        emittedNum++;
+    }
+
+    // The template is not reusable "as is" anymore
+    if (emittedNum)
+        context.m_IsFrameTemplateReplayed = false;
+}
+
+void nrd::InstanceImpl::GatherTransientLifetimes(const DenoiserData& denoiserData)
+{
+    // IMPORTANT: dispatches of a denoiser are added in the same order as they get emitted in "Update_X". Permutations and
+    // repeats of a pass are not ordered (A-trous iterations alternate between several dispatches), thus a lifetime is
+    // tracked in "stages". Denoisers never overlap in time, thus stages are just accumulated across denoisers. Interleaved
+    // views restart stages from the beginning, since they get executed simultaneously (see "BatchViews")
+    size_t lifetimeOffset = m_TransientLifetimes.size();
+
+    for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < m_Dispatches.size(); dispatchIndex++)
+    {
+        const InternalDispatchDesc& dispatchDesc = m_Dispatches[dispatchIndex];
+        uint16_t stage = dispatchDesc.stage;
+
+        size_t resourceOffset = (size_t)dispatchDesc.resources;
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            size_t resourceIndex = resourceOffset + r;
+            const ResourceDesc& resource = m_Resources[resourceIndex];
+            if (resource.type != ResourceType::TRANSIENT_POOL)
+                continue;
+
+            // Ping-pong partner (if any) lives in the same stages
+            uint16_t indices[2] = {resource.indexInPool, uint16_t(-1)};
+            for (size_t p = 0; p < denoiserData.pingPongNum; p++)
+            {
+                const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + p];
+                if (pingPong.resourceIndex == resourceIndex)
+                    indices[1] = pingPong.indexInPoolToSwapWith;
+            }
+
+            for (uint16_t indexInPool : indices)
+            {
+                if (indexInPool == uint16_t(-1))
+                    continue;
+
+                // A texture can be reused by several denoisers, but within a denoiser a single interval is enough
+                size_t l = lifetimeOffset;
+                for (; l < m_TransientLifetimes.size(); l++)
+                {
+                    TransientLifetime& lifetime = m_TransientLifetimes[l];
+                    if (lifetime.indexInPool == indexInPool)
+                    {
+                        lifetime.lastStage = stage;
+                        break;
+                    }
+                }
+
+                if (l == m_TransientLifetimes.size())
+                {
+                    // Outputs of a deduplicated dispatch can come from the source dispatch of a previous denoiser
+                    uint16_t firstStage = stage;
+                    if (dispatchDesc.sourceDispatchIndex != uint32_t(-1) && resource.stateNeeded == DescriptorType::STORAGE_TEXTURE)
+                    {
+                        for (size_t prev = lifetimeOffset; prev-- > 0; )
+                        {
+                            if (m_TransientLifetimes[prev].indexInPool == indexInPool)
+                            {
+                                firstStage = m_TransientLifetimes[prev].firstStage;
+                                break;
+                            }
+                        }
+                    }
+
+                    m_TransientLifetimes.push_back( {indexInPool, firstStage, stage} );
+                }
+            }
+        }
+    }
+}
+
+void nrd::InstanceImpl::PlanTransientPoolAliasing()
+{
+    // Interval graph coloring: textures are placed from the biggest to the smallest at the lowest offset, which doesn't
+    // overlap in memory with already placed textures having an overlapping lifetime
+    size_t texturesNum = m_TransientPool.size();
+
+    m_TransientPoolAliasing.resize(texturesNum);
+    m_AliasingGroups.clear();
+
+    Vector<uint16_t> order(GetStdAllocator());
+    order.reserve(texturesNum);
+
+    for (size_t i = 0; i < texturesNum; i++)
+    {
+        m_TransientPoolAliasing[i] = {0, EstimateTextureSize(m_TransientPool[i]), 0};
+        order.push_back((uint16_t)i);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](uint16_t a, uint16_t b)
+    {
+        return m_TransientPoolAliasing[a].size > m_TransientPoolAliasing[b].size;
+    });
+
+    auto IsLifetimeOverlapped = [&](uint16_t a, uint16_t b)
+    {
+        for (const TransientLifetime& la : m_TransientLifetimes)
+        {
+            if (la.indexInPool != a)
+                continue;
+
+            for (const TransientLifetime& lb : m_TransientLifetimes)
+            {
+                if (lb.indexInPool == b && la.firstStage <= lb.lastStage && lb.firstStage <= la.lastStage)
+                    return true;
+            }
+        }
+
+        return false;
+    };
+
+    for (size_t i = 0; i < texturesNum; i++)
+    {
+        TransientAliasingDesc& current = m_TransientPoolAliasing[order[i]];
+
+        // Candidates are "0" and ends of conflicting textures
+        uint64_t bestOffset = uint64_t(-1);
+        for (size_t c = 0; c <= i; c++)
+        {
+            uint64_t offset = 0;
+            if (c != i)
+            {
+                if (!IsLifetimeOverlapped(order[i], order[c]))
+                    continue;
+
+                const TransientAliasingDesc& candidate = m_TransientPoolAliasing[order[c]];
+                offset = candidate.offset + candidate.size;
+            }
+
+            if (offset >= bestOffset)
+                continue;
+
+            bool isFree = true;
+            for (size_t j = 0; j < i && isFree; j++)
+            {
+                const TransientAliasingDesc& placed = m_TransientPoolAliasing[order[j]];
+                if (offset < placed.offset + placed.size && placed.offset < offset + current.size)
+                    isFree = !IsLifetimeOverlapped(order[i], order[j]);
+            }
+
+            if (isFree)
+                bestOffset = offset;
+        }
+
+        current.offset = bestOffset;
+    }
+
+    // Split into groups of textures, which overlap in memory (offsets become group relative)
+    std::stable_sort(order.begin(), order.end(), [&](uint16_t a, uint16_t b)
+    {
+        return m_TransientPoolAliasing[a].offset < m_TransientPoolAliasing[b].offset;
+    });
+
+    uint64_t groupStart = 0;
+    uint64_t groupEnd = 0;
+    for (size_t i = 0; i < texturesNum; i++)
+    {
+        TransientAliasingDesc& current = m_TransientPoolAliasing[order[i]];
+
+        if (m_AliasingGroups.empty() || current.offset >= groupEnd)
+        {
+            groupStart = current.offset;
+            m_AliasingGroups.push_back( {0} );
+        }
+
+        groupEnd = std::max(groupEnd, current.offset + current.size);
+
+        current.offset -= groupStart;
+        current.aliasingGroupIndex = uint32_t(m_AliasingGroups.size() - 1);
+        m_AliasingGroups.back().size = groupEnd - groupStart;
+    }
+}
+
+void nrd::InstanceImpl::PrepareDesc()
+{
+    m_Desc = {};
+
+    m_Desc.constantBufferRegisterIndex = 0;
+    m_Desc.constantBufferSpaceIndex = NRD_CONSTANT_BUFFER_SPACE_INDEX;
+
+    m_Desc.sharedConstantBufferRegisterIndex = 1;
+    for (const DenoiserData& denoiserData : m_DenoiserData)
+        m_Desc.sharedConstantBufferMaxDataSize = std::max(denoiserData.sharedConstantBufferDataSize, m_Desc.sharedConstantBufferMaxDataSize);
+
+    m_Desc.samplers = g_Samplers.data();
+    m_Desc.samplersNum = (uint32_t)g_Samplers.size();
+    m_Desc.samplersSpaceIndex = NRD_SAMPLERS_SPACE_INDEX;
+    m_Desc.samplersBaseRegisterIndex = 0;
+
+    m_Desc.pipelines = m_Pipelines.data();
+    m_Desc.pipelinesNum = (uint32_t)m_Pipelines.size();
+    m_Desc.resourcesSpaceIndex = NRD_RESOURCES_SPACE_INDEX;
+
+    m_Desc.permanentPool = m_PermanentPool.data();
+    m_Desc.permanentPoolSize = (uint32_t)m_PermanentPool.size();
+
+    m_Desc.transientPool = m_TransientPool.data();
+    m_Desc.transientPoolSize = (uint32_t)m_TransientPool.size();
+
+    m_Desc.transientPoolAliasing = m_TransientPoolAliasing.data();
+    m_Desc.aliasingGroups = m_AliasingGroups.data();
+    m_Desc.aliasingGroupsNum = (uint32_t)m_AliasingGroups.size();
+
+    m_Desc.viewsNum = (uint32_t)m_ViewStates.size();
+
+    m_Desc.constantData = m_ConstantData;
+    m_Desc.framesInFlightNum = m_FramesInFlightNum;
+    m_Desc.constantDataPerFrameSize = m_ConstantDataPerFrameSize;
+
+    if (SAMPLERS_ARE_IN_SEPARATE_SET)
+        m_Desc.descriptorPoolDesc.samplersMaxNum += m_Desc.samplersNum;
+
+    // Calculate descriptor heap (sets) requirements
+    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
+    {
+        size_t textureOffset = (size_t)dispatchDesc.resources;
+        dispatchDesc.resources = &m_Resources[textureOffset];
+
+        for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++)
+        {
+            const ResourceDesc& resource = dispatchDesc.resources[i];
+            if (resource.stateNeeded == DescriptorType::TEXTURE)
+                m_Desc.descriptorPoolDesc.texturesMaxNum += dispatchDesc.maxRepeatsNum;
+            else if (resource.stateNeeded == DescriptorType::STORAGE_TEXTURE)
+                m_Desc.descriptorPoolDesc.storageTexturesMaxNum += dispatchDesc.maxRepeatsNum;
+        }
+
+        m_Desc.descriptorPoolDesc.setsMaxNum += dispatchDesc.maxRepeatsNum;
+
+        if (!SAMPLERS_ARE_IN_SEPARATE_SET)
+            m_Desc.descriptorPoolDesc.samplersMaxNum += dispatchDesc.maxRepeatsNum * m_Desc.samplersNum;
+
+        if (dispatchDesc.constantBufferDataSize != 0)
+        {
+            m_Desc.descriptorPoolDesc.constantBuffersMaxNum += dispatchDesc.maxRepeatsNum;
+            m_Desc.constantBufferMaxDataSize = std::max(dispatchDesc.constantBufferDataSize, m_Desc.constantBufferMaxDataSize);
+        }
+
+        if (dispatchDesc.hasSharedConstants)
+            m_Desc.descriptorPoolDesc.constantBuffersMaxNum += dispatchDesc.maxRepeatsNum;
+
+        // Worst case for "GetComputeDispatches" (all denoisers are requested)
+        m_DispatchesMaxNum += dispatchDesc.maxRepeatsNum;
+
+        for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++)
+            m_SubresourcesMaxNum += dispatchDesc.resources[i].mipNum * dispatchDesc.maxRepeatsNum;
+    }
+
+    m_PipelineReachability.resize(m_Pipelines.size());
+
+    // For potential clears (any subset of clear resources can't produce more batches than all of them)
+    m_ClearBatchesMaxNum = GetClearBatchesNum(m_ClearResources.data(), m_ClearResources.size());
+    m_Desc.descriptorPoolDesc.storageTexturesMaxNum += m_ClearBatchesMaxNum * CLEAR_RESOURCES_MAX_NUM;
+    m_Desc.descriptorPoolDesc.constantBuffersMaxNum += m_ClearBatchesMaxNum;
+    m_Desc.descriptorPoolDesc.setsMaxNum += m_ClearBatchesMaxNum;
+
+    if (!SAMPLERS_ARE_IN_SEPARATE_SET)
+        m_Desc.descriptorPoolDesc.samplersMaxNum += m_ClearBatchesMaxNum * m_Desc.samplersNum;
+
+    m_DispatchesMaxNum += m_ClearBatchesMaxNum;
+    m_SubresourcesMaxNum += m_ClearBatchesMaxNum * CLEAR_RESOURCES_MAX_NUM;
+
+    InitDispatchContext(m_DefaultContext);
+    InitDispatchContext(m_DryRunContext);
+
+    // Assign resources
+    for (PipelineDesc& pipelineDesc : m_Pipelines)
+    {
+        size_t descriptorRangeffset = (size_t)pipelineDesc.resourceRanges;
+        pipelineDesc.resourceRanges = &m_ResourceRanges[descriptorRangeffset];
+    }
+
+    FindUniquePipelines();
+
+    m_Desc.descriptorPoolDesc.setsMaxNum *= GetDescriptorSetSpacesNum(m_Desc);
+
+    PrepareMemoryUsage();
+}
+
+void nrd::InstanceImpl::FindUniquePipelines()
+{
+    constexpr size_t FORMATS_NUM = (size_t)ShaderFormat::MAX_NUM;
+    constexpr uint32_t NOT_ARCHIVED = uint32_t(-1);
+
+    // Not yet decompressed bytecode is compared by archive blocks (the archive stores identical bytecode once)
+    Vector<uint32_t> blockIndices(m_Pipelines.size() * FORMATS_NUM, NOT_ARCHIVED, GetStdAllocator());
+    for (size_t i = 0; i < m_Pipelines.size(); i++)
+    {
+        const PipelineDesc& pipelineDesc = m_Pipelines[i];
+        uint64_t shaderHash = HashShaderName(pipelineDesc.shaderFileName);
+
+        for (size_t format = 0; format < FORMATS_NUM; format++)
+        {
+            if (!(&pipelineDesc.computeShaderDXBC)[format].bytecode)
+                FindArchivedShader(shaderHash, (ShaderFormat)format, blockIndices[i * FORMATS_NUM + format]);
+        }
+    }
+
+    auto IsEquivalent = [&](size_t a, size_t b)
+    {
+        const PipelineDesc& pipelineA = m_Pipelines[a];
+        const PipelineDesc& pipelineB = m_Pipelines[b];
+
+        if (pipelineA.hasConstantData != pipelineB.hasConstantData || pipelineA.hasSharedConstantData != pipelineB.hasSharedConstantData
+            || pipelineA.resourceRangesNum != pipelineB.resourceRangesNum || strcmp(pipelineA.shaderEntryPointName, pipelineB.shaderEntryPointName))
+            return false;
+
+        for (uint32_t i = 0; i < pipelineA.resourceRangesNum; i++)
+        {
+            const ResourceRangeDesc& rangeA = pipelineA.resourceRanges[i];
+            const ResourceRangeDesc& rangeB = pipelineB.resourceRanges[i];
+
+            if (rangeA.descriptorType != rangeB.descriptorType || rangeA.baseRegisterIndex != rangeB.baseRegisterIndex || rangeA.descriptorsNum != rangeB.descriptorsNum)
+                return false;
+        }
+
+        // Shaders loaded by name (nothing is embedded) can't be compared
+        bool hasBytecode = false;
+        for (size_t format = 0; format < FORMATS_NUM; format++)
+        {
+            const ComputeShaderDesc& shaderA = (&pipelineA.computeShaderDXBC)[format];
+            const ComputeShaderDesc& shaderB = (&pipelineB.computeShaderDXBC)[format];
+            uint32_t blockIndexA = blockIndices[a * FORMATS_NUM + format];
+            uint32_t blockIndexB = blockIndices[b * FORMATS_NUM + format];
+
+            if (shaderA.bytecode && shaderB.bytecode)
+            {
+                if (shaderA.size != shaderB.size || (shaderA.bytecode != shaderB.bytecode && memcmp(shaderA.bytecode, shaderB.bytecode, (size_t)shaderA.size)))
+                    return false;
+            }
+            else if (shaderA.bytecode || shaderB.bytecode || blockIndexA != blockIndexB)
+                return false;
+
+            hasBytecode |= shaderA.bytecode || blockIndexA != NOT_ARCHIVED;
+        }
+
+        return hasBytecode;
+    };
+
+    m_Desc.uniquePipelinesNum = 0;
+    for (size_t i = 0; i < m_Pipelines.size(); i++)
+    {
+        PipelineDesc& pipelineDesc = m_Pipelines[i];
+        pipelineDesc.uniquePipelineIndex = (uint16_t)i;
+
+        for (size_t j = 0; j < i; j++)
+        {
+            if (m_Pipelines[j].uniquePipelineIndex == j && IsEquivalent(j, i))
+            {
+                pipelineDesc.uniquePipelineIndex = (uint16_t)j;
+                break;
+            }
+        }
+
+        if (pipelineDesc.uniquePipelineIndex == i)
+            m_Desc.uniquePipelinesNum++;
+    }
+}
+
+void nrd::InstanceImpl::PrepareMemoryUsage()
+{
+    m_MemoryUsageEntries.clear();
+    m_MemoryUsage = {};
+
+    for (const TextureDesc& textureDesc : m_PermanentPool)
+        m_MemoryUsage.permanentPoolSize += EstimateTextureSize(textureDesc);
+
+    for (const TextureDesc& textureDesc : m_TransientPool)
+        m_MemoryUsage.transientPoolSize += EstimateTextureSize(textureDesc);
+
+    uint64_t aliasedSize = 0;
+    for (const AliasingGroupDesc& aliasingGroup : m_AliasingGroups)
+        aliasedSize += aliasingGroup.size;
+
+    if (!m_AliasingGroups.empty() && aliasedSize < m_MemoryUsage.transientPoolSize)
+        m_MemoryUsage.transientPoolAliasedSize = m_MemoryUsage.transientPoolSize - aliasedSize;
+
+    Vector<uint16_t> sharedTextures(GetStdAllocator()); // sorted
+    Vector<uint16_t> geometryHistoryPairs(GetStdAllocator()); // sorted
+    uint64_t geometryHistoryCopiesSize = 0;
+    for (size_t i = 0; i < m_DenoiserData.size(); i++)
+    {
+        const DenoiserData& denoiserData = m_DenoiserData[i];
+        size_t entryOffset = m_MemoryUsageEntries.size();
+
+        auto AddTexture = [&](const TextureDesc& textureDesc, bool isHistory, bool isShared)
+        {
+            size_t j = entryOffset;
+            for (; j < m_MemoryUsageEntries.size(); j++)
+            {
+                const MemoryUsageEntry& entry = m_MemoryUsageEntries[j];
+                if (entry.format == textureDesc.format && entry.isHistory == isHistory)
+                    break;
+            }
+
+            if (j == m_MemoryUsageEntries.size())
+                m_MemoryUsageEntries.push_back( {denoiserData.desc.identifier, denoiserData.viewIndex, textureDesc.format, isHistory} );
+
+            uint64_t size = EstimateTextureSize(textureDesc);
+
+            MemoryUsageEntry& entry = m_MemoryUsageEntries[j];
+            entry.texturesNum++;
+            entry.size += size;
+            if (isShared)
+                entry.sharedSize += size;
+        };
+
+        for (uint16_t j = 0; j < denoiserData.permanentPoolNum; j++)
+            AddTexture(m_PermanentPool[denoiserData.permanentPoolOffset + j], true, false);
+
+        for (uint16_t j = 0; j < denoiserData.transientPoolNum; j++)
+            AddTexture(m_TransientPool[denoiserData.transientPoolOffset + j], false, false);
+
+        // Textures of previous denoisers, which are used by dispatches of the denoiser (aliased transient textures and shared geometry history)
+        size_t dispatchEnd = i + 1 < m_DenoiserData.size() ? m_DenoiserData[i + 1].dispatchOffset : m_DispatchClearIndex[0];
+        uint16_t permanentPoolEnd = denoiserData.permanentPoolOffset + denoiserData.permanentPoolNum;
+        uint16_t transientPoolEnd = denoiserData.transientPoolOffset + denoiserData.transientPoolNum;
+
+        sharedTextures.clear();
+        for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < dispatchEnd; dispatchIndex++)
+        {
+            const InternalDispatchDesc& dispatchDesc = m_Dispatches[dispatchIndex];
+            for (uint32_t j = 0; j < dispatchDesc.resourcesNum; j++)
+            {
+                const ResourceDesc& resource = dispatchDesc.resources[j];
+
+                uint16_t key;
+                if (resource.type == ResourceType::PERMANENT_POOL)
+                {
+                    if (resource.indexInPool >= denoiserData.permanentPoolOffset && resource.indexInPool < permanentPoolEnd)
+                        continue;
+
+                    key = resource.indexInPool | 0x8000;
+                }
+                else if (resource.type == ResourceType::TRANSIENT_POOL)
+                {
+                    if (resource.indexInPool >= denoiserData.transientPoolOffset && resource.indexInPool < transientPoolEnd)
+                        continue;
+
+                    key = resource.indexInPool;
+                }
+                else
+                    continue;
+
+                auto it = std::lower_bound(sharedTextures.begin(), sharedTextures.end(), key);
+                if (it == sharedTextures.end() || *it != key)
+                    sharedTextures.insert(it, key);
+            }
+        }
+
+        for (uint16_t key : sharedTextures)
+        {
+            if (key & 0x8000)
+            {
+                const TextureDesc& textureDesc = m_PermanentPool[key & 0x7FFF];
+                AddTexture(textureDesc, true, true);
+                m_MemoryUsage.permanentPoolSharedSize += EstimateTextureSize(textureDesc);
+            }
+            else
+            {
+                const TextureDesc& textureDesc = m_TransientPool[key];
+                AddTexture(textureDesc, false, true);
+                m_MemoryUsage.transientPoolSharedSize += EstimateTextureSize(textureDesc);
+            }
+        }
+
+        // Shared geometry history is double buffered: the first sharer allocates two textures instead of one, others reference two
+        // instead of allocating one, i.e. one texture per history and sharer is not saved
+        geometryHistoryPairs.clear();
+        for (size_t p = 0; p < denoiserData.pingPongNum; p++)
+        {
+            const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + p];
+            if (!pingPong.isGeometryHistory)
+                continue;
+
+            uint16_t key = std::max(m_Resources[pingPong.resourceIndex].indexInPool, pingPong.indexInPoolToSwapWith);
+            auto it = std::lower_bound(geometryHistoryPairs.begin(), geometryHistoryPairs.end(), key);
+            if (it == geometryHistoryPairs.end() || *it != key)
+            {
+                geometryHistoryPairs.insert(it, key);
+                geometryHistoryCopiesSize += EstimateTextureSize(m_PermanentPool[key]);
+            }
+        }
+    }
+
+    m_MemoryUsage.permanentPoolSharedSize -= geometryHistoryCopiesSize;
+
+    m_MemoryUsage.entries = m_MemoryUsageEntries.data();
+    m_MemoryUsage.entriesNum = (uint32_t)m_MemoryUsageEntries.size();
+}
 
-    m_ViewToWorldPrev = m_WorldToViewPrev;
-    m_ViewToWorldPrev.InvertOrtho();
+nrd::Result nrd::InstanceImpl::CompactTables()
+{
+    // Tables, which are needed after creation, and their final capacities. Creation is the measuring phase,
+    // i.e. sizes are exact and no reallocations happen later
+    auto ForEachTable = [&](auto&& visitor)
+    {
+        visitor(m_DenoiserData, m_DenoiserData.size());
+        visitor(m_Dispatches, m_Dispatches.size());
+        visitor(m_Resources, m_Resources.size());
+        visitor(m_PingPongs, m_PingPongs.size());
+        visitor(m_Pipelines, m_Pipelines.size());
+        visitor(m_ResourceRanges, m_ResourceRanges.size());
+        visitor(m_PipelineKeys, m_PipelineKeys.size());
+        visitor(m_ClearResources, m_ClearResources.size());
+        visitor(m_ViewStates, m_ViewStates.size());
+        visitor(m_PermanentPool, m_PermanentPool.size());
+        visitor(m_TransientPool, m_TransientPool.size());
+        visitor(m_TransientPoolAliasing, m_TransientPoolAliasing.size());
+        visitor(m_AliasingGroups, m_AliasingGroups.size());
+        visitor(m_MemoryUsageEntries, m_MemoryUsageEntries.size());
+        visitor(m_PipelineReachability, m_PipelineReachability.size());
+        visitor(m_ReachablePipelines, m_Pipelines.size());
+        visitor(m_NewReachablePipelines, m_Pipelines.size());
+
+        visitor(m_ReachabilityIdentifiers, m_DenoiserData.size());
+        visitor(m_FramePoolIdentifiers, m_DenoiserData.size());
+
+        for (DispatchContextImpl* context : {&m_DefaultContext, &m_DryRunContext})
+        {
+            visitor(context->m_ActiveDispatches, context->m_ActiveDispatches.capacity());
+            visitor(context->m_FrameTemplateDispatches, context->m_FrameTemplateDispatches.capacity());
+            visitor(context->m_FrameTemplateIdentifiers, context->m_FrameTemplateIdentifiers.capacity());
+            visitor(context->m_DeduplicatedDispatches, context->m_DeduplicatedDispatches.capacity());
+            visitor(context->m_ViewBatchedDispatches, context->m_ViewBatchedDispatches.capacity());
+            visitor(context->m_ViewBatchKeys, context->m_ViewBatchKeys.capacity());
+            visitor(context->m_ViewBatchOrder, context->m_ViewBatchOrder.capacity());
+            visitor(context->m_Dependencies, context->m_Dependencies.capacity());
+            visitor(context->m_SubresourceStates, context->m_SubresourceStates.capacity());
+            visitor(context->m_SubresourceReads, context->m_SubresourceReads.capacity());
+            visitor(context->m_ClearBatchResources, context->m_ClearBatchResources.capacity());
+            visitor(context->m_ScratchConstantData, context->m_ScratchConstantData.size());
+        }
+    };
 
-    const ml::float3& cameraPosition = m_ViewToWorld.GetCol3().To3d();
-    const ml::float3& cameraPositionPrev = m_ViewToWorldPrev.GetCol3().To3d();
-    ml::float3 translationDelta = cameraPositionPrev - cameraPosition;
+    // Measure (the constant data ring goes first, since it's the most aligned)
+    m_ArenaAlignment = std::max(m_ConstantDataAlignment, ARENA_ALIGNMENT);
 
-    // IMPORTANT: this part is mandatory needed to preserve precision by making matrices camera relative
-    m_ViewToWorld.SetTranslation( ml::float3::Zero() );
-    m_WorldToView = m_ViewToWorld;
-    m_WorldToView.InvertOrtho();
+    size_t arenaSize = m_OwnedConstantDataSize;
+    ForEachTable([&](auto& table, size_t num)
+    {
+        using T = typename std::remove_reference_t<decltype(table)>::value_type;
+        static_assert(std::is_trivially_destructible<T>::value, "Arena tables are freed as a whole");
 
-    m_ViewToWorldPrev.SetTranslation( translationDelta );
-    m_WorldToViewPrev = m_ViewToWorldPrev;
-    m_WorldToViewPrev.InvertOrtho();
+        arenaSize = GetAlignedSize(arenaSize, (uint32_t)alignof(T)) + num * sizeof(T);
+    });
 
-    m_WorldToClip = m_ViewToClip * m_WorldToView;
-    m_WorldToClipPrev = m_ViewToClipPrev * m_WorldToViewPrev;
+    const MemoryAllocatorInterface& lowLevelAllocator = m_StdAllocator.GetInterface();
+    m_Arena.memory = (uint8_t*)lowLevelAllocator.Allocate(lowLevelAllocator.userArg, arenaSize, m_ArenaAlignment);
+    if (!m_Arena.memory)
+        return Result::FAILURE;
 
-    m_ClipToWorldPrev = m_WorldToClipPrev;
-    m_ClipToWorldPrev.Invert();
+    m_Arena.size = arenaSize;
+    m_Arena.offset = 0;
+    m_Arena.fallbackMemoryAllocatorInterface = lowLevelAllocator;
 
-    m_ClipToView = m_ViewToClip;
-    m_ClipToView.Invert();
+    if (m_OwnedConstantDataSize)
+        m_ConstantData = (uint8_t*)ArenaAllocate(&m_Arena, m_OwnedConstantDataSize, m_ConstantDataAlignment);
 
-    m_ClipToViewPrev = m_ViewToClipPrev;
-    m_ClipToViewPrev.Invert();
+    // Pointers into tables become offsets...
+    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
+        dispatchDesc.resources = (const ResourceDesc*)size_t(dispatchDesc.resources - m_Resources.data());
 
-    m_ClipToWorld = m_WorldToClip;
-    m_ClipToWorld.Invert();
+    for (PipelineDesc& pipelineDesc : m_Pipelines)
+        pipelineDesc.resourceRanges = (const ResourceRangeDesc*)size_t(pipelineDesc.resourceRanges - m_ResourceRanges.data());
 
-    float project[3];
-    float settings[ml::PROJ_NUM];
-    ml::DecomposeProjection(NDC_D3D, NDC_D3D, m_ViewToClip, &flags, settings, nullptr, m_Frustum.pv, project, nullptr);
-    m_ProjectY = project[1];
-    m_IsOrtho = (flags & ml::PROJ_ORTHO) ? -1.0f : 0.0f;
+    // ... tables get carved from the arena (storage used during creation is released)
+    StdAllocator<uint8_t> arenaAllocator(GetArenaAllocatorInterface(m_Arena));
+    ForEachTable([&](auto& table, size_t num)
+    {
+        std::remove_reference_t<decltype(table)> carvedTable(arenaAllocator);
+        carvedTable.reserve(num);
+        carvedTable.assign(table.begin(), table.end());
 
-    ml::DecomposeProjection(NDC_D3D, NDC_D3D, m_ViewToClipPrev, &flags, nullptr, nullptr, m_FrustumPrev.pv, nullptr, nullptr);
+        table = std::move(carvedTable);
+    });
 
-    m_ViewDirection = -ml::float3(m_ViewToWorld.GetCol2().xmm);
-    m_ViewDirectionPrev = -ml::float3(m_ViewToWorldPrev.GetCol2().xmm);
+    assert( m_Arena.offset <= m_Arena.size );
 
-    m_CameraDelta = ml::float3(translationDelta.x, translationDelta.y, translationDelta.z);
+    // ... and pointers again
+    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
+        dispatchDesc.resources = m_Resources.data() + (size_t)dispatchDesc.resources;
 
-    m_Timer.UpdateElapsedTimeSinceLastSave();
-    m_Timer.SaveCurrentTime();
+    for (PipelineDesc& pipelineDesc : m_Pipelines)
+        pipelineDesc.resourceRanges = m_ResourceRanges.data() + (size_t)pipelineDesc.resourceRanges;
 
-    m_TimeDelta = m_CommonSettings.timeDeltaBetweenFrames > 0.0f ? m_CommonSettings.timeDeltaBetweenFrames : m_Timer.GetSmoothedElapsedTime();
-    m_FrameRateScale = ml::Max(33.333f / m_TimeDelta, 1.0f);
+    m_Desc.pipelines = m_Pipelines.data();
+    m_Desc.permanentPool = m_PermanentPool.data();
+    m_Desc.transientPool = m_TransientPool.data();
+    m_Desc.transientPoolAliasing = m_TransientPoolAliasing.data();
+    m_Desc.aliasingGroups = m_AliasingGroups.data();
+    m_Desc.constantData = m_ConstantData;
 
-    float dx = ml::Abs(m_CommonSettings.cameraJitter[0] - m_CommonSettings.cameraJitterPrev[0]);
-    float dy = ml::Abs(m_CommonSettings.cameraJitter[1] - m_CommonSettings.cameraJitterPrev[1]);
-    m_JitterDelta = ml::Max(dx, dy);
+    m_MemoryUsage.entries = m_MemoryUsageEntries.data();
 
-    float FPS = m_FrameRateScale * 30.0f;
-    float nonLinearAccumSpeed = FPS * 0.25f / (1.0f + FPS * 0.25f);
-    m_CheckerboardResolveAccumSpeed = ml::Lerp(nonLinearAccumSpeed, 0.5f, m_JitterDelta);
+    // Tables used only during creation
+    m_IndexRemap = Vector<uint16_t>(GetStdAllocator());
+    m_PermanentIndexRemap = Vector<uint16_t>(GetStdAllocator());
+    m_SharedTextures = Vector<SharedTexture>(GetStdAllocator());
+    m_TransientLifetimes = Vector<TransientLifetime>(GetStdAllocator());
 
     return Result::SUCCESS;
 }
 
-nrd::Result nrd::InstanceImpl::SetDenoiserSettings(Identifier identifier, const void* denoiserSettings)
+void nrd::InstanceImpl::InitDispatchContext(DispatchContextImpl& context)
 {
-    for( DenoiserData& denoiserData : m_DenoiserData )
+    // Scratch memory for constants, used by dry runs and on constant data overflow
+    context.m_ScratchConstantData.resize(std::max(m_Desc.constantBufferMaxDataSize, m_Desc.sharedConstantBufferMaxDataSize));
+
+    // "Clear" dispatches point to this memory, i.e. reallocations are not allowed
+    context.m_ClearBatchResources.reserve(m_ClearBatchesMaxNum * CLEAR_RESOURCES_MAX_NUM);
+
+    // Worst case storage for "GetComputeDispatches", i.e. no allocations in the steady state. A dependency is either a read
+    // since the last write (each read is counted once) or the last write, i.e. there are no more than 2 per subresource
+    context.m_ActiveDispatches.reserve(m_DispatchesMaxNum);
+    context.m_FrameTemplateDispatches.reserve(m_DispatchesMaxNum);
+    context.m_FrameTemplateIdentifiers.reserve(m_DenoiserData.size());
+    context.m_DeduplicatedDispatches.reserve(m_DispatchesMaxNum);
+    context.m_Dependencies.reserve(m_SubresourcesMaxNum * 2);
+    context.m_SubresourceStates.reserve(m_SubresourcesMaxNum);
+    context.m_SubresourceReads.reserve(m_SubresourcesMaxNum);
+
+    if (m_InterleaveViews)
     {
-        if (denoiserData.desc.identifier == identifier)
-        {
-            memcpy(&denoiserData.settings, denoiserSettings, denoiserData.settingsSize);
-
-            return Result::SUCCESS;
-        }
+        context.m_ViewBatchedDispatches.reserve(m_DispatchesMaxNum);
+        context.m_ViewBatchKeys.reserve(m_DispatchesMaxNum);
+        context.m_ViewBatchOrder.reserve(m_DispatchesMaxNum);
     }
+}
+
+void nrd::InstanceImpl::LoadView(uint32_t viewIndex)
+{
+    if (viewIndex == m_LoadedViewIndex)
+        return;
+
+    m_ViewStates[m_LoadedViewIndex] = *(const ViewState*)this;
+    *(ViewState*)this = m_ViewStates[viewIndex];
 
-    return Result::INVALID_ARGUMENT;
+    m_LoadedViewIndex = viewIndex;
 }
 
-nrd::Result nrd::InstanceImpl::GetComputeDispatches(const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
+const nrd::ViewState& nrd::InstanceImpl::GetViewState(uint32_t viewIndex) const
 {
-    m_ActiveDispatches.clear();
+    if (viewIndex == m_LoadedViewIndex)
+        return *this;
 
-    // Trivial checks
-    if (!identifiers || !identifiersNum)
+    return m_ViewStates[viewIndex];
+}
+
+void nrd::InstanceImpl::BatchViews(DispatchContextImpl& context)
+{
+    // Steady state: the order and dependencies are the same, only constants need to be patched
+    if (context.m_IsFrameTemplateReplayed)
     {
-        dispatchDescs = nullptr;
-        dispatchDescsNum = 0;
+        for (size_t i = 0; i < context.m_ViewBatchedDispatches.size(); i++)
+        {
+            DispatchDesc& dispatchDesc = context.m_ViewBatchedDispatches[i];
+            const DispatchDesc& activeDispatchDesc = context.m_ActiveDispatches[ context.m_ViewBatchOrder[i] ];
 
-        return !identifiersNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
+            dispatchDesc.constantBufferData = activeDispatchDesc.constantBufferData;
+            dispatchDesc.sharedConstantBufferData = activeDispatchDesc.sharedConstantBufferData;
+        }
+
+        return;
     }
 
-    // Inject "clear" calls if needed
-    if (m_CommonSettings.accumulationMode == AccumulationMode::CLEAR_AND_RESTART)
+    // Interleaved views don't share resources, thus only the order of dispatches within a view must be preserved. Dispatches
+    // of a view are contiguous in "m_ActiveDispatches", they get sorted by "stage - ordinal within the stage - view". It makes
+    // same-pipeline dispatches of different views adjacent. "Clear" dispatches go first, sorted by pipeline
+    size_t dispatchesNum = context.m_ActiveDispatches.size();
+    context.m_ViewBatchKeys.resize(dispatchesNum);
+    context.m_ViewBatchOrder.resize(dispatchesNum);
+
+    uint16_t viewIndex = uint16_t(-1);
+    uint16_t stage = 0;
+    uint32_t ordinal = 0;
+
+    for (size_t i = 0; i < dispatchesNum; i++)
     {
-        for (const ClearResource& clearResource : m_ClearResources)
-        {
-            // If current denoiser is in list
-            if (!IsInList(clearResource.identifier, identifiers, identifiersNum))
-                continue;
+        const DispatchDesc& dispatchDesc = context.m_ActiveDispatches[i];
+        uint32_t dispatchIndex = context.m_FrameTemplateDispatches[i];
 
-            // Add a clear dispatch
-            const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[ m_DispatchClearIndex[clearResource.isInteger ? 1 : 0] ];
+        uint64_t key = 0;
+        if (dispatchIndex == uint32_t(-1))
+            key = (uint64_t(dispatchDesc.pipelineIndex) << 16) | dispatchDesc.viewIndex;
+        else
+        {
+            if (dispatchDesc.viewIndex != viewIndex)
+            {
+                viewIndex = dispatchDesc.viewIndex;
+                stage = 0;
+            }
 
-            DispatchDesc dispatchDesc = {};
-            dispatchDesc.resourcesNum = 1;
-            dispatchDesc.name = internalDispatchDesc.name;
-            dispatchDesc.resources = &clearResource.resource;
-            dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
-            dispatchDesc.gridWidth = DivideUp(clearResource.w, internalDispatchDesc.numThreads.width);
-            dispatchDesc.gridHeight = DivideUp(clearResource.h, internalDispatchDesc.numThreads.height);
+            uint16_t dispatchStage = std::max(m_Dispatches[dispatchIndex].stage, stage);
+            ordinal = dispatchStage == stage ? ordinal + 1 : 0;
+            stage = dispatchStage;
 
-            m_ActiveDispatches.push_back(dispatchDesc);
+            key = (uint64_t(stage) << 48) | (uint64_t(ordinal) << 16) | viewIndex;
         }
+
+        context.m_ViewBatchKeys[i] = key;
+        context.m_ViewBatchOrder[i] = (uint32_t)i;
     }
 
-    // Collect dispatches for requested denoisers
-    for (const DenoiserData& denoiserData : m_DenoiserData)
+    // Stable, but without a temporary buffer ("std::stable_sort" allocates)
+    std::sort(context.m_ViewBatchOrder.begin(), context.m_ViewBatchOrder.end(), [&](uint32_t a, uint32_t b)
     {
-        // If current denoiser is in list
-        if (!IsInList(denoiserData.desc.identifier, identifiers, identifiersNum))
-            continue;
+        if (context.m_ViewBatchKeys[a] != context.m_ViewBatchKeys[b])
+            return context.m_ViewBatchKeys[a] < context.m_ViewBatchKeys[b];
 
-        // Update denoiser and gather dispatches
-        UpdatePingPong(denoiserData);
+        return a < b;
+    });
 
-        if( denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SH ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR_SH ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_SH ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION )
-            Update_Reblur(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_OCCLUSION ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR_OCCLUSION ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_OCCLUSION )
-            Update_ReblurOcclusion(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW || denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW_TRANSLUCENCY)
-            Update_SigmaShadow(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE)
-            Update_RelaxDiffuse(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SH)
-            Update_RelaxDiffuseSh(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR)
-            Update_RelaxSpecular(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR_SH)
-            Update_RelaxSpecularSh(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR)
-            Update_RelaxDiffuseSpecular(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
-            Update_RelaxDiffuseSpecularSh(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::REFERENCE)
-            Update_Reference(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::SPECULAR_REFLECTION_MV)
-            Update_SpecularReflectionMv(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::SPECULAR_DELTA_MV)
-            Update_SpecularDeltaMv(denoiserData);
-    }
-
-    dispatchDescs = m_ActiveDispatches.data();
-    dispatchDescsNum = (uint32_t)m_ActiveDispatches.size();
+    context.m_ViewBatchedDispatches.resize(dispatchesNum);
+    for (size_t i = 0; i < dispatchesNum; i++)
+        context.m_ViewBatchedDispatches[i] = context.m_ActiveDispatches[ context.m_ViewBatchOrder[i] ];
 
-    return dispatchDescsNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
+    BuildDependencies(context, context.m_ViewBatchedDispatches);
 }
 
-void nrd::InstanceImpl::AddComputeDispatchDesc
-(
-    NumThreads numThreads,
-    uint16_t downsampleFactor,
-    uint32_t constantBufferDataSize,
-    uint32_t maxRepeatNum,
-    const char* shaderFileName,
-    const ComputeShaderDesc& dxbc,
-    const ComputeShaderDesc& dxil,
-    const ComputeShaderDesc& spirv
-)
+void nrd::InstanceImpl::BuildDependencies(DispatchContextImpl& context, Vector<DispatchDesc>& dispatchDescs)
 {
-    // Pipeline (unique only)
-    size_t pipelineIndex = 0;
-    for (; pipelineIndex < m_Pipelines.size(); pipelineIndex++)
-    {
-        const PipelineDesc& pipeline = m_Pipelines[pipelineIndex];
-
-        if (!strcmp(pipeline.shaderFileName, shaderFileName))
-            break;
-    }
+    context.m_Dependencies.clear();
+    context.m_SubresourceStates.clear();
+    context.m_SubresourceReads.clear();
 
-    if (pipelineIndex == m_Pipelines.size())
+    for (size_t i = 0; i < dispatchDescs.size(); i++)
     {
-        PipelineDesc pipelineDesc = {};
-        pipelineDesc.shaderFileName = shaderFileName;
-        pipelineDesc.shaderEntryPointName = NRD_STRINGIFY(NRD_CS_MAIN);
-        pipelineDesc.computeShaderDXBC = dxbc;
-        pipelineDesc.computeShaderDXIL = dxil;
-        pipelineDesc.computeShaderSPIRV = spirv;
-        pipelineDesc.resourceRanges = (ResourceRangeDesc*)m_ResourceRanges.size();
-        pipelineDesc.hasConstantData = constantBufferDataSize != 0;
+        DispatchDesc& dispatchDesc = dispatchDescs[i];
+        size_t dependencyOffset = context.m_Dependencies.size();
 
-        for (size_t r = 0; r < 2; r++)
+        auto AddDependency = [&](uint32_t dispatchIndex, uint32_t resourceIndex, DependencyType type)
         {
-            ResourceRangeDesc descriptorRange = {};
-            descriptorRange.descriptorType = r == 0 ? DescriptorType::TEXTURE : DescriptorType::STORAGE_TEXTURE;
-
-            for (size_t i = m_ResourceOffset; i < m_Resources.size(); i++ )
-            {
-                const ResourceDesc& resource = m_Resources[i];
-                if (descriptorRange.descriptorType == resource.stateNeeded)
-                    descriptorRange.descriptorsNum++;
-            }
-
-            if (descriptorRange.descriptorsNum != 0)
+            for (size_t d = dependencyOffset; d < context.m_Dependencies.size(); d++)
             {
-                m_ResourceRanges.push_back(descriptorRange);
-                pipelineDesc.resourceRangesNum++;
+                const DispatchDependency& dependency = context.m_Dependencies[d];
+                if (dependency.dispatchIndex == dispatchIndex && dependency.resourceIndex == resourceIndex && dependency.type == type)
+                    return;
             }
-        }
-
-        m_Pipelines.push_back( pipelineDesc );
-    }
-
-    // Dispatch
-    InternalDispatchDesc computeDispatchDesc = {};
-    computeDispatchDesc.name = m_PassName;
-    computeDispatchDesc.pipelineIndex = (uint16_t)pipelineIndex;
-    computeDispatchDesc.downsampleFactor = downsampleFactor;
-    computeDispatchDesc.maxRepeatsNum = (uint16_t)maxRepeatNum;
-    computeDispatchDesc.constantBufferDataSize = constantBufferDataSize;
-    computeDispatchDesc.resourcesNum = uint32_t(m_Resources.size() - m_ResourceOffset);
-    computeDispatchDesc.resources = (ResourceDesc*)m_ResourceOffset;
-    computeDispatchDesc.numThreads = numThreads;
 
-    m_Dispatches.push_back(computeDispatchDesc);
-}
+            context.m_Dependencies.push_back( {dispatchIndex, resourceIndex, type} );
+        };
 
-void nrd::InstanceImpl::PrepareDesc()
-{
-    m_Desc = {};
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            const ResourceDesc& resource = dispatchDesc.resources[r];
+            bool isWrite = resource.stateNeeded == DescriptorType::STORAGE_TEXTURE;
 
-    m_Desc.constantBufferRegisterIndex = 0;
-    m_Desc.constantBufferSpaceIndex = NRD_CONSTANT_BUFFER_SPACE_INDEX;
+            // User provided resources are per view
+            bool isPool = resource.type == ResourceType::PERMANENT_POOL || resource.type == ResourceType::TRANSIENT_POOL;
+            uint16_t viewIndex = isPool ? 0 : dispatchDesc.viewIndex;
 
-    m_Desc.samplers = g_Samplers.data();
-    m_Desc.samplersNum = (uint32_t)g_Samplers.size();
-    m_Desc.samplersSpaceIndex = NRD_SAMPLERS_SPACE_INDEX;
-    m_Desc.samplersBaseRegisterIndex = 0;
+            // Mips are tracked independently
+            for (uint16_t mip = resource.mipOffset; mip < resource.mipOffset + resource.mipNum; mip++)
+            {
+                size_t s = 0;
+                for (; s < context.m_SubresourceStates.size(); s++)
+                {
+                    const SubresourceState& state = context.m_SubresourceStates[s];
+                    if (state.type == resource.type && state.indexInPool == resource.indexInPool && state.mip == mip && state.viewIndex == viewIndex)
+                        break;
+                }
 
-    m_Desc.pipelines = m_Pipelines.data();
-    m_Desc.pipelinesNum = (uint32_t)m_Pipelines.size();
-    m_Desc.resourcesSpaceIndex = NRD_RESOURCES_SPACE_INDEX;
+                if (s == context.m_SubresourceStates.size())
+                    context.m_SubresourceStates.push_back( {resource.type, resource.indexInPool, mip, viewIndex, uint32_t(-1), uint32_t(-1)} );
 
-    m_Desc.permanentPool = m_PermanentPool.data();
-    m_Desc.permanentPoolSize = (uint32_t)m_PermanentPool.size();
+                SubresourceState& state = context.m_SubresourceStates[s];
+                if (isWrite)
+                {
+                    // All reads since the last write
+                    for (uint32_t read = state.lastRead; read != uint32_t(-1); read = context.m_SubresourceReads[read].prev)
+                        AddDependency(context.m_SubresourceReads[read].dispatchIndex, r, DependencyType::WRITE_AFTER_READ);
 
-    m_Desc.transientPool = m_TransientPool.data();
-    m_Desc.transientPoolSize = (uint32_t)m_TransientPool.size();
+                    // A subresource can be bound more than once in a dispatch (see "Clear_X")
+                    if (state.lastWrite != uint32_t(-1) && state.lastWrite != (uint32_t)i)
+                        AddDependency(state.lastWrite, r, DependencyType::WRITE_AFTER_WRITE);
 
-    const bool samplersAreInSeparateSet = NRD_SAMPLERS_SPACE_INDEX != NRD_CONSTANT_BUFFER_SPACE_INDEX && NRD_SAMPLERS_SPACE_INDEX != NRD_RESOURCES_SPACE_INDEX;
-    if (samplersAreInSeparateSet)
-        m_Desc.descriptorPoolDesc.samplersMaxNum += m_Desc.samplersNum;
+                    state.lastWrite = (uint32_t)i;
+                    state.lastRead = uint32_t(-1);
+                }
+                else
+                {
+                    if (state.lastWrite != uint32_t(-1))
+                        AddDependency(state.lastWrite, r, DependencyType::READ_AFTER_WRITE);
 
-    // Calculate descriptor heap (sets) requirements
-    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
-    {
-        size_t textureOffset = (size_t)dispatchDesc.resources;
-        dispatchDesc.resources = &m_Resources[textureOffset];
+                    context.m_SubresourceReads.push_back( {(uint32_t)i, state.lastRead} );
+                    state.lastRead = uint32_t(context.m_SubresourceReads.size() - 1);
+                }
+            }
+        }
 
-        for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++)
+        // A dispatch goes to the level following the deepest dependency
+        dispatchDesc.dependencyLevel = 0;
+        for (size_t d = dependencyOffset; d < context.m_Dependencies.size(); d++)
         {
-            const ResourceDesc& resource = dispatchDesc.resources[i];
-            if (resource.stateNeeded == DescriptorType::TEXTURE)
-                m_Desc.descriptorPoolDesc.texturesMaxNum += dispatchDesc.maxRepeatsNum;
-            else if (resource.stateNeeded == DescriptorType::STORAGE_TEXTURE)
-                m_Desc.descriptorPoolDesc.storageTexturesMaxNum += dispatchDesc.maxRepeatsNum;
+            const DispatchDesc& dependency = dispatchDescs[ context.m_Dependencies[d].dispatchIndex ];
+            dispatchDesc.dependencyLevel = std::max(dispatchDesc.dependencyLevel, uint16_t(dependency.dependencyLevel + 1));
         }
 
-        m_Desc.descriptorPoolDesc.setsMaxNum += dispatchDesc.maxRepeatsNum;
-
-        if (!samplersAreInSeparateSet)
-            m_Desc.descriptorPoolDesc.samplersMaxNum += dispatchDesc.maxRepeatsNum * m_Desc.samplersNum;
+        dispatchDesc.dependencies = (DispatchDependency*)dependencyOffset;
+        dispatchDesc.dependenciesNum = uint32_t(context.m_Dependencies.size() - dependencyOffset);
+    }
 
-        if (dispatchDesc.constantBufferDataSize != 0)
-        {
-            m_Desc.descriptorPoolDesc.constantBuffersMaxNum += dispatchDesc.maxRepeatsNum;
-            m_Desc.constantBufferMaxDataSize = std::max(dispatchDesc.constantBufferDataSize, m_Desc.constantBufferMaxDataSize);
-        }
+    for (DispatchDesc& dispatchDesc : dispatchDescs)
+    {
+        size_t dependencyOffset = (size_t)dispatchDesc.dependencies;
+        dispatchDesc.dependencies = context.m_Dependencies.data() + dependencyOffset;
     }
+}
 
-    // For potential clears
-    uint32_t clearNum = (uint32_t)m_ClearResources.size();
-    m_Desc.descriptorPoolDesc.storageTexturesMaxNum += clearNum;
-    m_Desc.descriptorPoolDesc.setsMaxNum += clearNum;
+bool nrd::InstanceImpl::IsFrameTemplateReusable(const DispatchContextImpl& context, const Identifier* identifiers, uint32_t identifiersNum) const
+{
+    if (!context.m_IsFrameTemplateValid || context.m_FrameTemplateSettingsVersion != m_SettingsVersion || context.m_FrameTemplateIdentifiers.size() != identifiersNum)
+        return false;
 
-    if (!samplersAreInSeparateSet)
-        m_Desc.descriptorPoolDesc.samplersMaxNum += clearNum * m_Desc.samplersNum;
+    return !memcmp(context.m_FrameTemplateIdentifiers.data(), identifiers, identifiersNum * sizeof(Identifier));
+}
 
-    // Assign resources
-    for (PipelineDesc& pipelineDesc : m_Pipelines)
+void nrd::InstanceImpl::UpdateDenoiser(const DenoiserData& denoiserData)
+{
+    switch (denoiserData.desc.denoiser)
     {
-        size_t descriptorRangeffset = (size_t)pipelineDesc.resourceRanges;
-        pipelineDesc.resourceRanges = &m_ResourceRanges[descriptorRangeffset];
+#if NRD_WITH_REBLUR
+    case Denoiser::REBLUR_DIFFUSE:
+    case Denoiser::REBLUR_DIFFUSE_SH:
+    case Denoiser::REBLUR_SPECULAR:
+    case Denoiser::REBLUR_SPECULAR_SH:
+    case Denoiser::REBLUR_DIFFUSE_SPECULAR:
+    case Denoiser::REBLUR_DIFFUSE_SPECULAR_SH:
+    case Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION:
+        Update_Reblur(denoiserData);
+        break;
+    case Denoiser::REBLUR_DIFFUSE_OCCLUSION:
+    case Denoiser::REBLUR_SPECULAR_OCCLUSION:
+    case Denoiser::REBLUR_DIFFUSE_SPECULAR_OCCLUSION:
+        Update_ReblurOcclusion(denoiserData);
+        break;
+#endif
+#if NRD_WITH_SIGMA
+    case Denoiser::SIGMA_SHADOW:
+    case Denoiser::SIGMA_SHADOW_TRANSLUCENCY:
+        Update_SigmaShadow(denoiserData);
+        break;
+#endif
+#if NRD_WITH_RELAX
+    case Denoiser::RELAX_DIFFUSE: Update_RelaxDiffuse(denoiserData); break;
+    case Denoiser::RELAX_DIFFUSE_SH: Update_RelaxDiffuseSh(denoiserData); break;
+    case Denoiser::RELAX_SPECULAR: Update_RelaxSpecular(denoiserData); break;
+    case Denoiser::RELAX_SPECULAR_SH: Update_RelaxSpecularSh(denoiserData); break;
+    case Denoiser::RELAX_DIFFUSE_SPECULAR: Update_RelaxDiffuseSpecular(denoiserData); break;
+    case Denoiser::RELAX_DIFFUSE_SPECULAR_SH: Update_RelaxDiffuseSpecularSh(denoiserData); break;
+#endif
+#if NRD_WITH_REFERENCE
+    case Denoiser::REFERENCE: Update_Reference(denoiserData); break;
+#endif
+#if NRD_WITH_MV
+    case Denoiser::SPECULAR_REFLECTION_MV: Update_SpecularReflectionMv(denoiserData); break;
+    case Denoiser::SPECULAR_DELTA_MV: Update_SpecularDeltaMv(denoiserData); break;
+#endif
+    default: // Excluded denoisers can't be created
+        break;
     }
+}
 
-    // *= number of "spaces"
-    uint32_t descriptorSetNum = 1;
-    if (m_Desc.constantBufferSpaceIndex != m_Desc.samplersSpaceIndex)
-        descriptorSetNum++;
-    if (m_Desc.samplersSpaceIndex != m_Desc.resourcesSpaceIndex)
-        descriptorSetNum++;
+void nrd::InstanceImpl::UpdatePingPong(const DenoiserData& denoiserData)
+{
+    for (uint32_t i = 0; i < denoiserData.pingPongNum; i++)
+    {
+        PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
+        if (pingPong.isGeometryHistory)
+            continue;
+
+        ResourceDesc& resource = m_Resources[pingPong.resourceIndex];
 
-    m_Desc.descriptorPoolDesc.setsMaxNum *= descriptorSetNum;
+        ml::Swap(resource.indexInPool, pingPong.indexInPoolToSwapWith);
+    }
 }
 
-void nrd::InstanceImpl::UpdatePingPong(const DenoiserData& denoiserData)
+void nrd::InstanceImpl::UpdateGeometryHistory(const DenoiserData& denoiserData)
 {
+    denoiserData.isGeometryHistoryWriter = true;
+    if (denoiserData.geometryHistoryOwner == GEOMETRY_HISTORY_NOT_SHARED)
+        return;
+
+    // The first denoiser of the group dispatched in a frame writes the current frame history, others only read it. Shared textures
+    // are swapped when the writer starts a new frame, since later denoisers of the group still need the previous frame history
+    uint8_t slot = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_GeometryHistoryMutex);
+
+        const DenoiserData& owner = m_DenoiserData[denoiserData.geometryHistoryOwner];
+        if (owner.geometryHistoryFrameIndex == m_CommonSettings.frameIndex)
+            denoiserData.isGeometryHistoryWriter = false;
+        else
+        {
+            owner.geometryHistoryFrameIndex = m_CommonSettings.frameIndex;
+            owner.geometryHistorySlot ^= 1;
+        }
+
+        slot = owner.geometryHistorySlot;
+    }
+
+    if (denoiserData.geometryHistoryLocalSlot == slot)
+        return;
+
     for (uint32_t i = 0; i < denoiserData.pingPongNum; i++)
     {
         PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
+        if (!pingPong.isGeometryHistory)
+            continue;
+
         ResourceDesc& resource = m_Resources[pingPong.resourceIndex];
 
         ml::Swap(resource.indexInPool, pingPong.indexInPoolToSwapWith);
     }
+
+    denoiserData.geometryHistoryLocalSlot = slot;
 }
 
 void nrd::InstanceImpl::PushTexture(DescriptorType descriptorType, uint16_t localIndex, uint16_t mipOffset, uint16_t mipNum, uint16_t indexToSwapWith)
@@ -694,30 +2758,68 @@ void nrd::InstanceImpl::PushTexture(DescriptorType descriptorType, uint16_t loca
             assert(indexToSwapWith >= TRANSIENT_POOL_START && indexToSwapWith < PERMANENT_POOL_START);
 
             indexToSwapWith = m_IndexRemap[indexToSwapWith - TRANSIENT_POOL_START];
-            m_PingPongs.push_back( {m_Resources.size(), indexToSwapWith} );
+            m_PingPongs.push_back( {m_Resources.size(), indexToSwapWith, false} );
         }
     }
     else if (localIndex >= PERMANENT_POOL_START)
     {
         resourceType = ResourceType::PERMANENT_POOL;
-        globalIndex = m_PermanentPoolOffset + localIndex - PERMANENT_POOL_START;
+        globalIndex = m_PermanentIndexRemap[localIndex - PERMANENT_POOL_START];
 
         if (indexToSwapWith != uint16_t(-1))
         {
             assert(indexToSwapWith >= PERMANENT_POOL_START);
 
-            indexToSwapWith = m_PermanentPoolOffset + indexToSwapWith - PERMANENT_POOL_START;
-            m_PingPongs.push_back( {m_Resources.size(), indexToSwapWith} );
+            indexToSwapWith = m_PermanentIndexRemap[indexToSwapWith - PERMANENT_POOL_START];
+
+            // Previous and current geometry history are the same texture, if not shared
+            if (indexToSwapWith != globalIndex)
+            {
+                bool isGeometryHistory = false;
+                for (const SharedTexture& sharedTexture : m_SharedTextures)
+                    isGeometryHistory |= globalIndex == sharedTexture.indexInPool || globalIndex == sharedTexture.indexInPool + 1;
+
+                m_PingPongs.push_back( {m_Resources.size(), indexToSwapWith, isGeometryHistory} );
+            }
         }
     }
 
     m_Resources.push_back( {descriptorType, resourceType, globalIndex, mipOffset, mipNum} );
 }
 
+void nrd::InstanceImpl::AddSharedTextureToPermanentPool(const TextureDesc& textureDesc, GeometryHistory geometryHistory)
+{
+    if (m_IsGeometryHistoryShared)
+    {
+        // Try to find textures added by a previous denoiser of the same family (format and dimensions must match)
+        for (const SharedTexture& sharedTexture : m_SharedTextures)
+        {
+            const TextureDesc& t = m_PermanentPool[sharedTexture.indexInPool];
+            if (sharedTexture.geometryHistory == geometryHistory && t.format == textureDesc.format && t.width == textureDesc.width && t.height == textureDesc.height && t.mipNum == textureDesc.mipNum)
+            {
+                m_PermanentIndexRemap.push_back(sharedTexture.indexInPool);
+                m_PermanentIndexRemap.push_back(sharedTexture.indexInPool + 1);
+
+                return;
+            }
+        }
+
+        m_SharedTextures.push_back( {geometryHistory, (uint16_t)m_PermanentPool.size()} );
+
+        AddTextureToPermanentPool(textureDesc);
+        AddTextureToPermanentPool(textureDesc);
+    }
+    else
+    {
+        AddTextureToPermanentPool(textureDesc);
+        m_PermanentIndexRemap.push_back(m_PermanentIndexRemap.back());
+    }
+}
+
 void nrd::InstanceImpl::AddTextureToTransientPool(const TextureDesc& textureDesc)
 {
-    // Try to find a replacement from previous denoisers
-    for (uint16_t i = 0; i < m_TransientPoolOffset; i++)
+    // Try to find a replacement from previous denoisers (of the same view, if views are interleaved)
+    for (uint16_t i = m_ViewTransientPoolOffset; i < m_TransientPoolOffset; i++)
     {
         // Format and dimensions must match
         const TextureDesc& t = m_TransientPool[i];
@@ -746,45 +2848,147 @@ void nrd::InstanceImpl::AddTextureToTransientPool(const TextureDesc& textureDesc
     m_TransientPool.push_back(textureDesc);
 }
 
-nrd::Constant* nrd::InstanceImpl::PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex)
+uint8_t* nrd::InstanceImpl::PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex)
 {
     size_t dispatchIndex = denoiserData.dispatchOffset + localIndex;
     const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[dispatchIndex];
+    DispatchContextImpl& context = *denoiserData.context;
+
+    // Dry run (see "GetReachablePipelines" and "GetFrameDescriptorPoolDesc"). Deduplication is ignored, i.e. descriptors are counted
+    // as if each denoiser is dispatched by a separate call
+    if (context.m_IsDryRun)
+    {
+        m_PipelineReachability[internalDispatchDesc.pipelineIndex] |= PIPELINE_REACHABLE;
+
+        for (uint32_t i = 0; i < internalDispatchDesc.resourcesNum; i++)
+        {
+            const ResourceDesc& resource = internalDispatchDesc.resources[i];
+            if (resource.stateNeeded == DescriptorType::TEXTURE)
+                m_DryRunPoolDesc.texturesMaxNum++;
+            else if (resource.stateNeeded == DescriptorType::STORAGE_TEXTURE)
+                m_DryRunPoolDesc.storageTexturesMaxNum++;
+        }
+
+        m_DryRunPoolDesc.setsMaxNum++;
+        m_DryRunPoolDesc.constantBuffersMaxNum += (internalDispatchDesc.constantBufferDataSize != 0 ? 1 : 0) + (internalDispatchDesc.hasSharedConstants ? 1 : 0);
+
+        if (!SAMPLERS_ARE_IN_SEPARATE_SET)
+            m_DryRunPoolDesc.samplersMaxNum += m_Desc.samplersNum;
+
+        context.m_ScratchDispatchDesc.constantBufferData = context.m_ScratchConstantData.data();
+        context.m_ScratchDispatchDesc.constantBufferDataSize = internalDispatchDesc.constantBufferDataSize;
+        context.m_LastDispatchDesc = &context.m_ScratchDispatchDesc;
+
+        return context.m_ScratchConstantData.data();
+    }
+
+    // Deduplication: skip the dispatch if an identical one has already been emitted by a previous denoiser. Constants are
+    // not known yet, they get compared in "ResolveDeduplicatedDispatches"
+    if (internalDispatchDesc.sourceDispatchIndex != uint32_t(-1))
+    {
+        for (size_t i = context.m_FrameTemplateCursor; i-- > 0; )
+        {
+            uint32_t emittedDispatchIndex = context.m_FrameTemplateDispatches[i];
+            if (emittedDispatchIndex == uint32_t(-1))
+                continue;
+
+            if (emittedDispatchIndex == internalDispatchDesc.sourceDispatchIndex || m_Dispatches[emittedDispatchIndex].sourceDispatchIndex == internalDispatchDesc.sourceDispatchIndex)
+            {
+                DeduplicatedDispatch deduplicatedDispatch = {};
+                deduplicatedDispatch.dispatchDesc = context.m_ActiveDispatches[i];
+                deduplicatedDispatch.dispatchDesc.name = internalDispatchDesc.name;
+                deduplicatedDispatch.dispatchDesc.constantBufferData = PushConstants(context, internalDispatchDesc.constantBufferDataSize);
+                deduplicatedDispatch.position = context.m_FrameTemplateCursor;
+                deduplicatedDispatch.referencePosition = i;
+                deduplicatedDispatch.sourceDispatchIndex = internalDispatchDesc.sourceDispatchIndex;
+                deduplicatedDispatch.dispatchIndex = (uint32_t)dispatchIndex;
+
+                context.m_DeduplicatedDispatches.push_back(deduplicatedDispatch);
+                context.m_LastDispatchDesc = &context.m_DeduplicatedDispatches.back().dispatchDesc;
+
+                return (uint8_t*)context.m_LastDispatchDesc->constantBufferData;
+            }
+        }
+    }
+
+    // Steady state: resources (ping-pongs are swapped in-place), pipeline and grid size are taken from the template
+    if (context.m_IsFrameTemplateReplayed)
+    {
+        if (context.m_FrameTemplateCursor < context.m_FrameTemplateDispatches.size() && context.m_FrameTemplateDispatches[context.m_FrameTemplateCursor] == (uint32_t)dispatchIndex)
+        {
+            DispatchDesc& dispatchDesc = context.m_ActiveDispatches[context.m_FrameTemplateCursor++];
+            dispatchDesc.constantBufferData = PushConstants(context, internalDispatchDesc.constantBufferDataSize);
+
+            if (internalDispatchDesc.hasSharedConstants)
+                dispatchDesc.sharedConstantBufferData = context.m_SharedConstantData;
+
+            context.m_LastDispatchDesc = &dispatchDesc;
+
+            return (uint8_t*)dispatchDesc.constantBufferData;
+        }
+
+        // Branching has diverged from the template, regenerate the rest of the frame
+        context.m_ActiveDispatches.resize(context.m_FrameTemplateCursor);
+        context.m_FrameTemplateDispatches.resize(context.m_FrameTemplateCursor);
+        context.m_IsFrameTemplateReplayed = false;
+    }
 
     // Copy data
     DispatchDesc dispatchDesc = {};
     dispatchDesc.name = internalDispatchDesc.name;
     dispatchDesc.resources = internalDispatchDesc.resources;
     dispatchDesc.resourcesNum = internalDispatchDesc.resourcesNum;
+    dispatchDesc.viewIndex = (uint16_t)denoiserData.viewIndex;
     dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
 
     // Update constant data
-    if (m_ConstantDataOffset + internalDispatchDesc.constantBufferDataSize > CONSTANT_DATA_SIZE)
-        m_ConstantDataOffset = 0;
-    dispatchDesc.constantBufferData = m_ConstantData + m_ConstantDataOffset;
+    dispatchDesc.constantBufferData = PushConstants(context, internalDispatchDesc.constantBufferDataSize);
     dispatchDesc.constantBufferDataSize = internalDispatchDesc.constantBufferDataSize;
-    m_ConstantDataOffset += internalDispatchDesc.constantBufferDataSize;
+
+    if (internalDispatchDesc.hasSharedConstants)
+    {
+        dispatchDesc.sharedConstantBufferData = context.m_SharedConstantData;
+        dispatchDesc.sharedConstantBufferDataSize = denoiserData.sharedConstantBufferDataSize;
+    }
 
     // Update grid size
-    float sx = ml::Max(internalDispatchDesc.downsampleFactor == USE_MAX_DIMS ? m_CommonSettings.resolutionScalePrev[0] : 0.0f, m_CommonSettings.resolutionScale[0]);
-    float sy = ml::Max(internalDispatchDesc.downsampleFactor == USE_MAX_DIMS ? m_CommonSettings.resolutionScalePrev[1] : 0.0f, m_CommonSettings.resolutionScale[1]);
-    uint16_t d = internalDispatchDesc.downsampleFactor == USE_MAX_DIMS ? 1 : internalDispatchDesc.downsampleFactor;
+    uint16_t renderW = GetRenderSize(m_RenderWidth, denoiserData.desc.renderWidth);
+    uint16_t renderH = GetRenderSize(m_RenderHeight, denoiserData.desc.renderHeight);
+    float sx = m_CommonSettings.resolutionScale[0];
+    float sy = m_CommonSettings.resolutionScale[1];
+    uint16_t d = internalDispatchDesc.downsampleFactor;
+
+    if (internalDispatchDesc.downsampleFactor == USE_MAX_DIMS)
+    {
+        // Covers both the current and the previous rects (scales are relative to the current render size)
+        float renderWprev = float(GetRenderSize(m_RenderWidthPrev, denoiserData.desc.renderWidth));
+        float renderHprev = float(GetRenderSize(m_RenderHeightPrev, denoiserData.desc.renderHeight));
 
-    if (internalDispatchDesc.downsampleFactor == IGNORE_RS)
+        sx = ml::Max(sx, m_CommonSettings.resolutionScalePrev[0] * renderWprev / float(renderW));
+        sy = ml::Max(sy, m_CommonSettings.resolutionScalePrev[1] * renderHprev / float(renderH));
+        d = 1;
+    }
+    else if (internalDispatchDesc.downsampleFactor == IGNORE_RS)
     {
+        renderW = denoiserData.desc.renderWidth;
+        renderH = denoiserData.desc.renderHeight;
         sx = 1.0f;
         sy = 1.0f;
         d = 1;
     }
 
-    uint16_t w = uint16_t( float(DivideUp(denoiserData.desc.renderWidth, d)) * sx + 0.5f );
-    uint16_t h = uint16_t( float(DivideUp(denoiserData.desc.renderHeight, d)) * sy + 0.5f );
+    uint16_t w = uint16_t( float(DivideUp(renderW, d)) * sx + 0.5f );
+    uint16_t h = uint16_t( float(DivideUp(renderH, d)) * sy + 0.5f );
 
     dispatchDesc.gridWidth = DivideUp(w, internalDispatchDesc.numThreads.width);
     dispatchDesc.gridHeight = DivideUp(h, internalDispatchDesc.numThreads.height);
 
     // Store
-    m_ActiveDispatches.push_back(dispatchDesc);
+    context.m_ActiveDispatches.push_back(dispatchDesc);
+    context.m_FrameTemplateDispatches.push_back((uint32_t)dispatchIndex);
+    context.m_FrameTemplateCursor++;
+
+    context.m_LastDispatchDesc = &context.m_ActiveDispatches.back();
 
-    return (Constant*)dispatchDesc.constantBufferData;
+    return (uint8_t*)dispatchDesc.constantBufferData;
 }
@@ -17,9 +17,52 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 typedef nrd::MemoryAllocatorInterface MemoryAllocatorInterface;
 #include "StdAllocator.h"
+#include "ShaderArchive.h"
 
 #include "Timer.h"
 
+// Per-pass constants of passes, which don't belong to a denoiser family (the layout is declared in HLSL)
+#include "../Shaders/Include/PassConstants.hlsli"
+
+#include <type_traits>
+#include <array>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+// Denoiser families compiled into the library (set by CMake, everything is included by default)
+#ifndef NRD_WITH_REBLUR
+    #define NRD_WITH_REBLUR 1
+#endif
+
+#ifndef NRD_WITH_RELAX
+    #define NRD_WITH_RELAX 1
+#endif
+
+#ifndef NRD_WITH_SIGMA
+    #define NRD_WITH_SIGMA 1
+#endif
+
+#ifndef NRD_WITH_REFERENCE
+    #define NRD_WITH_REFERENCE 1
+#endif
+
+#ifndef NRD_WITH_MV
+    #define NRD_WITH_MV 1
+#endif
+
+// Declares a C++ struct from an "NRD_CONSTANT" list (see "REBLUR_SharedConstants.hlsli"):
+//  #define NRD_CONSTANT NRD_CONSTANT_MEMBER
+//  struct Name { LIST };
+//  #undef NRD_CONSTANT
+//  #define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(Name, constantType, constantName)
+//  LIST
+//  #undef NRD_CONSTANT
+#define NRD_CONSTANT_MEMBER(constantType, constantName) nrd::cb::constantType##_t constantName;
+#define NRD_CONSTANT_CHECK(structName, constantType, constantName) \
+    static_assert( nrd::IsPackedAsInHlsl(offsetof(structName, constantName), sizeof(nrd::cb::constantType##_t)), "'" #constantName "' doesn't follow HLSL packing rules" );
+
 #define _NRD_STRINGIFY(s) #s
 #define NRD_STRINGIFY(s) _NRD_STRINGIFY(s)
 
@@ -41,45 +84,139 @@ typedef nrd::MemoryAllocatorInterface MemoryAllocatorInterface;
     #define GET_SPIRV_SHADER_DESC(shaderName) {}
 #endif
 
+// Pipelines are identified by a compile-time hash of the shader name (no string comparisons in "Create")
+#define GET_SHADER_HASH(shaderName) std::integral_constant<uint64_t, nrd::HashShaderName(#shaderName ".cs")>::value
+
 #define AddDispatch(shaderName, constantNum, numThreads, downsampleFactor) \
-    AddComputeDispatchDesc(numThreads, downsampleFactor, constantNum, 1, #shaderName ".cs", GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
+    AddComputeDispatchDesc(numThreads, downsampleFactor, constantNum, 1, GET_SHADER_HASH(shaderName), #shaderName ".cs", GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
 
 #define AddDispatchRepeated(shaderName, constantNum, numThreads, downsampleFactor, repeatNum) \
-    AddComputeDispatchDesc(numThreads, downsampleFactor, constantNum, repeatNum, #shaderName ".cs", GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
+    AddComputeDispatchDesc(numThreads, downsampleFactor, constantNum, repeatNum, GET_SHADER_HASH(shaderName), #shaderName ".cs", GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
 
 #define PushPass(passName) \
     _PushPass(NRD_STRINGIFY(DENOISER_NAME) " - " passName)
 
+// Evaluates "graphBuilder" (a struct derived from "GraphBuilder") at compile time, declares "graph" tables and validates them
+#define NRD_DECLARE_GRAPH(graph, graphBuilder) \
+    static constexpr GraphSizes graph##Sizes = graphBuilder().sizes; \
+    static constexpr auto graph = CompactGraph<graph##Sizes.texturesNum, graph##Sizes.passesNum, graph##Sizes.dispatchesNum, graph##Sizes.resourcesNum, graph##Sizes.pipelinesNum>(graphBuilder()); \
+    static_assert(AreGraphTexturesDeclared(graph), NRD_STRINGIFY(DENOISER_NAME) ": undeclared texture or invalid ping-pong"); \
+    static_assert(AreGraphTransientsWrittenBeforeRead(graph), NRD_STRINGIFY(DENOISER_NAME) ": a transient texture is read before being written"); \
+    static_assert(AreGraphTransientsReadAfterWrite(graph), NRD_STRINGIFY(DENOISER_NAME) ": a transient texture is written, but never read"); \
+    static_assert(AreGraphPassesValid(graph), NRD_STRINGIFY(DENOISER_NAME) ": a pass has no dispatches or outputs, reads its own output or has invalid dimensions")
+
 // TODO: rework is needed, but still better than copy-pasting
 #define NRD_DECLARE_DIMS \
     uint16_t screenW = denoiserData.desc.renderWidth; \
     uint16_t screenH = denoiserData.desc.renderHeight; \
-    [[maybe_unused]] uint16_t rectW = uint16_t(screenW * m_CommonSettings.resolutionScale[0] + 0.5f); \
-    [[maybe_unused]] uint16_t rectH = uint16_t(screenH * m_CommonSettings.resolutionScale[1] + 0.5f); \
-    [[maybe_unused]] uint16_t rectWprev = uint16_t(screenW * m_CommonSettings.resolutionScalePrev[0] + 0.5f); \
-    [[maybe_unused]] uint16_t rectHprev = uint16_t(screenH * m_CommonSettings.resolutionScalePrev[1] + 0.5f)
+    uint16_t renderW = GetRenderSize(m_RenderWidth, screenW); \
+    uint16_t renderH = GetRenderSize(m_RenderHeight, screenH); \
+    uint16_t renderWprev = GetRenderSize(m_RenderWidthPrev, screenW); \
+    uint16_t renderHprev = GetRenderSize(m_RenderHeightPrev, screenH); \
+    [[maybe_unused]] uint16_t rectW = uint16_t(renderW * m_CommonSettings.resolutionScale[0] + 0.5f); \
+    [[maybe_unused]] uint16_t rectH = uint16_t(renderH * m_CommonSettings.resolutionScale[1] + 0.5f); \
+    [[maybe_unused]] uint16_t rectWprev = uint16_t(renderWprev * m_CommonSettings.resolutionScalePrev[0] + 0.5f); \
+    [[maybe_unused]] uint16_t rectHprev = uint16_t(renderHprev * m_CommonSettings.resolutionScalePrev[1] + 0.5f)
 
 namespace nrd
 {
     constexpr uint16_t PERMANENT_POOL_START = 1000;
     constexpr uint16_t TRANSIENT_POOL_START = 2000;
-    constexpr size_t CONSTANT_DATA_SIZE = 2 * 1024 * 2014;
+    constexpr uint32_t FRAMES_IN_FLIGHT_DEFAULT_NUM = 3;
+    constexpr uint32_t CONSTANT_DATA_PER_FRAME_DEFAULT_SIZE = 1024 * 1024;
+    constexpr uint32_t CONSTANT_DATA_DEFAULT_ALIGNMENT = 4;
+    constexpr uint32_t ARENA_ALIGNMENT = 64; // cache line
+
+    constexpr uint32_t CLEAR_RESOURCES_MAX_NUM = 8; // must match "Clear_X.resources.hlsli"
+
+    constexpr uint32_t BLOB_MAGIC = 0x4244524E; // "NRDB"
+    constexpr uint32_t BLOB_VERSION = 4; // must be incremented on any change of the blob layout or stored structures
+
+    constexpr uint8_t PIPELINE_REACHABLE = 0x1;
+    constexpr uint8_t PIPELINE_REPORTED = 0x2;
+
+    constexpr uint32_t GEOMETRY_HISTORY_NOT_SHARED = uint32_t(-1);
 
     constexpr uint16_t USE_MAX_DIMS = 0xFFFF;
     constexpr uint16_t IGNORE_RS = 0xFFFE;
 
+    // Compressed shader archive (see "ShaderArchive.cpp"), empty without "NRD_EMBEDS_COMPRESSED_SHADERS"
+    const ShaderArchiveBlock* FindArchivedShader(uint64_t shaderHash, ShaderFormat format, uint32_t& blockIndex);
+    bool DecompressArchivedShader(const ShaderArchiveBlock& block, uint8_t* bytecode);
+    uint32_t GetArchivedShaderBlocksNum();
+
     inline uint16_t DivideUp(uint32_t x, uint16_t y)
     { return uint16_t((x + y - 1) / y); }
 
+    // Textures are allocated for "DenoiserDesc" dimensions, "ResizeInstance" makes only a top-left part of them used
+    inline uint16_t GetRenderSize(uint16_t resizedSize, uint16_t maxSize)
+    { return resizedSize ? resizedSize : maxSize; }
+
     template <class T>
-    inline uint16_t AsUint(T x)
+    constexpr uint16_t AsUint(T x)
     { return (uint16_t)x; }
 
-    union Constant
+    // HLSL types for C++ structs mirroring "NRD_CONSTANT" lists (tightly packed, no SIMD alignment)
+    namespace cb
+    {
+        typedef float float_t;
+        typedef uint32_t uint_t;
+
+        struct float2_t { float x, y; };
+        struct float3_t { float x, y, z; };
+        struct float4_t { float x, y, z, w; };
+        struct float4x4_t { float m[16]; };
+        struct uint2_t { uint32_t x, y; };
+        struct int2_t { int32_t x, y; };
+
+        inline float4_t AsFloat4(const ml::float4& x)
+        {
+            static_assert( sizeof(ml::float4) == sizeof(float4_t), "Unexpected" );
+
+            float4_t r;
+            memcpy(&r, &x, sizeof(r));
+
+            return r;
+        }
+
+        inline float4x4_t AsFloat4x4(const ml::float4x4& x)
+        {
+            static_assert( sizeof(ml::float4x4) == sizeof(float4x4_t), "Unexpected" );
+
+            float4x4_t r;
+            memcpy(&r, &x, sizeof(r));
+
+            return r;
+        }
+    }
+
+    // HLSL packing rules: a constant can't straddle a 16-byte boundary, matrices start on a boundary
+    constexpr bool IsPackedAsInHlsl(size_t offset, size_t size)
+    { return size >= 16 ? offset % 16 == 0 : offset / 16 == (offset + size - 1) / 16; }
+
+    // "ClassifyTiles" is used by several denoiser families (see "PassConstants.hlsli")
+    #define NRD_CONSTANT NRD_CONSTANT_MEMBER
+    struct ClassifyTilesConstants
+    {
+        CLASSIFY_TILES_CB_DATA
+    };
+    #undef NRD_CONSTANT
+
+    #define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ClassifyTilesConstants, constantType, constantName)
+    CLASSIFY_TILES_CB_DATA
+    #undef NRD_CONSTANT
+
+    // "Clear" is dispatched by the instance itself, "gDebug" (see "Clear_*.resources.hlsli") is not a part of the list
+    #define NRD_CONSTANT NRD_CONSTANT_MEMBER
+    struct ClearConstants
     {
-        float f;
-        uint32_t ui;
+        CLEAR_CB_DATA
     };
+    #undef NRD_CONSTANT
+
+    #define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ClearConstants, constantType, constantName)
+    CLEAR_CB_DATA
+    #undef NRD_CONSTANT
 
     union Settings
     {
@@ -94,28 +231,67 @@ namespace nrd
         SpecularDeltaMvSettings specularDeltaMv;
     };
 
+    struct DispatchContextImpl;
+
     struct DenoiserData
     {
         DenoiserDesc desc;
         Settings settings;
         size_t settingsSize;
+        uint32_t sharedConstantBufferDataSize;
         size_t dispatchOffset;
         size_t pingPongOffset;
         size_t pingPongNum;
+        uint32_t viewIndex;
+        uint16_t permanentPoolOffset;
+        uint16_t permanentPoolNum;
+        uint16_t transientPoolOffset; // textures added to the transient pool by the denoiser (others are shared with previous denoisers)
+        uint16_t transientPoolNum;
+        DispatchContextImpl* context; // the context, which gathers dispatches of the denoiser in the current call
+        uint32_t geometryHistoryOwner; // the first denoiser sharing geometry history with this one (keeps the state below) or "GEOMETRY_HISTORY_NOT_SHARED"
+        mutable uint32_t accumulatedFrameNum; // REFERENCE
+        mutable uint32_t geometryHistoryFrameIndex; // owner: the frame, in which shared geometry history has been written
+        mutable uint8_t geometryHistorySlot; // owner: which of two shared textures holds the current frame
+        mutable uint8_t geometryHistoryLocalSlot; // "geometryHistorySlot" matching resources of the denoiser
+        mutable bool isGeometryHistoryWriter; // the denoiser writes geometry history in the current frame
+    };
+
+    // Geometry history textures, which can be shared by denoisers of the same family (see "InstanceCreationDesc::shareGeometryHistory").
+    // If shared, a history is a pair of textures (previous and current frame), swapped once per frame for the whole group
+    enum class GeometryHistory : uint8_t
+    {
+        REBLUR_VIEWZ,
+        REBLUR_NORMAL_ROUGHNESS,
+        RELAX_VIEWZ,
+        RELAX_NORMAL_ROUGHNESS,
+        RELAX_MATERIAL_ID
+    };
+
+    struct SharedTexture
+    {
+        GeometryHistory geometryHistory;
+        uint16_t indexInPool; // followed by the current frame texture
     };
 
     struct PingPong
     {
         size_t resourceIndex;
         uint16_t indexInPoolToSwapWith;
+        bool isGeometryHistory; // swapped by "UpdateGeometryHistory"
+    };
+
+    struct PassConstants
+    {
+        uint32_t dataSize; // excluding shared constants
+        bool hasSharedConstants;
     };
 
     struct NumThreads
     {
-        inline NumThreads(uint8_t w, uint8_t h) : width(w), height(h)
+        constexpr NumThreads(uint8_t w, uint8_t h) : width(w), height(h)
         {}
 
-        inline NumThreads() : width(0), height(0)
+        constexpr NumThreads() : width(0), height(0)
         {}
 
         uint8_t width;
@@ -131,8 +307,410 @@ namespace nrd
         uint32_t constantBufferDataSize;
         uint16_t pipelineIndex;
         uint16_t downsampleFactor;
+        uint32_t sourceDispatchIndex; // an identical dispatch of a previous denoiser (if any), whose outputs can be reused
         uint16_t maxRepeatsNum; // mostly for internal use
+        uint16_t stage; // consecutive dispatches of the same pass belong to the same stage (permutations and repeats)
+        NumThreads numThreads;
+        bool hasSharedConstants;
+    };
+
+    // Compile-time denoiser graphs: "Add_X" functions describe textures, passes and dispatches in the constexpr constructor of a local
+    // struct derived from "GraphBuilder" (the same calls as for the instance: "PushPass", "PushInput", "AddDispatch"...). The constructor
+    // runs at compile time, "NRD_DECLARE_GRAPH" compacts the result into exactly sized constexpr tables and validates them by
+    // "static_assert"s. "AddGraph" copies the tables into the instance in a single pass
+    constexpr size_t GRAPH_TEXTURES_MAX_NUM = 64; // transient textures are tracked by a 64-bit mask in graph checks
+    constexpr size_t GRAPH_PASSES_MAX_NUM = 64;
+    constexpr size_t GRAPH_DISPATCHES_MAX_NUM = 128;
+    constexpr size_t GRAPH_RESOURCES_MAX_NUM = 1024;
+    constexpr size_t GRAPH_PIPELINES_MAX_NUM = 64;
+
+    enum class GraphPool : uint8_t
+    {
+        TRANSIENT,
+        PERMANENT,
+        SHARED_PERMANENT, // adds two local indices: previous and current frame history
+    };
+
+    struct GraphTexture
+    {
+        Format format;
+        uint16_t downsampleFactor;
+        Format packedFormat = Format::MAX_NUM; // replaces "format" for "MemoryBudget::PARTIALLY_PACKED", if valid
+
+        // Filled by "GraphBuilder"
+        GraphPool pool = GraphPool::TRANSIENT;
+        GeometryHistory geometryHistory = GeometryHistory::REBLUR_VIEWZ;
+    };
+
+    struct GraphResource
+    {
+        DescriptorType descriptorType;
+        uint16_t indexInPool; // local index (see "PushTexture")
+        uint16_t mipOffset;
+        uint16_t mipNum;
+        uint16_t indexToSwapWith;
+    };
+
+    struct GraphPass
+    {
+        const char* name;
+        uint16_t resourcesOffset;
+        uint16_t resourcesNum;
+        uint16_t dispatchesOffset;
+        uint16_t dispatchesNum;
+    };
+
+    struct GraphPipeline
+    {
+        uint64_t shaderHash;
+        const char* shaderFileName;
+        ComputeShaderDesc dxbc;
+        ComputeShaderDesc dxil;
+        ComputeShaderDesc spirv;
+        PassConstants passConstants; // of the first dispatch, "hasSharedConstants" means "requested"
+        uint16_t texturesNum;
+        uint16_t storageTexturesNum;
+    };
+
+    struct GraphDispatch
+    {
+        PassConstants passConstants; // "hasSharedConstants" means "requested"
         NumThreads numThreads;
+        uint16_t downsampleFactor;
+        uint16_t maxRepeatNum;
+        uint16_t pipelineIndex; // local, resolved at compile time
+    };
+
+    struct GraphSizes
+    {
+        size_t texturesNum;
+        size_t passesNum;
+        size_t dispatchesNum;
+        size_t resourcesNum;
+        size_t pipelinesNum;
+    };
+
+    // Non-template view of "Graph" tables
+    struct GraphDesc
+    {
+        const GraphTexture* textures;
+        const GraphPass* passes;
+        const GraphDispatch* dispatches;
+        const GraphResource* resources;
+        const GraphPipeline* pipelines;
+        size_t texturesNum;
+        size_t passesNum;
+        size_t pipelinesNum;
+    };
+
+    template <size_t texturesNum, size_t passesNum, size_t dispatchesNum, size_t resourcesNum, size_t pipelinesNum>
+    struct Graph
+    {
+        std::array<GraphTexture, texturesNum> textures = {};
+        std::array<GraphPass, passesNum> passes = {};
+        std::array<GraphDispatch, dispatchesNum> dispatches = {};
+        std::array<GraphResource, resourcesNum> resources = {};
+        std::array<GraphPipeline, pipelinesNum> pipelines = {};
+
+        constexpr GraphDesc GetDesc() const
+        { return {textures.data(), passes.data(), dispatches.data(), resources.data(), pipelines.data(), texturesNum, passesNum, pipelinesNum}; }
+    };
+
+    struct GraphBuilder : Graph<GRAPH_TEXTURES_MAX_NUM, GRAPH_PASSES_MAX_NUM, GRAPH_DISPATCHES_MAX_NUM, GRAPH_RESOURCES_MAX_NUM, GRAPH_PIPELINES_MAX_NUM>
+    {
+        GraphSizes sizes = {};
+
+        constexpr void AddTextureToTransientPool(const GraphTexture& texture)
+        { AddTexture(texture, GraphPool::TRANSIENT, GeometryHistory::REBLUR_VIEWZ); }
+
+        constexpr void AddTextureToPermanentPool(const GraphTexture& texture)
+        { AddTexture(texture, GraphPool::PERMANENT, GeometryHistory::REBLUR_VIEWZ); }
+
+        // Adds two local indices: previous and current frame history (the same texture, if geometry history is not shared)
+        constexpr void AddSharedTextureToPermanentPool(const GraphTexture& texture, GeometryHistory geometryHistory)
+        { AddTexture(texture, GraphPool::SHARED_PERMANENT, geometryHistory); }
+
+        // For passes without per-pass constants
+        constexpr PassConstants NoConstants(bool addShared = true) const
+        { return {0, addShared}; }
+
+        // For passes, which constants are declared as a struct mirroring an "NRD_CONSTANT" list
+        template<class T>
+        constexpr PassConstants ConstantsOf(bool addShared = true) const
+        { return {(uint32_t)sizeof(T), addShared}; }
+
+        constexpr void PushInput(uint16_t indexInPool, uint16_t mipOffset = 0, uint16_t mipNum = 1, uint16_t indexToSwapWith = uint16_t(-1))
+        { PushTexture(DescriptorType::TEXTURE, indexInPool, mipOffset, mipNum, indexToSwapWith); }
+
+        constexpr void PushOutput(uint16_t indexInPool, uint16_t mipOffset = 0, uint16_t mipNum = 1, uint16_t indexToSwapWith = uint16_t(-1))
+        { PushTexture(DescriptorType::STORAGE_TEXTURE, indexInPool, mipOffset, mipNum, indexToSwapWith); }
+
+        constexpr void _PushPass(const char* name)
+        {
+            passes[sizes.passesNum++] = {name, (uint16_t)sizes.resourcesNum, 0, (uint16_t)sizes.dispatchesNum, 0};
+        }
+
+        constexpr void AddComputeDispatchDesc
+        (
+            NumThreads numThreads,
+            uint16_t downsampleFactor,
+            const PassConstants& passConstants,
+            uint32_t maxRepeatNum,
+            uint64_t shaderHash,
+            const char* shaderFileName,
+            const ComputeShaderDesc& dxbc,
+            const ComputeShaderDesc& dxil,
+            const ComputeShaderDesc& spirv
+        )
+        {
+            GraphPass& pass = passes[sizes.passesNum - 1];
+
+            // Pipeline (unique only), its descriptor ranges come from the first dispatch
+            size_t pipelineIndex = 0;
+            while (pipelineIndex < sizes.pipelinesNum && pipelines[pipelineIndex].shaderHash != shaderHash)
+                pipelineIndex++;
+
+            if (pipelineIndex == sizes.pipelinesNum)
+            {
+                GraphPipeline& pipeline = pipelines[sizes.pipelinesNum++];
+                pipeline = {shaderHash, shaderFileName, dxbc, dxil, spirv, passConstants, 0, 0};
+
+                for (size_t i = pass.resourcesOffset; i < sizes.resourcesNum; i++)
+                {
+                    if (resources[i].descriptorType == DescriptorType::TEXTURE)
+                        pipeline.texturesNum++;
+                    else
+                        pipeline.storageTexturesNum++;
+                }
+            }
+
+            // Dispatch
+            dispatches[sizes.dispatchesNum++] = {passConstants, numThreads, downsampleFactor, (uint16_t)maxRepeatNum, (uint16_t)pipelineIndex};
+            pass.dispatchesNum++;
+        }
+
+    private:
+        constexpr void AddTexture(const GraphTexture& texture, GraphPool pool, GeometryHistory geometryHistory)
+        {
+            GraphTexture& t = textures[sizes.texturesNum++];
+            t = texture;
+            t.pool = pool;
+            t.geometryHistory = geometryHistory;
+        }
+
+        constexpr void PushTexture(DescriptorType descriptorType, uint16_t indexInPool, uint16_t mipOffset, uint16_t mipNum, uint16_t indexToSwapWith)
+        {
+            resources[sizes.resourcesNum++] = {descriptorType, indexInPool, mipOffset, mipNum, indexToSwapWith};
+            passes[sizes.passesNum - 1].resourcesNum++;
+        }
+    };
+
+    template <size_t texturesNum, size_t passesNum, size_t dispatchesNum, size_t resourcesNum, size_t pipelinesNum>
+    constexpr Graph<texturesNum, passesNum, dispatchesNum, resourcesNum, pipelinesNum> CompactGraph(const GraphBuilder& builder)
+    {
+        Graph<texturesNum, passesNum, dispatchesNum, resourcesNum, pipelinesNum> graph = {};
+
+        for (size_t i = 0; i < texturesNum; i++)
+            graph.textures[i] = builder.textures[i];
+
+        for (size_t i = 0; i < passesNum; i++)
+            graph.passes[i] = builder.passes[i];
+
+        for (size_t i = 0; i < dispatchesNum; i++)
+            graph.dispatches[i] = builder.dispatches[i];
+
+        for (size_t i = 0; i < resourcesNum; i++)
+            graph.resources[i] = builder.resources[i];
+
+        for (size_t i = 0; i < pipelinesNum; i++)
+            graph.pipelines[i] = builder.pipelines[i];
+
+        return graph;
+    }
+
+    // Graph checks (linear in the number of resources)
+    constexpr bool IsTransient(uint16_t indexInPool)
+    { return indexInPool >= TRANSIENT_POOL_START; }
+
+    constexpr bool IsPermanent(uint16_t indexInPool)
+    { return indexInPool >= PERMANENT_POOL_START && indexInPool < TRANSIENT_POOL_START; }
+
+    constexpr bool IsGraphTextureDeclared(uint16_t indexInPool, size_t transientsNum, size_t permanentsNum)
+    {
+        if (IsTransient(indexInPool))
+            return indexInPool < TRANSIENT_POOL_START + transientsNum;
+
+        if (IsPermanent(indexInPool))
+            return indexInPool < PERMANENT_POOL_START + permanentsNum;
+
+        return true;
+    }
+
+    template <class GraphT>
+    constexpr bool AreGraphTexturesDeclared(const GraphT& graph)
+    {
+        size_t transientsNum = 0;
+        size_t permanentsNum = 0;
+        for (const GraphTexture& texture : graph.textures)
+        {
+            if (texture.pool == GraphPool::TRANSIENT)
+                transientsNum++;
+            else
+                permanentsNum += texture.pool == GraphPool::SHARED_PERMANENT ? 2 : 1;
+        }
+
+        if (transientsNum > 64)
+            return false;
+
+        for (const GraphResource& resource : graph.resources)
+        {
+            if (!IsGraphTextureDeclared(resource.indexInPool, transientsNum, permanentsNum))
+                return false;
+
+            if (resource.indexToSwapWith == uint16_t(-1))
+                continue;
+
+            // Ping-pong partners are in the same pool
+            if (!IsGraphTextureDeclared(resource.indexToSwapWith, transientsNum, permanentsNum) || IsTransient(resource.indexToSwapWith) != IsTransient(resource.indexInPool)
+                || IsPermanent(resource.indexToSwapWith) != IsPermanent(resource.indexInPool))
+                return false;
+        }
+
+        return true;
+    }
+
+    constexpr uint64_t GetGraphTransientBit(uint16_t indexInPool)
+    { return IsTransient(indexInPool) ? 1ull << (indexInPool - TRANSIENT_POOL_START) : 0; }
+
+    // Transient textures don't survive between frames
+    template <class GraphT>
+    constexpr bool AreGraphTransientsWrittenBeforeRead(const GraphT& graph)
+    {
+        uint64_t writtenMask = 0;
+        for (const GraphPass& pass : graph.passes)
+        {
+            for (size_t i = pass.resourcesOffset; i < pass.resourcesOffset + pass.resourcesNum; i++)
+            {
+                const GraphResource& resource = graph.resources[i];
+                uint64_t bit = GetGraphTransientBit(resource.indexInPool);
+                if (resource.descriptorType == DescriptorType::TEXTURE && (writtenMask & bit) != bit)
+                    return false;
+            }
+
+            for (size_t i = pass.resourcesOffset; i < pass.resourcesOffset + pass.resourcesNum; i++)
+            {
+                const GraphResource& resource = graph.resources[i];
+                if (resource.descriptorType == DescriptorType::STORAGE_TEXTURE)
+                    writtenMask |= GetGraphTransientBit(resource.indexInPool);
+            }
+        }
+
+        return true;
+    }
+
+    template <class GraphT>
+    constexpr bool AreGraphTransientsReadAfterWrite(const GraphT& graph)
+    {
+        uint64_t readMask = 0;
+        for (size_t p = graph.passes.size(); p > 0; p--)
+        {
+            const GraphPass& pass = graph.passes[p - 1];
+
+            for (size_t i = pass.resourcesOffset; i < pass.resourcesOffset + pass.resourcesNum; i++)
+            {
+                const GraphResource& resource = graph.resources[i];
+                uint64_t bit = GetGraphTransientBit(resource.indexInPool);
+                if (resource.descriptorType == DescriptorType::STORAGE_TEXTURE && (readMask & bit) != bit)
+                    return false;
+            }
+
+            for (size_t i = pass.resourcesOffset; i < pass.resourcesOffset + pass.resourcesNum; i++)
+            {
+                const GraphResource& resource = graph.resources[i];
+                if (resource.descriptorType == DescriptorType::TEXTURE)
+                    readMask |= GetGraphTransientBit(resource.indexInPool);
+            }
+        }
+
+        return true;
+    }
+
+    // A pass must have dispatches, write something and can't read and write the same texture
+    template <class GraphT>
+    constexpr bool AreGraphPassesValid(const GraphT& graph)
+    {
+        for (const GraphPass& pass : graph.passes)
+        {
+            if (pass.dispatchesNum == 0)
+                return false;
+
+            bool hasOutputs = false;
+            for (size_t i = pass.resourcesOffset; i < pass.resourcesOffset + pass.resourcesNum; i++)
+            {
+                const GraphResource& output = graph.resources[i];
+                if (output.descriptorType != DescriptorType::STORAGE_TEXTURE)
+                    continue;
+
+                hasOutputs = true;
+
+                for (size_t j = pass.resourcesOffset; j < pass.resourcesOffset + pass.resourcesNum; j++)
+                {
+                    const GraphResource& input = graph.resources[j];
+                    if (input.descriptorType == DescriptorType::TEXTURE && input.indexInPool == output.indexInPool)
+                        return false;
+                }
+            }
+
+            if (!hasOutputs)
+                return false;
+        }
+
+        for (const GraphDispatch& dispatch : graph.dispatches)
+        {
+            if (dispatch.numThreads.width == 0 || dispatch.numThreads.height == 0 || dispatch.downsampleFactor == 0 || dispatch.maxRepeatNum == 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    struct PipelineKey
+    {
+        uint64_t shaderHash;
+        uint16_t pipelineIndex;
+    };
+
+    struct DeduplicatedDispatch
+    {
+        DispatchDesc dispatchDesc;
+        size_t position; // in "m_ActiveDispatches" if emitted
+        size_t referencePosition; // in "m_ActiveDispatches", a previously emitted identical dispatch
+        uint32_t sourceDispatchIndex;
+        uint32_t dispatchIndex;
+        bool isEmitted;
+    };
+
+    struct TransientLifetime
+    {
+        uint16_t indexInPool;
+        uint16_t firstStage; // see "InternalDispatchDesc::stage"
+        uint16_t lastStage;
+    };
+
+    struct SubresourceState
+    {
+        ResourceType type;
+        uint16_t indexInPool;
+        uint16_t mip;
+        uint16_t viewIndex; // only for user provided resources
+        uint32_t lastWrite; // dispatch index
+        uint32_t lastRead; // index in "m_SubresourceReads"
+    };
+
+    struct SubresourceRead
+    {
+        uint32_t dispatchIndex;
+        uint32_t prev; // previous read since the last write
     };
 
     struct ClearResource
@@ -141,10 +719,155 @@ namespace nrd
         ResourceDesc resource;
         uint32_t w;
         uint32_t h;
+        uint32_t viewIndex;
         bool isInteger;
     };
 
-    class InstanceImpl
+    // Instance blob (see "SerializeInstance"): tables are stored as-is, pointers are replaced with indices in corresponding
+    // tables or offsets in the blob (names and bytecode)
+    enum class BlobTable : uint32_t
+    {
+        DENOISER_DATA,
+        PERMANENT_POOL,
+        TRANSIENT_POOL,
+        RESOURCES,
+        CLEAR_RESOURCES,
+        PING_PONGS,
+        RESOURCE_RANGES,
+        PIPELINES,
+        PIPELINE_KEYS,
+        DISPATCHES,
+        TRANSIENT_POOL_ALIASING,
+        ALIASING_GROUPS,
+        STRINGS,
+        BYTECODE,
+
+        MAX_NUM
+    };
+
+    struct BlobTableDesc
+    {
+        uint64_t offset;
+        uint32_t num;
+        uint32_t stride; // "sizeof" of an element, a mismatch means an incompatible build
+    };
+
+    struct BlobHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t libraryVersion[3];
+        uint32_t normalEncoding;
+        uint32_t roughnessEncoding;
+        uint32_t viewsNum;
+        uint32_t dispatchClearIndex[2];
+        uint32_t interleaveViews;
+        uint64_t size;
+        BlobTableDesc tables[(size_t)BlobTable::MAX_NUM];
+    };
+
+    // "CommonSettings" matrices, camera derivations depend only on them
+    struct CameraInputs
+    {
+        float viewToClip[16];
+        float viewToClipPrev[16];
+        float worldToView[16];
+        float worldToViewPrev[16];
+        float worldPrevToWorld[16];
+    };
+
+    // Camera derivations (see "InstanceImpl::UpdateCamera"), skipped if inputs are unchanged and can be copied between views of instances
+    // with the same camera (see "SetViewCommonSettingsWithSharedCamera")
+    struct CameraState
+    {
+        CameraInputs m_CameraInputs = {};
+        ml::float4x4 m_ViewToClip = ml::float4x4::Identity();
+        ml::float4x4 m_ViewToClipPrev = ml::float4x4::Identity();
+        ml::float4x4 m_ClipToView = ml::float4x4::Identity();
+        ml::float4x4 m_ClipToViewPrev = ml::float4x4::Identity();
+        ml::float4x4 m_WorldToView = ml::float4x4::Identity();
+        ml::float4x4 m_WorldToViewPrev = ml::float4x4::Identity();
+        ml::float4x4 m_ViewToWorld = ml::float4x4::Identity();
+        ml::float4x4 m_ViewToWorldPrev = ml::float4x4::Identity();
+        ml::float4x4 m_WorldToClip = ml::float4x4::Identity();
+        ml::float4x4 m_WorldToClipPrev = ml::float4x4::Identity();
+        ml::float4x4 m_ClipToWorld = ml::float4x4::Identity();
+        ml::float4x4 m_ClipToWorldPrev = ml::float4x4::Identity();
+        ml::float4x4 m_WorldPrevToWorld = ml::float4x4::Identity();
+        ml::float4 m_Frustum = ml::float4::Zero();
+        ml::float4 m_FrustumPrev = ml::float4::Zero();
+        ml::float3 m_CameraDelta = ml::float3::Zero();
+        ml::float3 m_ViewDirection = ml::float3::Zero();
+        ml::float3 m_ViewDirectionPrev = ml::float3::Zero();
+        float m_IsOrtho = 0.0f;
+        float m_ProjectY = 0.0f;
+        bool m_IsCameraValid = false;
+    };
+
+    // Per view state, views are switched by copying (see "InstanceImpl::LoadView")
+    struct ViewState : CameraState
+    {
+        Timer m_Timer;
+        ml::sFastRand m_FastRandState = {};
+        CommonSettings m_CommonSettings = {};
+        ml::float4 m_Rotator_PrePass = ml::float4::Zero();
+        ml::float4 m_Rotator_Blur = ml::float4::Zero();
+        ml::float4 m_Rotator_PostBlur = ml::float4::Zero();
+        float m_CheckerboardResolveAccumSpeed = 0.0f;
+        float m_JitterDelta = 0.0f;
+        float m_TimeDelta = 0.0f;
+        float m_FrameRateScale = 0.0f;
+        uint16_t m_RenderWidth = 0; // 0 - "DenoiserDesc" dimensions
+        uint16_t m_RenderHeight = 0;
+        uint16_t m_RenderWidthPrev = 0;
+        uint16_t m_RenderHeightPrev = 0;
+        bool m_IsFirstUse = true;
+        bool m_IsFirstFrame = true; // all calls for the first "frameIndex"
+    };
+
+    // Per call state of "GetComputeDispatches". Contexts are independent, i.e. dispatches for disjoint sets of identifiers
+    // can be gathered in parallel (see "CreateDispatchContext")
+    struct DispatchContextImpl
+    {
+        inline DispatchContextImpl(const StdAllocator<uint8_t>& stdAllocator) :
+            m_ActiveDispatches(stdAllocator)
+            , m_FrameTemplateDispatches(stdAllocator)
+            , m_FrameTemplateIdentifiers(stdAllocator)
+            , m_DeduplicatedDispatches(stdAllocator)
+            , m_ViewBatchedDispatches(stdAllocator)
+            , m_ViewBatchKeys(stdAllocator)
+            , m_ViewBatchOrder(stdAllocator)
+            , m_Dependencies(stdAllocator)
+            , m_SubresourceStates(stdAllocator)
+            , m_SubresourceReads(stdAllocator)
+            , m_ClearBatchResources(stdAllocator)
+            , m_ScratchConstantData(stdAllocator)
+        {}
+
+        Vector<DispatchDesc> m_ActiveDispatches;
+        Vector<uint32_t> m_FrameTemplateDispatches; // internal dispatch index for each entry in "m_ActiveDispatches"
+        Vector<Identifier> m_FrameTemplateIdentifiers;
+        Vector<DeduplicatedDispatch> m_DeduplicatedDispatches;
+        Vector<DispatchDesc> m_ViewBatchedDispatches;
+        Vector<uint64_t> m_ViewBatchKeys;
+        Vector<uint32_t> m_ViewBatchOrder; // index in "m_ActiveDispatches" for each entry in "m_ViewBatchedDispatches"
+        Vector<DispatchDependency> m_Dependencies;
+        Vector<SubresourceState> m_SubresourceStates;
+        Vector<SubresourceRead> m_SubresourceReads;
+        Vector<ResourceDesc> m_ClearBatchResources;
+        Vector<uint8_t> m_ScratchConstantData; // used by dry runs and on constant data overflow
+        DispatchDesc m_ScratchDispatchDesc = {};
+        const uint8_t* m_SharedConstantData = nullptr;
+        const DispatchDesc* m_LastDispatchDesc = nullptr;
+        size_t m_FrameTemplateCursor = 0;
+        uint32_t m_FrameTemplateSettingsVersion = 0; // "InstanceImpl::m_SettingsVersion" the template has been generated for
+        bool m_IsFrameTemplateValid = false;
+        bool m_IsFrameTemplateReplayed = false;
+        bool m_IsConstantDataOverflowed = false;
+        bool m_IsDryRun = false;
+    };
+
+    class InstanceImpl : private ViewState
     {
     // Add denoisers here
     public:
@@ -163,7 +886,7 @@ namespace nrd
         void Update_Reblur(const DenoiserData& denoiserData);
         void Update_ReblurOcclusion(const DenoiserData& denoiserData);
 
-        void AddSharedConstants_Reblur(const DenoiserData& denoiserData, const ReblurSettings& settings, Constant*& data);
+        void PushSharedConstants_Reblur(const DenoiserData& denoiserData, const ReblurSettings& settings);
 
         // Sigma
         void Add_SigmaShadow(DenoiserData& denoiserData);
@@ -171,7 +894,7 @@ namespace nrd
 
         void Update_SigmaShadow(const DenoiserData& denoiserData);
 
-        void AddSharedConstants_Sigma(const DenoiserData& denoiserData, const SigmaSettings& settings, Constant*& data);
+        void PushSharedConstants_Sigma(const DenoiserData& denoiserData, const SigmaSettings& settings);
 
         // Relax
         void Add_RelaxDiffuse(DenoiserData& denoiserData);
@@ -188,7 +911,7 @@ namespace nrd
         void Update_RelaxDiffuseSpecular(const DenoiserData& denoiserData);
         void Update_RelaxDiffuseSpecularSh(const DenoiserData& denoiserData);
 
-        void AddSharedConstants_Relax(const DenoiserData& denoiserData, Constant*& data, Denoiser denoiser);
+        void PushSharedConstants_Relax(const DenoiserData& denoiserData, Denoiser denoiser);
 
         // Other
         void Add_Reference(DenoiserData& denoiserData);
@@ -203,7 +926,8 @@ namespace nrd
     // Internal
     public:
         inline InstanceImpl(const StdAllocator<uint8_t>& stdAllocator) :
-            m_StdAllocator(stdAllocator)
+            m_AllocationTracker(stdAllocator.GetInterface())
+            , m_StdAllocator(GetTrackedAllocatorInterface(m_AllocationTracker))
             , m_DenoiserData(GetStdAllocator())
             , m_PermanentPool(GetStdAllocator())
             , m_TransientPool(GetStdAllocator())
@@ -212,11 +936,27 @@ namespace nrd
             , m_PingPongs(GetStdAllocator())
             , m_ResourceRanges(GetStdAllocator())
             , m_Pipelines(GetStdAllocator())
+            , m_PipelineKeys(GetStdAllocator())
             , m_Dispatches(GetStdAllocator())
-            , m_ActiveDispatches(GetStdAllocator())
             , m_IndexRemap(GetStdAllocator())
+            , m_PermanentIndexRemap(GetStdAllocator())
+            , m_SharedTextures(GetStdAllocator())
+            , m_ViewStates(GetStdAllocator())
+            , m_TransientLifetimes(GetStdAllocator())
+            , m_TransientPoolAliasing(GetStdAllocator())
+            , m_AliasingGroups(GetStdAllocator())
+            , m_MemoryUsageEntries(GetStdAllocator())
+            , m_PipelineReachability(GetStdAllocator())
+            , m_ReachablePipelines(GetStdAllocator())
+            , m_NewReachablePipelines(GetStdAllocator())
+            , m_ReachabilityIdentifiers(GetStdAllocator())
+            , m_FramePoolIdentifiers(GetStdAllocator())
+            , m_DecompressedBytecode(GetStdAllocator())
+            , m_DefaultContext(GetStdAllocator())
+            , m_DryRunContext(GetStdAllocator())
         {
-            m_ConstantData = m_StdAllocator.allocate(CONSTANT_DATA_SIZE);
+            m_DryRunContext.m_IsDryRun = true;
+
             m_DenoiserData.reserve(8);
             m_PermanentPool.reserve(32);
             m_TransientPool.reserve(32);
@@ -225,176 +965,236 @@ namespace nrd
             m_PingPongs.reserve(32);
             m_ResourceRanges.reserve(64);
             m_Pipelines.reserve(32);
+            m_PipelineKeys.reserve(32);
             m_Dispatches.reserve(32);
-            m_ActiveDispatches.reserve(32);
+            m_ViewStates.reserve(4);
+            m_TransientLifetimes.reserve(64);
+            m_TransientPoolAliasing.reserve(32);
+            m_AliasingGroups.reserve(4);
+            m_ReachabilityIdentifiers.reserve(8);
+            m_FramePoolIdentifiers.reserve(8);
         }
 
         ~InstanceImpl()
-        { m_StdAllocator.deallocate(m_ConstantData, CONSTANT_DATA_SIZE); }
+        {
+            // Tables are trivially destructible and freeing of arena memory is a no-op, i.e. the arena is not touched after this point
+            if (m_Arena.memory)
+            {
+                const MemoryAllocatorInterface& lowLevelAllocator = m_StdAllocator.GetInterface();
+                lowLevelAllocator.Free(lowLevelAllocator.userArg, m_Arena.memory, m_Arena.size, m_ArenaAlignment);
+            }
+
+            for (const ComputeShaderDesc& computeShaderDesc : m_DecompressedBytecode)
+            {
+                if (computeShaderDesc.bytecode)
+                    m_StdAllocator.deallocate((uint8_t*)computeShaderDesc.bytecode, computeShaderDesc.size);
+            }
+        }
 
         inline const InstanceDesc& GetDesc() const
         { return m_Desc; }
 
+        inline const MemoryUsageDesc& GetMemoryUsage() const
+        { return m_MemoryUsage; }
+
+        inline void GetAllocationStats(AllocationStatsDesc& allocationStatsDesc) const
+        {
+            allocationStatsDesc.allocationsNum = m_AllocationTracker.allocationsNum;
+            allocationStatsDesc.freesNum = m_AllocationTracker.freesNum;
+            allocationStatsDesc.allocatedSize = m_AllocationTracker.allocatedSize;
+            allocationStatsDesc.peakAllocatedSize = m_AllocationTracker.peakAllocatedSize;
+            allocationStatsDesc.steadyStateAllocationsNum = m_AllocationTracker.steadyStateAllocationsNum;
+        }
+
         inline StdAllocator<uint8_t>& GetStdAllocator()
         { return m_StdAllocator; }
 
+        // The instance object itself is allocated without tracking
+        inline StdAllocator<uint8_t> GetUntrackedStdAllocator() const
+        { return StdAllocator<uint8_t>(m_AllocationTracker.memoryAllocatorInterface); }
+
         Result Create(const InstanceCreationDesc& instanceCreationDesc);
-        Result SetCommonSettings(const CommonSettings& commonSettings);
+        Result CreateFromBlob(const InstanceCreationDesc& instanceCreationDesc, const uint8_t* blob, uint64_t blobSize);
+        Result Serialize(uint8_t* blob, uint64_t& blobSize) const;
+        Result SetCommonSettings(uint32_t viewIndex, const CommonSettings& commonSettings, const InstanceImpl* cameraSource = nullptr, uint32_t cameraSourceViewIndex = 0);
         Result SetDenoiserSettings(Identifier identifier, const void* denoiserSettings);
-        Result GetComputeDispatches(const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
+        Result Resize(uint16_t renderWidth, uint16_t renderHeight);
+        Result GetComputeDispatches(DispatchContextImpl& context, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
+        Result CreateDispatchContext(DispatchContextImpl*& context);
+        void DestroyDispatchContext(DispatchContextImpl& context);
 
-    private:
-        void AddComputeDispatchDesc
-        (
-            NumThreads numThreads,
-            uint16_t downsampleFactor,
-            uint32_t constantBufferDataSize,
-            uint32_t maxRepeatNum,
-            const char* shaderFileName,
-            const ComputeShaderDesc& dxbc,
-            const ComputeShaderDesc& dxil,
-            const ComputeShaderDesc& spirv
-        );
+        inline Result GetComputeDispatches(const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
+        { return GetComputeDispatches(m_DefaultContext, identifiers, identifiersNum, dispatchDescs, dispatchDescsNum); }
+
+        Result GetReachablePipelines(const Identifier* identifiers, uint32_t identifiersNum, ReachablePipelinesDesc& reachablePipelinesDesc);
+        Result GetFrameDescriptorPoolDesc(const Identifier* identifiers, uint32_t identifiersNum, DescriptorPoolDesc& descriptorPoolDesc);
+        Result DecompressPipelineBytecode(uint32_t pipelineIndex);
 
+    private:
+        uint16_t AddPipeline(const GraphPipeline& pipeline);
+
+        Result InitConstantData(const InstanceCreationDesc& instanceCreationDesc);
+        void DeduplicateDispatches(const DenoiserData& denoiserData, size_t resourceOffset);
+        bool IsDuplicateDispatch(size_t sourceDispatchIndex, size_t dispatchIndex, const DenoiserData& denoiserData) const;
+        void ResolveDeduplicatedDispatches(DispatchContextImpl& context);
+        void GatherTransientLifetimes(const DenoiserData& denoiserData);
+        void PlanTransientPoolAliasing();
         void PrepareDesc();
+        void DryRun(const Identifier* identifiers, uint32_t identifiersNum);
+        void FindUniquePipelines();
+        void PrepareMemoryUsage();
+        Result CompactTables();
+        void LoadView(uint32_t viewIndex);
+        void UpdateCamera(const CameraInputs& cameraInputs);
+        const ViewState& GetViewState(uint32_t viewIndex) const;
+        void BatchViews(DispatchContextImpl& context);
+        void BuildDependencies(DispatchContextImpl& context, Vector<DispatchDesc>& dispatchDescs);
+        bool IsFrameTemplateReusable(const DispatchContextImpl& context, const Identifier* identifiers, uint32_t identifiersNum) const;
+        void InitDispatchContext(DispatchContextImpl& context);
         void UpdatePingPong(const DenoiserData& denoiserData);
+        void UpdateGeometryHistory(const DenoiserData& denoiserData);
+        void UpdateDenoiser(const DenoiserData& denoiserData);
         void PushTexture(DescriptorType descriptorType, uint16_t localIndex, uint16_t mipOffset, uint16_t mipNum, uint16_t indexToSwapWith = uint16_t(-1));
 
     // Available in denoiser implementations
     private:
         void AddTextureToTransientPool(const TextureDesc& textureDesc);
-        Constant* PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex);
+        uint8_t* PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex);
+
+        // Adds two local indices: previous and current frame history (the same texture, if geometry history is not shared)
+        void AddSharedTextureToPermanentPool(const TextureDesc& textureDesc, GeometryHistory geometryHistory);
 
         inline void AddTextureToPermanentPool(const TextureDesc& textureDesc)
-        { m_PermanentPool.push_back(textureDesc); }
+        {
+            m_PermanentIndexRemap.push_back( (uint16_t)m_PermanentPool.size() );
+            m_PermanentPool.push_back(textureDesc);
+        }
 
-        inline void SetSharedConstants(uint32_t num4x4, uint32_t num4, uint32_t num2, uint32_t num1)
+        inline void SetSharedConstants(uint32_t size)
         {
-            m_SharedConstantNum = 16 * num4x4 + 4 * num4 + 2 * num2 + 1 * num1;
-            assert( m_SharedConstantNum % 4 == 0 );
+            m_SharedConstantDataSize = size;
+            assert( m_SharedConstantDataSize % 16 == 0 );
         }
 
-        inline uint32_t SumConstants(uint32_t num4x4, uint32_t num4, uint32_t num2, uint32_t num1, bool addShared = true)
-        { return ( 16 * num4x4 + 4 * num4 + 2 * num2 + 1 * num1 + ( addShared ? m_SharedConstantNum : 0 ) ) * sizeof(uint32_t); }
+        // Textures are sized for the denoiser
+        template <class GraphT>
+        inline void AddGraph(const DenoiserData& denoiserData, const GraphT& graph)
+        { AddGraph(graph.GetDesc(), denoiserData.desc.renderWidth, denoiserData.desc.renderHeight); }
 
-        inline void PushInput(uint16_t indexInPool, uint16_t mipOffset = 0, uint16_t mipNum = 1, uint16_t indexToSwapWith = uint16_t(-1))
-        { PushTexture(DescriptorType::TEXTURE, indexInPool, mipOffset, mipNum, indexToSwapWith); }
+        void AddGraph(const GraphDesc& graph, uint16_t width, uint16_t height);
 
-        inline void PushOutput(uint16_t indexInPool, uint16_t mipOffset = 0, uint16_t mipNum = 1, uint16_t indexToSwapWith = uint16_t(-1))
-        { PushTexture(DescriptorType::STORAGE_TEXTURE, indexInPool, mipOffset, mipNum, indexToSwapWith); }
+        inline uint8_t* PushConstants(DispatchContextImpl& context, uint32_t size)
+        {
+            // Dry run: constants are not needed
+            if (context.m_IsDryRun)
+                return context.m_ScratchConstantData.data();
+
+            // Overflow: data of in-flight frames can't be overwritten, constants go to the scratch memory and the call fails
+            size_t alignedSize = GetAlignedSize(size, m_ConstantDataAlignment);
+            size_t offset = m_ConstantDataOffset.fetch_add(alignedSize, std::memory_order_relaxed);
+            if (offset + alignedSize > m_ConstantDataPerFrameSize)
+            {
+                context.m_IsConstantDataOverflowed = true;
+
+                return context.m_ScratchConstantData.data();
+            }
+
+            return m_ConstantData + size_t(m_ConstantDataPartition) * m_ConstantDataPerFrameSize + offset;
+        }
 
-        inline void _PushPass(const char* name)
+        // "constants" must be zero-initialized: gaps left by HLSL packing rules get uploaded as well
+        template<class T>
+        inline void PushSharedConstants(const DenoiserData& denoiserData, const T& constants)
         {
-            m_PassName = name;
-            m_ResourceOffset = m_Resources.size();
+            static_assert( std::is_trivially_copyable<T>::value && sizeof(T) % 16 == 0, "Not a valid constant buffer layout" );
+            assert( sizeof(T) == denoiserData.sharedConstantBufferDataSize );
+
+            // A single sequential copy (the destination can be write-combined memory)
+            DispatchContextImpl& context = *denoiserData.context;
+            uint8_t* data = PushConstants(context, (uint32_t)sizeof(T));
+            memcpy(data, &constants, sizeof(T));
+
+            context.m_SharedConstantData = data;
         }
 
-        inline void ValidateConstants(const Constant* lastConstant) const
+        // "constants" must be zero-initialized: gaps left by HLSL packing rules get uploaded as well
+        template<class T>
+        inline void PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex, const T& constants)
         {
-            const DispatchDesc& dispatchDesc = m_ActiveDispatches.back();
+            static_assert( std::is_trivially_copyable<T>::value, "Not a valid constant buffer layout" );
 
-            [[maybe_unused]] size_t num = size_t(lastConstant - (const Constant*)dispatchDesc.constantBufferData);
-            [[maybe_unused]] size_t bytes = num * sizeof(uint32_t);
-            assert( bytes == dispatchDesc.constantBufferDataSize );
+            // A single sequential copy (the destination can be write-combined memory)
+            uint8_t* data = PushDispatch(denoiserData, localIndex);
+            assert( sizeof(T) == denoiserData.context->m_LastDispatchDesc->constantBufferDataSize );
+            memcpy(data, &constants, sizeof(T));
         }
 
     private:
+        AllocationTracker m_AllocationTracker; // all allocations of the instance go through it
         StdAllocator<uint8_t> m_StdAllocator;
+        Arena m_Arena = {}; // a single allocation for all tables, which live after creation (see "CompactTables")
         Vector<DenoiserData> m_DenoiserData;
         Vector<TextureDesc> m_PermanentPool;
         Vector<TextureDesc> m_TransientPool;
         Vector<ResourceDesc> m_Resources;
-        Vector<ClearResource> m_ClearResources;
+        Vector<ClearResource> m_ClearResources; // sorted by "view - class - size", i.e. batchable resources are adjacent
         Vector<PingPong> m_PingPongs;
         Vector<ResourceRangeDesc> m_ResourceRanges;
         Vector<PipelineDesc> m_Pipelines;
+        Vector<PipelineKey> m_PipelineKeys; // sorted by "shaderHash"
         Vector<InternalDispatchDesc> m_Dispatches;
-        Vector<DispatchDesc> m_ActiveDispatches;
         Vector<uint16_t> m_IndexRemap;
-        Timer m_Timer;
-        ml::sFastRand m_FastRandState = {};
+        Vector<uint16_t> m_PermanentIndexRemap;
+        Vector<SharedTexture> m_SharedTextures; // geometry history of the current view
+        Vector<ViewState> m_ViewStates;
+        Vector<TransientLifetime> m_TransientLifetimes;
+        Vector<TransientAliasingDesc> m_TransientPoolAliasing;
+        Vector<AliasingGroupDesc> m_AliasingGroups;
+        Vector<MemoryUsageEntry> m_MemoryUsageEntries;
+        Vector<uint8_t> m_PipelineReachability; // "PIPELINE_REACHABLE" and "PIPELINE_REPORTED" bits for each pipeline
+        Vector<uint16_t> m_ReachablePipelines;
+        Vector<uint16_t> m_NewReachablePipelines;
+        Vector<Identifier> m_ReachabilityIdentifiers;
+        Vector<Identifier> m_FramePoolIdentifiers; // "GetFrameDescriptorPoolDesc" has been called for
+        Vector<ComputeShaderDesc> m_DecompressedBytecode; // for each archive block, shared by pipelines with identical bytecode
+        DispatchContextImpl m_DefaultContext; // used by "GetComputeDispatches" without a context
+        DispatchContextImpl m_DryRunContext; // used by "GetReachablePipelines" and "GetFrameDescriptorPoolDesc"
         InstanceDesc m_Desc = {};
-        CommonSettings m_CommonSettings = {};
-        ml::float4x4 m_ViewToClip = ml::float4x4::Identity();
-        ml::float4x4 m_ViewToClipPrev = ml::float4x4::Identity();
-        ml::float4x4 m_ClipToView = ml::float4x4::Identity();
-        ml::float4x4 m_ClipToViewPrev = ml::float4x4::Identity();
-        ml::float4x4 m_WorldToView = ml::float4x4::Identity();
-        ml::float4x4 m_WorldToViewPrev = ml::float4x4::Identity();
-        ml::float4x4 m_ViewToWorld = ml::float4x4::Identity();
-        ml::float4x4 m_ViewToWorldPrev = ml::float4x4::Identity();
-        ml::float4x4 m_WorldToClip = ml::float4x4::Identity();
-        ml::float4x4 m_WorldToClipPrev = ml::float4x4::Identity();
-        ml::float4x4 m_ClipToWorld = ml::float4x4::Identity();
-        ml::float4x4 m_ClipToWorldPrev = ml::float4x4::Identity();
-        ml::float4x4 m_WorldPrevToWorld = ml::float4x4::Identity();
-        ml::float4 m_Rotator_PrePass = ml::float4::Zero();
-        ml::float4 m_Rotator_Blur = ml::float4::Zero();
-        ml::float4 m_Rotator_PostBlur = ml::float4::Zero();
-        ml::float4 m_Frustum = ml::float4::Zero();
-        ml::float4 m_FrustumPrev = ml::float4::Zero();
-        ml::float3 m_CameraDelta = ml::float3::Zero();
-        ml::float3 m_ViewDirection = ml::float3::Zero();
-        ml::float3 m_ViewDirectionPrev = ml::float3::Zero();
-        const char* m_PassName = nullptr;
+        DescriptorPoolDesc m_DryRunPoolDesc = {}; // accumulated by dry runs
+        DescriptorPoolDesc m_FramePoolDesc = {};
+        MemoryUsageDesc m_MemoryUsage = {};
+        std::shared_mutex m_Mutex; // exclusive: multi-view "GetComputeDispatches" and dry runs, shared: single-view contexts
+        std::mutex m_BytecodeMutex;
+        std::mutex m_GeometryHistoryMutex; // the state of shared geometry history is updated by contexts running in parallel
+        std::atomic<size_t> m_ConstantDataOffset = 0; // in the current partition
+        const char* m_PrevPassName = nullptr;
         uint8_t* m_ConstantData = nullptr;
-        size_t m_ConstantDataOffset = 0;
-        size_t m_ResourceOffset = 0;
+        size_t m_OwnedConstantDataSize = 0; // carved from the arena
+        size_t m_ArenaAlignment = ARENA_ALIGNMENT;
         size_t m_DispatchClearIndex[2] = {};
-        float m_IsOrtho = 0.0f;
-        float m_CheckerboardResolveAccumSpeed = 0.0f;
-        float m_JitterDelta = 0.0f;
-        float m_TimeDelta = 0.0f;
-        float m_FrameRateScale = 0.0f;
-        float m_ProjectY = 0.0f;
-        uint32_t m_SharedConstantNum = 0;
-        uint32_t m_AccumulatedFrameNum = 0;
+        uint32_t m_SharedConstantDataSize = 0;
+        uint32_t m_FramesInFlightNum = 0;
+        uint32_t m_ConstantDataPerFrameSize = 0;
+        uint32_t m_ConstantDataAlignment = CONSTANT_DATA_DEFAULT_ALIGNMENT;
+        uint32_t m_ConstantDataPartition = 0;
+        uint32_t m_ConstantDataFrameIndex = 0; // "CommonSettings::frameIndex" the current partition belongs to
+        uint32_t m_SettingsVersion = 0; // incremented on changes, which invalidate frame templates
+        uint32_t m_ClearBatchesMaxNum = 0;
+        uint32_t m_DispatchesMaxNum = 0; // per "GetComputeDispatches" call, including "clear" dispatches
+        uint32_t m_SubresourcesMaxNum = 0; // per "GetComputeDispatches" call, resource mips of all dispatches
+        uint32_t m_LoadedViewIndex = 0;
+        uint16_t m_ResizedWidth = 0; // set by "Resize", applied by the next "SetCommonSettings"
+        uint16_t m_ResizedHeight = 0;
         uint16_t m_TransientPoolOffset = 0;
+        uint16_t m_ViewTransientPoolOffset = 0;
+        uint16_t m_Stage = 0;
         uint16_t m_PermanentPoolOffset = 0;
-        bool m_IsFirstUse = true;
+        MemoryBudget m_MemoryBudget = MemoryBudget::DEFAULT;
+        bool m_InterleaveViews = false;
+        bool m_IsGeometryHistoryShared = false; // the current denoiser shares geometry history with other denoisers of its family
+        bool m_IsReachabilityDirty = true;
+        bool m_IsFramePoolDirty = true;
     };
-
-    inline void AddFloat4x4(Constant*& dst, const ml::float4x4& x)
-    {
-        memcpy(dst, &x, sizeof(ml::float4x4));
-        dst += 16;
-    }
-
-    inline void AddFloat4(Constant*& dst, const ml::float4& x)
-    {
-        memcpy(dst, &x, sizeof(ml::float4));
-        dst += 4;
-    }
-
-    inline void AddFloat2(Constant*& dst, float x, float y)
-    {
-        dst->f = x;
-        dst++;
-
-        dst->f = y;
-        dst++;
-    }
-
-    inline void AddFloat(Constant*& dst, float x)
-    {
-        dst->f = x;
-        dst++;
-    }
-
-    inline void AddUint(Constant*& dst, uint32_t x)
-    {
-        dst->ui = x;
-        dst++;
-    }
-
-    inline void AddUint2(Constant*& dst, uint32_t x, uint32_t y)
-    {
-        dst->ui = x;
-        dst++;
-
-        dst->ui = y;
-        dst++;
-    }
 }
 
 // IMPORTANT: needed only for DXBC produced by ShaderMake without "--useAPI"
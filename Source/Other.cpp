@@ -10,6 +10,20 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "InstanceImpl.h"
 
+#if NRD_WITH_REFERENCE
+
+// Reference constants (the layout is declared in HLSL, see "PassConstants.hlsli")
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct ReferenceTemporalAccumulationConstants
+{
+    REFERENCE_TEMPORAL_ACCUMULATION_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReferenceTemporalAccumulationConstants, constantType, constantName)
+REFERENCE_TEMPORAL_ACCUMULATION_CB_DATA
+#undef NRD_CONSTANT
+
 // REFERENCE
 #ifdef NRD_EMBEDS_DXBC_SHADERS
     #include "REFERENCE_TemporalAccumulation.cs.dxbc.h"
@@ -28,6 +42,30 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "Denoisers/Reference.hpp"
 
+#endif
+
+#if NRD_WITH_MV
+
+// Motion vector constants (the layout is declared in HLSL, see "PassConstants.hlsli")
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct SpecularReflectionMvConstants
+{
+    SPECULAR_REFLECTION_MV_CB_DATA
+};
+
+struct SpecularDeltaMvConstants
+{
+    SPECULAR_DELTA_MV_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(SpecularReflectionMvConstants, constantType, constantName)
+SPECULAR_REFLECTION_MV_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(SpecularDeltaMvConstants, constantType, constantName)
+SPECULAR_DELTA_MV_CB_DATA
+#undef NRD_CONSTANT
 
 // SPECULAR_REFLECTION_MV
 #ifdef NRD_EMBEDS_DXBC_SHADERS
@@ -59,3 +97,5 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #endif
 
 #include "Denoisers/SpecularDeltaMv.hpp"
+
+#endif
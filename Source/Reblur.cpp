@@ -12,37 +12,128 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include <array>
 
+// Shared constants (the layout is declared in HLSL, see "REBLUR_SharedConstants.hlsli")
+#include "../Shaders/Include/REBLUR/REBLUR_SharedConstants.hlsli"
+
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct ReblurSharedConstants
+{
+    REBLUR_SHARED_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurSharedConstants, constantType, constantName)
+REBLUR_SHARED_CB_DATA
+#undef NRD_CONSTANT
+
+// Per-pass constants (the layout is declared in HLSL, see "REBLUR_PassConstants.hlsli")
+#include "../Shaders/Include/REBLUR/REBLUR_PassConstants.hlsli"
+
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct ReblurPrePassConstants
+{
+    REBLUR_PREPASS_CB_DATA
+};
+
+struct ReblurTemporalAccumulationConstants
+{
+    REBLUR_TEMPORAL_ACCUMULATION_CB_DATA
+};
+
+struct ReblurHistoryFixConstants
+{
+    REBLUR_HISTORY_FIX_CB_DATA
+};
+
+struct ReblurBlurConstants
+{
+    REBLUR_BLUR_CB_DATA
+};
+
+struct ReblurCopyStabilizedHistoryConstants
+{
+    REBLUR_COPY_STABILIZED_HISTORY_CB_DATA
+};
+
+struct ReblurTemporalStabilizationConstants
+{
+    REBLUR_TEMPORAL_STABILIZATION_CB_DATA
+};
+
+struct ReblurSplitScreenConstants
+{
+    REBLUR_SPLIT_SCREEN_CB_DATA
+};
+
+struct ReblurValidationConstants
+{
+    REBLUR_VALIDATION_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurPrePassConstants, constantType, constantName)
+REBLUR_PREPASS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurTemporalAccumulationConstants, constantType, constantName)
+REBLUR_TEMPORAL_ACCUMULATION_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurHistoryFixConstants, constantType, constantName)
+REBLUR_HISTORY_FIX_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurBlurConstants, constantType, constantName)
+REBLUR_BLUR_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurCopyStabilizedHistoryConstants, constantType, constantName)
+REBLUR_COPY_STABILIZED_HISTORY_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurTemporalStabilizationConstants, constantType, constantName)
+REBLUR_TEMPORAL_STABILIZATION_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurSplitScreenConstants, constantType, constantName)
+REBLUR_SPLIT_SCREEN_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(ReblurValidationConstants, constantType, constantName)
+REBLUR_VALIDATION_CB_DATA
+#undef NRD_CONSTANT
+
 // Constants
-#define REBLUR_SET_SHARED_CONSTANTS                                 SetSharedConstants(2, 5, 9, 22)
+#define REBLUR_SET_SHARED_CONSTANTS                                 SetSharedConstants((uint32_t)sizeof(ReblurSharedConstants))
 
-#define REBLUR_CLASSIFY_TILES_CONSTANT_NUM                          SumConstants(0, 0, 0, 1, false)
+#define REBLUR_CLASSIFY_TILES_CONSTANT_NUM                          ConstantsOf<ClassifyTilesConstants>(false)
 #define REBLUR_CLASSIFY_TILES_NUM_THREADS                           NumThreads(16, 16)
 
-#define REBLUR_HITDIST_RECONSTRUCTION_CONSTANT_NUM                  SumConstants(0, 0, 0, 0)
+#define REBLUR_HITDIST_RECONSTRUCTION_CONSTANT_NUM                  NoConstants()
 #define REBLUR_HITDIST_RECONSTRUCTION_NUM_THREADS                   NumThreads(8, 8)
 
-#define REBLUR_PREPASS_CONSTANT_NUM                                 SumConstants(0, 1, 0, 2)
+#define REBLUR_PREPASS_CONSTANT_NUM                                 ConstantsOf<ReblurPrePassConstants>()
 #define REBLUR_PREPASS_NUM_THREADS                                  NumThreads(16, 16)
 
-#define REBLUR_TEMPORAL_ACCUMULATION_CONSTANT_NUM                   SumConstants(4, 2, 0, 7)
+#define REBLUR_TEMPORAL_ACCUMULATION_CONSTANT_NUM                   ConstantsOf<ReblurTemporalAccumulationConstants>()
 #define REBLUR_TEMPORAL_ACCUMULATION_NUM_THREADS                    NumThreads(8, 8)
 
-#define REBLUR_HISTORY_FIX_CONSTANT_NUM                             SumConstants(0, 0, 0, 1)
+#define REBLUR_HISTORY_FIX_CONSTANT_NUM                             ConstantsOf<ReblurHistoryFixConstants>()
 #define REBLUR_HISTORY_FIX_NUM_THREADS                              NumThreads(16, 16)
 
-#define REBLUR_BLUR_CONSTANT_NUM                                    SumConstants(0, 1, 0, 0)
+#define REBLUR_BLUR_CONSTANT_NUM                                    ConstantsOf<ReblurBlurConstants>()
 #define REBLUR_BLUR_NUM_THREADS                                     NumThreads(8, 8)
 
-#define REBLUR_POST_BLUR_CONSTANT_NUM                               SumConstants(0, 1, 0, 0)
+#define REBLUR_POST_BLUR_CONSTANT_NUM                               ConstantsOf<ReblurBlurConstants>()
 #define REBLUR_POST_BLUR_NUM_THREADS                                NumThreads(8, 8)
 
-#define REBLUR_COPY_STABILIZED_HISTORY_CONSTANT_NUM                 SumConstants(0, 0, 0, 1, false)
+#define REBLUR_COPY_STABILIZED_HISTORY_CONSTANT_NUM                 ConstantsOf<ReblurCopyStabilizedHistoryConstants>(false)
 #define REBLUR_COPY_STABILIZED_HISTORY_NUM_THREADS                  NumThreads(16, 16)
 
-#define REBLUR_TEMPORAL_STABILIZATION_CONSTANT_NUM                  SumConstants(3, 3, 1, 1)
+#define REBLUR_TEMPORAL_STABILIZATION_CONSTANT_NUM                  ConstantsOf<ReblurTemporalStabilizationConstants>()
 #define REBLUR_TEMPORAL_STABILIZATION_NUM_THREADS                   NumThreads(8, 8)
 
-#define REBLUR_SPLIT_SCREEN_CONSTANT_NUM                            SumConstants(0, 0, 0, 3)
+#define REBLUR_SPLIT_SCREEN_CONSTANT_NUM                            ConstantsOf<ReblurSplitScreenConstants>()
 #define REBLUR_SPLIT_SCREEN_NUM_THREADS                             NumThreads(16, 16)
 
 // Permutations
@@ -75,6 +166,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define REBLUR_FORMAT_DIRECTIONAL_OCCLUSION_FAST_HISTORY            REBLUR_FORMAT_OCCLUSION_FAST_HISTORY
 
 #define REBLUR_FORMAT_PREV_VIEWZ                                    Format::R32_SFLOAT
+#define REBLUR_FORMAT_PREV_VIEWZ_PACKED                             Format::R16_SFLOAT // "MemoryBudget::PARTIALLY_PACKED", packed by "PackViewZ"
 #define REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS                         Format::RGBA8_UNORM
 #define REBLUR_FORMAT_PREV_INTERNAL_DATA                            Format::R16_UINT
 
@@ -94,7 +186,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
         PushInput( AsUint(diff) ); \
         PushInput( AsUint(spec) ); \
         PushOutput( AsUint(ResourceType::OUT_VALIDATION) ); \
-        AddDispatch( REBLUR_Validation, SumConstants(1, 0, 1, 4), NumThreads(16, 16), IGNORE_RS ); \
+        AddDispatch( REBLUR_Validation, ConstantsOf<ReblurValidationConstants>(), NumThreads(16, 16), IGNORE_RS ); \
     }
 
 struct ReblurProps
@@ -167,139 +259,130 @@ void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData)
             break;
     }
 
+    // Shared constants (once per frame)
+    PushSharedConstants_Reblur(denoiserData, settings);
+
+    ReblurSplitScreenConstants splitScreenConstants = {};
+    splitScreenConstants.gSplitScreen = m_CommonSettings.splitScreen;
+    splitScreenConstants.gDiffCheckerboard = diffCheckerboard;
+    splitScreenConstants.gSpecCheckerboard = specCheckerboard;
+
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, diffCheckerboard);
-        AddUint(data, specCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
 
         return;
     }
 
     // CLASSIFY_TILES
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    ValidateConstants(data);
+    ClassifyTilesConstants classifyTilesConstants = {};
+    classifyTilesConstants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES), classifyTilesConstants);
 
     // HITDIST_RECONSTRUCTION
     if (enableHitDistanceReconstruction)
     {
         uint32_t passIndex = AsUint(Dispatch::HITDIST_RECONSTRUCTION) + (settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_5X5 ? 4 : 0) + (!skipPrePass ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        data = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, passIndex);
     }
 
     // PREPASS
     if (!skipPrePass)
     {
         uint32_t passIndex = AsUint(Dispatch::PREPASS) + (enableHitDistanceReconstruction ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        data = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat4(data, m_Rotator_PrePass);
-        AddUint(data, diffCheckerboard);
-        AddUint(data, specCheckerboard);
-        ValidateConstants(data);
+        ReblurPrePassConstants prePassConstants = {};
+        prePassConstants.gRotator = cb::AsFloat4(m_Rotator_PrePass);
+        prePassConstants.gDiffCheckerboard = diffCheckerboard;
+        prePassConstants.gSpecCheckerboard = specCheckerboard;
+        PushDispatch(denoiserData, passIndex, prePassConstants);
     }
 
     // TEMPORAL_ACCUMULATION
     uint32_t passIndex = AsUint(Dispatch::TEMPORAL_ACCUMULATION) + (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 16 : 0) +
         (!skipTemporalStabilization ? 8 : 0) + (m_CommonSettings.isHistoryConfidenceAvailable ? 4 : 0) +
         ((!skipPrePass || enableHitDistanceReconstruction) ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat4x4(data, m_WorldToViewPrev);
-    AddFloat4x4(data, m_WorldToClipPrev);
-    AddFloat4x4(data, m_WorldToClip);
-    AddFloat4x4(data, m_WorldPrevToWorld);
-    AddFloat4(data, m_FrustumPrev);
-    AddFloat4(data, ml::float4(m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z, disocclusionThreshold));
-    AddFloat(data, disocclusionThresholdAlternate);
-    AddFloat(data, m_CheckerboardResolveAccumSpeed);
-    AddUint(data, diffCheckerboard);
-    AddUint(data, specCheckerboard);
-    AddUint(data, skipPrePass ? 0 : 1);
-    AddUint(data, m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0);
-    AddUint(data, m_CommonSettings.isDisocclusionThresholdMixAvailable ? 1 : 0);
-    ValidateConstants(data);
+    ReblurTemporalAccumulationConstants temporalAccumulationConstants = {};
+    temporalAccumulationConstants.gWorldToViewPrev = cb::AsFloat4x4(m_WorldToViewPrev);
+    temporalAccumulationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+    temporalAccumulationConstants.gWorldToClip = cb::AsFloat4x4(m_WorldToClip);
+    temporalAccumulationConstants.gWorldPrevToWorld = cb::AsFloat4x4(m_WorldPrevToWorld);
+    temporalAccumulationConstants.gFrustumPrev = cb::AsFloat4(m_FrustumPrev);
+    temporalAccumulationConstants.gCameraDelta = {m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z};
+    temporalAccumulationConstants.gDisocclusionThreshold = disocclusionThreshold;
+    temporalAccumulationConstants.gDisocclusionThresholdAlternate = disocclusionThresholdAlternate;
+    temporalAccumulationConstants.gCheckerboardResolveAccumSpeed = m_CheckerboardResolveAccumSpeed;
+    temporalAccumulationConstants.gDiffCheckerboard = diffCheckerboard;
+    temporalAccumulationConstants.gSpecCheckerboard = specCheckerboard;
+    temporalAccumulationConstants.gIsPrepassEnabled = skipPrePass ? 0 : 1;
+    temporalAccumulationConstants.gHasHistoryConfidence = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+    temporalAccumulationConstants.gHasDisocclusionThresholdMix = m_CommonSettings.isDisocclusionThresholdMixAvailable ? 1 : 0;
+    PushDispatch(denoiserData, passIndex, temporalAccumulationConstants);
 
     // HISTORY_FIX
     passIndex = AsUint(Dispatch::HISTORY_FIX) + (settings.enablePerformanceMode ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat(data, settings.historyFixStrideBetweenSamples);
-    ValidateConstants(data);
+    ReblurHistoryFixConstants historyFixConstants = {};
+    historyFixConstants.gHistoryFixStrideBetweenSamples = settings.historyFixStrideBetweenSamples;
+    PushDispatch(denoiserData, passIndex, historyFixConstants);
 
     // BLUR
     passIndex = AsUint(Dispatch::BLUR) + (settings.enablePerformanceMode ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat4(data, m_Rotator_Blur);
-    ValidateConstants(data);
+    ReblurBlurConstants blurConstants = {};
+    blurConstants.gRotator = cb::AsFloat4(m_Rotator_Blur);
+    PushDispatch(denoiserData, passIndex, blurConstants);
 
     // POST_BLUR
     passIndex = AsUint(Dispatch::POST_BLUR) + (skipTemporalStabilization ? 0 : 2) + (settings.enablePerformanceMode ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat4(data, m_Rotator_PostBlur);
-    ValidateConstants(data);
+    ReblurBlurConstants postBlurConstants = {};
+    postBlurConstants.gRotator = cb::AsFloat4(m_Rotator_PostBlur);
+    PushDispatch(denoiserData, passIndex, postBlurConstants);
 
     // COPY_STABILIZED_HISTORY
     if (!skipTemporalStabilization)
     {
         passIndex = AsUint(Dispatch::COPY_STABILIZED_HISTORY);
-        data = PushDispatch(denoiserData, passIndex);
-        AddUint(data, isRectChanged ? 1 : 0);
-        ValidateConstants(data);
+        ReblurCopyStabilizedHistoryConstants copyStabilizedHistoryConstants = {};
+        copyStabilizedHistoryConstants.gIsRectChanged = isRectChanged ? 1 : 0;
+        PushDispatch(denoiserData, passIndex, copyStabilizedHistoryConstants);
     }
 
     // TEMPORAL_STABILIZATION
     if (!skipTemporalStabilization)
     {
         passIndex = AsUint(Dispatch::TEMPORAL_STABILIZATION) + (m_CommonSettings.isBaseColorMetalnessAvailable ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        data = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat4x4(data, m_WorldToClip);
-        AddFloat4x4(data, m_WorldToClipPrev);
-        AddFloat4x4(data, m_WorldToViewPrev);
-        AddFloat4(data, m_FrustumPrev);
-        AddFloat4(data, ml::float4(m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z, settings.stabilizationStrength));
-        AddFloat4(data, ml::float4(settings.antilagSettings.luminanceSigmaScale, settings.antilagSettings.hitDistanceSigmaScale, settings.antilagSettings.luminanceAntilagPower, settings.antilagSettings.hitDistanceAntilagPower));
+        ReblurTemporalStabilizationConstants temporalStabilizationConstants = {};
+        temporalStabilizationConstants.gWorldToClip = cb::AsFloat4x4(m_WorldToClip);
+        temporalStabilizationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+        temporalStabilizationConstants.gWorldToViewPrev = cb::AsFloat4x4(m_WorldToViewPrev);
+        temporalStabilizationConstants.gFrustumPrev = cb::AsFloat4(m_FrustumPrev);
+        temporalStabilizationConstants.gCameraDelta = {m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z};
+        temporalStabilizationConstants.gStabilizationStrength = settings.stabilizationStrength;
+        temporalStabilizationConstants.gAntilagParams = {settings.antilagSettings.luminanceSigmaScale, settings.antilagSettings.hitDistanceSigmaScale, settings.antilagSettings.luminanceAntilagPower, settings.antilagSettings.hitDistanceAntilagPower};
         if (m_CommonSettings.isBaseColorMetalnessAvailable)
-            AddFloat2(data, settings.specularProbabilityThresholdsForMvModification[0], settings.specularProbabilityThresholdsForMvModification[1]);
+            temporalStabilizationConstants.gSpecularProbabilityThresholdsForMvModification = {settings.specularProbabilityThresholdsForMvModification[0], settings.specularProbabilityThresholdsForMvModification[1]};
         else
-            AddFloat2(data, 2.0f, 3.0f);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        ValidateConstants(data);
+            temporalStabilizationConstants.gSpecularProbabilityThresholdsForMvModification = {2.0f, 3.0f};
+        temporalStabilizationConstants.gSplitScreen = m_CommonSettings.splitScreen;
+        PushDispatch(denoiserData, passIndex, temporalStabilizationConstants);
     }
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, diffCheckerboard);
-        AddUint(data, specCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
     }
 
     // VALIDATION
     if (m_CommonSettings.enableValidation)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat4x4(data, m_WorldToClipPrev);
-        AddFloat2(data, m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]);
-        AddUint(data, props.hasDiffuse ? 1 : 0);
-        AddUint(data, props.hasSpecular ? 1 : 0);
-        AddUint(data, diffCheckerboard);
-        AddUint(data, specCheckerboard);
-        ValidateConstants(data);
+        ReblurValidationConstants validationConstants = {};
+        validationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+        validationConstants.gJitter = {m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]};
+        validationConstants.gHasDiffuse = props.hasDiffuse ? 1 : 0;
+        validationConstants.gHasSpecular = props.hasSpecular ? 1 : 0;
+        validationConstants.gDiffCheckerboard = diffCheckerboard;
+        validationConstants.gSpecCheckerboard = specCheckerboard;
+        PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION), validationConstants);
     }
 }
 
@@ -345,101 +428,93 @@ void nrd::InstanceImpl::Update_ReblurOcclusion(const DenoiserData& denoiserData)
             break;
     }
 
+    // Shared constants (once per frame)
+    PushSharedConstants_Reblur(denoiserData, settings);
+
+    ReblurSplitScreenConstants splitScreenConstants = {};
+    splitScreenConstants.gSplitScreen = m_CommonSettings.splitScreen;
+    splitScreenConstants.gDiffCheckerboard = diffCheckerboard;
+    splitScreenConstants.gSpecCheckerboard = specCheckerboard;
+
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, diffCheckerboard);
-        AddUint(data, specCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
 
         return;
     }
 
     // CLASSIFY_TILES
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    ValidateConstants(data);
+    ClassifyTilesConstants classifyTilesConstants = {};
+    classifyTilesConstants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES), classifyTilesConstants);
 
     // HITDIST_RECONSTRUCTION
     if (enableHitDistanceReconstruction)
     {
         uint32_t passIndex = AsUint(Dispatch::HITDIST_RECONSTRUCTION) + (settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_5X5 ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        data = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, passIndex);
     }
 
     // TEMPORAL_ACCUMULATION
     uint32_t passIndex = AsUint(Dispatch::TEMPORAL_ACCUMULATION) + (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 8 : 0) +
         (m_CommonSettings.isHistoryConfidenceAvailable ? 4 : 0) + (enableHitDistanceReconstruction ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat4x4(data, m_WorldToViewPrev);
-    AddFloat4x4(data, m_WorldToClipPrev);
-    AddFloat4x4(data, m_WorldToClip);
-    AddFloat4x4(data, m_WorldPrevToWorld);
-    AddFloat4(data, m_FrustumPrev);
-    AddFloat4(data, ml::float4(m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z, disocclusionThreshold));
-    AddFloat(data, disocclusionThresholdAlternate);
-    AddFloat(data, m_CheckerboardResolveAccumSpeed);
-    AddUint(data, diffCheckerboard);
-    AddUint(data, specCheckerboard);
-    AddUint(data, 0);
-    AddUint(data, m_CommonSettings.isHistoryConfidenceAvailable);
-    AddUint(data, m_CommonSettings.isDisocclusionThresholdMixAvailable);
-    ValidateConstants(data);
+    ReblurTemporalAccumulationConstants temporalAccumulationConstants = {};
+    temporalAccumulationConstants.gWorldToViewPrev = cb::AsFloat4x4(m_WorldToViewPrev);
+    temporalAccumulationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+    temporalAccumulationConstants.gWorldToClip = cb::AsFloat4x4(m_WorldToClip);
+    temporalAccumulationConstants.gWorldPrevToWorld = cb::AsFloat4x4(m_WorldPrevToWorld);
+    temporalAccumulationConstants.gFrustumPrev = cb::AsFloat4(m_FrustumPrev);
+    temporalAccumulationConstants.gCameraDelta = {m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z};
+    temporalAccumulationConstants.gDisocclusionThreshold = disocclusionThreshold;
+    temporalAccumulationConstants.gDisocclusionThresholdAlternate = disocclusionThresholdAlternate;
+    temporalAccumulationConstants.gCheckerboardResolveAccumSpeed = m_CheckerboardResolveAccumSpeed;
+    temporalAccumulationConstants.gDiffCheckerboard = diffCheckerboard;
+    temporalAccumulationConstants.gSpecCheckerboard = specCheckerboard;
+    temporalAccumulationConstants.gIsPrepassEnabled = 0;
+    temporalAccumulationConstants.gHasHistoryConfidence = m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0;
+    temporalAccumulationConstants.gHasDisocclusionThresholdMix = m_CommonSettings.isDisocclusionThresholdMixAvailable ? 1 : 0;
+    PushDispatch(denoiserData, passIndex, temporalAccumulationConstants);
 
     // HISTORY_FIX
     passIndex = AsUint(Dispatch::HISTORY_FIX) + (!settings.enableAntiFirefly ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat(data, settings.historyFixStrideBetweenSamples);
-    ValidateConstants(data);
+    ReblurHistoryFixConstants historyFixConstants = {};
+    historyFixConstants.gHistoryFixStrideBetweenSamples = settings.historyFixStrideBetweenSamples;
+    PushDispatch(denoiserData, passIndex, historyFixConstants);
 
     // BLUR
     passIndex = AsUint(Dispatch::BLUR) + (settings.enablePerformanceMode ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat4(data, m_Rotator_Blur);
-    ValidateConstants(data);
+    ReblurBlurConstants blurConstants = {};
+    blurConstants.gRotator = cb::AsFloat4(m_Rotator_Blur);
+    PushDispatch(denoiserData, passIndex, blurConstants);
 
     // POST_BLUR
     passIndex = AsUint(Dispatch::POST_BLUR) + (settings.enablePerformanceMode ? 1 : 0);
-    data = PushDispatch(denoiserData, passIndex);
-    AddSharedConstants_Reblur(denoiserData, settings, data);
-    AddFloat4(data, m_Rotator_PostBlur);
-    ValidateConstants(data);
+    ReblurBlurConstants postBlurConstants = {};
+    postBlurConstants.gRotator = cb::AsFloat4(m_Rotator_PostBlur);
+    PushDispatch(denoiserData, passIndex, postBlurConstants);
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        AddUint(data, diffCheckerboard);
-        AddUint(data, specCheckerboard);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
     }
 
     // VALIDATION
     if (m_CommonSettings.enableValidation)
     {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
-        AddSharedConstants_Reblur(denoiserData, settings, data);
-        AddFloat4x4(data, m_WorldToClipPrev);
-        AddFloat2(data, m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]);
-        AddUint(data, props.hasDiffuse ? 1 : 0);
-        AddUint(data, props.hasSpecular ? 1 : 0);
-        AddUint(data, diffCheckerboard);
-        AddUint(data, specCheckerboard);
-        ValidateConstants(data);
+        ReblurValidationConstants validationConstants = {};
+        validationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+        validationConstants.gJitter = {m_CommonSettings.cameraJitter[0], m_CommonSettings.cameraJitter[1]};
+        validationConstants.gHasDiffuse = props.hasDiffuse ? 1 : 0;
+        validationConstants.gHasSpecular = props.hasSpecular ? 1 : 0;
+        validationConstants.gDiffCheckerboard = diffCheckerboard;
+        validationConstants.gSpecCheckerboard = specCheckerboard;
+        PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION), validationConstants);
     }
 }
 
-void nrd::InstanceImpl::AddSharedConstants_Reblur(const DenoiserData& denoiserData, const ReblurSettings& settings, Constant*& data)
+void nrd::InstanceImpl::PushSharedConstants_Reblur(const DenoiserData& denoiserData, const ReblurSettings& settings)
 {
     NRD_DECLARE_DIMS;
 
@@ -447,70 +522,64 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const DenoiserData& denoiserDa
     float unproject = 1.0f / (0.5f * rectH * m_ProjectY);
     uint32_t maxAccumulatedFrameNum = ml::Min(settings.maxAccumulatedFrameNum, REBLUR_MAX_HISTORY_FRAME_NUM);
 
-    AddFloat4x4(data, m_ViewToClip);
-    AddFloat4x4(data, m_ViewToWorld);
-
-    AddFloat4(data, m_Frustum);
-    AddFloat4(data, ml::float4(settings.hitDistanceParameters.A, settings.hitDistanceParameters.B, settings.hitDistanceParameters.C, settings.hitDistanceParameters.D));
-    AddFloat4(data, ml::float4(m_ViewDirection.x, m_ViewDirection.y, m_ViewDirection.z, 0.0f));
-    AddFloat4(data, ml::float4(m_ViewDirectionPrev.x, m_ViewDirectionPrev.y, m_ViewDirectionPrev.z, 0.0f));
-    AddFloat4(data, ml::float4(m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2], m_CommonSettings.debug));
-
-    AddFloat2(data, 1.0f / float(screenW), 1.0f / float(screenH));
-    AddFloat2(data, float(screenW), float(screenH));
-
-    AddFloat2(data, 1.0f / float(rectW), 1.0f / float(rectH));
-    AddFloat2(data, float(rectW), float(rectH));
-
-    AddFloat2(data, float(rectW) / float(screenW), float(rectH) / float(screenH));
-    AddFloat2(data, float(rectWprev) / float(screenW), float(rectHprev) / float(screenH));
-
-    AddFloat2(data, float(rectWprev), float(rectHprev));
-    AddFloat2(data, float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH));
-
-    AddUint2(data, m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]);
-    AddFloat(data, m_IsOrtho);
-    AddFloat(data, unproject);
-
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    AddFloat(data, settings.planeDistanceSensitivity);
-    AddFloat(data, m_FrameRateScale);
-    AddFloat(data, settings.blurRadius);
-
-    AddFloat(data, isHistoryReset ? 0 : float(maxAccumulatedFrameNum));
-    AddFloat(data, float(settings.maxFastAccumulatedFrameNum));
-    AddFloat(data, settings.enableAntiFirefly ? 1.0f : 0.0f);
-    AddFloat(data, settings.lobeAngleFraction);
-
-    AddFloat(data, settings.roughnessFraction);
-    AddFloat(data, settings.responsiveAccumulationRoughnessThreshold);
-    AddFloat(data, settings.diffusePrepassBlurRadius);
-    AddFloat(data, settings.specularPrepassBlurRadius);
-
-    AddFloat(data, (float)settings.historyFixFrameNum);
-    AddFloat(data, (float)ml::Min(rectW, rectH) * unproject);
-    AddFloat(data, settings.usePrepassOnlyForSpecularMotionEstimation ? 0.0f : 1.0f);
-    AddUint(data, m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0);
-
-    AddUint(data, m_CommonSettings.frameIndex);
-    AddUint(data, settings.enableMaterialTestForDiffuse ? 1 : 0);
-    AddUint(data, settings.enableMaterialTestForSpecular ? 1 : 0);
-    AddUint(data, isHistoryReset ? 1 : 0);
+    ReblurSharedConstants constants = {};
+    constants.gViewToClip = cb::AsFloat4x4(m_ViewToClip);
+    constants.gViewToWorld = cb::AsFloat4x4(m_ViewToWorld);
+    constants.gFrustum = cb::AsFloat4(m_Frustum);
+    constants.gHitDistParams = {settings.hitDistanceParameters.A, settings.hitDistanceParameters.B, settings.hitDistanceParameters.C, settings.hitDistanceParameters.D};
+    constants.gViewVectorWorld = {m_ViewDirection.x, m_ViewDirection.y, m_ViewDirection.z, 0.0f};
+    constants.gViewVectorWorldPrev = {m_ViewDirectionPrev.x, m_ViewDirectionPrev.y, m_ViewDirectionPrev.z, 0.0f};
+    constants.gMvScale = {m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2]};
+    constants.gDebug = m_CommonSettings.debug;
+    constants.gInvScreenSize = {1.0f / float(screenW), 1.0f / float(screenH)};
+    constants.gScreenSize = {float(screenW), float(screenH)};
+    constants.gInvRectSize = {1.0f / float(rectW), 1.0f / float(rectH)};
+    constants.gRectSize = {float(rectW), float(rectH)};
+    constants.gResolutionScale = {float(rectW) / float(screenW), float(rectH) / float(screenH)};
+    constants.gResolutionScalePrev = {float(rectWprev) / float(screenW), float(rectHprev) / float(screenH)};
+    constants.gRectSizePrev = {float(rectWprev), float(rectHprev)};
+    constants.gRectOffset = {float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH)};
+    constants.gRectOrigin = {m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]};
+    constants.gOrthoMode = m_IsOrtho;
+    constants.gUnproject = unproject;
+    constants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    constants.gPlaneDistSensitivity = settings.planeDistanceSensitivity;
+    constants.gFramerateScale = m_FrameRateScale;
+    constants.gBlurRadius = settings.blurRadius;
+    constants.gMaxAccumulatedFrameNum = isHistoryReset ? 0 : float(maxAccumulatedFrameNum);
+    constants.gMaxFastAccumulatedFrameNum = float(settings.maxFastAccumulatedFrameNum);
+    constants.gAntiFirefly = settings.enableAntiFirefly ? 1.0f : 0.0f;
+    constants.gLobeAngleFraction = settings.lobeAngleFraction;
+    constants.gRoughnessFraction = settings.roughnessFraction;
+    constants.gResponsiveAccumulationRoughnessThreshold = settings.responsiveAccumulationRoughnessThreshold;
+    constants.gDiffPrepassBlurRadius = settings.diffusePrepassBlurRadius;
+    constants.gSpecPrepassBlurRadius = settings.specularPrepassBlurRadius;
+    constants.gHistoryFixFrameNum = (float)settings.historyFixFrameNum;
+    constants.gMinRectDimMulUnproject = (float)ml::Min(rectW, rectH) * unproject;
+    constants.gUsePrepassNotOnlyForSpecularMotionEstimation = settings.usePrepassOnlyForSpecularMotionEstimation ? 0.0f : 1.0f;
+    constants.gIsWorldSpaceMotionEnabled = m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0;
+    constants.gFrameIndex = m_CommonSettings.frameIndex;
+    constants.gDiffMaterialMask = settings.enableMaterialTestForDiffuse ? 1 : 0;
+    constants.gSpecMaterialMask = settings.enableMaterialTestForSpecular ? 1 : 0;
+    constants.gResetHistory = isHistoryReset ? 1 : 0;
+    constants.gIsGeometryHistoryWriter = denoiserData.isGeometryHistoryWriter ? 1 : 0;
+
+    PushSharedConstants(denoiserData, constants);
 }
 
 // REBLUR_SHARED
 #ifdef NRD_EMBEDS_DXBC_SHADERS
-    #include "REBLUR_ClassifyTiles.cs.dxbc.h"
+    #include "ClassifyTiles.cs.dxbc.h"
     #include "REBLUR_Validation.cs.dxbc.h"
 #endif
 
 #ifdef NRD_EMBEDS_DXIL_SHADERS
-    #include "REBLUR_ClassifyTiles.cs.dxil.h"
+    #include "ClassifyTiles.cs.dxil.h"
     #include "REBLUR_Validation.cs.dxil.h"
 #endif
 
 #ifdef NRD_EMBEDS_SPIRV_SHADERS
-    #include "REBLUR_ClassifyTiles.cs.spirv.h"
+    #include "ClassifyTiles.cs.spirv.h"
     #include "REBLUR_Validation.cs.spirv.h"
 #endif
 
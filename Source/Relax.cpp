@@ -12,7 +12,259 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 constexpr uint32_t RELAX_MAX_ATROUS_PASS_NUM = 8;
 
-#define RELAX_SET_SHARED_CONSTANTS SetSharedConstants(5, 8, 7, 14)
+// Shared constants (the layout is declared in HLSL, see "RELAX_SharedConstants.hlsli")
+#include "../Shaders/Include/RELAX/RELAX_SharedConstants.hlsli"
+
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct RelaxSharedConstants
+{
+    RELAX_SHARED_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSharedConstants, constantType, constantName)
+RELAX_SHARED_CB_DATA
+#undef NRD_CONSTANT
+
+// Per-pass constants (the layout is declared in HLSL, see "RELAX_PassConstants.hlsli"). Most passes have a struct per variant
+#include "../Shaders/Include/RELAX/RELAX_PassConstants.hlsli"
+
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct RelaxDiffuseSpecularPrePassConstants
+{
+    RELAX_DIFFUSE_SPECULAR_PREPASS_CB_DATA
+};
+
+struct RelaxDiffusePrePassConstants
+{
+    RELAX_DIFFUSE_PREPASS_CB_DATA
+};
+
+struct RelaxSpecularPrePassConstants
+{
+    RELAX_SPECULAR_PREPASS_CB_DATA
+};
+
+struct RelaxDiffuseSpecularTemporalAccumulationConstants
+{
+    RELAX_DIFFUSE_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA
+};
+
+struct RelaxDiffuseTemporalAccumulationConstants
+{
+    RELAX_DIFFUSE_TEMPORAL_ACCUMULATION_CB_DATA
+};
+
+struct RelaxSpecularTemporalAccumulationConstants
+{
+    RELAX_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA
+};
+
+struct RelaxDiffuseSpecularHistoryFixConstants
+{
+    RELAX_DIFFUSE_SPECULAR_HISTORY_FIX_CB_DATA
+};
+
+struct RelaxDiffuseHistoryFixConstants
+{
+    RELAX_DIFFUSE_HISTORY_FIX_CB_DATA
+};
+
+struct RelaxSpecularHistoryFixConstants
+{
+    RELAX_SPECULAR_HISTORY_FIX_CB_DATA
+};
+
+struct RelaxDiffuseSpecularHistoryClampingConstants
+{
+    RELAX_DIFFUSE_SPECULAR_HISTORY_CLAMPING_CB_DATA
+};
+
+struct RelaxDiffuseHistoryClampingConstants
+{
+    RELAX_DIFFUSE_HISTORY_CLAMPING_CB_DATA
+};
+
+struct RelaxSpecularHistoryClampingConstants
+{
+    RELAX_SPECULAR_HISTORY_CLAMPING_CB_DATA
+};
+
+struct RelaxDiffuseSpecularAtrousSmemConstants
+{
+    RELAX_DIFFUSE_SPECULAR_ATROUS_SMEM_CB_DATA
+};
+
+struct RelaxDiffuseAtrousSmemConstants
+{
+    RELAX_DIFFUSE_ATROUS_SMEM_CB_DATA
+};
+
+struct RelaxSpecularAtrousSmemConstants
+{
+    RELAX_SPECULAR_ATROUS_SMEM_CB_DATA
+};
+
+struct RelaxDiffuseSpecularAtrousConstants
+{
+    RELAX_DIFFUSE_SPECULAR_ATROUS_CB_DATA
+};
+
+struct RelaxDiffuseAtrousConstants
+{
+    RELAX_DIFFUSE_ATROUS_CB_DATA
+};
+
+struct RelaxSpecularAtrousConstants
+{
+    RELAX_SPECULAR_ATROUS_CB_DATA
+};
+
+struct RelaxDiffuseSpecularShAtrousConstants
+{
+    RELAX_DIFFUSE_SPECULAR_SH_ATROUS_CB_DATA
+};
+
+struct RelaxDiffuseShAtrousConstants
+{
+    RELAX_DIFFUSE_SH_ATROUS_CB_DATA
+};
+
+struct RelaxSpecularShAtrousConstants
+{
+    RELAX_SPECULAR_SH_ATROUS_CB_DATA
+};
+
+struct RelaxDiffuseSpecularSplitScreenConstants
+{
+    RELAX_DIFFUSE_SPECULAR_SPLIT_SCREEN_CB_DATA
+};
+
+struct RelaxDiffuseSplitScreenConstants
+{
+    RELAX_DIFFUSE_SPLIT_SCREEN_CB_DATA
+};
+
+struct RelaxSpecularSplitScreenConstants
+{
+    RELAX_SPECULAR_SPLIT_SCREEN_CB_DATA
+};
+
+struct RelaxValidationConstants
+{
+    RELAX_VALIDATION_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularPrePassConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_PREPASS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffusePrePassConstants, constantType, constantName)
+RELAX_DIFFUSE_PREPASS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularPrePassConstants, constantType, constantName)
+RELAX_SPECULAR_PREPASS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularTemporalAccumulationConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseTemporalAccumulationConstants, constantType, constantName)
+RELAX_DIFFUSE_TEMPORAL_ACCUMULATION_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularTemporalAccumulationConstants, constantType, constantName)
+RELAX_SPECULAR_TEMPORAL_ACCUMULATION_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularHistoryFixConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_HISTORY_FIX_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseHistoryFixConstants, constantType, constantName)
+RELAX_DIFFUSE_HISTORY_FIX_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularHistoryFixConstants, constantType, constantName)
+RELAX_SPECULAR_HISTORY_FIX_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularHistoryClampingConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_HISTORY_CLAMPING_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseHistoryClampingConstants, constantType, constantName)
+RELAX_DIFFUSE_HISTORY_CLAMPING_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularHistoryClampingConstants, constantType, constantName)
+RELAX_SPECULAR_HISTORY_CLAMPING_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularAtrousSmemConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_ATROUS_SMEM_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseAtrousSmemConstants, constantType, constantName)
+RELAX_DIFFUSE_ATROUS_SMEM_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularAtrousSmemConstants, constantType, constantName)
+RELAX_SPECULAR_ATROUS_SMEM_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularAtrousConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_ATROUS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseAtrousConstants, constantType, constantName)
+RELAX_DIFFUSE_ATROUS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularAtrousConstants, constantType, constantName)
+RELAX_SPECULAR_ATROUS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularShAtrousConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_SH_ATROUS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseShAtrousConstants, constantType, constantName)
+RELAX_DIFFUSE_SH_ATROUS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularShAtrousConstants, constantType, constantName)
+RELAX_SPECULAR_SH_ATROUS_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSpecularSplitScreenConstants, constantType, constantName)
+RELAX_DIFFUSE_SPECULAR_SPLIT_SCREEN_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxDiffuseSplitScreenConstants, constantType, constantName)
+RELAX_DIFFUSE_SPLIT_SCREEN_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxSpecularSplitScreenConstants, constantType, constantName)
+RELAX_SPECULAR_SPLIT_SCREEN_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(RelaxValidationConstants, constantType, constantName)
+RELAX_VALIDATION_CB_DATA
+#undef NRD_CONSTANT
+
+#define RELAX_SET_SHARED_CONSTANTS SetSharedConstants((uint32_t)sizeof(RelaxSharedConstants))
+
+// Formats
+#define RELAX_FORMAT_DIFF_ILLUM_RESPONSIVE_PREV Format::RGBA16_SFLOAT
+#define RELAX_FORMAT_DIFF_ILLUM_RESPONSIVE_PREV_PACKED Format::R11_G11_B10_UFLOAT // "MemoryBudget::PARTIALLY_PACKED", .w - unused
+#define RELAX_FORMAT_PREV_VIEWZ Format::R32_SFLOAT
+#define RELAX_FORMAT_PREV_VIEWZ_PACKED Format::R16_SFLOAT // "MemoryBudget::PARTIALLY_PACKED", packed by "PackPrevViewZ"
+#define RELAX_FORMAT_PREV_NORMAL_ROUGHNESS Format::RGBA8_UNORM
+#define RELAX_FORMAT_PREV_MATERIAL_ID Format::R8_UNORM
 
 #define RELAX_ADD_VALIDATION_DISPATCH \
     PushPass("Validation"); \
@@ -22,7 +274,7 @@ constexpr uint32_t RELAX_MAX_ATROUS_PASS_NUM = 8;
         PushInput( AsUint(ResourceType::IN_MV) ); \
         PushInput( AsUint(Transient::HISTORY_LENGTH) ); \
         PushOutput( AsUint(ResourceType::OUT_VALIDATION) ); \
-        AddDispatch( RELAX_Validation, SumConstants(1, 0, 1, 1), NumThreads(16, 16), IGNORE_RS ); \
+        AddDispatch( RELAX_Validation, ConstantsOf<RelaxValidationConstants>(), NumThreads(16, 16), IGNORE_RS ); \
     }
 
 inline ml::float3 RELAX_GetFrustumForward(const ml::float4x4& viewToWorld, const ml::float4& frustum)
@@ -44,7 +296,7 @@ inline bool RELAX_IsCameraStatic
     return ml::Length(cameraDelta) < eps && ml::Length(frustumRight - prevFrustumRight) < eps && ml::Length(frustumUp - prevFrustumUp) < eps && ml::Length(frustumForward - prevFrustumForward) < eps;
 }
 
-void nrd::InstanceImpl::AddSharedConstants_Relax(const DenoiserData& denoiserData, Constant*& data, Denoiser denoiser)
+void nrd::InstanceImpl::PushSharedConstants_Relax(const DenoiserData& denoiserData, Denoiser denoiser)
 {
     NRD_DECLARE_DIMS;
 
@@ -62,83 +314,81 @@ void nrd::InstanceImpl::AddSharedConstants_Relax(const DenoiserData& denoiserDat
     ml::float3 prevFrustumUp = m_WorldToViewPrev.GetRow1().To3d() * prevTanHalfFov * prevAspect;
     ml::float3 prevFrustumForward = RELAX_GetFrustumForward(m_ViewToWorldPrev, m_FrustumPrev);
 
-    AddFloat4x4(data, m_WorldToClipPrev);
-    AddFloat4x4(data, m_WorldToViewPrev);
-    AddFloat4x4(data, m_WorldToClip);
-    AddFloat4x4(data, m_WorldPrevToWorld);
-    AddFloat4x4(data, m_ViewToWorld);
-
-    AddFloat4(data, ml::float4(frustumRight.x, frustumRight.y, frustumRight.z, 0));
-    AddFloat4(data, ml::float4(frustumUp.x, frustumUp.y, frustumUp.z, 0));
-    AddFloat4(data, ml::float4(frustumForward.x, frustumForward.y, frustumForward.z, 0));
-    AddFloat4(data, ml::float4(prevFrustumRight.x, prevFrustumRight.y, prevFrustumRight.z, 0));
-    AddFloat4(data, ml::float4(prevFrustumUp.x, prevFrustumUp.y, prevFrustumUp.z, 0));
-    AddFloat4(data, ml::float4(prevFrustumForward.x, prevFrustumForward.y, prevFrustumForward.z, 0));
-    AddFloat4(data, ml::float4(m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z, 0.0f));
-    AddFloat4(data, ml::float4(m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2], m_CommonSettings.debug));
-
-    AddFloat2(data, float(rectW) / float(screenW), float(rectH) / float(screenH));
-    AddUint2(data, m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]);
-
-    AddFloat2(data, float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH));
-    AddUint2(data, rectW, rectH);
-
-    AddFloat2(data, 1.0f / screenW, 1.0f / screenH);
-    AddFloat2(data, 1.0f / rectW, 1.0f / rectH);
-
-    AddFloat2(data, float(rectWprev), float(rectHprev));
-    AddUint(data, m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0);
-    AddFloat(data, m_IsOrtho);
-
-    AddFloat(data, 1.0f / (0.5f * rectH * m_ProjectY));
-    AddUint(data, m_CommonSettings.frameIndex);
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    AddFloat(data, ml::Clamp(16.66f / m_TimeDelta, 0.25f, 4.0f)); // Normalizing to 60 FPS
-
-    AddFloat(data, m_CheckerboardResolveAccumSpeed);
-    AddFloat(data, m_JitterDelta);
+    RelaxSharedConstants constants = {};
+    constants.gPrevWorldToClip = cb::AsFloat4x4(m_WorldToClipPrev);
+    constants.gPrevWorldToView = cb::AsFloat4x4(m_WorldToViewPrev);
+    constants.gWorldToClip = cb::AsFloat4x4(m_WorldToClip);
+    constants.gWorldPrevToWorld = cb::AsFloat4x4(m_WorldPrevToWorld);
+    constants.gViewToWorld = cb::AsFloat4x4(m_ViewToWorld);
+    constants.gFrustumRight = {frustumRight.x, frustumRight.y, frustumRight.z, 0.0f};
+    constants.gFrustumUp = {frustumUp.x, frustumUp.y, frustumUp.z, 0.0f};
+    constants.gFrustumForward = {frustumForward.x, frustumForward.y, frustumForward.z, 0.0f};
+    constants.gPrevFrustumRight = {prevFrustumRight.x, prevFrustumRight.y, prevFrustumRight.z, 0.0f};
+    constants.gPrevFrustumUp = {prevFrustumUp.x, prevFrustumUp.y, prevFrustumUp.z, 0.0f};
+    constants.gPrevFrustumForward = {prevFrustumForward.x, prevFrustumForward.y, prevFrustumForward.z, 0.0f};
+    constants.gPrevCameraPosition = {m_CameraDelta.x, m_CameraDelta.y, m_CameraDelta.z, 0.0f};
+    constants.gMvScale = {m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2]};
+    constants.gDebug = m_CommonSettings.debug;
+    constants.gResolutionScale = {float(rectW) / float(screenW), float(rectH) / float(screenH)};
+    constants.gRectOrigin = {m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]};
+    constants.gRectOffset = {float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH)};
+    constants.gRectSize = {rectW, rectH};
+    constants.gInvResourceSize = {1.0f / screenW, 1.0f / screenH};
+    constants.gInvRectSize = {1.0f / rectW, 1.0f / rectH};
+    constants.gRectSizePrev = {float(rectWprev), float(rectHprev)};
+    constants.gIsWorldSpaceMotionEnabled = m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0;
+    constants.gOrthoMode = m_IsOrtho;
+    constants.gUnproject = 1.0f / (0.5f * rectH * m_ProjectY);
+    constants.gFrameIndex = m_CommonSettings.frameIndex;
+    constants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    constants.gFramerateScale = ml::Clamp(16.66f / m_TimeDelta, 0.25f, 4.0f); // Normalizing to 60 FPS
+    constants.gCheckerboardResolveAccumSpeed = m_CheckerboardResolveAccumSpeed;
+    constants.gJitterDelta = m_JitterDelta;
+
     switch (denoiser)
     {
     case Denoiser::RELAX_DIFFUSE:
     case Denoiser::RELAX_DIFFUSE_SH:
-        AddUint(data, denoiserData.settings.diffuseRelax.enableMaterialTest ? 1 : 0);
-        AddUint(data, 0);
+        constants.gDiffMaterialMask = denoiserData.settings.diffuseRelax.enableMaterialTest ? 1 : 0;
+        constants.gSpecMaterialMask = 0;
         break;
     case Denoiser::RELAX_SPECULAR:
     case Denoiser::RELAX_SPECULAR_SH:
-        AddUint(data, 0);
-        AddUint(data, denoiserData.settings.specularRelax.enableMaterialTest ? 1 : 0);
+        constants.gDiffMaterialMask = 0;
+        constants.gSpecMaterialMask = denoiserData.settings.specularRelax.enableMaterialTest ? 1 : 0;
         break;
     case Denoiser::RELAX_DIFFUSE_SPECULAR:
     case Denoiser::RELAX_DIFFUSE_SPECULAR_SH:
-        AddUint(data, denoiserData.settings.diffuseSpecularRelax.enableMaterialTestForDiffuse ? 1 : 0);
-        AddUint(data, denoiserData.settings.diffuseSpecularRelax.enableMaterialTestForSpecular ? 1 : 0);
+        constants.gDiffMaterialMask = denoiserData.settings.diffuseSpecularRelax.enableMaterialTestForDiffuse ? 1 : 0;
+        constants.gSpecMaterialMask = denoiserData.settings.diffuseSpecularRelax.enableMaterialTestForSpecular ? 1 : 0;
         break;
     default:
         // Should never get here
-        AddUint(data, 0);
-        AddUint(data, 0);
+        constants.gDiffMaterialMask = 0;
+        constants.gSpecMaterialMask = 0;
         break;
     }
 
     // 1 if m_WorldPrevToWorld should be used in shader, otherwise we can skip multiplication
-    AddUint(data, (m_WorldPrevToWorld != ml::float4x4::Identity()) ? 1 : 0);
-    AddUint(data, m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE ? 1 : 0);
-    AddUint(data, 0);
-    AddUint(data, 0);
+    constants.gUseWorldPrevToWorld = (m_WorldPrevToWorld != ml::float4x4::Identity()) ? 1 : 0;
+    constants.gResetHistory = m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE ? 1 : 0;
+    constants.gIsPrevViewZPacked = m_MemoryBudget == MemoryBudget::PARTIALLY_PACKED ? 1 : 0;
+    constants.gIsGeometryHistoryWriter = denoiserData.isGeometryHistoryWriter ? 1 : 0;
+
+    PushSharedConstants(denoiserData, constants);
 }
 
 // RELAX_SHARED
 #ifdef NRD_EMBEDS_DXBC_SHADERS
-    #include "RELAX_ClassifyTiles.cs.dxbc.h"
+    #include "ClassifyTiles.cs.dxbc.h"
 #endif
 
 #ifdef NRD_EMBEDS_DXIL_SHADERS
-    #include "RELAX_ClassifyTiles.cs.dxil.h"
+    #include "ClassifyTiles.cs.dxil.h"
 #endif
 
 #ifdef NRD_EMBEDS_SPIRV_SHADERS
-    #include "RELAX_ClassifyTiles.cs.spirv.h"
+    #include "ClassifyTiles.cs.spirv.h"
 #endif
 
 // RELAX_DIFFUSE
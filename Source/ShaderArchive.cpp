@@ -0,0 +1,55 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#include "InstanceImpl.h"
+
+#ifdef NRD_EMBEDS_COMPRESSED_SHADERS
+    #include "NRDShaderArchive.h"
+#endif
+
+const nrd::ShaderArchiveBlock* nrd::FindArchivedShader([[maybe_unused]] uint64_t shaderHash, [[maybe_unused]] ShaderFormat format, [[maybe_unused]] uint32_t& blockIndex)
+{
+#ifdef NRD_EMBEDS_COMPRESSED_SHADERS
+    const ShaderArchiveEntry* begin = g_ShaderArchiveEntries;
+    const ShaderArchiveEntry* end = g_ShaderArchiveEntries + g_ShaderArchiveEntriesNum;
+
+    const ShaderArchiveEntry* entry = std::lower_bound(begin, end, shaderHash, [format](const ShaderArchiveEntry& a, uint64_t b)
+    {
+        return a.shaderHash != b ? a.shaderHash < b : a.format < format;
+    });
+
+    if (entry != end && entry->shaderHash == shaderHash && entry->format == format)
+    {
+        blockIndex = entry->blockIndex;
+
+        return g_ShaderArchiveBlocks + entry->blockIndex;
+    }
+#endif
+
+    return nullptr;
+}
+
+bool nrd::DecompressArchivedShader([[maybe_unused]] const ShaderArchiveBlock& block, [[maybe_unused]] uint8_t* bytecode)
+{
+#ifdef NRD_EMBEDS_COMPRESSED_SHADERS
+    return Lz4Decompress(g_ShaderArchiveData + block.offset, block.compressedSize, bytecode, block.size);
+#else
+    return false;
+#endif
+}
+
+uint32_t nrd::GetArchivedShaderBlocksNum()
+{
+#ifdef NRD_EMBEDS_COMPRESSED_SHADERS
+    return g_ShaderArchiveBlocksNum;
+#else
+    return 0;
+#endif
+}
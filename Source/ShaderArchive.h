@@ -0,0 +1,251 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#pragma once
+
+// Compressed shader archive ("NRD_EMBEDS_COMPRESSED_SHADERS"):
+// - generated by "Tools/ShaderArchiver.cpp" from ShaderMake binaries as "NRDShaderArchive.h"
+// - identical bytecode is stored once, each unique blob is an independent LZ4 block (i.e. can be decompressed alone)
+// - entries are sorted by "shaderHash - format"
+// IMPORTANT: this file is shared with the archiver, it must not depend on anything except the standard library
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef NRD_SHADER_ARCHIVE_COMPRESSOR
+    #include <algorithm>
+#endif
+
+namespace nrd
+{
+    // FNV-1a
+    constexpr uint64_t HashShaderName(const char* s, uint64_t hash = 14695981039346656037ull)
+    { return *s ? HashShaderName(s + 1, (hash ^ uint8_t(*s)) * 1099511628211ull) : hash; }
+
+    // Matches the order of "PipelineDesc::computeShader*"
+    enum class ShaderFormat : uint32_t
+    {
+        DXBC,
+        DXIL,
+        SPIRV,
+
+        MAX_NUM
+    };
+
+    struct ShaderArchiveBlock
+    {
+        uint32_t offset; // in the archive data
+        uint32_t compressedSize;
+        uint32_t size;
+    };
+
+    struct ShaderArchiveEntry
+    {
+        uint64_t shaderHash; // "HashShaderName" of "PipelineDesc::shaderFileName"
+        ShaderFormat format;
+        uint32_t blockIndex;
+    };
+
+    constexpr uint32_t LZ4_MIN_MATCH = 4;
+    constexpr uint32_t LZ4_LAST_LITERALS = 5; // the last bytes of a block are always literals
+    constexpr uint32_t LZ4_MATCH_LIMIT = 12; // a match can't start closer to the end of a block
+    constexpr uint32_t LZ4_WINDOW_SIZE = 65535;
+
+    // LZ4 block format, returns "false" on malformed input instead of reading or writing out of bounds
+    inline bool Lz4Decompress(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstSize)
+    {
+        const uint8_t* srcEnd = src + srcSize;
+        uint8_t* out = dst;
+        uint8_t* outEnd = dst + dstSize;
+
+        auto ReadLength = [&](size_t& length) -> bool
+        {
+            uint8_t b;
+            do
+            {
+                if (src >= srcEnd)
+                    return false;
+
+                b = *src++;
+                length += b;
+            }
+            while (b == 255);
+
+            return true;
+        };
+
+        while (src < srcEnd)
+        {
+            uint32_t token = *src++;
+
+            // Literals
+            size_t literalsNum = token >> 4;
+            if (literalsNum == 15 && !ReadLength(literalsNum))
+                return false;
+
+            if (literalsNum > size_t(srcEnd - src) || literalsNum > size_t(outEnd - out))
+                return false;
+
+            if (literalsNum)
+            {
+                memcpy(out, src, literalsNum);
+                out += literalsNum;
+                src += literalsNum;
+            }
+
+            // The last sequence has no match
+            if (src == srcEnd)
+                break;
+
+            // Match
+            if (srcEnd - src < 2)
+                return false;
+
+            size_t offset = src[0] | (src[1] << 8);
+            src += 2;
+
+            if (offset == 0 || offset > size_t(out - dst))
+                return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(matchLength))
+                return false;
+
+            matchLength += LZ4_MIN_MATCH;
+            if (matchLength > size_t(outEnd - out))
+                return false;
+
+            const uint8_t* match = out - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(out, match, matchLength);
+                out += matchLength;
+            }
+            else
+            {
+                // Overlapping match (repeated pattern)
+                for (size_t i = 0; i < matchLength; i++)
+                    *out++ = *match++;
+            }
+        }
+
+        return out == outEnd;
+    }
+
+#ifdef NRD_SHADER_ARCHIVE_COMPRESSOR
+
+    // Build-time only (greedy parsing with hash chains, favors ratio over speed)
+    template<class ByteVector>
+    void Lz4Compress(const uint8_t* src, uint32_t srcSize, ByteVector& dst, uint32_t chainMaxLength = 256)
+    {
+        constexpr uint32_t HASH_BITS = 16;
+        constexpr uint32_t NONE = uint32_t(-1);
+
+        auto Hash = [&](uint32_t pos)
+        {
+            uint32_t v;
+            memcpy(&v, src + pos, sizeof(v));
+
+            return (v * 2654435761u) >> (32 - HASH_BITS);
+        };
+
+        auto WriteLength = [&](size_t length)
+        {
+            for (; length >= 255; length -= 255)
+                dst.push_back(255);
+
+            dst.push_back(uint8_t(length));
+        };
+
+        static thread_local uint32_t heads[1 << HASH_BITS];
+        static thread_local uint32_t chain[LZ4_WINDOW_SIZE + 1];
+        for (uint32_t& head : heads)
+            head = NONE;
+
+        uint32_t anchor = 0;
+        uint32_t pos = 0;
+        uint32_t matchLimit = srcSize > LZ4_MATCH_LIMIT ? srcSize - LZ4_MATCH_LIMIT : 0;
+        uint32_t matchEnd = srcSize > LZ4_LAST_LITERALS ? srcSize - LZ4_LAST_LITERALS : 0;
+
+        while (pos < matchLimit)
+        {
+            // Find the longest match within the window
+            uint32_t h = Hash(pos);
+            uint32_t candidate = heads[h];
+            uint32_t bestLength = 0;
+            uint32_t bestOffset = 0;
+
+            for (uint32_t i = 0; i < chainMaxLength && candidate != NONE && pos - candidate <= LZ4_WINDOW_SIZE; i++)
+            {
+                uint32_t length = 0;
+                while (pos + length < matchEnd && src[candidate + length] == src[pos + length])
+                    length++;
+
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    bestOffset = pos - candidate;
+                }
+
+                uint32_t next = chain[candidate % (LZ4_WINDOW_SIZE + 1)];
+                if (next == NONE || next >= candidate)
+                    break;
+
+                candidate = next;
+            }
+
+            chain[pos % (LZ4_WINDOW_SIZE + 1)] = heads[h];
+            heads[h] = pos;
+
+            if (bestLength < LZ4_MIN_MATCH)
+            {
+                pos++;
+                continue;
+            }
+
+            // Sequence
+            size_t literalsNum = pos - anchor;
+            size_t matchLength = bestLength - LZ4_MIN_MATCH;
+
+            dst.push_back(uint8_t((std::min<size_t>(literalsNum, 15) << 4) | std::min<size_t>(matchLength, 15)));
+            if (literalsNum >= 15)
+                WriteLength(literalsNum - 15);
+
+            dst.insert(dst.end(), src + anchor, src + pos);
+
+            dst.push_back(uint8_t(bestOffset & 0xFF));
+            dst.push_back(uint8_t(bestOffset >> 8));
+            if (matchLength >= 15)
+                WriteLength(matchLength - 15);
+
+            // Skipped positions still feed the chains
+            uint32_t end = pos + bestLength;
+            for (pos++; pos < end && pos < matchLimit; pos++)
+            {
+                uint32_t hs = Hash(pos);
+                chain[pos % (LZ4_WINDOW_SIZE + 1)] = heads[hs];
+                heads[hs] = pos;
+            }
+
+            pos = end;
+            anchor = pos;
+        }
+
+        // Last literals
+        size_t literalsNum = srcSize - anchor;
+        dst.push_back(uint8_t(std::min<size_t>(literalsNum, 15) << 4));
+        if (literalsNum >= 15)
+            WriteLength(literalsNum - 15);
+
+        dst.insert(dst.end(), src + anchor, src + srcSize);
+    }
+
+#endif
+}
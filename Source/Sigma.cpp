@@ -10,22 +10,77 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "InstanceImpl.h"
 
-#define SIGMA_SET_SHARED_CONSTANTS                      SetSharedConstants(1, 2, 8, 8)
+// Shared constants (the layout is declared in HLSL, see "SIGMA_SharedConstants.hlsli")
+#include "../Shaders/Include/SIGMA/SIGMA_SharedConstants.hlsli"
 
-#define SIGMA_CLASSIFY_TILES_SET_CONSTANTS              SumConstants(0, 0, 0, 0)
-#define SIGMA_CLASSIFY_TILES_NUM_THREADS                NumThreads(1, 1)
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct SigmaSharedConstants
+{
+    SIGMA_SHARED_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(SigmaSharedConstants, constantType, constantName)
+SIGMA_SHARED_CB_DATA
+#undef NRD_CONSTANT
+
+// Per-pass constants (the layout is declared in HLSL, see "SIGMA_PassConstants.hlsli")
+#include "../Shaders/Include/SIGMA/SIGMA_PassConstants.hlsli"
+
+#define NRD_CONSTANT NRD_CONSTANT_MEMBER
+struct SigmaSmoothTilesConstants
+{
+    SIGMA_SMOOTH_TILES_CB_DATA
+};
+
+struct SigmaBlurConstants
+{
+    SIGMA_BLUR_CB_DATA
+};
+
+struct SigmaTemporalStabilizationConstants
+{
+    SIGMA_TEMPORAL_STABILIZATION_CB_DATA
+};
+
+struct SigmaSplitScreenConstants
+{
+    SIGMA_SPLIT_SCREEN_CB_DATA
+};
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(SigmaSmoothTilesConstants, constantType, constantName)
+SIGMA_SMOOTH_TILES_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(SigmaBlurConstants, constantType, constantName)
+SIGMA_BLUR_CB_DATA
+#undef NRD_CONSTANT
+
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(SigmaTemporalStabilizationConstants, constantType, constantName)
+SIGMA_TEMPORAL_STABILIZATION_CB_DATA
+#undef NRD_CONSTANT
 
-#define SIGMA_SMOOTH_TILES_SET_CONSTANTS                SumConstants(0, 0, 1, 0)
-#define SIGMA_SMOOTH_TILES_NUM_THREADS                  NumThreads(16, 16)
+#define NRD_CONSTANT(constantType, constantName) NRD_CONSTANT_CHECK(SigmaSplitScreenConstants, constantType, constantName)
+SIGMA_SPLIT_SCREEN_CB_DATA
+#undef NRD_CONSTANT
 
-#define SIGMA_BLUR_SET_CONSTANTS                        SumConstants(1, 1, 0, 0)
-#define SIGMA_BLUR_NUM_THREADS                          NumThreads(16, 16)
+#define SIGMA_SET_SHARED_CONSTANTS                       SetSharedConstants((uint32_t)sizeof(SigmaSharedConstants))
 
-#define SIGMA_TEMPORAL_STABILIZATION_SET_CONSTANTS      SumConstants(2, 0, 0, 0)
-#define SIGMA_TEMPORAL_STABILIZATION_NUM_THREADS        NumThreads(16, 16)
+#define SIGMA_CLASSIFY_TILES_SET_CONSTANTS               NoConstants()
+#define SIGMA_CLASSIFY_TILES_NUM_THREADS                 NumThreads(1, 1)
 
-#define SIGMA_SPLIT_SCREEN_SET_CONSTANTS                SumConstants(0, 0, 0, 1)
-#define SIGMA_SPLIT_SCREEN_NUM_THREADS                  NumThreads(16, 16)
+#define SIGMA_SMOOTH_TILES_SET_CONSTANTS                 ConstantsOf<SigmaSmoothTilesConstants>()
+#define SIGMA_SMOOTH_TILES_NUM_THREADS                   NumThreads(16, 16)
+
+#define SIGMA_BLUR_SET_CONSTANTS                         ConstantsOf<SigmaBlurConstants>()
+#define SIGMA_BLUR_NUM_THREADS                           NumThreads(16, 16)
+
+#define SIGMA_TEMPORAL_STABILIZATION_SET_CONSTANTS       ConstantsOf<SigmaTemporalStabilizationConstants>()
+#define SIGMA_TEMPORAL_STABILIZATION_NUM_THREADS         NumThreads(16, 16)
+
+#define SIGMA_SPLIT_SCREEN_SET_CONSTANTS                 ConstantsOf<SigmaSplitScreenConstants>()
+#define SIGMA_SPLIT_SCREEN_NUM_THREADS                   NumThreads(16, 16)
 
 void nrd::InstanceImpl::Update_SigmaShadow(const DenoiserData& denoiserData)
 {
@@ -46,92 +101,81 @@ void nrd::InstanceImpl::Update_SigmaShadow(const DenoiserData& denoiserData)
     uint16_t tilesW = DivideUp(rectW, 16);
     uint16_t tilesH = DivideUp(rectH, 16);
 
+    // Shared constants (once per frame)
+    PushSharedConstants_Sigma(denoiserData, settings);
+
+    SigmaSplitScreenConstants splitScreenConstants = {};
+    splitScreenConstants.gSplitScreen = m_CommonSettings.splitScreen;
+
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Sigma(denoiserData, settings, data);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        ValidateConstants(data);
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
 
         return;
     }
 
     // CLASSIFY_TILES
-    Constant* data = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-    AddSharedConstants_Sigma(denoiserData, settings, data);
-    ValidateConstants(data);
+    PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
 
     // SMOOTH_TILES
-    data = PushDispatch(denoiserData, AsUint(Dispatch::SMOOTH_TILES));
-    AddSharedConstants_Sigma(denoiserData, settings, data);
-    AddUint2(data, tilesW - 1, tilesH - 1);
-    ValidateConstants(data);
+    SigmaSmoothTilesConstants smoothTilesConstants = {};
+    smoothTilesConstants.gTilesSizeMinusOne = {tilesW - 1, tilesH - 1};
+    PushDispatch(denoiserData, AsUint(Dispatch::SMOOTH_TILES), smoothTilesConstants);
 
     // BLUR
-    data = PushDispatch(denoiserData, AsUint(Dispatch::BLUR));
-    AddSharedConstants_Sigma(denoiserData, settings, data);
-    AddFloat4x4(data, m_WorldToView);
-    AddFloat4(data, m_Rotator_Blur);
-    ValidateConstants(data);
+    SigmaBlurConstants blurConstants = {};
+    blurConstants.gWorldToView = cb::AsFloat4x4(m_WorldToView);
+    blurConstants.gRotator = cb::AsFloat4(m_Rotator_Blur);
+    PushDispatch(denoiserData, AsUint(Dispatch::BLUR), blurConstants);
 
     // POST_BLUR
-    data = PushDispatch(denoiserData, AsUint(Dispatch::POST_BLUR));
-    AddSharedConstants_Sigma(denoiserData, settings, data);
-    AddFloat4x4(data, m_WorldToView);
-    AddFloat4(data, m_Rotator_PostBlur);
-    ValidateConstants(data);
+    SigmaBlurConstants postBlurConstants = {};
+    postBlurConstants.gWorldToView = cb::AsFloat4x4(m_WorldToView);
+    postBlurConstants.gRotator = cb::AsFloat4(m_Rotator_PostBlur);
+    PushDispatch(denoiserData, AsUint(Dispatch::POST_BLUR), postBlurConstants);
 
     // TEMPORAL_STABILIZATION
-    data = PushDispatch(denoiserData, AsUint(Dispatch::TEMPORAL_STABILIZATION));
-    AddSharedConstants_Sigma(denoiserData, settings, data);
-    AddFloat4x4(data, m_WorldToClipPrev);
-    AddFloat4x4(data, m_ViewToWorld);
-    ValidateConstants(data);
+    SigmaTemporalStabilizationConstants temporalStabilizationConstants = {};
+    temporalStabilizationConstants.gWorldToClipPrev = cb::AsFloat4x4(m_WorldToClipPrev);
+    temporalStabilizationConstants.gViewToWorld = cb::AsFloat4x4(m_ViewToWorld);
+    PushDispatch(denoiserData, AsUint(Dispatch::TEMPORAL_STABILIZATION), temporalStabilizationConstants);
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
-    {
-        data = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Sigma(denoiserData, settings, data);
-        AddFloat(data, m_CommonSettings.splitScreen);
-        ValidateConstants(data);
-    }
+        PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN), splitScreenConstants);
 }
 
-void nrd::InstanceImpl::AddSharedConstants_Sigma(const DenoiserData& denoiserData, const SigmaSettings& settings, Constant*& data)
+void nrd::InstanceImpl::PushSharedConstants_Sigma(const DenoiserData& denoiserData, const SigmaSettings& settings)
 {
     NRD_DECLARE_DIMS;
 
     // Even with DRS keep radius, it works well for shadows
     float unproject = 1.0f / (0.5f * screenH * m_ProjectY);
 
-    AddFloat4x4(data, m_ViewToClip);
-
-    AddFloat4(data, m_Frustum);
-    AddFloat4(data, ml::float4(m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2], m_CommonSettings.debug));
-
-    AddFloat2(data, 1.0f / float(screenW), 1.0f / float(screenH));
-    AddFloat2(data, float(screenW), float(screenH));
-
-    AddFloat2(data, 1.0f / float(rectW), 1.0f / float(rectH));
-    AddFloat2(data, float(rectW), float(rectH));
-
-    AddFloat2(data, float(rectWprev), float(rectHprev));
-    AddFloat2(data, float(rectW) / float(screenW), float(rectH) / float(screenH));
-
-    AddFloat2(data, float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH));
-    AddUint2(data, m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]);
-
-    AddFloat(data, m_IsOrtho);
-    AddFloat(data, unproject);
-    AddFloat(data, m_CommonSettings.denoisingRange);
-    AddFloat(data, settings.planeDistanceSensitivity);
-
-    AddFloat(data, settings.blurRadiusScale);
-    AddFloat(data, m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE ? 0.0f : 1.0f);
-    AddUint(data, m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0);
-    AddUint(data, m_CommonSettings.frameIndex);
+    SigmaSharedConstants constants = {};
+    constants.gViewToClip = cb::AsFloat4x4(m_ViewToClip);
+    constants.gFrustum = cb::AsFloat4(m_Frustum);
+    constants.gMvScale = {m_CommonSettings.motionVectorScale[0], m_CommonSettings.motionVectorScale[1], m_CommonSettings.motionVectorScale[2]};
+    constants.gDebug = m_CommonSettings.debug;
+    constants.gInvScreenSize = {1.0f / float(screenW), 1.0f / float(screenH)};
+    constants.gScreenSize = {float(screenW), float(screenH)};
+    constants.gInvRectSize = {1.0f / float(rectW), 1.0f / float(rectH)};
+    constants.gRectSize = {float(rectW), float(rectH)};
+    constants.gRectSizePrev = {float(rectWprev), float(rectHprev)};
+    constants.gResolutionScale = {float(rectW) / float(screenW), float(rectH) / float(screenH)};
+    constants.gRectOffset = {float(m_CommonSettings.inputSubrectOrigin[0]) / float(screenW), float(m_CommonSettings.inputSubrectOrigin[1]) / float(screenH)};
+    constants.gRectOrigin = {m_CommonSettings.inputSubrectOrigin[0], m_CommonSettings.inputSubrectOrigin[1]};
+    constants.gOrthoMode = m_IsOrtho;
+    constants.gUnproject = unproject;
+    constants.gDenoisingRange = m_CommonSettings.denoisingRange;
+    constants.gPlaneDistSensitivity = settings.planeDistanceSensitivity;
+    constants.gBlurRadiusScale = settings.blurRadiusScale;
+    constants.gContinueAccumulation = m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE ? 0.0f : 1.0f;
+    constants.gIsWorldSpaceMotionEnabled = m_CommonSettings.isMotionVectorInWorldSpace ? 1 : 0;
+    constants.gFrameIndex = m_CommonSettings.frameIndex;
+
+    PushSharedConstants(denoiserData, constants);
 }
 
 // SIGMA_SHADOW
@@ -13,6 +13,9 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <atomic>
+#include <cassert>
+#include <cstring>
 
 template<typename T> void StdAllocator_MaybeUnused([[maybe_unused]] const T& arg)
 {}
@@ -260,6 +263,161 @@ inline void DeallocateArray(StdAllocator<uint8_t>& allocator, T* array, size_t a
 
 //==============================================================================================================================
 
+// Linear allocator over a single block. Tables get carved sequentially with exactly reserved capacities, "Free" is a no-op
+// (the block is freed as a whole). Growth beyond the block (i.e. beyond expected worst cases) goes to the fallback allocator
+struct Arena
+{
+    uint8_t* memory;
+    size_t size;
+    size_t offset;
+    MemoryAllocatorInterface fallbackMemoryAllocatorInterface;
+};
+
+inline bool IsInArena(const Arena& arena, const void* memory)
+{
+    return memory >= arena.memory && memory < arena.memory + arena.size;
+}
+
+inline void* ArenaAllocate(void* userArg, size_t size, size_t alignment)
+{
+    Arena& arena = *(Arena*)userArg;
+
+    size_t offset = GetAlignedSize(arena.offset, (uint32_t)alignment);
+    if (offset + size > arena.size)
+        return arena.fallbackMemoryAllocatorInterface.Allocate(arena.fallbackMemoryAllocatorInterface.userArg, size, alignment);
+
+    arena.offset = offset + size;
+
+    return arena.memory + offset;
+}
+
+inline void* ArenaReallocate(void* userArg, void* memory, size_t size, size_t alignment, size_t old_size, size_t old_alignment)
+{
+    Arena& arena = *(Arena*)userArg;
+
+    if (!IsInArena(arena, memory))
+        return arena.fallbackMemoryAllocatorInterface.Reallocate(arena.fallbackMemoryAllocatorInterface.userArg, memory, size, alignment, old_size, old_alignment);
+
+    void* newMemory = ArenaAllocate(userArg, size, alignment);
+    if (newMemory)
+        memcpy(newMemory, memory, old_size < size ? old_size : size);
+
+    return newMemory;
+}
+
+inline void ArenaFree(void* userArg, void* memory, size_t size, size_t alignment)
+{
+    Arena& arena = *(Arena*)userArg;
+
+    if (memory && !IsInArena(arena, memory))
+        arena.fallbackMemoryAllocatorInterface.Free(arena.fallbackMemoryAllocatorInterface.userArg, memory, size, alignment);
+}
+
+inline MemoryAllocatorInterface GetArenaAllocatorInterface(Arena& arena)
+{
+    MemoryAllocatorInterface memoryAllocatorInterface = {};
+    memoryAllocatorInterface.Allocate = ArenaAllocate;
+    memoryAllocatorInterface.Reallocate = ArenaReallocate;
+    memoryAllocatorInterface.Free = ArenaFree;
+    memoryAllocatorInterface.userArg = &arena;
+
+    return memoryAllocatorInterface;
+}
+
+//==============================================================================================================================
+
+// Counts allocations and forwards them to another allocator. After "isSteadyState" is set allocations are expected only within
+// creation scopes (see "AllocationCreationScope") of the calling thread, others are steady state allocations
+struct AllocationTracker
+{
+    inline AllocationTracker(const MemoryAllocatorInterface& forwardedMemoryAllocatorInterface) : memoryAllocatorInterface(forwardedMemoryAllocatorInterface)
+    {}
+
+    MemoryAllocatorInterface memoryAllocatorInterface;
+    std::atomic<uint64_t> allocationsNum = 0;
+    std::atomic<uint64_t> freesNum = 0;
+    std::atomic<uint64_t> allocatedSize = 0;
+    std::atomic<uint64_t> peakAllocatedSize = 0;
+    std::atomic<uint64_t> steadyStateAllocationsNum = 0;
+    std::atomic<bool> isSteadyState = false;
+    bool isLocked = false; // steady state allocations assert
+};
+
+inline thread_local uint32_t g_AllocationCreationScopesNum = 0;
+
+struct AllocationCreationScope
+{
+    inline AllocationCreationScope()
+    { g_AllocationCreationScopesNum++; }
+
+    inline ~AllocationCreationScope()
+    { g_AllocationCreationScopesNum--; }
+};
+
+inline void TrackAllocation(AllocationTracker& tracker, size_t size)
+{
+    tracker.allocationsNum++;
+
+    uint64_t allocatedSize = tracker.allocatedSize += size;
+    uint64_t peakAllocatedSize = tracker.peakAllocatedSize;
+    while (allocatedSize > peakAllocatedSize && !tracker.peakAllocatedSize.compare_exchange_weak(peakAllocatedSize, allocatedSize))
+        ;
+
+    if (tracker.isSteadyState && !g_AllocationCreationScopesNum)
+    {
+        tracker.steadyStateAllocationsNum++;
+        assert( !tracker.isLocked && "Allocation in the steady state!" );
+    }
+}
+
+inline void* TrackedAllocate(void* userArg, size_t size, size_t alignment)
+{
+    AllocationTracker& tracker = *(AllocationTracker*)userArg;
+    TrackAllocation(tracker, size);
+
+    return tracker.memoryAllocatorInterface.Allocate(tracker.memoryAllocatorInterface.userArg, size, alignment);
+}
+
+inline void* TrackedReallocate(void* userArg, void* memory, size_t size, size_t alignment, size_t old_size, size_t old_alignment)
+{
+    AllocationTracker& tracker = *(AllocationTracker*)userArg;
+    TrackAllocation(tracker, size);
+
+    if (memory)
+    {
+        tracker.freesNum++;
+        tracker.allocatedSize -= old_size;
+    }
+
+    return tracker.memoryAllocatorInterface.Reallocate(tracker.memoryAllocatorInterface.userArg, memory, size, alignment, old_size, old_alignment);
+}
+
+inline void TrackedFree(void* userArg, void* memory, size_t size, size_t alignment)
+{
+    AllocationTracker& tracker = *(AllocationTracker*)userArg;
+
+    if (memory)
+    {
+        tracker.freesNum++;
+        tracker.allocatedSize -= size;
+    }
+
+    tracker.memoryAllocatorInterface.Free(tracker.memoryAllocatorInterface.userArg, memory, size, alignment);
+}
+
+inline MemoryAllocatorInterface GetTrackedAllocatorInterface(AllocationTracker& tracker)
+{
+    MemoryAllocatorInterface memoryAllocatorInterface = {};
+    memoryAllocatorInterface.Allocate = TrackedAllocate;
+    memoryAllocatorInterface.Reallocate = TrackedReallocate;
+    memoryAllocatorInterface.Free = TrackedFree;
+    memoryAllocatorInterface.userArg = &tracker;
+
+    return memoryAllocatorInterface;
+}
+
+//==============================================================================================================================
+
 template<typename T>
 using Vector = std::vector<T, StdAllocator<T>>;
 
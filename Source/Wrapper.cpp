@@ -18,8 +18,10 @@ static_assert(VERSION_MAJOR == NRD_VERSION_MAJOR, "VERSION_MAJOR & NRD_VERSION_M
 static_assert(VERSION_MINOR == NRD_VERSION_MINOR, "VERSION_MINOR & NRD_VERSION_MINOR don't match!");
 static_assert(VERSION_BUILD == NRD_VERSION_BUILD, "VERSION_BUILD & NRD_VERSION_BUILD don't match!");
 
-constexpr std::array<nrd::Denoiser, (size_t)nrd::Denoiser::MAX_NUM> g_NrdSupportedDenoisers =
+// Only denoisers compiled into the library (see "NRD_WITH_X" CMake options)
+constexpr nrd::Denoiser g_NrdSupportedDenoisers[] =
 {
+#if NRD_WITH_REBLUR
     nrd::Denoiser::REBLUR_DIFFUSE,
     nrd::Denoiser::REBLUR_DIFFUSE_OCCLUSION,
     nrd::Denoiser::REBLUR_DIFFUSE_SH,
@@ -30,24 +32,33 @@ constexpr std::array<nrd::Denoiser, (size_t)nrd::Denoiser::MAX_NUM> g_NrdSupport
     nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR_OCCLUSION,
     nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR_SH,
     nrd::Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION,
+#endif
+#if NRD_WITH_SIGMA
     nrd::Denoiser::SIGMA_SHADOW,
     nrd::Denoiser::SIGMA_SHADOW_TRANSLUCENCY,
+#endif
+#if NRD_WITH_RELAX
     nrd::Denoiser::RELAX_DIFFUSE,
     nrd::Denoiser::RELAX_DIFFUSE_SH,
     nrd::Denoiser::RELAX_SPECULAR,
     nrd::Denoiser::RELAX_SPECULAR_SH,
     nrd::Denoiser::RELAX_DIFFUSE_SPECULAR,
     nrd::Denoiser::RELAX_DIFFUSE_SPECULAR_SH,
+#endif
+#if NRD_WITH_REFERENCE
     nrd::Denoiser::REFERENCE,
+#endif
+#if NRD_WITH_MV
     nrd::Denoiser::SPECULAR_REFLECTION_MV,
-    nrd::Denoiser::SPECULAR_DELTA_MV
+    nrd::Denoiser::SPECULAR_DELTA_MV,
+#endif
 };
 
 constexpr nrd::LibraryDesc g_NrdLibraryDesc =
 {
     { 100, 200, 300, 400 }, // IMPORTANT: must match values used in CMake
-    g_NrdSupportedDenoisers.data(),
-    (uint32_t)g_NrdSupportedDenoisers.size(),
+    g_NrdSupportedDenoisers,
+    GetCountOf(g_NrdSupportedDenoisers),
     VERSION_MAJOR,
     VERSION_MINOR,
     VERSION_BUILD,
@@ -269,6 +280,32 @@ NRD_API nrd::Result NRD_CALL nrd::CreateInstance(const InstanceCreationDesc& ins
     return result;
 }
 
+NRD_API nrd::Result NRD_CALL nrd::SerializeInstance(const Instance& instance, void* blob, uint64_t& blobSize)
+{
+    return ((const InstanceImpl&)instance).Serialize((uint8_t*)blob, blobSize);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::CreateInstanceFromBlob(const InstanceCreationDesc& instanceCreationDesc, const void* blob, uint64_t blobSize, Instance*& instance)
+{
+    InstanceCreationDesc modifiedInstanceCreationDesc = instanceCreationDesc;
+    CheckAndSetDefaultAllocator(modifiedInstanceCreationDesc.memoryAllocatorInterface);
+
+    StdAllocator<uint8_t> memoryAllocator(modifiedInstanceCreationDesc.memoryAllocatorInterface);
+
+    InstanceImpl* implementation = Allocate<InstanceImpl>(memoryAllocator, memoryAllocator);
+    const Result result = implementation->CreateFromBlob(modifiedInstanceCreationDesc, (const uint8_t*)blob, blobSize);
+
+    if (result == Result::SUCCESS)
+    {
+        instance = (Instance*)implementation;
+        return Result::SUCCESS;
+    }
+
+    Deallocate(memoryAllocator, implementation);
+
+    return result;
+}
+
 NRD_API const nrd::InstanceDesc& NRD_CALL nrd::GetInstanceDesc(const Instance& denoiser)
 {
     return ((const InstanceImpl&)denoiser).GetDesc();
@@ -276,7 +313,17 @@ NRD_API const nrd::InstanceDesc& NRD_CALL nrd::GetInstanceDesc(const Instance& d
 
 NRD_API nrd::Result NRD_CALL nrd::SetCommonSettings(Instance& instance, const CommonSettings& commonSettings)
 {
-    return ((InstanceImpl&)instance).SetCommonSettings(commonSettings);
+    return ((InstanceImpl&)instance).SetCommonSettings(0, commonSettings);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::SetViewCommonSettings(Instance& instance, uint32_t viewIndex, const CommonSettings& commonSettings)
+{
+    return ((InstanceImpl&)instance).SetCommonSettings(viewIndex, commonSettings);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::SetViewCommonSettingsWithSharedCamera(Instance& instance, uint32_t viewIndex, const CommonSettings& commonSettings, const Instance& cameraSource, uint32_t cameraSourceViewIndex)
+{
+    return ((InstanceImpl&)instance).SetCommonSettings(viewIndex, commonSettings, (const InstanceImpl*)&cameraSource, cameraSourceViewIndex);
 }
 
 NRD_API nrd::Result NRD_CALL nrd::SetDenoiserSettings(Instance& instance, Identifier identifier, const void* denoiserSettings)
@@ -284,14 +331,63 @@ NRD_API nrd::Result NRD_CALL nrd::SetDenoiserSettings(Instance& instance, Identi
     return ((InstanceImpl&)instance).SetDenoiserSettings(identifier, denoiserSettings);
 }
 
+NRD_API nrd::Result NRD_CALL nrd::ResizeInstance(Instance& instance, uint16_t renderWidth, uint16_t renderHeight)
+{
+    return ((InstanceImpl&)instance).Resize(renderWidth, renderHeight);
+}
+
 NRD_API nrd::Result NRD_CALL nrd::GetComputeDispatches(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
 {
     return ((InstanceImpl&)instance).GetComputeDispatches(identifiers, identifiersNum, dispatchDescs, dispatchDescsNum);
 }
 
+NRD_API nrd::Result NRD_CALL nrd::CreateDispatchContext(Instance& instance, DispatchContext*& dispatchContext)
+{
+    return ((InstanceImpl&)instance).CreateDispatchContext((DispatchContextImpl*&)dispatchContext);
+}
+
+NRD_API void NRD_CALL nrd::DestroyDispatchContext(Instance& instance, DispatchContext& dispatchContext)
+{
+    ((InstanceImpl&)instance).DestroyDispatchContext((DispatchContextImpl&)dispatchContext);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::GetContextComputeDispatches(Instance& instance, DispatchContext& dispatchContext, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
+{
+    return ((InstanceImpl&)instance).GetComputeDispatches((DispatchContextImpl&)dispatchContext, identifiers, identifiersNum, dispatchDescs, dispatchDescsNum);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::GetReachablePipelines(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, ReachablePipelinesDesc& reachablePipelinesDesc)
+{
+    return ((InstanceImpl&)instance).GetReachablePipelines(identifiers, identifiersNum, reachablePipelinesDesc);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::GetFrameDescriptorPoolDesc(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, DescriptorPoolDesc& descriptorPoolDesc)
+{
+    return ((InstanceImpl&)instance).GetFrameDescriptorPoolDesc(identifiers, identifiersNum, descriptorPoolDesc);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::DecompressPipelineBytecode(Instance& instance, uint32_t pipelineIndex)
+{
+    return ((InstanceImpl&)instance).DecompressPipelineBytecode(pipelineIndex);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::GetMemoryUsage(const Instance& instance, MemoryUsageDesc& memoryUsageDesc)
+{
+    memoryUsageDesc = ((const InstanceImpl&)instance).GetMemoryUsage();
+
+    return Result::SUCCESS;
+}
+
+NRD_API nrd::Result NRD_CALL nrd::GetAllocationStats(const Instance& instance, AllocationStatsDesc& allocationStatsDesc)
+{
+    ((const InstanceImpl&)instance).GetAllocationStats(allocationStatsDesc);
+
+    return Result::SUCCESS;
+}
+
 NRD_API void NRD_CALL nrd::DestroyInstance(Instance& instance)
 {
-    StdAllocator<uint8_t> memoryAllocator = ((InstanceImpl&)instance).GetStdAllocator();
+    StdAllocator<uint8_t> memoryAllocator = ((InstanceImpl&)instance).GetUntrackedStdAllocator();
     Deallocate(memoryAllocator, (InstanceImpl*)&instance);
 }
 
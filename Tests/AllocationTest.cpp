@@ -0,0 +1,174 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// After creation an instance must not allocate: thousands of frames with changing settings, resolution scale, validation, restarts,
+// subsets of identifiers, dispatch contexts and per-frame queries must keep "AllocationStatsDesc::steadyStateAllocationsNum" at 0
+
+#include "TestCommon.h"
+
+#include <new>
+
+static void RunFrames(nrd::Instance& instance, const std::vector<nrd::DenoiserDesc>& denoiserDescs, const std::vector<nrd::Identifier>& identifiers, bool isSubsetAllowed)
+{
+    // Contexts are created upfront ("CreateDispatchContext" is not a steady state call)
+    nrd::DispatchContext* dispatchContexts[2] = {};
+    for (nrd::DispatchContext*& dispatchContext : dispatchContexts)
+        NRD_TEST_CHECK(nrd::CreateDispatchContext(instance, dispatchContext) == nrd::Result::SUCCESS);
+
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(instance);
+    for (uint32_t frameIndex = 0; frameIndex < 2000; frameIndex++)
+    {
+        for (uint32_t viewIndex = 0; viewIndex < instanceDesc.viewsNum; viewIndex++)
+        {
+            nrd::CommonSettings commonSettings = nrd_test::GetCommonSettings(frameIndex, viewIndex);
+            commonSettings.enableValidation = (frameIndex / 50) % 2 != 0;
+            if ((frameIndex / 150) % 2)
+                commonSettings.resolutionScale[0] = commonSettings.resolutionScale[1] = 0.5f + 0.05f * ((frameIndex / 10) % 10);
+            if (frameIndex % 111 == 60 + viewIndex)
+                commonSettings.accumulationMode = nrd::AccumulationMode::CLEAR_AND_RESTART;
+
+            NRD_TEST_CHECK(nrd::SetViewCommonSettings(instance, viewIndex, commonSettings) == nrd::Result::SUCCESS);
+        }
+
+        nrd_test::SetDenoiserSettings(instance, denoiserDescs, frameIndex / 7);
+
+        // All denoisers, the first half or the second half
+        const nrd::Identifier* frameIdentifiers = identifiers.data();
+        uint32_t frameIdentifiersNum = (uint32_t)identifiers.size();
+        if (isSubsetAllowed && (frameIndex / 20) % 3 != 0)
+        {
+            frameIdentifiersNum /= 2;
+            if ((frameIndex / 20) % 3 == 2)
+                frameIdentifiers += frameIdentifiersNum;
+        }
+
+        nrd::ReachablePipelinesDesc reachablePipelinesDesc = {};
+        NRD_TEST_CHECK(nrd::GetReachablePipelines(instance, frameIdentifiers, frameIdentifiersNum, reachablePipelinesDesc) == nrd::Result::SUCCESS);
+
+        nrd::DescriptorPoolDesc descriptorPoolDesc = {};
+        NRD_TEST_CHECK(nrd::GetFrameDescriptorPoolDesc(instance, frameIdentifiers, frameIdentifiersNum, descriptorPoolDesc) == nrd::Result::SUCCESS);
+
+        const nrd::DispatchDesc* dispatchDescs = nullptr;
+        uint32_t dispatchDescsNum = 0;
+        if (frameIndex % 4 == 3)
+        {
+            // Disjoint halves via contexts
+            uint32_t firstHalfNum = frameIdentifiersNum / 2;
+            NRD_TEST_CHECK(nrd::GetContextComputeDispatches(instance, *dispatchContexts[0], frameIdentifiers, firstHalfNum, dispatchDescs, dispatchDescsNum) == nrd::Result::SUCCESS);
+            NRD_TEST_CHECK(nrd::GetContextComputeDispatches(instance, *dispatchContexts[1], frameIdentifiers + firstHalfNum, frameIdentifiersNum - firstHalfNum, dispatchDescs, dispatchDescsNum) == nrd::Result::SUCCESS);
+        }
+        else
+            NRD_TEST_CHECK(nrd::GetComputeDispatches(instance, frameIdentifiers, frameIdentifiersNum, dispatchDescs, dispatchDescsNum) == nrd::Result::SUCCESS);
+
+        nrd::AllocationStatsDesc allocationStatsDesc = {};
+        NRD_TEST_CHECK(nrd::GetAllocationStats(instance, allocationStatsDesc) == nrd::Result::SUCCESS);
+
+        if (allocationStatsDesc.steadyStateAllocationsNum)
+            printf("Frame %u: %llu steady state allocations\n", frameIndex, (unsigned long long)allocationStatsDesc.steadyStateAllocationsNum);
+
+        NRD_TEST_CHECK(allocationStatsDesc.steadyStateAllocationsNum == 0);
+    }
+
+    for (nrd::DispatchContext* dispatchContext : dispatchContexts)
+        nrd::DestroyDispatchContext(instance, *dispatchContext);
+}
+
+static void Test(uint32_t viewsNum, bool interleaveViews, bool shareGeometryHistory)
+{
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+    std::vector<nrd::Identifier> identifiers = nrd_test::GetIdentifiers(denoiserDescs);
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+    instanceCreationDesc.viewsNum = viewsNum;
+    instanceCreationDesc.interleaveViews = interleaveViews;
+    instanceCreationDesc.shareGeometryHistory = shareGeometryHistory;
+
+    nrd::Instance* instance = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::SUCCESS);
+
+    // Allocations are tracked at all
+    nrd::AllocationStatsDesc allocationStatsDesc = {};
+    NRD_TEST_CHECK(nrd::GetAllocationStats(*instance, allocationStatsDesc) == nrd::Result::SUCCESS);
+    NRD_TEST_CHECK(allocationStatsDesc.allocationsNum != 0);
+
+    // A restored instance has its own storage, which must be preallocated as well
+    uint64_t blobSize = 0;
+    NRD_TEST_CHECK(nrd::SerializeInstance(*instance, nullptr, blobSize) == nrd::Result::SUCCESS);
+
+    std::vector<uint8_t> blob(blobSize);
+    NRD_TEST_CHECK(nrd::SerializeInstance(*instance, blob.data(), blobSize) == nrd::Result::SUCCESS);
+
+    nrd::Instance* restored = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstanceFromBlob(instanceCreationDesc, blob.data(), blob.size(), restored) == nrd::Result::SUCCESS);
+
+    // Geometry history sharing requires all denoisers to be dispatched
+    RunFrames(*instance, denoiserDescs, identifiers, !shareGeometryHistory);
+    RunFrames(*restored, denoiserDescs, identifiers, !shareGeometryHistory);
+
+    nrd::DestroyInstance(*restored);
+    nrd::DestroyInstance(*instance);
+}
+
+// An allocator which refuses only the large arena backing the constant ring: creation must fail gracefully
+static void* AllocateSmall(void*, size_t size, size_t alignment)
+{
+    if (size >= 32 * 1024 * 1024)
+        return nullptr;
+
+    return operator new(size, std::align_val_t(alignment));
+}
+
+static void* ReallocateSmall(void* userArg, void* memory, size_t newSize, size_t newAlignment, size_t oldSize, size_t oldAlignment)
+{
+    void* newMemory = AllocateSmall(userArg, newSize, newAlignment);
+    if (newMemory && memory)
+    {
+        memcpy(newMemory, memory, oldSize < newSize ? oldSize : newSize);
+        operator delete(memory, std::align_val_t(oldAlignment));
+    }
+
+    return newMemory;
+}
+
+static void FreeSmall(void*, void* memory, size_t, size_t alignment)
+{
+    if (memory)
+        operator delete(memory, std::align_val_t(alignment));
+}
+
+static void TestFailedArena()
+{
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+    instanceCreationDesc.constantDataPerFrameSize = 64 * 1024 * 1024;
+    instanceCreationDesc.memoryAllocatorInterface.Allocate = AllocateSmall;
+    instanceCreationDesc.memoryAllocatorInterface.Reallocate = ReallocateSmall;
+    instanceCreationDesc.memoryAllocatorInterface.Free = FreeSmall;
+
+    nrd::Instance* instance = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::FAILURE);
+}
+
+int main()
+{
+    TestFailedArena();
+
+    Test(1, false, false);
+    Test(1, false, true);
+    Test(2, false, false);
+    Test(2, true, false);
+
+    return 0;
+}
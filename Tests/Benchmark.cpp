@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// CPU cost of "GetComputeDispatches"
+// Usage: NRD_Benchmark [frames]
+//  - steady state - settings don't change, the cached frame template is replayed (only constants get patched)
+//  - regeneration - denoiser settings change every frame, the dispatch list is rebuilt from scratch
+//  - per denoiser - steady state of each denoiser alone and the amount of per-pass constants it fills per call (i.e. the cost of
+//    constant updates, which are the only work left in the steady state)
+
+#include "TestCommon.h"
+
+#include <chrono>
+
+struct Measurement
+{
+    double microseconds;
+    uint32_t constantBytes;
+};
+
+static Measurement MeasureGetComputeDispatches(nrd::Instance& instance, const std::vector<nrd::DenoiserDesc>& denoiserDescs, const std::vector<nrd::Identifier>& identifiers, uint32_t framesNum, bool changeSettings)
+{
+    // Warm up (the first frame clears history, a new list of identifiers invalidates the cached frame template)
+    const nrd::DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+
+    nrd_test::SetDenoiserSettings(instance, denoiserDescs, 0);
+    for (uint32_t frameIndex = 0; frameIndex < 4; frameIndex++)
+    {
+        nrd::SetCommonSettings(instance, nrd_test::GetCommonSettings(frameIndex));
+        nrd::GetComputeDispatches(instance, identifiers.data(), (uint32_t)identifiers.size(), dispatchDescs, dispatchDescsNum);
+    }
+
+    // Only "GetComputeDispatches" is measured
+    std::chrono::steady_clock::duration duration = {};
+    for (uint32_t frameIndex = 4; frameIndex < framesNum + 4; frameIndex++)
+    {
+        if (changeSettings)
+            nrd_test::SetDenoiserSettings(instance, denoiserDescs, frameIndex);
+
+        nrd::SetCommonSettings(instance, nrd_test::GetCommonSettings(frameIndex));
+
+        auto begin = std::chrono::steady_clock::now();
+        nrd::Result result = nrd::GetComputeDispatches(instance, identifiers.data(), (uint32_t)identifiers.size(), dispatchDescs, dispatchDescsNum);
+        duration += std::chrono::steady_clock::now() - begin;
+
+        NRD_TEST_CHECK(result == nrd::Result::SUCCESS);
+    }
+
+    // Per-pass constants of the last frame
+    Measurement measurement = {};
+    measurement.microseconds = std::chrono::duration<double, std::micro>(duration).count() / framesNum;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+        measurement.constantBytes += dispatchDescs[i].constantBufferDataSize;
+
+    return measurement;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t framesNum = argc > 1 ? (uint32_t)atoi(argv[1]) : 10000;
+    if (framesNum == 0)
+        framesNum = 1;
+
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+    std::vector<nrd::Identifier> identifiers = nrd_test::GetIdentifiers(denoiserDescs);
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+
+    nrd::Instance* instance = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::SUCCESS);
+
+    printf("GetComputeDispatches (%u denoisers, %u frames):\n", (uint32_t)denoiserDescs.size(), framesNum);
+
+    Measurement steadyState = MeasureGetComputeDispatches(*instance, denoiserDescs, identifiers, framesNum, false);
+    Measurement regeneration = MeasureGetComputeDispatches(*instance, denoiserDescs, identifiers, framesNum, true);
+
+    printf("  steady state: %.2f us (%u bytes of constants)\n", steadyState.microseconds, steadyState.constantBytes);
+    printf("  regeneration: %.2f us\n", regeneration.microseconds);
+    printf("  ratio: %.1fx\n", regeneration.microseconds / steadyState.microseconds);
+
+    printf("Steady state per denoiser:\n");
+    for (const nrd::DenoiserDesc& denoiserDesc : denoiserDescs)
+    {
+        std::vector<nrd::Identifier> denoiserIdentifiers = {denoiserDesc.identifier};
+        Measurement measurement = MeasureGetComputeDispatches(*instance, denoiserDescs, denoiserIdentifiers, framesNum, false);
+
+        printf("  %-36s %6.2f us (%u bytes of constants)\n", nrd::GetDenoiserString(denoiserDesc.denoiser), measurement.microseconds, measurement.constantBytes);
+    }
+
+    nrd::DestroyInstance(*instance);
+
+    return 0;
+}
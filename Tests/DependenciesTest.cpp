@@ -0,0 +1,158 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// "DispatchDesc::dependencies" vs an O(n^2) brute-force scan of hazards between all pairs of dispatches:
+//  - each reported dependency is a real hazard of the reported type
+//  - each hazard is covered by dependencies directly or transitively
+//  - a dispatch has a higher "dependencyLevel" than all dispatches it depends on
+
+#include "TestCommon.h"
+
+static bool AreSubresourcesOverlapped(const nrd::DispatchDesc& a, const nrd::ResourceDesc& x, const nrd::DispatchDesc& b, const nrd::ResourceDesc& y)
+{
+    if (x.type != y.type || x.indexInPool != y.indexInPool)
+        return false;
+
+    if (x.mipOffset >= y.mipOffset + y.mipNum || y.mipOffset >= x.mipOffset + x.mipNum)
+        return false;
+
+    // User provided resources are per view
+    bool isPool = x.type == nrd::ResourceType::PERMANENT_POOL || x.type == nrd::ResourceType::TRANSIENT_POOL;
+
+    return isPool || a.viewIndex == b.viewIndex;
+}
+
+static bool IsWrite(const nrd::ResourceDesc& resource)
+{
+    return resource.stateNeeded == nrd::DescriptorType::STORAGE_TEXTURE;
+}
+
+static void CheckDependencies(const nrd::DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum)
+{
+    // "isReachable[i * n + j]" - dispatch "i" depends on dispatch "j" (directly or transitively)
+    std::vector<bool> isReachable(size_t(dispatchDescsNum) * dispatchDescsNum, false);
+
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+
+        // Reported dependencies
+        for (uint32_t d = 0; d < dispatchDesc.dependenciesNum; d++)
+        {
+            const nrd::DispatchDependency& dependency = dispatchDesc.dependencies[d];
+            NRD_TEST_CHECK(dependency.dispatchIndex < i);
+            NRD_TEST_CHECK(dependency.resourceIndex < dispatchDesc.resourcesNum);
+
+            const nrd::DispatchDesc& producer = dispatchDescs[dependency.dispatchIndex];
+            NRD_TEST_CHECK(dispatchDesc.dependencyLevel > producer.dependencyLevel);
+
+            const nrd::ResourceDesc& resource = dispatchDesc.resources[dependency.resourceIndex];
+
+            bool isHazard = false;
+            for (uint32_t r = 0; r < producer.resourcesNum; r++)
+            {
+                const nrd::ResourceDesc& producerResource = producer.resources[r];
+                if (!AreSubresourcesOverlapped(dispatchDesc, resource, producer, producerResource))
+                    continue;
+
+                nrd::DependencyType type = nrd::DependencyType::MAX_NUM;
+                if (IsWrite(resource))
+                    type = IsWrite(producerResource) ? nrd::DependencyType::WRITE_AFTER_WRITE : nrd::DependencyType::WRITE_AFTER_READ;
+                else if (IsWrite(producerResource))
+                    type = nrd::DependencyType::READ_AFTER_WRITE;
+
+                isHazard |= type == dependency.type;
+            }
+
+            NRD_TEST_CHECK(isHazard);
+
+            isReachable[size_t(i) * dispatchDescsNum + dependency.dispatchIndex] = true;
+            for (uint32_t j = 0; j < dependency.dispatchIndex; j++)
+            {
+                if (isReachable[size_t(dependency.dispatchIndex) * dispatchDescsNum + j])
+                    isReachable[size_t(i) * dispatchDescsNum + j] = true;
+            }
+        }
+
+        // Brute-force hazards with all earlier dispatches
+        for (uint32_t j = 0; j < i; j++)
+        {
+            const nrd::DispatchDesc& earlier = dispatchDescs[j];
+
+            bool isHazard = false;
+            for (uint32_t a = 0; a < dispatchDesc.resourcesNum && !isHazard; a++)
+            {
+                for (uint32_t b = 0; b < earlier.resourcesNum && !isHazard; b++)
+                {
+                    const nrd::ResourceDesc& x = dispatchDesc.resources[a];
+                    const nrd::ResourceDesc& y = earlier.resources[b];
+
+                    isHazard = (IsWrite(x) || IsWrite(y)) && AreSubresourcesOverlapped(dispatchDesc, x, earlier, y);
+                }
+            }
+
+            if (isHazard && !isReachable[size_t(i) * dispatchDescsNum + j])
+                printf("Missing dependency: \"%s\" (%u) on \"%s\" (%u)\n", dispatchDesc.name, i, earlier.name, j);
+
+            NRD_TEST_CHECK(!isHazard || isReachable[size_t(i) * dispatchDescsNum + j]);
+        }
+    }
+}
+
+static void Test(uint32_t viewsNum, bool interleaveViews, bool shareGeometryHistory)
+{
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+    std::vector<nrd::Identifier> identifiers = nrd_test::GetIdentifiers(denoiserDescs);
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+    instanceCreationDesc.viewsNum = viewsNum;
+    instanceCreationDesc.interleaveViews = interleaveViews;
+    instanceCreationDesc.shareGeometryHistory = shareGeometryHistory;
+
+    nrd::Instance* instance = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::SUCCESS);
+
+    // Replayed frames reuse dependencies, thus settings change only every few frames
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*instance);
+    for (uint32_t frameIndex = 0; frameIndex < 96; frameIndex++)
+    {
+        for (uint32_t viewIndex = 0; viewIndex < instanceDesc.viewsNum; viewIndex++)
+        {
+            nrd::CommonSettings commonSettings = nrd_test::GetCommonSettings(frameIndex, viewIndex);
+            commonSettings.enableValidation = (frameIndex / 24) % 2 != 0;
+            if (frameIndex % 32 == 20 + viewIndex)
+                commonSettings.accumulationMode = nrd::AccumulationMode::CLEAR_AND_RESTART;
+
+            NRD_TEST_CHECK(nrd::SetViewCommonSettings(*instance, viewIndex, commonSettings) == nrd::Result::SUCCESS);
+        }
+
+        nrd_test::SetDenoiserSettings(*instance, denoiserDescs, frameIndex / 4);
+
+        const nrd::DispatchDesc* dispatchDescs = nullptr;
+        uint32_t dispatchDescsNum = 0;
+        NRD_TEST_CHECK(nrd::GetComputeDispatches(*instance, identifiers.data(), (uint32_t)identifiers.size(), dispatchDescs, dispatchDescsNum) == nrd::Result::SUCCESS);
+
+        CheckDependencies(dispatchDescs, dispatchDescsNum);
+    }
+
+    nrd::DestroyInstance(*instance);
+}
+
+int main()
+{
+    Test(1, false, false);
+    Test(1, false, true);
+    Test(2, false, false);
+    Test(2, true, false);
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Shared geometry history ("InstanceCreationDesc::shareGeometryHistory") must stay consistent for any subset and order of
+// denoisers dispatched in a frame: all of them must read the same previous frame history and bind the same current frame
+// history, and the previous frame history must be the current frame history of the last frame, in which any of them has run.
+// Shared textures are found from emitted dispatches: permanent textures bound by several denoisers
+
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+
+struct HistorySets
+{
+    std::set<uint16_t> prev;
+    std::set<uint16_t> curr;
+};
+
+static std::string GetDenoiserName(const char* name)
+{
+    const char* separator = strstr(name, " - ");
+
+    return separator ? std::string(name, separator - name) : std::string(name);
+}
+
+static void GatherSharedTextures(const nrd::DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, std::set<uint16_t>& sharedTextures)
+{
+    std::vector<std::pair<uint16_t, std::string>> users;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+
+        // "Clear" dispatches are not a part of any denoiser
+        if (!strncmp(dispatchDesc.name, "Clear", 5))
+            continue;
+
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            const nrd::ResourceDesc& resource = dispatchDesc.resources[r];
+            if (resource.type == nrd::ResourceType::PERMANENT_POOL)
+                users.push_back( {resource.indexInPool, GetDenoiserName(dispatchDesc.name)} );
+        }
+    }
+
+    for (const auto& a : users)
+    {
+        for (const auto& b : users)
+        {
+            if (a.first == b.first && a.second != b.second)
+                sharedTextures.insert(a.first);
+        }
+    }
+}
+
+// Per denoiser: shared textures bound as outputs hold the current frame, others are read as the previous frame
+static void GatherHistorySets(const nrd::DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, const std::set<uint16_t>& sharedTextures, std::vector<HistorySets>& historySets)
+{
+    std::string segmentName;
+    std::set<uint16_t> read;
+
+    auto FlushSegment = [&]()
+    {
+        if (segmentName.empty())
+            return;
+
+        HistorySets& sets = historySets.back();
+        for (uint16_t indexInPool : read)
+        {
+            if (!sets.curr.count(indexInPool))
+                sets.prev.insert(indexInPool);
+        }
+
+        read.clear();
+    };
+
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+
+        // "Clear" dispatches are not a part of any denoiser
+        if (!strncmp(dispatchDesc.name, "Clear", 5))
+            continue;
+
+        std::string name = GetDenoiserName(dispatchDesc.name);
+        if (name != segmentName)
+        {
+            FlushSegment();
+
+            segmentName = name;
+            historySets.push_back( {} );
+        }
+
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            const nrd::ResourceDesc& resource = dispatchDesc.resources[r];
+            if (resource.type != nrd::ResourceType::PERMANENT_POOL || !sharedTextures.count(resource.indexInPool))
+                continue;
+
+            if (resource.stateNeeded == nrd::DescriptorType::STORAGE_TEXTURE)
+                historySets.back().curr.insert(resource.indexInPool);
+            else
+                read.insert(resource.indexInPool);
+        }
+    }
+
+    FlushSegment();
+}
+
+static void Test(const std::vector<nrd::Denoiser>& denoisers)
+{
+    if (!nrd_test::IsSupported(denoisers[0]))
+        return;
+
+    std::vector<nrd::DenoiserDesc> denoiserDescs;
+    for (nrd::Denoiser denoiser : denoisers)
+        denoiserDescs.push_back( {(nrd::Identifier)denoiserDescs.size(), denoiser, nrd_test::RENDER_WIDTH, nrd_test::RENDER_HEIGHT} );
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+    instanceCreationDesc.shareGeometryHistory = true;
+
+    nrd::Instance* instance = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::SUCCESS);
+
+    // Each frame: a list of calls. A whole frame can be skipped, as well as some of the denoisers
+    const std::vector<std::vector<std::vector<nrd::Identifier>>> schedules =
+    {
+        { {0, 1, 2} },
+        { {2}, {0, 1} },
+        { {1} },
+        {},
+        { {1, 2}, {0} },
+        { {0}, {2} },
+    };
+
+    std::set<uint16_t> sharedTextures;
+    std::set<uint16_t> prevCurr;
+
+    for (uint32_t frameIndex = 0; frameIndex < 48; frameIndex++)
+    {
+        NRD_TEST_CHECK(nrd::SetCommonSettings(*instance, nrd_test::GetCommonSettings(frameIndex)) == nrd::Result::SUCCESS);
+
+        std::vector<HistorySets> historySets;
+        for (const std::vector<nrd::Identifier>& call : schedules[frameIndex % schedules.size()])
+        {
+            const nrd::DispatchDesc* dispatchDescs = nullptr;
+            uint32_t dispatchDescsNum = 0;
+            NRD_TEST_CHECK(nrd::GetComputeDispatches(*instance, call.data(), (uint32_t)call.size(), dispatchDescs, dispatchDescsNum) == nrd::Result::SUCCESS);
+
+            // The first frame dispatches all denoisers
+            if (frameIndex == 0)
+            {
+                GatherSharedTextures(dispatchDescs, dispatchDescsNum, sharedTextures);
+                NRD_TEST_CHECK(!sharedTextures.empty());
+            }
+
+            GatherHistorySets(dispatchDescs, dispatchDescsNum, sharedTextures, historySets);
+        }
+
+        if (historySets.empty())
+            continue;
+
+        // All denoisers of the frame agree, histories are double buffered
+        for (const HistorySets& sets : historySets)
+        {
+            NRD_TEST_CHECK(sets.curr == historySets[0].curr);
+            NRD_TEST_CHECK(sets.prev == historySets[0].prev);
+        }
+
+        const HistorySets& sets = historySets[0];
+        NRD_TEST_CHECK(sets.curr.size() * 2 == sharedTextures.size());
+        NRD_TEST_CHECK(sets.prev.size() == sets.curr.size());
+        NRD_TEST_CHECK(std::none_of(sets.prev.begin(), sets.prev.end(), [&](uint16_t i) { return sets.curr.count(i) != 0; }));
+
+        // The previous frame history is the one written last time
+        if (!prevCurr.empty())
+            NRD_TEST_CHECK(sets.prev == prevCurr);
+
+        prevCurr = sets.curr;
+    }
+
+    nrd::DestroyInstance(*instance);
+}
+
+int main()
+{
+    // Families are excluded at build time as a whole
+    Test( {nrd::Denoiser::REBLUR_DIFFUSE, nrd::Denoiser::REBLUR_SPECULAR, nrd::Denoiser::REBLUR_DIFFUSE_OCCLUSION} );
+    Test( {nrd::Denoiser::RELAX_DIFFUSE, nrd::Denoiser::RELAX_SPECULAR, nrd::Denoiser::RELAX_DIFFUSE_SPECULAR} );
+
+    return 0;
+}
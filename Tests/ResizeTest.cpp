@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// "ResizeInstance" takes effect at the next frame: the previous rect (shared constants, grids of passes covering both rects) must
+// come from the previous frame, even if "SetViewCommonSettings" is called several times for the same frame
+
+#include "TestCommon.h"
+
+#include <string>
+
+struct DispatchSnapshot
+{
+    std::string name;
+    uint32_t gridWidth;
+    uint32_t gridHeight;
+    std::vector<uint8_t> sharedConstants;
+};
+
+static std::vector<DispatchSnapshot> RunFrame(nrd::Instance& instance, const std::vector<nrd::Identifier>& identifiers, uint32_t frameIndex, uint32_t setCommonSettingsNum)
+{
+    nrd::CommonSettings commonSettings = nrd_test::GetCommonSettings(frameIndex);
+    for (uint32_t i = 0; i < setCommonSettingsNum; i++)
+        NRD_TEST_CHECK(nrd::SetCommonSettings(instance, commonSettings) == nrd::Result::SUCCESS);
+
+    const nrd::DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+    NRD_TEST_CHECK(nrd::GetComputeDispatches(instance, identifiers.data(), (uint32_t)identifiers.size(), dispatchDescs, dispatchDescsNum) == nrd::Result::SUCCESS);
+
+    // Per pass constants are not compared, since rotators are randomized per "SetCommonSettings" call
+    std::vector<DispatchSnapshot> snapshots;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+        const uint8_t* sharedConstants = (const uint8_t*)dispatchDesc.sharedConstantBufferData;
+
+        DispatchSnapshot snapshot;
+        snapshot.name = dispatchDesc.name;
+        snapshot.gridWidth = dispatchDesc.gridWidth;
+        snapshot.gridHeight = dispatchDesc.gridHeight;
+        snapshot.sharedConstants.assign(sharedConstants, sharedConstants + dispatchDesc.sharedConstantBufferDataSize);
+        snapshots.push_back(snapshot);
+    }
+
+    return snapshots;
+}
+
+static bool AreSnapshotsEqual(const std::vector<DispatchSnapshot>& a, const std::vector<DispatchSnapshot>& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].name != b[i].name || a[i].gridWidth != b[i].gridWidth || a[i].gridHeight != b[i].gridHeight || a[i].sharedConstants != b[i].sharedConstants)
+            return false;
+    }
+
+    return true;
+}
+
+static uint64_t GetGridArea(const std::vector<DispatchSnapshot>& snapshots)
+{
+    uint64_t area = 0;
+    for (const DispatchSnapshot& snapshot : snapshots)
+        area += uint64_t(snapshot.gridWidth) * snapshot.gridHeight;
+
+    return area;
+}
+
+int main()
+{
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+    std::vector<nrd::Identifier> identifiers = nrd_test::GetIdentifiers(denoiserDescs);
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+
+    // "single" gets one "SetCommonSettings" call per frame, "repeated" gets three
+    nrd::Instance* single = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, single) == nrd::Result::SUCCESS);
+
+    nrd::Instance* repeated = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, repeated) == nrd::Result::SUCCESS);
+
+    NRD_TEST_CHECK(AreSnapshotsEqual(RunFrame(*single, identifiers, 0, 1), RunFrame(*repeated, identifiers, 0, 3)));
+
+    // Shrink: the previous rect is still the full size
+    NRD_TEST_CHECK(nrd::ResizeInstance(*single, nrd_test::RENDER_WIDTH / 2, nrd_test::RENDER_HEIGHT / 2) == nrd::Result::SUCCESS);
+    NRD_TEST_CHECK(nrd::ResizeInstance(*repeated, nrd_test::RENDER_WIDTH / 2, nrd_test::RENDER_HEIGHT / 2) == nrd::Result::SUCCESS);
+
+    std::vector<DispatchSnapshot> resizedFrame = RunFrame(*single, identifiers, 1, 1);
+    NRD_TEST_CHECK(AreSnapshotsEqual(resizedFrame, RunFrame(*repeated, identifiers, 1, 3)));
+
+    // The next frame has both rects shrunk
+    std::vector<DispatchSnapshot> nextFrame = RunFrame(*single, identifiers, 2, 1);
+    NRD_TEST_CHECK(AreSnapshotsEqual(nextFrame, RunFrame(*repeated, identifiers, 2, 3)));
+    NRD_TEST_CHECK(!AreSnapshotsEqual(resizedFrame, nextFrame));
+
+    // Passes covering both rects (SIGMA blur) shrink one frame later
+    bool isMaxDimsUsed = false;
+    for (const nrd::DenoiserDesc& denoiserDesc : denoiserDescs)
+        isMaxDimsUsed = isMaxDimsUsed || denoiserDesc.denoiser == nrd::Denoiser::SIGMA_SHADOW;
+
+    if (isMaxDimsUsed)
+        NRD_TEST_CHECK(GetGridArea(resizedFrame) > GetGridArea(nextFrame));
+
+    nrd::DestroyInstance(*repeated);
+    nrd::DestroyInstance(*single);
+
+    return 0;
+}
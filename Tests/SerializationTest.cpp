@@ -0,0 +1,196 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// An instance created by "CreateInstanceFromBlob" from a blob of "SerializeInstance" must be indistinguishable from the original:
+// the same "InstanceDesc" tables (including pipelines and bytecode) and the same dispatches for the same settings
+
+#include "TestCommon.h"
+
+static bool IsShaderEqual(const nrd::ComputeShaderDesc& a, const nrd::ComputeShaderDesc& b)
+{
+    return a.size == b.size && (!a.size || !memcmp(a.bytecode, b.bytecode, a.size));
+}
+
+static bool IsStringEqual(const char* a, const char* b)
+{
+    return a == b || (a && b && !strcmp(a, b));
+}
+
+static bool IsTextureEqual(const nrd::TextureDesc& a, const nrd::TextureDesc& b)
+{
+    return a.format == b.format && a.width == b.width && a.height == b.height && a.mipNum == b.mipNum;
+}
+
+static void CheckInstanceDescs(nrd::Instance& original, nrd::Instance& restored)
+{
+    const nrd::InstanceDesc& a = nrd::GetInstanceDesc(original);
+    const nrd::InstanceDesc& b = nrd::GetInstanceDesc(restored);
+
+    NRD_TEST_CHECK(a.constantBufferMaxDataSize == b.constantBufferMaxDataSize);
+    NRD_TEST_CHECK(a.constantBufferSpaceIndex == b.constantBufferSpaceIndex);
+    NRD_TEST_CHECK(a.constantBufferRegisterIndex == b.constantBufferRegisterIndex);
+    NRD_TEST_CHECK(a.sharedConstantBufferMaxDataSize == b.sharedConstantBufferMaxDataSize);
+    NRD_TEST_CHECK(a.sharedConstantBufferRegisterIndex == b.sharedConstantBufferRegisterIndex);
+
+    NRD_TEST_CHECK(a.samplersNum == b.samplersNum);
+    NRD_TEST_CHECK(a.samplersSpaceIndex == b.samplersSpaceIndex);
+    NRD_TEST_CHECK(a.samplersBaseRegisterIndex == b.samplersBaseRegisterIndex);
+    for (uint32_t i = 0; i < a.samplersNum; i++)
+        NRD_TEST_CHECK(a.samplers[i] == b.samplers[i]);
+
+    NRD_TEST_CHECK(a.pipelinesNum == b.pipelinesNum);
+    NRD_TEST_CHECK(a.uniquePipelinesNum == b.uniquePipelinesNum);
+    NRD_TEST_CHECK(a.resourcesSpaceIndex == b.resourcesSpaceIndex);
+    for (uint32_t i = 0; i < a.pipelinesNum; i++)
+    {
+        NRD_TEST_CHECK(nrd::DecompressPipelineBytecode(original, i) == nrd::Result::SUCCESS);
+        NRD_TEST_CHECK(nrd::DecompressPipelineBytecode(restored, i) == nrd::Result::SUCCESS);
+
+        const nrd::PipelineDesc& x = a.pipelines[i];
+        const nrd::PipelineDesc& y = b.pipelines[i];
+
+        NRD_TEST_CHECK(IsShaderEqual(x.computeShaderDXBC, y.computeShaderDXBC));
+        NRD_TEST_CHECK(IsShaderEqual(x.computeShaderDXIL, y.computeShaderDXIL));
+        NRD_TEST_CHECK(IsShaderEqual(x.computeShaderSPIRV, y.computeShaderSPIRV));
+        NRD_TEST_CHECK(IsStringEqual(x.shaderFileName, y.shaderFileName));
+        NRD_TEST_CHECK(IsStringEqual(x.shaderEntryPointName, y.shaderEntryPointName));
+        NRD_TEST_CHECK(x.hasConstantData == y.hasConstantData);
+        NRD_TEST_CHECK(x.hasSharedConstantData == y.hasSharedConstantData);
+        NRD_TEST_CHECK(x.uniquePipelineIndex == y.uniquePipelineIndex);
+
+        NRD_TEST_CHECK(x.resourceRangesNum == y.resourceRangesNum);
+        for (uint32_t r = 0; r < x.resourceRangesNum; r++)
+        {
+            const nrd::ResourceRangeDesc& p = x.resourceRanges[r];
+            const nrd::ResourceRangeDesc& q = y.resourceRanges[r];
+
+            NRD_TEST_CHECK(p.descriptorType == q.descriptorType && p.baseRegisterIndex == q.baseRegisterIndex && p.descriptorsNum == q.descriptorsNum);
+        }
+    }
+
+    NRD_TEST_CHECK(a.permanentPoolSize == b.permanentPoolSize);
+    for (uint32_t i = 0; i < a.permanentPoolSize; i++)
+        NRD_TEST_CHECK(IsTextureEqual(a.permanentPool[i], b.permanentPool[i]));
+
+    NRD_TEST_CHECK(a.transientPoolSize == b.transientPoolSize);
+    for (uint32_t i = 0; i < a.transientPoolSize; i++)
+    {
+        NRD_TEST_CHECK(IsTextureEqual(a.transientPool[i], b.transientPool[i]));
+
+        const nrd::TransientAliasingDesc& x = a.transientPoolAliasing[i];
+        const nrd::TransientAliasingDesc& y = b.transientPoolAliasing[i];
+
+        NRD_TEST_CHECK(x.offset == y.offset && x.size == y.size && x.aliasingGroupIndex == y.aliasingGroupIndex);
+    }
+
+    NRD_TEST_CHECK(a.aliasingGroupsNum == b.aliasingGroupsNum);
+    for (uint32_t i = 0; i < a.aliasingGroupsNum; i++)
+        NRD_TEST_CHECK(a.aliasingGroups[i].size == b.aliasingGroups[i].size);
+
+    NRD_TEST_CHECK(a.viewsNum == b.viewsNum);
+    NRD_TEST_CHECK(a.framesInFlightNum == b.framesInFlightNum);
+    NRD_TEST_CHECK(a.constantDataPerFrameSize == b.constantDataPerFrameSize);
+
+    const nrd::DescriptorPoolDesc& x = a.descriptorPoolDesc;
+    const nrd::DescriptorPoolDesc& y = b.descriptorPoolDesc;
+    NRD_TEST_CHECK(x.setsMaxNum == y.setsMaxNum);
+    NRD_TEST_CHECK(x.constantBuffersMaxNum == y.constantBuffersMaxNum);
+    NRD_TEST_CHECK(x.samplersMaxNum == y.samplersMaxNum);
+    NRD_TEST_CHECK(x.texturesMaxNum == y.texturesMaxNum);
+    NRD_TEST_CHECK(x.storageTexturesMaxNum == y.storageTexturesMaxNum);
+}
+
+static void Test(uint32_t viewsNum, bool interleaveViews, bool shareGeometryHistory)
+{
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+    std::vector<nrd::Identifier> identifiers = nrd_test::GetIdentifiers(denoiserDescs);
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+    instanceCreationDesc.viewsNum = viewsNum;
+    instanceCreationDesc.interleaveViews = interleaveViews;
+    instanceCreationDesc.shareGeometryHistory = shareGeometryHistory;
+
+    nrd::Instance* original = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, original) == nrd::Result::SUCCESS);
+
+    uint64_t blobSize = 0;
+    NRD_TEST_CHECK(nrd::SerializeInstance(*original, nullptr, blobSize) == nrd::Result::SUCCESS);
+    NRD_TEST_CHECK(blobSize != 0);
+
+    // Must be alive until destruction of "restored"
+    std::vector<uint8_t> blob(blobSize);
+    NRD_TEST_CHECK(nrd::SerializeInstance(*original, blob.data(), blobSize) == nrd::Result::SUCCESS);
+    NRD_TEST_CHECK(blobSize == blob.size());
+
+    // Graph related fields must come from the blob
+    nrd::InstanceCreationDesc blobCreationDesc = instanceCreationDesc;
+    blobCreationDesc.denoisers = nullptr;
+    blobCreationDesc.denoisersNum = 0;
+    blobCreationDesc.viewsNum = 0;
+    blobCreationDesc.interleaveViews = !interleaveViews;
+
+    nrd::Instance* restored = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstanceFromBlob(blobCreationDesc, blob.data(), blob.size(), restored) == nrd::Result::SUCCESS);
+
+    CheckInstanceDescs(*original, *restored);
+
+    // A corrupted header must be rejected
+    std::vector<uint8_t> corruptedBlob = blob;
+    corruptedBlob[0] ^= 0xFF;
+
+    nrd::Instance* corrupted = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstanceFromBlob(blobCreationDesc, corruptedBlob.data(), corruptedBlob.size(), corrupted) != nrd::Result::SUCCESS);
+
+    // Dispatches of several frames, including a restart and settings changes
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*original);
+    for (uint32_t frameIndex = 0; frameIndex < 16; frameIndex++)
+    {
+        for (uint32_t viewIndex = 0; viewIndex < instanceDesc.viewsNum; viewIndex++)
+        {
+            nrd::CommonSettings commonSettings = nrd_test::GetCommonSettings(frameIndex, viewIndex);
+            if (frameIndex == 8)
+                commonSettings.accumulationMode = nrd::AccumulationMode::CLEAR_AND_RESTART;
+
+            NRD_TEST_CHECK(nrd::SetViewCommonSettings(*original, viewIndex, commonSettings) == nrd::Result::SUCCESS);
+            NRD_TEST_CHECK(nrd::SetViewCommonSettings(*restored, viewIndex, commonSettings) == nrd::Result::SUCCESS);
+        }
+
+        nrd_test::SetDenoiserSettings(*original, denoiserDescs, frameIndex / 4);
+        nrd_test::SetDenoiserSettings(*restored, denoiserDescs, frameIndex / 4);
+
+        const nrd::DispatchDesc* originalDispatchDescs = nullptr;
+        uint32_t originalDispatchDescsNum = 0;
+        NRD_TEST_CHECK(nrd::GetComputeDispatches(*original, identifiers.data(), (uint32_t)identifiers.size(), originalDispatchDescs, originalDispatchDescsNum) == nrd::Result::SUCCESS);
+
+        const nrd::DispatchDesc* restoredDispatchDescs = nullptr;
+        uint32_t restoredDispatchDescsNum = 0;
+        NRD_TEST_CHECK(nrd::GetComputeDispatches(*restored, identifiers.data(), (uint32_t)identifiers.size(), restoredDispatchDescs, restoredDispatchDescsNum) == nrd::Result::SUCCESS);
+
+        if (!nrd_test::AreDispatchesEqual(originalDispatchDescs, originalDispatchDescsNum, restoredDispatchDescs, restoredDispatchDescsNum))
+            printf("Frame %u: dispatches of the original and the restored instances differ\n", frameIndex);
+
+        NRD_TEST_CHECK(nrd_test::AreDispatchesEqual(originalDispatchDescs, originalDispatchDescsNum, restoredDispatchDescs, restoredDispatchDescsNum));
+    }
+
+    nrd::DestroyInstance(*restored);
+    nrd::DestroyInstance(*original);
+}
+
+int main()
+{
+    Test(1, false, false);
+    Test(1, false, true);
+    Test(2, false, false);
+    Test(2, true, false);
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Helpers shared by CPU tests and benchmarks. Only the public API is used, i.e. no GPU and no shaders are needed at runtime
+
+#pragma once
+
+#include "NRD.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define NRD_TEST_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(1); \
+        } \
+    } while (0)
+
+namespace nrd_test
+{
+    constexpr uint16_t RENDER_WIDTH = 1920;
+    constexpr uint16_t RENDER_HEIGHT = 1080;
+
+    inline bool IsSupported(nrd::Denoiser denoiser)
+    {
+        const nrd::LibraryDesc& libraryDesc = nrd::GetLibraryDesc();
+        for (uint32_t i = 0; i < libraryDesc.supportedDenoisersNum; i++)
+        {
+            if (libraryDesc.supportedDenoisers[i] == denoiser)
+                return true;
+        }
+
+        return false;
+    }
+
+    // A typical setup: several denoisers of different families (the ones dropped at build time are skipped)
+    inline std::vector<nrd::DenoiserDesc> GetDenoisers()
+    {
+        const nrd::Denoiser denoisers[] =
+        {
+            nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR,
+            nrd::Denoiser::RELAX_DIFFUSE,
+            nrd::Denoiser::SIGMA_SHADOW,
+            nrd::Denoiser::REBLUR_DIFFUSE_OCCLUSION,
+            nrd::Denoiser::RELAX_DIFFUSE_SPECULAR,
+            nrd::Denoiser::REFERENCE,
+        };
+
+        std::vector<nrd::DenoiserDesc> denoiserDescs;
+        for (nrd::Denoiser denoiser : denoisers)
+        {
+            if (IsSupported(denoiser))
+                denoiserDescs.push_back( {(nrd::Identifier)denoiserDescs.size(), denoiser, RENDER_WIDTH, RENDER_HEIGHT} );
+        }
+
+        return denoiserDescs;
+    }
+
+    inline std::vector<nrd::Identifier> GetIdentifiers(const std::vector<nrd::DenoiserDesc>& denoiserDescs)
+    {
+        std::vector<nrd::Identifier> identifiers;
+        for (const nrd::DenoiserDesc& denoiserDesc : denoiserDescs)
+            identifiers.push_back(denoiserDesc.identifier);
+
+        return identifiers;
+    }
+
+    // A camera moving along X (matrices are column-major)
+    inline nrd::CommonSettings GetCommonSettings(uint32_t frameIndex, uint32_t viewIndex = 0)
+    {
+        const float viewToClip[16] = {1.0f, 0.0f, 0.0f, 0.0f,  0.0f, 1.7f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f, 1.0f,  0.0f, 0.0f, -0.1f, 0.0f};
+        float worldToView[16] = {1.0f, 0.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f, 0.0f,  0.0f, 0.0f, 0.0f, 1.0f};
+        float worldToViewPrev[16];
+        memcpy(worldToViewPrev, worldToView, sizeof(worldToView));
+
+        worldToView[12] = 0.1f * frameIndex;
+        worldToViewPrev[12] = 0.1f * (frameIndex ? frameIndex - 1 : 0);
+
+        nrd::CommonSettings commonSettings = {};
+        memcpy(commonSettings.viewToClipMatrix, viewToClip, sizeof(viewToClip));
+        memcpy(commonSettings.viewToClipMatrixPrev, viewToClip, sizeof(viewToClip));
+        memcpy(commonSettings.worldToViewMatrix, worldToView, sizeof(worldToView));
+        memcpy(commonSettings.worldToViewMatrixPrev, worldToViewPrev, sizeof(worldToViewPrev));
+        commonSettings.cameraJitter[0] = (frameIndex % 8) / 16.0f - 0.25f + 0.1f * viewIndex;
+        commonSettings.cameraJitter[1] = (frameIndex % 4) / 8.0f - 0.25f;
+        commonSettings.frameIndex = frameIndex;
+        commonSettings.timeDeltaBetweenFrames = 16.0f + viewIndex;
+
+        return commonSettings;
+    }
+
+    // Settings permutation "permutation" for all denoisers (selects different passes and permutations of pipelines)
+    inline void SetDenoiserSettings(nrd::Instance& instance, const std::vector<nrd::DenoiserDesc>& denoiserDescs, uint32_t permutation)
+    {
+        for (const nrd::DenoiserDesc& denoiserDesc : denoiserDescs)
+        {
+            const void* settings = nullptr;
+
+            nrd::ReblurSettings reblurSettings = {};
+            reblurSettings.enablePerformanceMode = (permutation & 0x1) != 0;
+            reblurSettings.stabilizationStrength = (permutation & 0x2) ? 0.0f : 1.0f;
+            reblurSettings.hitDistanceReconstructionMode = (permutation & 0x4) ? nrd::HitDistanceReconstructionMode::AREA_3X3 : nrd::HitDistanceReconstructionMode::OFF;
+
+            nrd::RelaxDiffuseSettings relaxDiffuseSettings = {};
+            relaxDiffuseSettings.atrousIterationNum = 2 + permutation % 4;
+            relaxDiffuseSettings.enableAntiFirefly = (permutation & 0x2) != 0;
+            relaxDiffuseSettings.historyFixFrameNum = (permutation & 0x8) ? 0 : 3;
+            relaxDiffuseSettings.hitDistanceReconstructionMode = (nrd::HitDistanceReconstructionMode)(permutation % 3);
+
+            nrd::RelaxDiffuseSpecularSettings relaxDiffuseSpecularSettings = {};
+            relaxDiffuseSpecularSettings.atrousIterationNum = 2 + (permutation + 1) % 4;
+            relaxDiffuseSpecularSettings.enableAntiFirefly = (permutation & 0x4) != 0;
+
+            switch (denoiserDesc.denoiser)
+            {
+                case nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR:
+                case nrd::Denoiser::REBLUR_DIFFUSE_OCCLUSION:
+                    settings = &reblurSettings;
+                    break;
+                case nrd::Denoiser::RELAX_DIFFUSE:
+                    settings = &relaxDiffuseSettings;
+                    break;
+                case nrd::Denoiser::RELAX_DIFFUSE_SPECULAR:
+                    settings = &relaxDiffuseSpecularSettings;
+                    break;
+                default:
+                    break;
+            }
+
+            if (settings)
+                NRD_TEST_CHECK(nrd::SetDenoiserSettings(instance, denoiserDesc.identifier, settings) == nrd::Result::SUCCESS);
+        }
+    }
+
+    // Exact comparison of two dispatch lists (including constants and dependencies)
+    inline bool AreDispatchesEqual(const nrd::DispatchDesc* a, uint32_t aNum, const nrd::DispatchDesc* b, uint32_t bNum)
+    {
+        if (aNum != bNum)
+            return false;
+
+        for (uint32_t i = 0; i < aNum; i++)
+        {
+            const nrd::DispatchDesc& x = a[i];
+            const nrd::DispatchDesc& y = b[i];
+
+            if (strcmp(x.name, y.name) || x.pipelineIndex != y.pipelineIndex || x.gridWidth != y.gridWidth || x.gridHeight != y.gridHeight || x.viewIndex != y.viewIndex)
+                return false;
+
+            if (x.resourcesNum != y.resourcesNum)
+                return false;
+
+            for (uint32_t r = 0; r < x.resourcesNum; r++)
+            {
+                const nrd::ResourceDesc& p = x.resources[r];
+                const nrd::ResourceDesc& q = y.resources[r];
+
+                if (p.stateNeeded != q.stateNeeded || p.type != q.type || p.indexInPool != q.indexInPool || p.mipOffset != q.mipOffset || p.mipNum != q.mipNum)
+                    return false;
+            }
+
+            if (x.constantBufferDataSize != y.constantBufferDataSize || (x.constantBufferDataSize && memcmp(x.constantBufferData, y.constantBufferData, x.constantBufferDataSize)))
+                return false;
+
+            if (x.sharedConstantBufferDataSize != y.sharedConstantBufferDataSize || (x.sharedConstantBufferDataSize && memcmp(x.sharedConstantBufferData, y.sharedConstantBufferData, x.sharedConstantBufferDataSize)))
+                return false;
+
+            if (x.dependencyLevel != y.dependencyLevel || x.dependenciesNum != y.dependenciesNum || (x.dependenciesNum && memcmp(x.dependencies, y.dependencies, x.dependenciesNum * sizeof(nrd::DispatchDependency))))
+                return false;
+        }
+
+        return true;
+    }
+}
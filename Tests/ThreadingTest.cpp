@@ -0,0 +1,176 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// "GetContextComputeDispatches" called from several threads in parallel must produce exactly the same dispatches as the same calls
+// made serially on an identical instance. Constants of different contexts must not overlap in memory. "GetReachablePipelines" and
+// "GetFrameDescriptorPoolDesc" (dry runs) polled from another thread at the same time must not affect dispatches and must return
+// the same results as serial calls
+
+#include "TestCommon.h"
+
+#include <thread>
+
+struct ContextResult
+{
+    const nrd::DispatchDesc* dispatchDescs;
+    uint32_t dispatchDescsNum;
+    nrd::Result result;
+};
+
+static bool AreRangesOverlapped(const uint8_t* a, uint32_t aSize, const uint8_t* b, uint32_t bSize)
+{
+    return aSize && bSize && a < b + bSize && b < a + aSize;
+}
+
+static void CheckConstantsAreDisjoint(const ContextResult& x, const ContextResult& y)
+{
+    for (uint32_t i = 0; i < x.dispatchDescsNum; i++)
+    {
+        for (uint32_t j = 0; j < y.dispatchDescsNum; j++)
+        {
+            const nrd::DispatchDesc& a = x.dispatchDescs[i];
+            const nrd::DispatchDesc& b = y.dispatchDescs[j];
+
+            NRD_TEST_CHECK(!AreRangesOverlapped(a.constantBufferData, a.constantBufferDataSize, b.constantBufferData, b.constantBufferDataSize));
+            NRD_TEST_CHECK(!AreRangesOverlapped(a.sharedConstantBufferData, a.sharedConstantBufferDataSize, b.sharedConstantBufferData, b.sharedConstantBufferDataSize));
+            NRD_TEST_CHECK(!AreRangesOverlapped(a.constantBufferData, a.constantBufferDataSize, b.sharedConstantBufferData, b.sharedConstantBufferDataSize));
+            NRD_TEST_CHECK(!AreRangesOverlapped(a.sharedConstantBufferData, a.sharedConstantBufferDataSize, b.constantBufferData, b.constantBufferDataSize));
+        }
+    }
+}
+
+static void Test(uint32_t viewsNum, uint32_t contextsNum)
+{
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+    std::vector<nrd::Identifier> identifiers = nrd_test::GetIdentifiers(denoiserDescs);
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+    instanceCreationDesc.viewsNum = viewsNum;
+
+    // "parallel" is used from several threads, "serial" from one
+    nrd::Instance* parallel = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, parallel) == nrd::Result::SUCCESS);
+
+    nrd::Instance* serial = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, serial) == nrd::Result::SUCCESS);
+
+    std::vector<nrd::DispatchContext*> parallelContexts(contextsNum);
+    std::vector<nrd::DispatchContext*> serialContexts(contextsNum);
+    for (uint32_t i = 0; i < contextsNum; i++)
+    {
+        NRD_TEST_CHECK(nrd::CreateDispatchContext(*parallel, parallelContexts[i]) == nrd::Result::SUCCESS);
+        NRD_TEST_CHECK(nrd::CreateDispatchContext(*serial, serialContexts[i]) == nrd::Result::SUCCESS);
+    }
+
+    // Disjoint lists of identifiers: denoiser "i" goes to context "i % contextsNum"
+    std::vector<std::vector<nrd::Identifier>> contextIdentifiers(contextsNum);
+    for (size_t i = 0; i < identifiers.size(); i++)
+        contextIdentifiers[i % contextsNum].push_back(identifiers[i]);
+
+    std::vector<ContextResult> parallelResults(contextsNum);
+    std::vector<std::thread> threads(contextsNum);
+
+    nrd::Result parallelQueryResult = nrd::Result::SUCCESS;
+    std::vector<uint16_t> parallelReachablePipelines;
+    nrd::DescriptorPoolDesc parallelDescriptorPoolDesc = {};
+
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*parallel);
+    for (uint32_t frameIndex = 0; frameIndex < 1000; frameIndex++)
+    {
+        for (uint32_t viewIndex = 0; viewIndex < instanceDesc.viewsNum; viewIndex++)
+        {
+            nrd::CommonSettings commonSettings = nrd_test::GetCommonSettings(frameIndex, viewIndex);
+            if (frameIndex % 97 == 50 + viewIndex)
+                commonSettings.accumulationMode = nrd::AccumulationMode::CLEAR_AND_RESTART;
+            if ((frameIndex / 300) % 2)
+                commonSettings.resolutionScale[0] = commonSettings.resolutionScale[1] = 0.75f;
+
+            NRD_TEST_CHECK(nrd::SetViewCommonSettings(*parallel, viewIndex, commonSettings) == nrd::Result::SUCCESS);
+            NRD_TEST_CHECK(nrd::SetViewCommonSettings(*serial, viewIndex, commonSettings) == nrd::Result::SUCCESS);
+        }
+
+        nrd_test::SetDenoiserSettings(*parallel, denoiserDescs, frameIndex / 40);
+        nrd_test::SetDenoiserSettings(*serial, denoiserDescs, frameIndex / 40);
+
+        for (uint32_t i = 0; i < contextsNum; i++)
+        {
+            threads[i] = std::thread([&, i]()
+            {
+                ContextResult& r = parallelResults[i];
+                r.result = nrd::GetContextComputeDispatches(*parallel, *parallelContexts[i], contextIdentifiers[i].data(), (uint32_t)contextIdentifiers[i].size(), r.dispatchDescs, r.dispatchDescsNum);
+            });
+        }
+
+        // Dry runs for all identifiers, which overlap with every context
+        std::thread queryThread([&]()
+        {
+            nrd::ReachablePipelinesDesc reachablePipelinesDesc = {};
+            parallelQueryResult = nrd::GetReachablePipelines(*parallel, identifiers.data(), (uint32_t)identifiers.size(), reachablePipelinesDesc);
+            parallelReachablePipelines.assign(reachablePipelinesDesc.pipelineIndices, reachablePipelinesDesc.pipelineIndices + reachablePipelinesDesc.pipelineIndicesNum);
+
+            if (parallelQueryResult == nrd::Result::SUCCESS)
+                parallelQueryResult = nrd::GetFrameDescriptorPoolDesc(*parallel, identifiers.data(), (uint32_t)identifiers.size(), parallelDescriptorPoolDesc);
+        });
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        queryThread.join();
+
+        nrd::ReachablePipelinesDesc serialReachablePipelinesDesc = {};
+        NRD_TEST_CHECK(nrd::GetReachablePipelines(*serial, identifiers.data(), (uint32_t)identifiers.size(), serialReachablePipelinesDesc) == nrd::Result::SUCCESS);
+
+        nrd::DescriptorPoolDesc serialDescriptorPoolDesc = {};
+        NRD_TEST_CHECK(nrd::GetFrameDescriptorPoolDesc(*serial, identifiers.data(), (uint32_t)identifiers.size(), serialDescriptorPoolDesc) == nrd::Result::SUCCESS);
+
+        NRD_TEST_CHECK(parallelQueryResult == nrd::Result::SUCCESS);
+        NRD_TEST_CHECK(parallelReachablePipelines.size() == serialReachablePipelinesDesc.pipelineIndicesNum);
+        NRD_TEST_CHECK(!memcmp(parallelReachablePipelines.data(), serialReachablePipelinesDesc.pipelineIndices, parallelReachablePipelines.size() * sizeof(uint16_t)));
+        NRD_TEST_CHECK(!memcmp(&parallelDescriptorPoolDesc, &serialDescriptorPoolDesc, sizeof(serialDescriptorPoolDesc)));
+
+        for (uint32_t i = 0; i < contextsNum; i++)
+        {
+            ContextResult serialResult = {};
+            serialResult.result = nrd::GetContextComputeDispatches(*serial, *serialContexts[i], contextIdentifiers[i].data(), (uint32_t)contextIdentifiers[i].size(), serialResult.dispatchDescs, serialResult.dispatchDescsNum);
+
+            const ContextResult& parallelResult = parallelResults[i];
+            NRD_TEST_CHECK(parallelResult.result == nrd::Result::SUCCESS);
+            NRD_TEST_CHECK(serialResult.result == nrd::Result::SUCCESS);
+
+            if (!nrd_test::AreDispatchesEqual(parallelResult.dispatchDescs, parallelResult.dispatchDescsNum, serialResult.dispatchDescs, serialResult.dispatchDescsNum))
+                printf("Frame %u, context %u: parallel and serial dispatches differ\n", frameIndex, i);
+
+            NRD_TEST_CHECK(nrd_test::AreDispatchesEqual(parallelResult.dispatchDescs, parallelResult.dispatchDescsNum, serialResult.dispatchDescs, serialResult.dispatchDescsNum));
+
+            for (uint32_t j = 0; j < i; j++)
+                CheckConstantsAreDisjoint(parallelResults[i], parallelResults[j]);
+        }
+    }
+
+    for (uint32_t i = 0; i < contextsNum; i++)
+    {
+        nrd::DestroyDispatchContext(*parallel, *parallelContexts[i]);
+        nrd::DestroyDispatchContext(*serial, *serialContexts[i]);
+    }
+
+    nrd::DestroyInstance(*parallel);
+    nrd::DestroyInstance(*serial);
+}
+
+int main()
+{
+    Test(1, 2);
+    Test(1, 3);
+    Test(2, 3);
+
+    return 0;
+}
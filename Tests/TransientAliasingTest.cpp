@@ -0,0 +1,187 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// "InstanceDesc::transientPoolAliasing" must not place textures with overlapping lifetimes into overlapping memory. Lifetimes
+// are gathered from emitted dispatches independently of the library: a live range of a texture starts at the first access
+// within a denoiser and ends at the last access. If the first access of a denoiser is a read of a texture, which is already
+// live, its content comes from a previous denoiser (i.e. the range continues)
+
+#include "TestCommon.h"
+
+struct LiveRange
+{
+    uint32_t indexInPool;
+    uint32_t first;
+    uint32_t last;
+};
+
+static size_t GetDenoiserNameLength(const char* name)
+{
+    const char* separator = strstr(name, " - ");
+
+    return separator ? size_t(separator - name) : strlen(name);
+}
+
+static void GatherLiveRanges(const nrd::InstanceDesc& instanceDesc, const nrd::DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, std::vector<LiveRange>& liveRanges)
+{
+    std::vector<uint32_t> currentRange(instanceDesc.transientPoolSize, uint32_t(-1));
+    std::vector<uint32_t> lastSegment(instanceDesc.transientPoolSize, uint32_t(-1));
+
+    liveRanges.clear();
+
+    const char* segmentName = nullptr;
+    uint32_t segment = 0;
+
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+
+        // "Clear" dispatches touch only history
+        if (!strncmp(dispatchDesc.name, "Clear", 5))
+            continue;
+
+        // Dispatches of a denoiser are contiguous and share the name prefix
+        size_t nameLength = GetDenoiserNameLength(dispatchDesc.name);
+        if (!segmentName || nameLength != GetDenoiserNameLength(segmentName) || strncmp(dispatchDesc.name, segmentName, nameLength))
+        {
+            segmentName = dispatchDesc.name;
+            segment++;
+        }
+
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            const nrd::ResourceDesc& resource = dispatchDesc.resources[r];
+            if (resource.type != nrd::ResourceType::TRANSIENT_POOL)
+                continue;
+
+            NRD_TEST_CHECK(resource.indexInPool < instanceDesc.transientPoolSize);
+
+            uint16_t indexInPool = resource.indexInPool;
+            if (lastSegment[indexInPool] != segment)
+            {
+                lastSegment[indexInPool] = segment;
+
+                bool isContentCarried = resource.stateNeeded == nrd::DescriptorType::TEXTURE && currentRange[indexInPool] != uint32_t(-1);
+                if (!isContentCarried)
+                {
+                    currentRange[indexInPool] = (uint32_t)liveRanges.size();
+                    liveRanges.push_back( {indexInPool, i, i} );
+                }
+            }
+
+            liveRanges[ currentRange[indexInPool] ].last = i;
+        }
+    }
+}
+
+static void CheckAliasing(const nrd::InstanceDesc& instanceDesc, const nrd::DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, std::vector<LiveRange>& liveRanges)
+{
+    GatherLiveRanges(instanceDesc, dispatchDescs, dispatchDescsNum, liveRanges);
+
+    for (size_t i = 0; i < liveRanges.size(); i++)
+    {
+        for (size_t j = i + 1; j < liveRanges.size(); j++)
+        {
+            const LiveRange& a = liveRanges[i];
+            const LiveRange& b = liveRanges[j];
+
+            if (a.indexInPool == b.indexInPool)
+                continue;
+
+            bool isLifetimeOverlapped = a.first <= b.last && b.first <= a.last;
+            if (!isLifetimeOverlapped)
+                continue;
+
+            const nrd::TransientAliasingDesc& x = instanceDesc.transientPoolAliasing[a.indexInPool];
+            const nrd::TransientAliasingDesc& y = instanceDesc.transientPoolAliasing[b.indexInPool];
+
+            bool isMemoryOverlapped = x.aliasingGroupIndex == y.aliasingGroupIndex && x.offset < y.offset + y.size && y.offset < x.offset + x.size;
+            if (isMemoryOverlapped)
+            {
+                printf("Transient textures %u and %u are alive at the same time (\"%s\" and \"%s\"), but share memory\n",
+                    a.indexInPool, b.indexInPool, dispatchDescs[a.first].name, dispatchDescs[b.first].name);
+            }
+
+            NRD_TEST_CHECK(!isMemoryOverlapped);
+        }
+    }
+}
+
+static void Test(uint32_t viewsNum, bool interleaveViews, bool shareGeometryHistory)
+{
+    std::vector<nrd::DenoiserDesc> denoiserDescs = nrd_test::GetDenoisers();
+    std::vector<nrd::Identifier> identifiers = nrd_test::GetIdentifiers(denoiserDescs);
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs.data();
+    instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+    instanceCreationDesc.viewsNum = viewsNum;
+    instanceCreationDesc.interleaveViews = interleaveViews;
+    instanceCreationDesc.shareGeometryHistory = shareGeometryHistory;
+
+    nrd::Instance* instance = nullptr;
+    NRD_TEST_CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::SUCCESS);
+
+    // Placement is within aliasing groups
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*instance);
+    for (uint32_t i = 0; i < instanceDesc.transientPoolSize; i++)
+    {
+        const nrd::TransientAliasingDesc& aliasingDesc = instanceDesc.transientPoolAliasing[i];
+
+        NRD_TEST_CHECK(aliasingDesc.aliasingGroupIndex < instanceDesc.aliasingGroupsNum);
+        NRD_TEST_CHECK(aliasingDesc.size != 0);
+        NRD_TEST_CHECK(aliasingDesc.offset + aliasingDesc.size <= instanceDesc.aliasingGroups[aliasingDesc.aliasingGroupIndex].size);
+    }
+
+    // Lifetimes depend on settings and the set of denoisers, which are dispatched together
+    std::vector<LiveRange> liveRanges;
+    for (uint32_t frameIndex = 0; frameIndex < 256; frameIndex++)
+    {
+        for (uint32_t viewIndex = 0; viewIndex < instanceDesc.viewsNum; viewIndex++)
+        {
+            nrd::CommonSettings commonSettings = nrd_test::GetCommonSettings(frameIndex, viewIndex);
+            commonSettings.enableValidation = (frameIndex / 32) % 2 != 0;
+            if (frameIndex % 64 == 40 + viewIndex)
+                commonSettings.accumulationMode = nrd::AccumulationMode::CLEAR_AND_RESTART;
+
+            NRD_TEST_CHECK(nrd::SetViewCommonSettings(*instance, viewIndex, commonSettings) == nrd::Result::SUCCESS);
+        }
+
+        nrd_test::SetDenoiserSettings(*instance, denoiserDescs, frameIndex / 8);
+
+        // All denoisers, the first half or the second half
+        const nrd::Identifier* frameIdentifiers = identifiers.data();
+        uint32_t frameIdentifiersNum = (uint32_t)identifiers.size();
+        if (!shareGeometryHistory && (frameIndex / 16) % 3 != 0)
+        {
+            frameIdentifiersNum /= 2;
+            if ((frameIndex / 16) % 3 == 2)
+                frameIdentifiers += frameIdentifiersNum;
+        }
+
+        const nrd::DispatchDesc* dispatchDescs = nullptr;
+        uint32_t dispatchDescsNum = 0;
+        NRD_TEST_CHECK(nrd::GetComputeDispatches(*instance, frameIdentifiers, frameIdentifiersNum, dispatchDescs, dispatchDescsNum) == nrd::Result::SUCCESS);
+
+        CheckAliasing(instanceDesc, dispatchDescs, dispatchDescsNum, liveRanges);
+    }
+
+    nrd::DestroyInstance(*instance);
+}
+
+int main()
+{
+    Test(1, false, false);
+    Test(1, false, true);
+    Test(2, false, false);
+    Test(2, true, false);
+
+    return 0;
+}
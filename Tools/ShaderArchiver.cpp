@@ -0,0 +1,273 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Packs ShaderMake binaries ("*.cs.dxbc", "*.cs.dxil" and "*.cs.spirv") into a compressed archive header (see "ShaderArchive.h")
+// Usage: ShaderArchiver <shaders directory> <output header> [--config <shaders config>] [--benchmark]
+//  --config - only shaders listed in the ShaderMake config get archived (stale binaries of dropped denoisers are ignored)
+//  --benchmark - reports decompression speed (the ratio is always reported)
+
+#define NRD_SHADER_ARCHIVE_COMPRESSOR
+#include "../Source/ShaderArchive.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Shader
+{
+    std::string fileName;
+    uint64_t shaderHash;
+    nrd::ShaderFormat format;
+    uint32_t blockIndex;
+};
+
+struct Block
+{
+    std::vector<uint8_t> bytecode;
+    uint64_t contentHash;
+    nrd::ShaderArchiveBlock desc;
+};
+
+static const char* g_Extensions[] = {".cs.dxbc", ".cs.dxil", ".cs.spirv"};
+static_assert(sizeof(g_Extensions) / sizeof(g_Extensions[0]) == (size_t)nrd::ShaderFormat::MAX_NUM, "Out of sync");
+
+static uint64_t HashContent(const std::vector<uint8_t>& data)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t b : data)
+        hash = (hash ^ b) * 1099511628211ull;
+
+    return hash;
+}
+
+static bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: ShaderArchiver <shaders directory> <output header> [--config <shaders config>] [--benchmark]\n");
+        return 1;
+    }
+
+    bool isBenchmark = false;
+    const char* configPath = nullptr;
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--benchmark"))
+            isBenchmark = true;
+        else if (!strcmp(argv[i], "--config") && i + 1 < argc)
+            configPath = argv[++i];
+        else
+        {
+            printf("ERROR: unknown argument '%s'!\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Shader names from the config ("Name.cs.hlsl -T cs" => "Name.cs")
+    std::set<std::string> configShaderNames;
+    if (configPath)
+    {
+        std::ifstream config(configPath);
+        if (!config)
+        {
+            printf("ERROR: can't read '%s'!\n", configPath);
+            return 1;
+        }
+
+        std::string line;
+        while (std::getline(config, line))
+        {
+            std::string sourceName = line.substr(0, line.find_first_of(" \t\r"));
+            if (sourceName.size() > 5 && !sourceName.compare(sourceName.size() - 5, 5, ".hlsl"))
+                configShaderNames.insert(sourceName.substr(0, sourceName.size() - 5));
+        }
+    }
+
+    // Collect binaries (sorted for a deterministic output)
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::directory_iterator(argv[1]))
+    {
+        if (entry.is_regular_file())
+            paths.push_back(entry.path());
+    }
+
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<Shader> shaders;
+    std::vector<Block> blocks;
+    uint64_t totalSize = 0;
+
+    for (const std::filesystem::path& path : paths)
+    {
+        std::string fileName = path.filename().string();
+
+        for (uint32_t format = 0; format < (uint32_t)nrd::ShaderFormat::MAX_NUM; format++)
+        {
+            const std::string extension = g_Extensions[format];
+            if (fileName.size() <= extension.size() || fileName.compare(fileName.size() - extension.size(), extension.size(), extension))
+                continue;
+
+            // "Name.cs.format" => "Name.cs" (matches "PipelineDesc::shaderFileName")
+            std::string shaderFileName = fileName.substr(0, fileName.size() - extension.size() + 3);
+            if (configPath && !configShaderNames.count(shaderFileName))
+                continue;
+
+            std::vector<uint8_t> bytecode;
+            if (!ReadFile(path, bytecode))
+            {
+                printf("ERROR: can't read '%s'!\n", path.string().c_str());
+                return 1;
+            }
+
+            totalSize += bytecode.size();
+
+            // Deduplication
+            uint64_t contentHash = HashContent(bytecode);
+
+            size_t blockIndex = 0;
+            while (blockIndex < blocks.size() && (blocks[blockIndex].contentHash != contentHash || blocks[blockIndex].bytecode != bytecode))
+                blockIndex++;
+
+            if (blockIndex == blocks.size())
+                blocks.push_back({std::move(bytecode), contentHash, {}});
+
+            shaders.push_back({fileName, nrd::HashShaderName(shaderFileName.c_str()), (nrd::ShaderFormat)format, (uint32_t)blockIndex});
+        }
+    }
+
+    std::sort(shaders.begin(), shaders.end(), [](const Shader& a, const Shader& b)
+    {
+        return a.shaderHash != b.shaderHash ? a.shaderHash < b.shaderHash : a.format < b.format;
+    });
+
+    for (size_t i = 1; i < shaders.size(); i++)
+    {
+        if (shaders[i].shaderHash == shaders[i - 1].shaderHash && shaders[i].format == shaders[i - 1].format)
+        {
+            printf("ERROR: shader name hash collision ('%s' and '%s')!\n", shaders[i - 1].fileName.c_str(), shaders[i].fileName.c_str());
+            return 1;
+        }
+    }
+
+    // Compression (each block is independent, round trip is validated)
+    std::vector<uint8_t> data;
+    uint64_t uniqueSize = 0;
+
+    for (Block& block : blocks)
+    {
+        block.desc.offset = (uint32_t)data.size();
+        block.desc.size = (uint32_t)block.bytecode.size();
+
+        nrd::Lz4Compress(block.bytecode.data(), block.desc.size, data);
+        block.desc.compressedSize = uint32_t(data.size() - block.desc.offset);
+
+        std::vector<uint8_t> decompressed(block.desc.size);
+        if (!nrd::Lz4Decompress(data.data() + block.desc.offset, block.desc.compressedSize, decompressed.data(), block.desc.size) || decompressed != block.bytecode)
+        {
+            printf("ERROR: round trip failed!\n");
+            return 1;
+        }
+
+        uniqueSize += block.desc.size;
+    }
+
+    printf("NRD shader archive: %zu shaders (%zu unique), %.1f KB => %.1f KB unique => %.1f KB compressed (ratio %.2f)\n",
+        shaders.size(), blocks.size(), totalSize / 1024.0, uniqueSize / 1024.0, data.size() / 1024.0, data.empty() ? 0.0 : double(totalSize) / double(data.size()));
+
+    if (isBenchmark && !blocks.empty())
+    {
+        std::vector<uint8_t> decompressed(uniqueSize);
+        uint64_t decompressedSize = 0;
+        uint32_t passesNum = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        double seconds = 0.0;
+        while (seconds < 1.0)
+        {
+            uint8_t* out = decompressed.data();
+            for (const Block& block : blocks)
+            {
+                nrd::Lz4Decompress(data.data() + block.desc.offset, block.desc.compressedSize, out, block.desc.size);
+                out += block.desc.size;
+            }
+
+            decompressedSize += uniqueSize;
+            passesNum++;
+            seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        printf("NRD shader archive: decompression %.1f MB/s (%u passes, %.3f ms per archive)\n",
+            decompressedSize / (1024.0 * 1024.0) / seconds, passesNum, seconds * 1000.0 / passesNum);
+    }
+
+    // Header
+    std::ostringstream header;
+    header << "// This file is auto-generated by ShaderArchiver. Do not modify!\n\n";
+
+    char buffer[64];
+    header << "static const uint8_t g_ShaderArchiveData[] = {";
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        snprintf(buffer, sizeof(buffer), "%s0x%02x,", i % 32 ? " " : "\n    ", data[i]);
+        header << buffer;
+    }
+    header << (data.empty() ? " 0 };\n\n" : "\n};\n\n");
+
+    header << "static const nrd::ShaderArchiveBlock g_ShaderArchiveBlocks[] = {\n";
+    for (const Block& block : blocks)
+        header << "    {" << block.desc.offset << ", " << block.desc.compressedSize << ", " << block.desc.size << "},\n";
+    header << (blocks.empty() ? "    {}\n};\n\n" : "};\n\n");
+
+    header << "static const nrd::ShaderArchiveEntry g_ShaderArchiveEntries[] = {\n";
+    for (const Shader& shader : shaders)
+    {
+        snprintf(buffer, sizeof(buffer), "0x%016llxull", (unsigned long long)shader.shaderHash);
+        header << "    {" << buffer << ", nrd::ShaderFormat(" << (uint32_t)shader.format << "), " << shader.blockIndex << "}, // " << shader.fileName << "\n";
+    }
+    header << (shaders.empty() ? "    {}\n};\n\n" : "};\n\n");
+
+    header << "static const uint32_t g_ShaderArchiveBlocksNum = " << blocks.size() << ";\n";
+    header << "static const uint32_t g_ShaderArchiveEntriesNum = " << shaders.size() << ";\n";
+
+    // Rewrite only if changed to avoid needless recompilation
+    const std::string content = header.str();
+
+    std::vector<uint8_t> prevContent;
+    if (ReadFile(argv[2], prevContent) && prevContent.size() == content.size() && !memcmp(prevContent.data(), content.data(), content.size()))
+        return 0;
+
+    std::ofstream file(argv[2], std::ios::binary);
+    file << content;
+
+    if (!file)
+    {
+        printf("ERROR: can't write '%s'!\n", argv[2]);
+        return 1;
+    }
+
+    return 0;
+}